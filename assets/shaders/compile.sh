@@ -1,5 +1,16 @@
 /usr/local/bin/glslc simple_shader.vert -o simple_shader.vert.spv
+/usr/local/bin/glslc simple_shader_instanced.vert -o simple_shader_instanced.vert.spv
+/usr/local/bin/glslc simple_shader_indirect.vert -o simple_shader_indirect.vert.spv
 /usr/local/bin/glslc simple_shader.frag -o simple_shader.frag.spv
+/usr/local/bin/glslc depth_only.frag -o depth_only.frag.spv
 /usr/local/bin/glslc point_light.vert -o point_light.vert.spv
 /usr/local/bin/glslc point_light.frag -o point_light.frag.spv
+/usr/local/bin/glslc cull_instances.comp -o cull_instances.comp.spv
+/usr/local/bin/glslc compact_draws.comp -o compact_draws.comp.spv
+/usr/local/bin/glslc hiz_downsample.comp -o hiz_downsample.comp.spv
+
+# Validate what was compiled against the Vulkan environment the engine targets.
+for spv in *.spv; do
+	/usr/local/bin/spirv-val --target-env vulkan1.0 "$spv" || exit 1
+done
 echo "Done compiling shaders. ✅"
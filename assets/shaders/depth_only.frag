@@ -0,0 +1,6 @@
+#version 450
+
+// Depth prepass: only the depth written by the rasterizer is kept.
+void main()
+{
+}
@@ -18,18 +18,38 @@ layout (set = 0, binding = 0) uniform GlobalUbo
 	vec4 lightColor;
 } ubo;
 
+// Matches ObjectData in engine/renderer/object_buffer.h.
+struct ObjectData
+{
+	vec4 modelRows[3]; // 3x4 model matrix, stored by rows
+	vec3 normalColumn0;
+	uint materialIndex;
+	vec3 normalColumn1;
+	float padding0;
+	vec3 normalColumn2;
+	float padding1;
+};
+
+layout (std430, set = 1, binding = 0) readonly buffer ObjectBuffer
+{
+	ObjectData objects[];
+};
+
 layout (push_constant) uniform Push
 {
-	mat4 modelMatrix;
-	mat4 normalMatrix;
+	uint objectIndex;
 } push;
 
 void main()
 {
-	vec4 positionWS = push.modelMatrix * vec4(position, 1.0);
+	ObjectData object = objects[push.objectIndex];
+
+	mat3x4 modelRows = mat3x4(object.modelRows[0], object.modelRows[1], object.modelRows[2]);
+	vec4 positionWS = vec4(vec4(position, 1.0) * modelRows, 1.0);
 	gl_Position = ubo.projectionMatrix * ubo.viewMatrix * positionWS;
 
-	fragNormalWS = normalize(mat3(push.normalMatrix) * normal);
+	mat3 normalMatrix = mat3(object.normalColumn0, object.normalColumn1, object.normalColumn2);
+	fragNormalWS = normalize(normalMatrix * normal);
 	fragPositionWS = positionWS.xyz;
 	fragColor = color;
 }
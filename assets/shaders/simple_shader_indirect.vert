@@ -0,0 +1,57 @@
+#version 450
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+layout (location = 2) in vec3 normal;
+layout (location = 3) in vec3 uv;
+
+layout (location = 0) out vec3 fragColor;
+layout (location = 1) out vec3 fragPositionWS;
+layout (location = 2) out vec3 fragNormalWS;
+
+layout (set = 0, binding = 0) uniform GlobalUbo
+{
+	mat4 projectionMatrix;
+	mat4 viewMatrix;
+	vec4 ambientLightColor;
+	vec3 lightPosition;
+	vec4 lightColor;
+} ubo;
+
+// Matches ObjectData in engine/renderer/object_buffer.h.
+struct ObjectData
+{
+	vec4 modelRows[3]; // 3x4 model matrix, stored by rows
+	vec3 normalColumn0;
+	uint materialIndex;
+	vec3 normalColumn1;
+	float padding0;
+	vec3 normalColumn2;
+	float padding1;
+};
+
+layout (std430, set = 1, binding = 0) readonly buffer ObjectBuffer
+{
+	ObjectData objects[];
+};
+
+// Written by cull_instances.comp: the object of every visible instance, grouped by batch.
+layout (std430, set = 2, binding = 0) readonly buffer VisibleBuffer
+{
+	uint visibleObjects[];
+};
+
+void main()
+{
+	// firstInstance of the draw is the start of the batch in the visible list.
+	ObjectData object = objects[visibleObjects[gl_InstanceIndex]];
+
+	mat3x4 modelRows = mat3x4(object.modelRows[0], object.modelRows[1], object.modelRows[2]);
+	vec4 positionWS = vec4(vec4(position, 1.0) * modelRows, 1.0);
+	gl_Position = ubo.projectionMatrix * ubo.viewMatrix * positionWS;
+
+	mat3 normalMatrix = mat3(object.normalColumn0, object.normalColumn1, object.normalColumn2);
+	fragNormalWS = normalize(normalMatrix * normal);
+	fragPositionWS = positionWS.xyz;
+	fragColor = color;
+}
@@ -0,0 +1,148 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vector>
+
+// Tiny in-house microbenchmark harness. A benchmark is a function that runs its body
+// state.GetIterations() times. The runner calibrates the iteration count, repeats the
+// measurement and reports per-iteration statistics as a table and as JSON.
+//
+//   MP_BENCHMARK(HashMap_Find)
+//   {
+//       ... setup ...
+//       for (U64 i = 0; i < state.GetIterations(); ++i)
+//       {
+//           Bench::DoNotOptimize(map.find(key));
+//       }
+//       state.SetItemsProcessed(state.GetIterations());
+//   }
+//
+// Correctness checks of the benchmarked code are registered separately. They run once before the
+// benchmarks, outside of any timing, and a failed check makes mapo-bench exit with a non-zero code.
+//
+//   MP_BENCHMARK_CHECK(HashMap_Find_Check)
+//   {
+//       check.Expect(map.find(key) != map.end(), "inserted key not found");
+//   }
+
+namespace Mapo
+{
+	namespace Bench
+	{
+		class State
+		{
+		public:
+			State(U64 iterations)
+				: m_iterations(iterations)
+			{
+			}
+
+			U64 GetIterations() const { return m_iterations; }
+
+			// Excludes setup work inside the loop from the measurement.
+			void PauseTiming();
+			void ResumeTiming();
+
+			void SetItemsProcessed(U64 items) { m_itemsProcessed = items; }
+			void SetBytesProcessed(U64 bytes) { m_bytesProcessed = bytes; }
+
+			// Marks the benchmark as skipped (e.g. missing assets).
+			void SkipWithMessage(const String& message) { m_skipMessage = message; }
+
+		private:
+			friend class Runner;
+
+			U64 m_iterations = 0;
+			U64 m_itemsProcessed = 0;
+			U64 m_bytesProcessed = 0;
+			F64 m_pausedSeconds = 0.0;
+
+			Timer::Clock::time_point m_pauseStart{};
+			String					 m_skipMessage{};
+		};
+
+		class Check
+		{
+		public:
+			// Records a failure unless the condition holds. Returns the condition.
+			bool Expect(bool condition, const String& message);
+
+			// Marks the check as skipped (e.g. instruction set not supported).
+			void SkipWithMessage(const String& message) { m_skipMessage = message; }
+
+		private:
+			friend class Runner;
+
+			String m_failMessage{}; // first failure
+			String m_skipMessage{};
+		};
+
+		using BenchmarkFn = void (*)(State&);
+		using CheckFn = void (*)(Check&);
+
+		struct BenchmarkInfo
+		{
+			const char* name;
+			BenchmarkFn function;
+		};
+
+		struct CheckInfo
+		{
+			const char* name;
+			CheckFn		function;
+		};
+
+		std::vector<BenchmarkInfo>& GetRegistry();
+		std::vector<CheckInfo>&		GetCheckRegistry();
+
+		struct Registrar
+		{
+			Registrar(const char* name, BenchmarkFn function)
+			{
+				GetRegistry().push_back({ name, function });
+			}
+
+			Registrar(const char* name, CheckFn function)
+			{
+				GetCheckRegistry().push_back({ name, function });
+			}
+		};
+
+		// Prevents the compiler from optimizing away a computed value.
+		template <typename T>
+		MP_ALWAYS_INLINE void DoNotOptimize(const T& value)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "r,m"(value) : "memory");
+#else
+			static volatile const void* s_sink;
+			s_sink = &value;
+#endif
+		}
+
+		// Forces pending memory writes to be considered observable.
+		MP_ALWAYS_INLINE void ClobberMemory()
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : : "memory");
+#endif
+		}
+
+	} // namespace Bench
+
+} // namespace Mapo
+
+#define MP_BENCHMARK(name)                                                             \
+	static void						 name(::Mapo::Bench::State& state);               \
+	static ::Mapo::Bench::Registrar s_benchmarkRegistrar_##name(#name, name);          \
+	static void						 name([[maybe_unused]] ::Mapo::Bench::State& state)
+
+#define MP_BENCHMARK_CHECK(name)                                                       \
+	static void						 name(::Mapo::Bench::Check& check);               \
+	static ::Mapo::Bench::Registrar s_checkRegistrar_##name(#name, name);              \
+	static void						 name([[maybe_unused]] ::Mapo::Bench::Check& check)
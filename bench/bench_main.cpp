@@ -0,0 +1,469 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "bench/bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Mapo
+{
+	namespace Bench
+	{
+		std::vector<BenchmarkInfo>& GetRegistry()
+		{
+			static std::vector<BenchmarkInfo> s_registry;
+			return s_registry;
+		}
+
+		std::vector<CheckInfo>& GetCheckRegistry()
+		{
+			static std::vector<CheckInfo> s_registry;
+			return s_registry;
+		}
+
+		bool Check::Expect(bool condition, const String& message)
+		{
+			if (!condition && m_failMessage.empty())
+			{
+				m_failMessage = message;
+			}
+
+			return condition;
+		}
+
+		void State::PauseTiming()
+		{
+			m_pauseStart = Timer::Clock::now();
+		}
+
+		void State::ResumeTiming()
+		{
+			m_pausedSeconds += std::chrono::duration<F64>(Timer::Clock::now() - m_pauseStart).count();
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Runner
+		/////////////////////////////////////////////////////////////////////////////////
+
+		struct RunnerOptions
+		{
+			String filter{};
+			String outputPath{}; // "-" writes JSON to stdout
+			F64	   minTime = 0.2; // seconds per repetition
+			U32	   repetitions = 5;
+			bool   listOnly = false;
+		};
+
+		struct BenchmarkResult
+		{
+			String name{};
+			U64	   iterations = 0;
+			F64	   nsMedian = 0.0;
+			F64	   nsMin = 0.0;
+			F64	   nsMean = 0.0;
+			F64	   nsStddev = 0.0;
+			F64	   itemsPerSecond = 0.0;
+			F64	   bytesPerSecond = 0.0;
+			String skipMessage{};
+		};
+
+		struct CheckResult
+		{
+			String name{};
+			String failMessage{};
+			String skipMessage{};
+		};
+
+		class Runner
+		{
+		public:
+			Runner(const RunnerOptions& options)
+				: m_options(options)
+			{
+			}
+
+			BenchmarkResult Run(const BenchmarkInfo& info)
+			{
+				BenchmarkResult result{};
+				result.name = info.name;
+
+				// Calibrate the iteration count so that one repetition takes about minTime.
+				U64 iterations = 1;
+				F64 seconds = 0.0;
+
+				while (true)
+				{
+					State state(iterations);
+					seconds = RunOnce(info, state);
+
+					if (!state.m_skipMessage.empty())
+					{
+						result.skipMessage = state.m_skipMessage;
+						return result;
+					}
+
+					if (seconds >= m_options.minTime || iterations >= (1ull << 40))
+					{
+						break;
+					}
+
+					// Grow at most 10x per step and aim slightly above the target.
+					F64 multiplier = seconds > 0.0 ? (m_options.minTime * 1.4) / seconds : 10.0;
+					multiplier = std::min(10.0, std::max(2.0, multiplier));
+					iterations = static_cast<U64>(iterations * multiplier);
+				}
+
+				std::vector<F64> nsPerIteration{};
+				F64				 items = 0.0;
+				F64				 bytes = 0.0;
+				F64				 totalSeconds = 0.0;
+
+				for (U32 repetition = 0; repetition < m_options.repetitions; ++repetition)
+				{
+					State state(iterations);
+					seconds = RunOnce(info, state);
+
+					nsPerIteration.push_back(seconds * 1e9 / iterations);
+					items += static_cast<F64>(state.m_itemsProcessed);
+					bytes += static_cast<F64>(state.m_bytesProcessed);
+					totalSeconds += seconds;
+				}
+
+				std::sort(nsPerIteration.begin(), nsPerIteration.end());
+
+				F64 sum = 0.0;
+				for (F64 value : nsPerIteration)
+				{
+					sum += value;
+				}
+
+				F64 mean = sum / nsPerIteration.size();
+				F64 variance = 0.0;
+				for (F64 value : nsPerIteration)
+				{
+					variance += (value - mean) * (value - mean);
+				}
+
+				result.iterations = iterations;
+				result.nsMedian = nsPerIteration[nsPerIteration.size() / 2];
+				result.nsMin = nsPerIteration.front();
+				result.nsMean = mean;
+				result.nsStddev = nsPerIteration.size() > 1 ? std::sqrt(variance / (nsPerIteration.size() - 1)) : 0.0;
+				result.itemsPerSecond = totalSeconds > 0.0 ? items / totalSeconds : 0.0;
+				result.bytesPerSecond = totalSeconds > 0.0 ? bytes / totalSeconds : 0.0;
+				return result;
+			}
+
+			static CheckResult RunCheck(const CheckInfo& info)
+			{
+				Check check{};
+				info.function(check);
+
+				return { info.name, check.m_failMessage, check.m_skipMessage };
+			}
+
+		private:
+			static F64 RunOnce(const BenchmarkInfo& info, State& state)
+			{
+				auto start = Timer::Clock::now();
+				info.function(state);
+				auto end = Timer::Clock::now();
+
+				return std::chrono::duration<F64>(end - start).count() - state.m_pausedSeconds;
+			}
+
+		private:
+			RunnerOptions m_options;
+		};
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Reports
+		/////////////////////////////////////////////////////////////////////////////////
+
+		static void PrintTableHeader()
+		{
+			printf("%-40s %14s %12s %12s %12s %14s\n", "Benchmark", "Iterations", "Median(ns)", "Min(ns)", "Stddev(ns)", "Items/s");
+			printf("%s\n", String(109, '-').c_str());
+		}
+
+		static void PrintTableRow(const BenchmarkResult& result)
+		{
+			if (!result.skipMessage.empty())
+			{
+				printf("%-40s SKIPPED: %s\n", result.name.c_str(), result.skipMessage.c_str());
+				return;
+			}
+
+			printf("%-40s %14llu %12.2f %12.2f %12.2f %14.4g\n", result.name.c_str(), (unsigned long long)result.iterations,
+				result.nsMedian, result.nsMin, result.nsStddev, result.itemsPerSecond);
+		}
+
+		static void PrintCheckRow(const CheckResult& result)
+		{
+			if (!result.failMessage.empty())
+			{
+				printf("%-40s FAILED: %s\n", result.name.c_str(), result.failMessage.c_str());
+			}
+			else if (!result.skipMessage.empty())
+			{
+				printf("%-40s SKIPPED: %s\n", result.name.c_str(), result.skipMessage.c_str());
+			}
+			else
+			{
+				printf("%-40s OK\n", result.name.c_str());
+			}
+		}
+
+		static String EscapeJson(const String& text)
+		{
+			String escaped{};
+			for (char c : text)
+			{
+				if (c == '"' || c == '\\')
+				{
+					escaped += '\\';
+				}
+				escaped += c;
+			}
+			return escaped;
+		}
+
+		static void WriteJson(std::ostream& os, const RunnerOptions& options, const std::vector<CheckResult>& checkResults,
+			const std::vector<BenchmarkResult>& results)
+		{
+			char		dateBuffer[64]{};
+			std::time_t now = std::time(nullptr);
+			std::strftime(dateBuffer, sizeof(dateBuffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef NDEBUG
+			const char* buildType = "release";
+#else
+			const char* buildType = "debug";
+#endif
+
+#if defined(__clang__)
+			const char* compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+			const char* compiler = "gcc " __VERSION__;
+#else
+			const char* compiler = "unknown";
+#endif
+
+			os << "{\n";
+			os << "  \"context\": {\n";
+			os << "    \"date\": \"" << dateBuffer << "\",\n";
+			os << "    \"build_type\": \"" << buildType << "\",\n";
+			os << "    \"compiler\": \"" << EscapeJson(compiler) << "\",\n";
+			os << "    \"repetitions\": " << options.repetitions << ",\n";
+			os << "    \"min_time_s\": " << options.minTime << "\n";
+			os << "  },\n";
+			os << "  \"checks\": [\n";
+
+			for (size_t i = 0; i < checkResults.size(); ++i)
+			{
+				const CheckResult& result = checkResults[i];
+
+				os << "    { \"name\": \"" << EscapeJson(result.name) << "\"";
+
+				if (!result.failMessage.empty())
+				{
+					os << ", \"failed\": \"" << EscapeJson(result.failMessage) << "\"";
+				}
+				else if (!result.skipMessage.empty())
+				{
+					os << ", \"skipped\": \"" << EscapeJson(result.skipMessage) << "\"";
+				}
+				else
+				{
+					os << ", \"passed\": true";
+				}
+
+				os << " }" << (i + 1 < checkResults.size() ? ",\n" : "\n");
+			}
+
+			os << "  ],\n";
+			os << "  \"benchmarks\": [\n";
+
+			for (size_t i = 0; i < results.size(); ++i)
+			{
+				const BenchmarkResult& result = results[i];
+
+				os << "    { \"name\": \"" << EscapeJson(result.name) << "\"";
+
+				if (!result.skipMessage.empty())
+				{
+					os << ", \"skipped\": \"" << EscapeJson(result.skipMessage) << "\"";
+				}
+				else
+				{
+					os << ", \"iterations\": " << result.iterations << ", \"ns_per_iter_median\": " << result.nsMedian
+					   << ", \"ns_per_iter_min\": " << result.nsMin << ", \"ns_per_iter_mean\": " << result.nsMean
+					   << ", \"ns_per_iter_stddev\": " << result.nsStddev << ", \"items_per_second\": " << result.itemsPerSecond
+					   << ", \"bytes_per_second\": " << result.bytesPerSecond;
+				}
+
+				os << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+			}
+
+			os << "  ]\n";
+			os << "}\n";
+		}
+
+		static RunnerOptions ParseOptions(int argc, char** argv)
+		{
+			RunnerOptions options{};
+			String		  value{};
+
+			for (int i = 1; i < argc; ++i)
+			{
+				if (strcmp(argv[i], "--list") == 0)
+				{
+					options.listOnly = true;
+				}
+				else if (StringOp::ParseOption(argv[i], "--filter", value))
+				{
+					options.filter = value;
+				}
+				else if (StringOp::ParseOption(argv[i], "--output", value))
+				{
+					options.outputPath = value;
+				}
+				else if (StringOp::ParseOption(argv[i], "--min-time", value))
+				{
+					options.minTime = std::max(0.001, std::atof(value.c_str()));
+				}
+				else if (StringOp::ParseOption(argv[i], "--repetitions", value))
+				{
+					options.repetitions = std::max(1, std::atoi(value.c_str()));
+				}
+				else
+				{
+					printf("Usage: mapo-bench [--list] [--filter=<substring>] [--output=<file.json>|-] [--min-time=<s>] [--repetitions=<n>]\n");
+					exit(1);
+				}
+			}
+
+			return options;
+		}
+
+	} // namespace Bench
+
+} // namespace Mapo
+
+int main(int argc, char** argv)
+{
+	using namespace Mapo;
+	using namespace Mapo::Bench;
+
+	Log::Init();
+
+	RunnerOptions options = ParseOptions(argc, argv);
+
+	std::vector<BenchmarkInfo> benchmarks = GetRegistry();
+	std::sort(benchmarks.begin(), benchmarks.end(),
+		[](const BenchmarkInfo& a, const BenchmarkInfo& b) { return strcmp(a.name, b.name) < 0; });
+
+	std::vector<CheckInfo> checks = GetCheckRegistry();
+	std::sort(checks.begin(), checks.end(),
+		[](const CheckInfo& a, const CheckInfo& b) { return strcmp(a.name, b.name) < 0; });
+
+	if (options.listOnly)
+	{
+		for (const CheckInfo& info : checks)
+		{
+			printf("%s\n", info.name);
+		}
+		for (const BenchmarkInfo& info : benchmarks)
+		{
+			printf("%s\n", info.name);
+		}
+		return 0;
+	}
+
+	auto isFilteredOut = [&options](const char* name) {
+		return !options.filter.empty() && strstr(name, options.filter.c_str()) == nullptr;
+	};
+
+	const bool jsonToStdout = options.outputPath == "-";
+
+	// Checks first, so a broken code path is reported before its timings.
+	std::vector<CheckResult> checkResults{};
+	U32						 failedCheckCount = 0;
+
+	for (const CheckInfo& info : checks)
+	{
+		if (isFilteredOut(info.name))
+		{
+			continue;
+		}
+
+		checkResults.push_back(Runner::RunCheck(info));
+		failedCheckCount += checkResults.back().failMessage.empty() ? 0 : 1;
+
+		if (!jsonToStdout)
+		{
+			PrintCheckRow(checkResults.back());
+			fflush(stdout);
+		}
+	}
+
+	if (!jsonToStdout)
+	{
+		if (!checkResults.empty())
+		{
+			printf("\n");
+		}
+
+		PrintTableHeader();
+	}
+
+	Runner						 runner(options);
+	std::vector<BenchmarkResult> results{};
+
+	for (const BenchmarkInfo& info : benchmarks)
+	{
+		if (isFilteredOut(info.name))
+		{
+			continue;
+		}
+
+		results.push_back(runner.Run(info));
+
+		if (!jsonToStdout)
+		{
+			PrintTableRow(results.back());
+			fflush(stdout);
+		}
+	}
+
+	if (jsonToStdout)
+	{
+		WriteJson(std::cout, options, checkResults, results);
+	}
+	else if (!options.outputPath.empty())
+	{
+		std::ofstream file(options.outputPath);
+		if (!file.is_open())
+		{
+			MP_ERROR("Failed to write benchmark results: {}", options.outputPath);
+			return 1;
+		}
+
+		WriteJson(file, options, checkResults, results);
+		printf("\nResults written to %s\n", options.outputPath.c_str());
+	}
+
+	if (failedCheckCount > 0 && !jsonToStdout)
+	{
+		printf("\n%u of %zu checks failed\n", failedCheckCount, checkResults.size());
+	}
+
+	return failedCheckCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,340 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "bench/bench.h"
+
+#include "core/memory/range_allocator.h"
+
+namespace Mapo
+{
+	static constexpr U32 NAME_COUNT = 1024;
+
+	static const std::vector<String>& GetTestNames()
+	{
+		static std::vector<String> s_names = [] {
+			std::vector<String> names;
+			names.reserve(NAME_COUNT);
+			for (U32 i = 0; i < NAME_COUNT; ++i)
+			{
+				names.push_back("GameObject_" + std::to_string(i) + "_TransformComponent");
+			}
+			return names;
+		}();
+		return s_names;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// SName
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Hashes the string and looks it up in the intern table (all names already interned).
+	MP_BENCHMARK(SName_Intern)
+	{
+		const std::vector<String>& names = GetTestNames();
+
+		for (const String& name : names)
+		{
+			SName warmup(name);
+		}
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			SName name(names[i % NAME_COUNT].c_str());
+			Bench::DoNotOptimize(name);
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(SName_GetCString)
+	{
+		std::vector<SName> names;
+		for (const String& name : GetTestNames())
+		{
+			names.emplace_back(name);
+		}
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Bench::DoNotOptimize(names[i % NAME_COUNT].GetCString());
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(SName_Compare)
+	{
+		std::vector<SName> names;
+		for (const String& name : GetTestNames())
+		{
+			names.emplace_back(name);
+		}
+
+		U64 matches = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			matches += names[i % NAME_COUNT] == names[(i * 7) % NAME_COUNT];
+		}
+
+		Bench::DoNotOptimize(matches);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	// Baseline for SName_Compare.
+	MP_BENCHMARK(String_Compare)
+	{
+		const std::vector<String>& names = GetTestNames();
+
+		U64 matches = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			matches += names[i % NAME_COUNT] == names[(i * 7) % NAME_COUNT];
+		}
+
+		Bench::DoNotOptimize(matches);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// HashMap
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Fills a fresh map with NAME_COUNT entries per iteration.
+	MP_BENCHMARK(HashMap_Insert)
+	{
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			HashMap<U32, U32> map;
+			for (U32 key = 0; key < NAME_COUNT; ++key)
+			{
+				map[key * 2654435761u] = key;
+			}
+			Bench::DoNotOptimize(map);
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * NAME_COUNT);
+	}
+
+	MP_BENCHMARK(HashMap_Find)
+	{
+		HashMap<U32, U32> map;
+		for (U32 key = 0; key < NAME_COUNT; ++key)
+		{
+			map[key * 2654435761u] = key;
+		}
+
+		U64 sum = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			auto it = map.find(static_cast<U32>(i % NAME_COUNT) * 2654435761u);
+			sum += it->second;
+		}
+
+		Bench::DoNotOptimize(sum);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(HashMap_FindMiss)
+	{
+		HashMap<U32, U32> map;
+		for (U32 key = 0; key < NAME_COUNT; ++key)
+		{
+			map[key * 2] = key;
+		}
+
+		U64 misses = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			misses += map.find(static_cast<U32>(i % NAME_COUNT) * 2 + 1) == map.end();
+		}
+
+		Bench::DoNotOptimize(misses);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(HashMap_FindSName)
+	{
+		HashMap<SName, U32> map;
+		std::vector<SName>	keys;
+
+		for (U32 i = 0; i < NAME_COUNT; ++i)
+		{
+			keys.emplace_back(GetTestNames()[i]);
+			map[keys.back()] = i;
+		}
+
+		U64 sum = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			sum += map.find(keys[i % NAME_COUNT])->second;
+		}
+
+		Bench::DoNotOptimize(sum);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(HashMap_FindString)
+	{
+		HashMap<String, U32> map;
+		for (U32 i = 0; i < NAME_COUNT; ++i)
+		{
+			map[GetTestNames()[i]] = i;
+		}
+
+		const std::vector<String>& names = GetTestNames();
+
+		U64 sum = 0;
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			sum += map.find(names[i % NAME_COUNT])->second;
+		}
+
+		Bench::DoNotOptimize(sum);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Allocators
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr U32 ALLOCATION_COUNT = 256;
+	static constexpr U32 ALLOCATION_SIZE = 64;
+
+	// Allocates ALLOCATION_COUNT small blocks and frees them again.
+	MP_BENCHMARK(Allocator_Std)
+	{
+		IAllocator& allocator = StdAllocator::Get();
+		void*		blocks[ALLOCATION_COUNT];
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (U32 j = 0; j < ALLOCATION_COUNT; ++j)
+			{
+				blocks[j] = allocator.Allocate(ALLOCATION_SIZE + (j & 7) * 8);
+			}
+
+			Bench::ClobberMemory();
+
+			for (U32 j = 0; j < ALLOCATION_COUNT; ++j)
+			{
+				allocator.Free(blocks[j]);
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * ALLOCATION_COUNT);
+	}
+
+	// Same workload as Allocator_Std, released with a single Reset.
+	MP_BENCHMARK(Allocator_Linear)
+	{
+		LinearAllocator allocator(ALLOCATION_COUNT * (ALLOCATION_SIZE + 7 * 8));
+		void*			blocks[ALLOCATION_COUNT];
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (U32 j = 0; j < ALLOCATION_COUNT; ++j)
+			{
+				blocks[j] = allocator.Allocate(ALLOCATION_SIZE + (j & 7) * 8);
+			}
+
+			Bench::DoNotOptimize(blocks);
+			allocator.Reset();
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * ALLOCATION_COUNT);
+	}
+
+	// Sub-allocates mesh-sized ranges, frees every other one and fills the holes again, like models being
+	// loaded and unloaded in the geometry pool, then frees everything.
+	static constexpr U32 RANGE_SIZE = 1000;
+
+	static void ChurnRanges(RangeAllocator& allocator, U32 (&offsets)[ALLOCATION_COUNT])
+	{
+		auto rangeSize = [](U32 j) { return RANGE_SIZE / 2 + (j & 7) * (RANGE_SIZE / 8); };
+
+		for (U32 j = 0; j < ALLOCATION_COUNT; ++j)
+		{
+			offsets[j] = allocator.Allocate(rangeSize(j));
+		}
+
+		for (U32 j = 0; j < ALLOCATION_COUNT; j += 2)
+		{
+			allocator.Free(offsets[j], rangeSize(j));
+		}
+
+		for (U32 j = 0; j < ALLOCATION_COUNT; j += 2)
+		{
+			offsets[j] = allocator.Allocate(rangeSize(j));
+		}
+
+		Bench::DoNotOptimize(offsets);
+
+		for (U32 j = 0; j < ALLOCATION_COUNT; ++j)
+		{
+			allocator.Free(offsets[j], rangeSize(j));
+		}
+	}
+
+	// Everything freed must merge back into one free range.
+	MP_BENCHMARK_CHECK(RangeAllocator_Churn_Check)
+	{
+		RangeAllocator allocator(ALLOCATION_COUNT * RANGE_SIZE * 2);
+		U32			   offsets[ALLOCATION_COUNT];
+
+		ChurnRanges(allocator, offsets);
+
+		check.Expect(allocator.GetUsedCount() == 0 && allocator.GetFreeRangeCount() == 1, "freed ranges did not merge back into one");
+	}
+
+	MP_BENCHMARK(RangeAllocator_Churn)
+	{
+		RangeAllocator allocator(ALLOCATION_COUNT * RANGE_SIZE * 2);
+		U32			   offsets[ALLOCATION_COUNT];
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			ChurnRanges(allocator, offsets);
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * ALLOCATION_COUNT * 2);
+	}
+
+	MP_BENCHMARK(AllocateAligned_16)
+	{
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			void* ptr = AllocateAligned(ALLOCATION_SIZE, 16);
+			Bench::DoNotOptimize(ptr);
+			FreeAligned(ptr);
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(AllocateAligned_128)
+	{
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			void* ptr = AllocateAligned(ALLOCATION_SIZE, 128);
+			Bench::DoNotOptimize(ptr);
+			FreeAligned(ptr);
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	// Baseline for AllocateAligned.
+	MP_BENCHMARK(AllocateNew)
+	{
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			U8* ptr = new U8[ALLOCATION_SIZE];
+			Bench::DoNotOptimize(ptr);
+			delete[] ptr;
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+} // namespace Mapo
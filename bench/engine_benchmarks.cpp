@@ -0,0 +1,1186 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "bench/bench.h"
+
+#include "engine/model.h"
+
+#include "engine/scene/scene.h"
+#include "engine/scene/component.h"
+#include "engine/scene/scene_camera.h"
+#include "engine/scene/scene_system.h"
+#include "engine/scene/system_scheduler.h"
+#include "engine/scene/entity_command_buffer.h"
+#include "engine/scene/transform_batch.h"
+#include "engine/scene/dynamic_aabb_tree.h"
+#include "engine/scene/potentially_visible_set.h"
+
+#include "engine/renderer/render_queue.h"
+#include "engine/renderer/software_occlusion.h"
+
+#include "engine/event/event.h"
+#include "engine/event/application_event.h"
+#include "engine/event/key_event.h"
+#include "engine/event/mouse_event.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace Mapo
+{
+	/////////////////////////////////////////////////////////////////////////////////
+	// Transform
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr U32 TRANSFORM_COUNT = 1024;
+
+	static std::vector<TransformComponent> CreateTestTransforms()
+	{
+		std::vector<TransformComponent> transforms(TRANSFORM_COUNT);
+
+		for (U32 i = 0; i < TRANSFORM_COUNT; ++i)
+		{
+			F32 t = static_cast<F32>(i);
+			transforms[i].translation = { t * 0.1f, t * -0.2f, t * 0.3f };
+			transforms[i].rotation = { t * 1.7f, t * 3.1f, t * 0.7f };
+			transforms[i].scale = { 1.0f + t * 0.001f, 1.0f, 0.5f };
+		}
+
+		return transforms;
+	}
+
+	MP_BENCHMARK(Transform_GetTransformMatrix)
+	{
+		std::vector<TransformComponent> transforms = CreateTestTransforms();
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (TransformComponent& transform : transforms)
+			{
+				Matrix4 matrix = transform.GetTransformMatrix();
+				Bench::DoNotOptimize(matrix);
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * TRANSFORM_COUNT);
+	}
+
+	MP_BENCHMARK(Transform_GetNormalMatrix)
+	{
+		std::vector<TransformComponent> transforms = CreateTestTransforms();
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (TransformComponent& transform : transforms)
+			{
+				Matrix3 matrix = transform.GetNormalMatrix();
+				Bench::DoNotOptimize(matrix);
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * TRANSFORM_COUNT);
+	}
+
+	// The test transforms in structure-of-arrays layout.
+	struct TransformBatchData
+	{
+		std::vector<F32>	soa;
+		TransformBatchInput input{};
+	};
+
+	static TransformBatchData CreateTransformBatchData(const std::vector<TransformComponent>& transforms)
+	{
+		TransformBatchData data;
+		data.soa.resize(9 * TRANSFORM_COUNT);
+
+		for (U32 i = 0; i < TRANSFORM_COUNT; ++i)
+		{
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				data.soa[axis * TRANSFORM_COUNT + i] = transforms[i].translation[axis];
+				data.soa[(3 + axis) * TRANSFORM_COUNT + i] = transforms[i].rotation[axis];
+				data.soa[(6 + axis) * TRANSFORM_COUNT + i] = transforms[i].scale[axis];
+			}
+		}
+
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			data.input.translation[axis] = &data.soa[axis * TRANSFORM_COUNT];
+			data.input.rotation[axis] = &data.soa[(3 + axis) * TRANSFORM_COUNT];
+			data.input.scale[axis] = &data.soa[(6 + axis) * TRANSFORM_COUNT];
+		}
+
+		return data;
+	}
+
+	// Every path must stay within 2e-6 of the scalar matrices, relative to the scale, for angles within
+	// [-720, 720] degrees (see ComputeTransformMatrices).
+	static void CheckComputeTransformBatch(Bench::Check& check, Simd::SimdLevel level)
+	{
+		if (Simd::GetBestSimdLevel() < level)
+		{
+			check.SkipWithMessage(String(Simd::GetSimdLevelName(level)) + " is not supported by this CPU");
+			return;
+		}
+
+		std::mt19937						random(42);
+		std::uniform_real_distribution<F32> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<F32> angle(-720.0f, 720.0f);
+		std::uniform_real_distribution<F32> scale(0.1f, 10.0f);
+
+		std::vector<TransformComponent> transforms(TRANSFORM_COUNT);
+		for (TransformComponent& transform : transforms)
+		{
+			transform.translation = { position(random), position(random), position(random) };
+			transform.rotation = { angle(random), angle(random), angle(random) };
+			transform.scale = { scale(random), scale(random), scale(random) };
+		}
+
+		const TransformBatchData data = CreateTransformBatchData(transforms);
+
+		std::vector<TransformMatrices> output(TRANSFORM_COUNT);
+		std::vector<TransformMatrices> expected(TRANSFORM_COUNT);
+		ComputeTransformMatrices(data.input, TRANSFORM_COUNT, output.data(), level);
+		ComputeTransformMatrices(data.input, TRANSFORM_COUNT, expected.data(), Simd::SimdLevel::Scalar);
+
+		for (U32 i = 0; i < TRANSFORM_COUNT; ++i)
+		{
+			const Matrix4* matrices[2] = { &output[i].model, &output[i].normal };
+			const Matrix4* expectedMatrices[2] = { &expected[i].model, &expected[i].normal };
+
+			for (U32 matrix = 0; matrix < 2; ++matrix)
+			{
+				for (U32 column = 0; column < 4; ++column)
+				{
+					const Vector4& values = (*matrices[matrix])[column];
+					const Vector4& expectedValues = (*expectedMatrices[matrix])[column];
+
+					// The length of a column is its scale (or inverse scale).
+					const F32 tolerance = 2e-6f * MathOp::Max(1.0f, MathOp::Length(expectedValues));
+
+					for (U32 row = 0; row < 4; ++row)
+					{
+						if (!check.Expect(MathOp::Abs(values[row] - expectedValues[row]) <= tolerance,
+								"matrices differ from the scalar ones at object " + std::to_string(i)))
+						{
+							return;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	static void BenchmarkComputeTransformBatch(Bench::State& state, Simd::SimdLevel level)
+	{
+		if (Simd::GetBestSimdLevel() < level)
+		{
+			state.SkipWithMessage(String(Simd::GetSimdLevelName(level)) + " is not supported by this CPU");
+			return;
+		}
+
+		const TransformBatchData data = CreateTransformBatchData(CreateTestTransforms());
+
+		std::vector<TransformMatrices> output(TRANSFORM_COUNT);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			ComputeTransformMatrices(data.input, TRANSFORM_COUNT, output.data(), level);
+			Bench::DoNotOptimize(output.data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * TRANSFORM_COUNT);
+	}
+
+	MP_BENCHMARK(Transform_ComputeBatchScalar)
+	{
+		BenchmarkComputeTransformBatch(state, Simd::SimdLevel::Scalar);
+	}
+
+#if MP_SIMD_X86
+	MP_BENCHMARK_CHECK(Transform_ComputeBatchSSE41_Check)
+	{
+		CheckComputeTransformBatch(check, Simd::SimdLevel::SSE41);
+	}
+
+	MP_BENCHMARK_CHECK(Transform_ComputeBatchAVX2_Check)
+	{
+		CheckComputeTransformBatch(check, Simd::SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK(Transform_ComputeBatchSSE41)
+	{
+		BenchmarkComputeTransformBatch(state, Simd::SimdLevel::SSE41);
+	}
+
+	MP_BENCHMARK(Transform_ComputeBatchAVX2)
+	{
+		BenchmarkComputeTransformBatch(state, Simd::SimdLevel::AVX2);
+	}
+#endif
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Scene
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Starts the job system for a check, unless the runner already has: systems and scenes use the command
+	// buffer of the job system thread they run on.
+	class ScopedJobSystem
+	{
+	public:
+		ScopedJobSystem()
+			: m_owner(!JobSystem::IsInitialized())
+		{
+			if (m_owner)
+			{
+				JobSystemSettings settings{};
+				settings.workerCount = 3;
+				JobSystem::Init(settings);
+			}
+		}
+
+		~ScopedJobSystem()
+		{
+			if (m_owner)
+			{
+				JobSystem::Shutdown();
+			}
+		}
+
+		ScopedJobSystem(const ScopedJobSystem&) = delete;
+		ScopedJobSystem& operator=(const ScopedJobSystem&) = delete;
+
+	private:
+		bool m_owner = false;
+	};
+
+	// Stamps the start and the end of its update with a clock shared by the systems of a check.
+	class OrderTestSystem : public SceneSystem
+	{
+	public:
+		OrderTestSystem(const String& name, std::atomic<U32>& clock)
+			: SceneSystem(name), m_clock(clock) { }
+
+		using SceneSystem::Reads;
+		using SceneSystem::Writes;
+		using SceneSystem::RequireExclusiveAccess;
+
+		void OnUpdate(entt::registry& registry, EntityCommandBuffer& commands, Timestep dt) override
+		{
+			start = m_clock.fetch_add(1);
+
+			// Long enough for systems that should not run at the same time to overlap if they do.
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+			end = m_clock.fetch_add(1);
+			runCount++;
+		}
+
+		U32 start = 0;
+		U32 end = 0;
+		U32 runCount = 0;
+
+	private:
+		std::atomic<U32>& m_clock;
+	};
+
+	// Conflicting systems must run one after the other in registration order, every frame.
+	MP_BENCHMARK_CHECK(SystemScheduler_DependencyOrder_Check)
+	{
+		ScopedJobSystem jobSystem;
+
+		std::atomic<U32> clock{ 0 };
+		SystemScheduler	 scheduler;
+
+		OrderTestSystem& writeTransform = scheduler.AddSystem<OrderTestSystem>("WriteTransform", clock);
+		OrderTestSystem& readTransform = scheduler.AddSystem<OrderTestSystem>("ReadTransform", clock);
+		OrderTestSystem& writeMaterial = scheduler.AddSystem<OrderTestSystem>("WriteMaterial", clock);
+		OrderTestSystem& readBoth = scheduler.AddSystem<OrderTestSystem>("ReadBoth", clock);
+		OrderTestSystem& exclusive = scheduler.AddSystem<OrderTestSystem>("Exclusive", clock);
+		OrderTestSystem& writeTransformAgain = scheduler.AddSystem<OrderTestSystem>("WriteTransformAgain", clock);
+		OrderTestSystem& readMaterial = scheduler.AddSystem<OrderTestSystem>("ReadMaterial", clock);
+
+		writeTransform.Writes<TransformComponent>();
+		readTransform.Reads<TransformComponent>();
+		writeMaterial.Writes<MaterialComponent>();
+		readBoth.Reads<TransformComponent, MaterialComponent>();
+		exclusive.RequireExclusiveAccess();
+		writeTransformAgain.Writes<TransformComponent>();
+		readMaterial.Reads<MaterialComponent>();
+
+		// Pairs that conflict, earlier system first. The others (readTransform and readBoth, writeMaterial and
+		// the transform systems before the exclusive one) may overlap.
+		const std::pair<const OrderTestSystem*, const OrderTestSystem*> ordered[] = {
+			{ &writeTransform, &readTransform },
+			{ &writeTransform, &readBoth },
+			{ &writeMaterial, &readBoth },
+			{ &writeTransform, &exclusive },
+			{ &readTransform, &exclusive },
+			{ &writeMaterial, &exclusive },
+			{ &readBoth, &exclusive },
+			{ &exclusive, &writeTransformAgain },
+			{ &exclusive, &readMaterial },
+			{ &readTransform, &writeTransformAgain },
+			{ &readBoth, &writeTransformAgain },
+			{ &writeMaterial, &readMaterial },
+		};
+
+		entt::registry registry;
+
+		std::vector<UniqueRef<EntityCommandBuffer>> commandBuffers;
+		std::vector<EntityCommandBuffer*>			commandBufferPointers;
+		for (U32 i = 0; i < JobSystem::GetThreadCount(); ++i)
+		{
+			commandBuffers.push_back(MakeUnique<EntityCommandBuffer>());
+			commandBufferPointers.push_back(commandBuffers.back().get());
+		}
+
+		constexpr U32 FRAME_COUNT = 16;
+
+		for (U32 frame = 0; frame < FRAME_COUNT; ++frame)
+		{
+			scheduler.Run(registry, commandBufferPointers.data(), 1.0f / 60.0f);
+
+			for (const auto& [first, second] : ordered)
+			{
+				if (!check.Expect(first->end < second->start, first->GetName() + " and " + second->GetName() + " overlapped or ran out of order"))
+				{
+					return;
+				}
+			}
+		}
+
+		for (const UniqueRef<SceneSystem>& system : scheduler.GetSystems())
+		{
+			check.Expect(static_cast<const OrderTestSystem&>(*system).runCount == FRAME_COUNT, system->GetName() + " did not run once per frame");
+		}
+	}
+
+	static MaterialComponent MakeMaterial(F32 red)
+	{
+		MaterialComponent material;
+		material.color = { red, 0.0f, 0.0f };
+		return material;
+	}
+
+	// Commands of one game object and component apply in recording order, buffer by buffer, and game objects are
+	// destroyed after all component commands.
+	MP_BENCHMARK_CHECK(EntityCommandBuffer_Playback_Check)
+	{
+		Scene scene;
+
+		GameObject sameBuffer = scene.CreateGameObject("SameBuffer");
+		GameObject twoBuffers = scene.CreateGameObject("TwoBuffers");
+		GameObject addRemove = scene.CreateGameObject("AddRemove");
+		GameObject destroyed = scene.CreateGameObject("Destroyed");
+
+		EntityCommandBuffer first;
+		EntityCommandBuffer second;
+
+		first.SetComponent(sameBuffer, MakeMaterial(1.0f));
+		first.SetComponent(sameBuffer, MakeMaterial(2.0f));
+
+		first.SetComponent(twoBuffers, MakeMaterial(3.0f));
+		second.SetComponent(twoBuffers, MakeMaterial(4.0f));
+
+		first.AddComponent<MaterialComponent>(addRemove);
+		first.RemoveComponent<MaterialComponent>(addRemove);
+
+		// Recorded before the component command, applied after it. Destroying twice is fine.
+		first.DestroyGameObject(destroyed);
+		second.SetComponent(destroyed, MakeMaterial(5.0f));
+		second.DestroyGameObject(destroyed);
+
+		const DeferredEntity created = first.CreateGameObject("Created");
+		first.SetComponent(created, MakeMaterial(6.0f));
+
+		const DeferredEntity temporary = first.CreateGameObject("Temporary");
+		first.DestroyGameObject(temporary);
+
+		EntityCommandBuffer* buffers[] = { &first, &second };
+		EntityCommandBuffer::Playback(scene, buffers, 2);
+
+		check.Expect(first.IsEmpty() && second.IsEmpty(), "command buffers were not reset by the playback");
+
+		HashMap<String, GameObject> gameObjects;
+		for (GameObject& gameObject : scene.GetGameObjects())
+		{
+			gameObjects[gameObject.GetName()] = gameObject;
+		}
+
+		auto getRed = [&gameObjects](const String& name) {
+			auto iter = gameObjects.find(name);
+			if (iter == gameObjects.end() || !iter->second.HasComponent<MaterialComponent>())
+			{
+				return -1.0f;
+			}
+			return iter->second.GetComponent<MaterialComponent>().color.x;
+		};
+
+		check.Expect(getRed("SameBuffer") == 2.0f, "commands of one buffer were not applied in recording order");
+		check.Expect(getRed("TwoBuffers") == 4.0f, "buffers were not applied in order");
+		check.Expect(gameObjects.count("AddRemove") == 1 && getRed("AddRemove") == -1.0f, "removing a component added by the same buffer failed");
+		check.Expect(gameObjects.count("Destroyed") == 0, "destroyed game object is still alive");
+		check.Expect(getRed("Created") == 6.0f, "command on a created game object was not applied");
+		check.Expect(gameObjects.count("Temporary") == 0, "game object created and destroyed by one buffer is still alive");
+		check.Expect(gameObjects.size() == 4, "unexpected number of game objects after playback");
+	}
+
+	static bool IsNearlyEqual(const Matrix4& matrix, const Matrix4& expected, F32 tolerance)
+	{
+		for (U32 column = 0; column < 4; ++column)
+		{
+			for (U32 row = 0; row < 4; ++row)
+			{
+				if (MathOp::Abs(matrix[column][row] - expected[column][row]) > tolerance * MathOp::Max(1.0f, MathOp::Abs(expected[column][row])))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// World matrices are the products of the local matrices down the hierarchy, whatever order the game objects
+	// were created in, and follow when an ancestor moves or the hierarchy changes.
+	MP_BENCHMARK_CHECK(Scene_HierarchyTransforms_Check)
+	{
+		ScopedJobSystem jobSystem;
+
+		Scene		 scene;
+		EditorCamera camera(45.0f, 1.0f);
+
+		// Children first, so the scene has to sort them behind their parents.
+		GameObject grandchild = scene.CreateGameObject("Grandchild");
+		GameObject child = scene.CreateGameObject("Child");
+		GameObject root = scene.CreateGameObject("Root");
+
+		scene.SetParent(child, root);
+		scene.SetParent(grandchild, child);
+
+		TransformComponent& rootTransform = root.GetComponent<TransformComponent>();
+		TransformComponent& childTransform = child.GetComponent<TransformComponent>();
+		TransformComponent& grandchildTransform = grandchild.GetComponent<TransformComponent>();
+
+		rootTransform.translation = { 1.0f, 2.0f, 3.0f };
+		rootTransform.rotation = { 10.0f, 20.0f, 30.0f };
+		rootTransform.scale = { 2.0f, 2.0f, 2.0f };
+
+		childTransform.translation = { 0.0f, 1.0f, 0.0f };
+		childTransform.rotation = { 0.0f, 90.0f, 0.0f };
+
+		grandchildTransform.translation = { 0.5f, 0.0f, -0.5f };
+		grandchildTransform.rotation = { -45.0f, 0.0f, 15.0f };
+		grandchildTransform.scale = { 1.0f, 0.5f, 1.0f };
+
+		// The scene computes local matrices with SIMD, see ComputeTransformMatrices.
+		constexpr F32 TOLERANCE = 1e-5f;
+
+		auto expectWorldMatrices = [&](const char* step) {
+			const Matrix4 rootWorld = rootTransform.GetTransformMatrix();
+			const Matrix4 childWorld = rootWorld * childTransform.GetTransformMatrix();
+			const Matrix4 grandchildWorld = childWorld * grandchildTransform.GetTransformMatrix();
+			const Matrix3 grandchildNormal = rootTransform.GetNormalMatrix() * childTransform.GetNormalMatrix() * grandchildTransform.GetNormalMatrix();
+
+			check.Expect(IsNearlyEqual(rootTransform.worldMatrix, rootWorld, TOLERANCE), String("root world matrix is wrong ") + step);
+			check.Expect(IsNearlyEqual(childTransform.worldMatrix, childWorld, TOLERANCE), String("child world matrix is wrong ") + step);
+			check.Expect(IsNearlyEqual(grandchildTransform.worldMatrix, grandchildWorld, TOLERANCE), String("grandchild world matrix is wrong ") + step);
+			check.Expect(IsNearlyEqual(grandchildTransform.worldNormalMatrix, Matrix4(grandchildNormal), TOLERANCE), String("grandchild world normal matrix is wrong ") + step);
+		};
+
+		scene.OnUpdateEditor(1.0f / 60.0f, camera);
+		expectWorldMatrices("after the first update");
+
+		// Only the root changes, the descendants must still follow.
+		rootTransform.translation = { -4.0f, 0.0f, 5.0f };
+		rootTransform.rotation = { 0.0f, -60.0f, 0.0f };
+
+		scene.OnUpdateEditor(1.0f / 60.0f, camera);
+		expectWorldMatrices("after moving the root");
+
+		// The grandchild keeps its local transform and becomes a root.
+		scene.SetParent(grandchild, GameObject{});
+		scene.OnUpdateEditor(1.0f / 60.0f, camera);
+
+		check.Expect(IsNearlyEqual(grandchildTransform.worldMatrix, grandchildTransform.GetTransformMatrix(), TOLERANCE), "world matrix of a detached game object is wrong");
+		check.Expect(IsNearlyEqual(childTransform.worldMatrix, rootTransform.GetTransformMatrix() * childTransform.GetTransformMatrix(), TOLERANCE), "world matrix of a detached game object's parent is wrong");
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Spatial tree
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Boxes of 0.2 to 6 units scattered in a cube whose volume grows with the count, so the density is the
+	// same for every count.
+	static std::vector<AABB> CreateTestBoxes(U32 count, std::mt19937& random)
+	{
+		const F32 halfSize = 10.0f * std::cbrt(static_cast<F32>(count));
+
+		std::uniform_real_distribution<F32> position(-halfSize, halfSize);
+		std::uniform_real_distribution<F32> extent(0.1f, 3.0f);
+
+		std::vector<AABB> boxes(count);
+		for (AABB& box : boxes)
+		{
+			const Vector3 center = { position(random), position(random), position(random) };
+			const Vector3 halfExtent = { extent(random), extent(random), extent(random) };
+			box = { center - halfExtent, center + halfExtent };
+		}
+
+		return boxes;
+	}
+
+	static std::vector<Ray> CreateTestRays(U32 count, F32 halfSize, std::mt19937& random)
+	{
+		std::uniform_real_distribution<F32> position(-halfSize, halfSize);
+		std::uniform_real_distribution<F32> direction(-1.0f, 1.0f);
+
+		std::vector<Ray> rays(count);
+		for (Ray& ray : rays)
+		{
+			ray.origin = { position(random), position(random), position(random) };
+			ray.direction = MathOp::Normalize(Vector3(direction(random), direction(random), direction(random)));
+		}
+
+		return rays;
+	}
+
+	// Index of the closest box hit, or -1.
+	static I32 RayCastBruteForce(const std::vector<AABB>& boxes, const Ray& ray, F32 maxDistance)
+	{
+		I32 closest = -1;
+
+		for (U32 i = 0; i < boxes.size(); ++i)
+		{
+			F32 distance = 0.0f;
+			if (MathOp::IntersectRayAABB(ray, boxes[i], maxDistance, distance))
+			{
+				closest = static_cast<I32>(i);
+				maxDistance = distance;
+			}
+		}
+
+		return closest;
+	}
+
+	static I32 RayCastTree(const DynamicAABBTree& tree, const std::vector<AABB>& boxes, const Ray& ray, F32 maxDistance)
+	{
+		I32 closest = -1;
+
+		tree.RayCast(ray, maxDistance, [&](I32 proxy, F32 currentMaxDistance) {
+			const U32 index = tree.GetUserData(proxy);
+
+			F32 distance = 0.0f;
+			if (!MathOp::IntersectRayAABB(ray, boxes[index], currentMaxDistance, distance))
+			{
+				return currentMaxDistance;
+			}
+
+			closest = static_cast<I32>(index);
+			return distance;
+		});
+
+		return closest;
+	}
+
+	static constexpr U32 RAY_COUNT = 256;
+	static constexpr F32 RAY_LENGTH = 50.0f;
+
+	static DynamicAABBTree CreateTestTree(const std::vector<AABB>& boxes)
+	{
+		DynamicAABBTree tree;
+		for (U32 i = 0; i < boxes.size(); ++i)
+		{
+			tree.CreateProxy(boxes[i], i);
+		}
+
+		return tree;
+	}
+
+	MP_BENCHMARK_CHECK(SpatialTree_RayCast_Check)
+	{
+		for (const U32 boxCount : { 1000u, 100000u })
+		{
+			std::mt19937			random(42);
+			const std::vector<AABB> boxes = CreateTestBoxes(boxCount, random);
+			const std::vector<Ray>	rays = CreateTestRays(RAY_COUNT, 10.0f * std::cbrt(static_cast<F32>(boxCount)), random);
+			const DynamicAABBTree	tree = CreateTestTree(boxes);
+			tree.Validate();
+
+			// Ties between boxes hit at the same distance may resolve differently, so compare the distances.
+			for (const Ray& ray : rays)
+			{
+				const I32 expected = RayCastBruteForce(boxes, ray, RAY_LENGTH);
+				const I32 result = RayCastTree(tree, boxes, ray, RAY_LENGTH);
+
+				F32 expectedDistance = -1.0f;
+				F32 resultDistance = -1.0f;
+				if (expected >= 0)
+				{
+					MathOp::IntersectRayAABB(ray, boxes[expected], RAY_LENGTH, expectedDistance);
+				}
+				if (result >= 0)
+				{
+					MathOp::IntersectRayAABB(ray, boxes[result], RAY_LENGTH, resultDistance);
+				}
+
+				if (!check.Expect(expectedDistance == resultDistance, "tree ray cast differs from the brute force one"))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	static void BenchmarkRayCast(Bench::State& state, U32 boxCount, bool useTree)
+	{
+		state.PauseTiming();
+
+		std::mt19937			random(42);
+		const std::vector<AABB> boxes = CreateTestBoxes(boxCount, random);
+		const std::vector<Ray>	rays = CreateTestRays(RAY_COUNT, 10.0f * std::cbrt(static_cast<F32>(boxCount)), random);
+		const DynamicAABBTree	tree = CreateTestTree(boxes);
+
+		state.ResumeTiming();
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			const Ray& ray = rays[i % RAY_COUNT];
+			Bench::DoNotOptimize(useTree ? RayCastTree(tree, boxes, ray, RAY_LENGTH) : RayCastBruteForce(boxes, ray, RAY_LENGTH));
+		}
+
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(SpatialTree_RayCast_1K)
+	{
+		BenchmarkRayCast(state, 1000, true);
+	}
+
+	MP_BENCHMARK(SpatialTree_RayCast_100K)
+	{
+		BenchmarkRayCast(state, 100000, true);
+	}
+
+	MP_BENCHMARK(SpatialTree_RayCastBruteForce_1K)
+	{
+		BenchmarkRayCast(state, 1000, false);
+	}
+
+	MP_BENCHMARK(SpatialTree_RayCastBruteForce_100K)
+	{
+		BenchmarkRayCast(state, 100000, false);
+	}
+
+	// Every box moves a little per frame; most stay inside their enlarged boxes.
+	MP_BENCHMARK(SpatialTree_MoveProxies)
+	{
+		static constexpr U32 BOX_COUNT = 10000;
+
+		state.PauseTiming();
+
+		std::mt19937					   random(42);
+		std::vector<AABB>				   boxes = CreateTestBoxes(BOX_COUNT, random);
+		std::uniform_real_distribution<F32> offset(-0.05f, 0.05f);
+
+		DynamicAABBTree	 tree;
+		std::vector<I32> proxies(BOX_COUNT);
+		for (U32 i = 0; i < BOX_COUNT; ++i)
+		{
+			proxies[i] = tree.CreateProxy(boxes[i], i);
+		}
+
+		state.ResumeTiming();
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (U32 j = 0; j < BOX_COUNT; ++j)
+			{
+				const Vector3 move = { offset(random), offset(random), offset(random) };
+				boxes[j].min += move;
+				boxes[j].max += move;
+				tree.MoveProxy(proxies[j], boxes[j]);
+			}
+		}
+
+		tree.Validate();
+		state.SetItemsProcessed(state.GetIterations() * BOX_COUNT);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Render queue
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr U32 DRAW_PACKET_COUNT = 10000;
+
+	// A frame of opaque draws: one pipeline, a few materials and meshes, random depths.
+	static std::vector<DrawPacket> CreateTestDrawPackets()
+	{
+		std::mt19937					 random(42);
+		std::uniform_int_distribution<U32> material(0, 7);
+		std::uniform_int_distribution<U32> mesh(0, 63);
+		std::uniform_int_distribution<U32> depth(0, 0xFFFF);
+
+		std::vector<DrawPacket> packets(DRAW_PACKET_COUNT);
+		for (U32 i = 0; i < DRAW_PACKET_COUNT; ++i)
+		{
+			packets[i].sortKey = RenderQueue::MakeSortKey(DRAW_PASS_OPAQUE, 1, material(random), mesh(random), depth(random));
+			packets[i].payload = i;
+		}
+
+		return packets;
+	}
+
+	static bool IsSameOrder(const std::vector<DrawPacket>& a, const std::vector<DrawPacket>& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+			[](const DrawPacket& x, const DrawPacket& y) { return x.sortKey == y.sortKey && x.payload == y.payload; });
+	}
+
+	// The radix sort is stable, so it must match std::stable_sort exactly.
+	MP_BENCHMARK_CHECK(RenderQueue_RadixSort_Check)
+	{
+		const std::vector<DrawPacket> packets = CreateTestDrawPackets();
+		RenderQueue					  queue;
+
+		for (const DrawPacket& packet : packets)
+		{
+			queue.Push(packet.sortKey, packet.payload);
+		}
+
+		queue.Sort();
+
+		std::vector<DrawPacket> expected = packets;
+		std::stable_sort(expected.begin(), expected.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.sortKey < b.sortKey; });
+
+		check.Expect(IsSameOrder(queue.GetPackets(), expected), "radix sort order differs from std::stable_sort");
+	}
+
+	MP_BENCHMARK(RenderQueue_RadixSort)
+	{
+		const std::vector<DrawPacket> packets = CreateTestDrawPackets();
+		RenderQueue					  queue;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			queue.Clear();
+			for (const DrawPacket& packet : packets)
+			{
+				queue.Push(packet.sortKey, packet.payload);
+			}
+
+			queue.Sort();
+			Bench::DoNotOptimize(queue.GetPackets().data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * DRAW_PACKET_COUNT);
+	}
+
+	MP_BENCHMARK(RenderQueue_StdSort)
+	{
+		const std::vector<DrawPacket> packets = CreateTestDrawPackets();
+		std::vector<DrawPacket>		  sorted;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			sorted = packets;
+			std::sort(sorted.begin(), sorted.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.sortKey < b.sortKey; });
+			Bench::DoNotOptimize(sorted.data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * DRAW_PACKET_COUNT);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Software occlusion
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr U32 OCCLUDER_GRID_SIZE = 32; // quads per side of a wall
+	static constexpr U32 OCCLUSION_BOX_COUNT = 10000;
+
+	// Unit wall in the xy plane, tessellated into OCCLUDER_GRID_SIZE^2 quads.
+	static void CreateWallMesh(std::vector<Vector3>& positions, std::vector<U32>& indices)
+	{
+		for (U32 y = 0; y <= OCCLUDER_GRID_SIZE; ++y)
+		{
+			for (U32 x = 0; x <= OCCLUDER_GRID_SIZE; ++x)
+			{
+				positions.push_back({ static_cast<F32>(x) / OCCLUDER_GRID_SIZE - 0.5f, static_cast<F32>(y) / OCCLUDER_GRID_SIZE - 0.5f, 0.0f });
+			}
+		}
+
+		for (U32 y = 0; y < OCCLUDER_GRID_SIZE; ++y)
+		{
+			for (U32 x = 0; x < OCCLUDER_GRID_SIZE; ++x)
+			{
+				const U32 corner = y * (OCCLUDER_GRID_SIZE + 1) + x;
+				indices.insert(indices.end(), { corner, corner + 1, corner + OCCLUDER_GRID_SIZE + 2 });
+				indices.insert(indices.end(), { corner, corner + OCCLUDER_GRID_SIZE + 2, corner + OCCLUDER_GRID_SIZE + 1 });
+			}
+		}
+	}
+
+	// A row of tessellated walls 10 to 20 units in front of a camera at the origin looking down +z, and boxes
+	// scattered behind them.
+	struct OcclusionTestScene
+	{
+		Matrix4 viewProjection{ 1.0f };
+
+		std::vector<Vector3>	  positions{};
+		std::vector<U32>		  indices{};
+		std::vector<OccluderMesh> occluders{};
+
+		std::vector<Vector3> centers{};
+		std::vector<Vector3> extents{};
+	};
+
+	static OcclusionTestScene CreateOcclusionTestScene()
+	{
+		OcclusionTestScene scene{};
+
+		SceneCamera camera;
+		camera.SetPerspective(MathOp::Radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+		scene.viewProjection = camera.GetProjectionMatrix();
+
+		CreateWallMesh(scene.positions, scene.indices);
+
+		for (I32 i = -3; i <= 3; ++i)
+		{
+			TransformComponent transform;
+			transform.translation = { static_cast<F32>(i) * 5.0f, 0.0f, 10.0f + static_cast<F32>(i + 3) * 1.5f };
+			transform.rotation = { 0.0f, static_cast<F32>(i) * 10.0f, 0.0f };
+			transform.scale = { 6.0f, 8.0f, 1.0f };
+
+			scene.occluders.push_back({ transform.GetTransformMatrix(), scene.positions.data(), static_cast<U32>(scene.positions.size()),
+				scene.indices.data(), static_cast<U32>(scene.indices.size()) });
+		}
+
+		std::mt19937						random(42);
+		std::uniform_real_distribution<F32> x(-40.0f, 40.0f);
+		std::uniform_real_distribution<F32> y(-15.0f, 15.0f);
+		std::uniform_real_distribution<F32> z(1.0f, 100.0f);
+		std::uniform_real_distribution<F32> size(0.1f, 1.0f);
+
+		for (U32 i = 0; i < OCCLUSION_BOX_COUNT; ++i)
+		{
+			scene.centers.push_back({ x(random), y(random), z(random) });
+			scene.extents.push_back({ size(random), size(random), size(random) });
+		}
+
+		return scene;
+	}
+
+	// Every path must produce the same buffer as the reference one.
+	static void CheckRenderOccluders(Bench::Check& check, Simd::SimdLevel level)
+	{
+		if (Simd::GetBestSimdLevel() < level)
+		{
+			check.SkipWithMessage(String(Simd::GetSimdLevelName(level)) + " is not supported by this CPU");
+			return;
+		}
+
+		const OcclusionTestScene scene = CreateOcclusionTestScene();
+		const U32				 occluderCount = static_cast<U32>(scene.occluders.size());
+
+		SoftwareOcclusion occlusion;
+		SoftwareOcclusion reference;
+		occlusion.RenderOccluders(scene.viewProjection, scene.occluders.data(), occluderCount, level);
+		reference.RenderOccluders(scene.viewProjection, scene.occluders.data(), occluderCount, Simd::SimdLevel::Scalar);
+
+		const std::vector<Detail::OcclusionTile>& tiles = occlusion.GetTiles();
+		const std::vector<Detail::OcclusionTile>& expected = reference.GetTiles();
+
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			const bool same = tiles[i].zMax0 == expected[i].zMax0 && tiles[i].zMax1 == expected[i].zMax1 && tiles[i].mask == expected[i].mask;
+
+			if (!check.Expect(same, "occlusion buffer differs from the scalar one at tile " + std::to_string(i)))
+			{
+				return;
+			}
+		}
+	}
+
+	static void BenchmarkRenderOccluders(Bench::State& state, Simd::SimdLevel level)
+	{
+		if (Simd::GetBestSimdLevel() < level)
+		{
+			state.SkipWithMessage(String(Simd::GetSimdLevelName(level)) + " is not supported by this CPU");
+			return;
+		}
+
+		const OcclusionTestScene scene = CreateOcclusionTestScene();
+		const U32				 occluderCount = static_cast<U32>(scene.occluders.size());
+		SoftwareOcclusion		 occlusion;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			occlusion.RenderOccluders(scene.viewProjection, scene.occluders.data(), occluderCount, level);
+			Bench::DoNotOptimize(occlusion.GetTiles().data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * occlusion.GetTriangleCount());
+	}
+
+#if MP_SIMD_X86
+	MP_BENCHMARK_CHECK(SoftwareOcclusion_RenderOccludersAVX2_Check)
+	{
+		CheckRenderOccluders(check, Simd::SimdLevel::AVX2);
+	}
+#endif
+
+	MP_BENCHMARK(SoftwareOcclusion_RenderOccludersScalar)
+	{
+		BenchmarkRenderOccluders(state, Simd::SimdLevel::Scalar);
+	}
+
+#if MP_SIMD_X86
+	MP_BENCHMARK(SoftwareOcclusion_RenderOccludersAVX2)
+	{
+		BenchmarkRenderOccluders(state, Simd::SimdLevel::AVX2);
+	}
+#endif
+
+	// Boxes in front of the nearest wall cannot be hidden, and the walls must hide something.
+	MP_BENCHMARK_CHECK(SoftwareOcclusion_IsVisible_Check)
+	{
+		const OcclusionTestScene scene = CreateOcclusionTestScene();
+		SoftwareOcclusion		 occlusion;
+		occlusion.RenderOccluders(scene.viewProjection, scene.occluders.data(), static_cast<U32>(scene.occluders.size()));
+
+		U32 visibleCount = 0;
+
+		for (U32 j = 0; j < OCCLUSION_BOX_COUNT; ++j)
+		{
+			const bool visible = occlusion.IsVisible(scene.centers[j], scene.extents[j]);
+			visibleCount += visible ? 1 : 0;
+
+			if (!check.Expect(visible || scene.centers[j].z + scene.extents[j].z >= 8.0f, "a box in front of the occluders was culled"))
+			{
+				return;
+			}
+		}
+
+		check.Expect(visibleCount < OCCLUSION_BOX_COUNT, "no box was culled by the occluders");
+	}
+
+	MP_BENCHMARK(SoftwareOcclusion_IsVisible)
+	{
+		const OcclusionTestScene scene = CreateOcclusionTestScene();
+		SoftwareOcclusion		 occlusion;
+		occlusion.RenderOccluders(scene.viewProjection, scene.occluders.data(), static_cast<U32>(scene.occluders.size()));
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			U32 visibleCount = 0;
+			for (U32 j = 0; j < OCCLUSION_BOX_COUNT; ++j)
+			{
+				visibleCount += occlusion.IsVisible(scene.centers[j], scene.extents[j]) ? 1 : 0;
+			}
+			Bench::DoNotOptimize(visibleCount);
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * OCCLUSION_BOX_COUNT);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Potentially visible set
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// A 20x20 wall through the origin with a small panel on each side of it.
+	struct PvsTestScene
+	{
+		std::vector<Vector3>   positions{};
+		std::vector<U32>	   indices{};
+		std::vector<PvsObject> objects{};
+	};
+
+	static PvsTestScene CreatePvsTestScene()
+	{
+		PvsTestScene scene{};
+		CreateWallMesh(scene.positions, scene.indices);
+
+		const Vector3 translations[3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -5.0f }, { 0.0f, 0.0f, 5.0f } };
+		const Vector3 scales[3] = { { 20.0f, 20.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } };
+
+		for (U32 i = 0; i < 3; ++i)
+		{
+			TransformComponent transform;
+			transform.translation = translations[i];
+			transform.scale = scales[i];
+
+			PvsObject object{};
+			object.worldMatrix = transform.GetTransformMatrix();
+			object.bounds = { translations[i] - scales[i] * 0.5f, translations[i] + scales[i] * 0.5f };
+			object.positions = scene.positions.data();
+			object.vertexCount = static_cast<U32>(scene.positions.size());
+			object.indices = scene.indices.data();
+			object.indexCount = static_cast<U32>(scene.indices.size());
+			scene.objects.push_back(object);
+		}
+
+		return scene;
+	}
+
+	// From in front of the wall, the panel behind it is hidden and the one in front is not.
+	MP_BENCHMARK_CHECK(PotentiallyVisibleSet_Bake_Check)
+	{
+		const PvsTestScene scene = CreatePvsTestScene();
+
+		PvsBakeSettings settings{};
+		settings.cellSize = 2.0f;
+		settings.originSamples = 8;
+		settings.targetSamples = 8;
+
+		PotentiallyVisibleSet pvs;
+		pvs.Bake(scene.objects, settings);
+
+		const U32 cell = pvs.FindCell({ 0.0f, 0.0f, 5.0f });
+
+		check.Expect(cell != PotentiallyVisibleSet::INVALID_CELL && pvs.IsVisible(cell, 0) && !pvs.IsVisible(cell, 1) && pvs.IsVisible(cell, 2),
+			"baked visibility through the wall is wrong");
+	}
+
+	MP_BENCHMARK(PotentiallyVisibleSet_Bake)
+	{
+		const PvsTestScene scene = CreatePvsTestScene();
+
+		PvsBakeSettings settings{};
+		settings.cellSize = 2.0f;
+		settings.originSamples = 8;
+		settings.targetSamples = 8;
+
+		PotentiallyVisibleSet pvs;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			pvs.Bake(scene.objects, settings);
+			Bench::DoNotOptimize(pvs.GetMemorySize());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * pvs.GetCellCount());
+	}
+
+	MP_BENCHMARK(PotentiallyVisibleSet_Lookup)
+	{
+		const PvsTestScene scene = CreatePvsTestScene();
+
+		PvsBakeSettings settings{};
+		settings.cellSize = 2.0f;
+		settings.originSamples = 4;
+		settings.targetSamples = 4;
+
+		PotentiallyVisibleSet pvs;
+		pvs.Bake(scene.objects, settings);
+
+		std::mt19937						random(42);
+		std::uniform_real_distribution<F32> coordinate(-12.0f, 12.0f);
+
+		std::vector<Vector3> positions(1024);
+		for (Vector3& position : positions)
+		{
+			position = { coordinate(random), coordinate(random), coordinate(random) };
+		}
+
+		U32 visibleCount = 0;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (const Vector3& position : positions)
+			{
+				const U32 cell = pvs.FindCell(position);
+				visibleCount += (cell != PotentiallyVisibleSet::INVALID_CELL && pvs.IsVisible(cell, 1)) ? 1 : 0;
+			}
+		}
+
+		Bench::DoNotOptimize(visibleCount);
+		state.SetItemsProcessed(state.GetIterations() * positions.size());
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Model loading (OBJ parsing + vertex deduplication)
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static void BenchmarkLoadModel(Bench::State& state, const char* filepath)
+	{
+		if (!std::filesystem::exists(filepath))
+		{
+			state.SkipWithMessage(String("Missing asset (run from the repository root): ") + filepath);
+			return;
+		}
+
+		U64 indexCount = 0;
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Model::Builder builder{};
+			builder.LoadModel(filepath);
+			indexCount += builder.indices.size();
+			Bench::DoNotOptimize(builder.vertices.data());
+		}
+
+		// Items are processed face vertices, i.e. dedup lookups.
+		state.SetItemsProcessed(indexCount);
+	}
+
+	MP_BENCHMARK(Model_LoadModel_Bunny)
+	{
+		BenchmarkLoadModel(state, "assets/models/bunny.obj");
+	}
+
+	MP_BENCHMARK(Model_LoadModel_SmoothVase)
+	{
+		BenchmarkLoadModel(state, "assets/models/smooth_vase.obj");
+	}
+
+	MP_BENCHMARK(Model_LoadModel_VikingRoom)
+	{
+		BenchmarkLoadModel(state, "assets/models/viking_room/viking_room.obj");
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Events
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Mirrors Application::OnEvent: three typed dispatches per event.
+	template <typename T>
+	static void BenchmarkDispatch(Bench::State& state, T& event)
+	{
+		U64 handledCount = 0;
+
+		auto onWindowClose = [&handledCount](WindowCloseEvent& e) { handledCount++; return false; };
+		auto onWindowResize = [&handledCount](WindowResizeEvent& e) { handledCount++; return false; };
+		auto onKeyPressed = [&handledCount](KeyPressedEvent& e) { handledCount += e.GetKeyCode(); return false; };
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			EventDispatcher dispatcher(event);
+			dispatcher.Dispatch<WindowCloseEvent>(onWindowClose);
+			dispatcher.Dispatch<WindowResizeEvent>(onWindowResize);
+			dispatcher.Dispatch<KeyPressedEvent>(onKeyPressed);
+		}
+
+		Bench::DoNotOptimize(handledCount);
+		state.SetItemsProcessed(state.GetIterations());
+	}
+
+	MP_BENCHMARK(EventDispatcher_Dispatch_KeyPressed)
+	{
+		KeyPressedEvent event(Key::W, 0);
+		BenchmarkDispatch(state, event);
+	}
+
+	MP_BENCHMARK(EventDispatcher_Dispatch_MouseMoved)
+	{
+		MouseMovedEvent event(100.0f, 200.0f);
+		BenchmarkDispatch(state, event);
+	}
+
+} // namespace Mapo
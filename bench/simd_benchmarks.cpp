@@ -0,0 +1,616 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "bench/bench.h"
+
+#include "core/simd/simd_batch.h"
+#include "core/simd/simd_math.h"
+
+#include <cmath>
+#include <random>
+
+// Each SIMD routine has a check that compares its results against glm, the C library or the scalar path and
+// fails if they are outside the documented bounds. The benchmarks themselves only measure.
+
+namespace Mapo
+{
+	using namespace Simd;
+
+	static constexpr U32 VALUE_COUNT = 4096;
+
+	// The float4 paths serve the SSE4.1 level on x86 and the NEON level on ARM.
+#if MP_SIMD_NEON
+	static constexpr SimdLevel FLOAT4_LEVEL = SimdLevel::NEON;
+#else
+	static constexpr SimdLevel FLOAT4_LEVEL = SimdLevel::SSE41;
+#endif
+
+	static void CheckMaxError(Bench::Check& check, const char* what, F64 maxError, F64 bound)
+	{
+		check.Expect(maxError <= bound, String(what) + " error " + std::to_string(maxError) + " > " + std::to_string(bound));
+	}
+
+	// Works for both benchmarks and checks.
+	template <typename State>
+	static bool CheckSupported(State& state, SimdLevel level)
+	{
+		if (level == SimdLevel::Scalar || GetBestSimdLevel() >= level)
+		{
+			return true;
+		}
+
+		state.SkipWithMessage(String(GetSimdLevelName(level)) + " is not supported by this CPU");
+		return false;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Sin / Cos
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static std::vector<F32> CreateTestAngles(F32 range)
+	{
+		std::mt19937						  random(42);
+		std::uniform_real_distribution<F32> distribution(-range, range);
+
+		std::vector<F32> angles(VALUE_COUNT);
+		for (F32& angle : angles)
+		{
+			angle = distribution(random);
+		}
+
+		return angles;
+	}
+
+	// Largest absolute error of SinCos against the double precision results over the documented range.
+	static F64 MeasureSinCosError()
+	{
+		F64 maxError = 0.0;
+
+		for (const F32 range : { 4.0f, 100.0f, 8192.0f })
+		{
+			const std::vector<F32> angles = CreateTestAngles(range);
+
+			for (U32 i = 0; i < VALUE_COUNT; i += 4)
+			{
+				float4 sinValue, cosValue;
+				SinCos(Load(&angles[i]), sinValue, cosValue);
+
+				F32 sinResult[4], cosResult[4];
+				Store(sinValue, sinResult);
+				Store(cosValue, cosResult);
+
+				for (U32 lane = 0; lane < 4; ++lane)
+				{
+					const F64 angle = angles[i + lane];
+					maxError = std::max(maxError, std::abs(sinResult[lane] - std::sin(angle)));
+					maxError = std::max(maxError, std::abs(cosResult[lane] - std::cos(angle)));
+				}
+			}
+		}
+
+		return maxError;
+	}
+
+	// Baseline: glm (the C library) per value.
+	MP_BENCHMARK(Simd_SinCos_Glm)
+	{
+		const std::vector<F32> angles = CreateTestAngles(100.0f);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (F32 angle : angles)
+			{
+				Bench::DoNotOptimize(MathOp::Sin(angle));
+				Bench::DoNotOptimize(MathOp::Cos(angle));
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_SinCos_Check)
+	{
+		CheckMaxError(check, "SinCos", MeasureSinCosError(), 1.5e-7);
+	}
+
+	MP_BENCHMARK(Simd_SinCos)
+	{
+		const std::vector<F32> angles = CreateTestAngles(100.0f);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (U32 j = 0; j < VALUE_COUNT; j += 4)
+			{
+				float4 sinValue, cosValue;
+				SinCos(Load(&angles[j]), sinValue, cosValue);
+				Bench::DoNotOptimize(sinValue);
+				Bench::DoNotOptimize(cosValue);
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Rsqrt
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Spread over many orders of magnitude.
+	static std::vector<F32> CreateTestPositiveValues()
+	{
+		std::mt19937						  random(42);
+		std::uniform_real_distribution<F32> exponent(-30.0f, 30.0f);
+
+		std::vector<F32> values(VALUE_COUNT);
+		for (F32& value : values)
+		{
+			value = std::pow(10.0f, exponent(random));
+		}
+
+		return values;
+	}
+
+	template <typename Function>
+	static F64 MeasureRsqrtError(Function function)
+	{
+		const std::vector<F32> values = CreateTestPositiveValues();
+		F64					   maxError = 0.0;
+
+		for (U32 i = 0; i < VALUE_COUNT; i += 4)
+		{
+			F32 result[4];
+			Store(function(Load(&values[i])), result);
+
+			for (U32 lane = 0; lane < 4; ++lane)
+			{
+				const F64 expected = 1.0 / std::sqrt(static_cast<F64>(values[i + lane]));
+				maxError = std::max(maxError, std::abs(result[lane] - expected) / expected);
+			}
+		}
+
+		return maxError;
+	}
+
+	template <typename Function>
+	static void BenchmarkRsqrt(Bench::State& state, Function function)
+	{
+		const std::vector<F32> values = CreateTestPositiveValues();
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			for (U32 j = 0; j < VALUE_COUNT; j += 4)
+			{
+				Bench::DoNotOptimize(function(Load(&values[j])));
+			}
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	// Baseline: divide and square root.
+	MP_BENCHMARK(Simd_Rsqrt_Divide)
+	{
+		BenchmarkRsqrt(state, [](float4 x) { return Splat(1.0f) / Sqrt(x); });
+	}
+
+	MP_BENCHMARK_CHECK(Simd_Rsqrt_Check)
+	{
+		CheckMaxError(check, "Rsqrt", MeasureRsqrtError([](float4 x) { return Rsqrt(x); }), 3e-7);
+		CheckMaxError(check, "RsqrtEstimate", MeasureRsqrtError([](float4 x) { return RsqrtEstimate(x); }), 3.7e-4);
+	}
+
+	MP_BENCHMARK(Simd_Rsqrt)
+	{
+		BenchmarkRsqrt(state, [](float4 x) { return Rsqrt(x); });
+	}
+
+	MP_BENCHMARK(Simd_RsqrtEstimate)
+	{
+		BenchmarkRsqrt(state, [](float4 x) { return RsqrtEstimate(x); });
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Batch routines
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static Matrix4 CreateTestMatrix(std::mt19937& random)
+	{
+		std::uniform_real_distribution<F32> distribution(-10.0f, 10.0f);
+
+		Matrix4 matrix{ 1.0f };
+		for (U32 column = 0; column < 4; ++column)
+		{
+			for (U32 row = 0; row < 3; ++row)
+			{
+				matrix[column][row] = distribution(random);
+			}
+		}
+
+		return matrix;
+	}
+
+	static std::vector<Vector3> CreateTestPoints(std::mt19937& random)
+	{
+		std::uniform_real_distribution<F32> distribution(-100.0f, 100.0f);
+
+		std::vector<Vector3> points(VALUE_COUNT);
+		for (Vector3& point : points)
+		{
+			point = { distribution(random), distribution(random), distribution(random) };
+		}
+
+		return points;
+	}
+
+	// Largest difference relative to the largest reference value. Single elements can cancel to almost zero,
+	// so they are not compared against their own magnitude.
+	static F64 MeasureRelativeError(const F32* values, const F32* reference, size_t count)
+	{
+		F64 scale = 1.0;
+		F64 maxDifference = 0.0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			scale = std::max(scale, std::abs(static_cast<F64>(reference[i])));
+			maxDifference = std::max(maxDifference, std::abs(static_cast<F64>(values[i]) - reference[i]));
+		}
+
+		return maxDifference / scale;
+	}
+
+	// Counts with a remainder so the tail paths are covered as well.
+	static constexpr U32 CHECK_COUNT = VALUE_COUNT - 3;
+
+	static void CheckTransformPoints(Bench::Check& check, SimdLevel level)
+	{
+		if (!CheckSupported(check, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const Matrix4			   matrix = CreateTestMatrix(random);
+		const std::vector<Vector3> points = CreateTestPoints(random);
+
+		std::vector<Vector3> output(VALUE_COUNT);
+		std::vector<Vector3> reference(VALUE_COUNT);
+		TransformPoints(matrix, points.data(), reference.data(), CHECK_COUNT, SimdLevel::Scalar);
+		TransformPoints(matrix, points.data(), output.data(), CHECK_COUNT, level);
+
+		CheckMaxError(check, "TransformPoints", MeasureRelativeError(GLM_PTR(output[0]), GLM_PTR(reference[0]), CHECK_COUNT * 3), 1e-5);
+	}
+
+	static void BenchmarkTransformPoints(Bench::State& state, SimdLevel level)
+	{
+		if (!CheckSupported(state, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const Matrix4			   matrix = CreateTestMatrix(random);
+		const std::vector<Vector3> points = CreateTestPoints(random);
+		std::vector<Vector3>	   output(VALUE_COUNT);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			TransformPoints(matrix, points.data(), output.data(), VALUE_COUNT, level);
+			Bench::DoNotOptimize(output.data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	static std::vector<AABB> CreateTestBoxes(std::mt19937& random)
+	{
+		std::uniform_real_distribution<F32> size(0.0f, 10.0f);
+
+		const std::vector<Vector3> corners = CreateTestPoints(random);
+
+		std::vector<AABB> boxes(VALUE_COUNT);
+		for (U32 i = 0; i < VALUE_COUNT; ++i)
+		{
+			boxes[i].min = corners[i];
+			boxes[i].max = corners[i] + Vector3(size(random), size(random), size(random));
+		}
+
+		return boxes;
+	}
+
+	static void CheckTransformAABBs(Bench::Check& check, SimdLevel level)
+	{
+		if (!CheckSupported(check, level))
+		{
+			return;
+		}
+
+		std::mt19937			random(42);
+		const Matrix4			matrix = CreateTestMatrix(random);
+		const std::vector<AABB> boxes = CreateTestBoxes(random);
+
+		std::vector<AABB> output(VALUE_COUNT);
+		std::vector<AABB> reference(VALUE_COUNT);
+		TransformAABBs(matrix, boxes.data(), reference.data(), CHECK_COUNT, SimdLevel::Scalar);
+		TransformAABBs(matrix, boxes.data(), output.data(), CHECK_COUNT, level);
+
+		CheckMaxError(check, "TransformAABBs", MeasureRelativeError(GLM_PTR(output[0].min), GLM_PTR(reference[0].min), CHECK_COUNT * 6), 1e-5);
+	}
+
+	static void BenchmarkTransformAABBs(Bench::State& state, SimdLevel level)
+	{
+		if (!CheckSupported(state, level))
+		{
+			return;
+		}
+
+		std::mt19937			random(42);
+		const Matrix4			matrix = CreateTestMatrix(random);
+		const std::vector<AABB> boxes = CreateTestBoxes(random);
+		std::vector<AABB>		output(VALUE_COUNT);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			TransformAABBs(matrix, boxes.data(), output.data(), VALUE_COUNT, level);
+			Bench::DoNotOptimize(output.data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	static constexpr U32 MATRIX_COUNT = 1024;
+
+	static std::vector<Matrix4> CreateTestMatrices(std::mt19937& random)
+	{
+		std::vector<Matrix4> matrices(MATRIX_COUNT);
+		for (Matrix4& matrix : matrices)
+		{
+			matrix = CreateTestMatrix(random);
+		}
+
+		return matrices;
+	}
+
+	static void CheckMultiplyMatrices(Bench::Check& check, SimdLevel level)
+	{
+		if (!CheckSupported(check, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const std::vector<Matrix4> a = CreateTestMatrices(random);
+		const std::vector<Matrix4> b = CreateTestMatrices(random);
+
+		std::vector<Matrix4> output(MATRIX_COUNT);
+		std::vector<Matrix4> reference(MATRIX_COUNT);
+		MultiplyMatrices(a.data(), b.data(), reference.data(), MATRIX_COUNT, SimdLevel::Scalar);
+		MultiplyMatrices(a.data(), b.data(), output.data(), MATRIX_COUNT, level);
+
+		CheckMaxError(check, "MultiplyMatrices", MeasureRelativeError(GLM_PTR(output[0]), GLM_PTR(reference[0]), MATRIX_COUNT * 16), 1e-5);
+	}
+
+	static void BenchmarkMultiplyMatrices(Bench::State& state, SimdLevel level)
+	{
+		if (!CheckSupported(state, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const std::vector<Matrix4> a = CreateTestMatrices(random);
+		const std::vector<Matrix4> b = CreateTestMatrices(random);
+		std::vector<Matrix4>	   output(MATRIX_COUNT);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			MultiplyMatrices(a.data(), b.data(), output.data(), MATRIX_COUNT, level);
+			Bench::DoNotOptimize(output.data());
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * MATRIX_COUNT);
+	}
+
+	// Six planes around the origin in random directions, so only part of the bounds passes.
+	static std::vector<Vector4> CreateTestPlanes(std::mt19937& random)
+	{
+		std::uniform_real_distribution<F32> distribution(-1.0f, 1.0f);
+
+		std::vector<Vector4> planes(6);
+		for (Vector4& plane : planes)
+		{
+			const Vector3 normal = MathOp::Normalize(Vector3(distribution(random), distribution(random), distribution(random)));
+			plane = Vector4(normal, 120.0f);
+		}
+
+		return planes;
+	}
+
+	// Random bounds in structure-of-arrays layout. `soa` keeps the values BoundsSoA points to.
+	static BoundsSoA CreateTestBounds(std::mt19937& random, std::vector<F32> (&soa)[7])
+	{
+		std::uniform_real_distribution<F32> size(0.0f, 10.0f);
+
+		const std::vector<Vector3> centers = CreateTestPoints(random);
+
+		for (std::vector<F32>& values : soa)
+		{
+			values.resize(VALUE_COUNT);
+		}
+
+		for (U32 i = 0; i < VALUE_COUNT; ++i)
+		{
+			const Vector3 extent = { size(random), size(random), size(random) };
+
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				soa[axis][i] = centers[i][axis];
+				soa[3 + axis][i] = extent[axis];
+			}
+
+			soa[6][i] = MathOp::Length(extent) * (0.8f + 0.2f * size(random) / 10.0f);
+		}
+
+		BoundsSoA bounds{};
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			bounds.center[axis] = soa[axis].data();
+			bounds.extent[axis] = soa[3 + axis].data();
+		}
+		bounds.radius = soa[6].data();
+
+		return bounds;
+	}
+
+	static void CheckCullBounds(Bench::Check& check, SimdLevel level)
+	{
+		if (!CheckSupported(check, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const std::vector<Vector4> planes = CreateTestPlanes(random);
+		std::vector<F32>		   soa[7];
+		const BoundsSoA			   bounds = CreateTestBounds(random, soa);
+		const U32				   planeCount = static_cast<U32>(planes.size());
+
+		std::vector<U32> output(VALUE_COUNT);
+		std::vector<U32> reference(VALUE_COUNT);
+		const U32		 referenceCount = CullBounds(planes.data(), planeCount, bounds, CHECK_COUNT, reference.data(), SimdLevel::Scalar);
+		const U32		 outputCount = CullBounds(planes.data(), planeCount, bounds, CHECK_COUNT, output.data(), level);
+
+		U32 mismatches = (outputCount == referenceCount) ? 0 : 1;
+		for (U32 i = 0; i < MathOp::Min(outputCount, referenceCount); ++i)
+		{
+			mismatches += (output[i] != reference[i]) ? 1 : 0;
+		}
+
+		CheckMaxError(check, "CullBounds mismatches", mismatches, 0.0);
+	}
+
+	static void BenchmarkCullBounds(Bench::State& state, SimdLevel level)
+	{
+		if (!CheckSupported(state, level))
+		{
+			return;
+		}
+
+		std::mt19937			   random(42);
+		const std::vector<Vector4> planes = CreateTestPlanes(random);
+		std::vector<F32>		   soa[7];
+		const BoundsSoA			   bounds = CreateTestBounds(random, soa);
+		const U32				   planeCount = static_cast<U32>(planes.size());
+		std::vector<U32>		   output(VALUE_COUNT);
+
+		for (U64 i = 0; i < state.GetIterations(); ++i)
+		{
+			Bench::DoNotOptimize(CullBounds(planes.data(), planeCount, bounds, VALUE_COUNT, output.data(), level));
+		}
+
+		state.SetItemsProcessed(state.GetIterations() * VALUE_COUNT);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_TransformPoints_Float4_Check)
+	{
+		CheckTransformPoints(check, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_TransformAABBs_Float4_Check)
+	{
+		CheckTransformAABBs(check, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_MultiplyMatrices_Float4_Check)
+	{
+		CheckMultiplyMatrices(check, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_CullBounds_Float4_Check)
+	{
+		CheckCullBounds(check, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK(Simd_TransformPoints_Scalar)
+	{
+		BenchmarkTransformPoints(state, SimdLevel::Scalar);
+	}
+
+	MP_BENCHMARK(Simd_TransformPoints_Float4)
+	{
+		BenchmarkTransformPoints(state, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK(Simd_TransformAABBs_Scalar)
+	{
+		BenchmarkTransformAABBs(state, SimdLevel::Scalar);
+	}
+
+	MP_BENCHMARK(Simd_TransformAABBs_Float4)
+	{
+		BenchmarkTransformAABBs(state, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK(Simd_MultiplyMatrices_Scalar)
+	{
+		BenchmarkMultiplyMatrices(state, SimdLevel::Scalar);
+	}
+
+	MP_BENCHMARK(Simd_MultiplyMatrices_Float4)
+	{
+		BenchmarkMultiplyMatrices(state, FLOAT4_LEVEL);
+	}
+
+	MP_BENCHMARK(Simd_CullBounds_Scalar)
+	{
+		BenchmarkCullBounds(state, SimdLevel::Scalar);
+	}
+
+	MP_BENCHMARK(Simd_CullBounds_Float4)
+	{
+		BenchmarkCullBounds(state, FLOAT4_LEVEL);
+	}
+
+#if MP_SIMD_X86
+	MP_BENCHMARK_CHECK(Simd_TransformPoints_AVX2_Check)
+	{
+		CheckTransformPoints(check, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_TransformAABBs_AVX2_Check)
+	{
+		CheckTransformAABBs(check, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_MultiplyMatrices_AVX2_Check)
+	{
+		CheckMultiplyMatrices(check, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK_CHECK(Simd_CullBounds_AVX2_Check)
+	{
+		CheckCullBounds(check, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK(Simd_TransformPoints_AVX2)
+	{
+		BenchmarkTransformPoints(state, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK(Simd_TransformAABBs_AVX2)
+	{
+		BenchmarkTransformAABBs(state, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK(Simd_MultiplyMatrices_AVX2)
+	{
+		BenchmarkMultiplyMatrices(state, SimdLevel::AVX2);
+	}
+
+	MP_BENCHMARK(Simd_CullBounds_AVX2)
+	{
+		BenchmarkCullBounds(state, SimdLevel::AVX2);
+	}
+#endif
+
+} // namespace Mapo
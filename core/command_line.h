@@ -0,0 +1,21 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+namespace Mapo
+{
+	// argc and argv of the process. Settings of core and engine modules parse their options from it.
+	struct ApplicationCommandLineArgs
+	{
+		int	   count = 0;
+		char** args = nullptr;
+
+		const char* operator[](int index) const
+		{
+			return args[index];
+		}
+	};
+
+} // namespace Mapo
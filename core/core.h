@@ -11,6 +11,7 @@
 #include "core/timestep.h"
 #include "core/timer.h"
 #include "core/optional.h"
+#include "core/command_line.h"
 
 // string
 #include "core/string/string.h"
@@ -23,3 +24,11 @@
 // memory
 #include "core/memory/allocator.h"
 #include "core/memory/memory.h"
+
+// jobs
+#include "core/jobs/job_system.h"
+
+// profiling
+#include "core/profiling/startup_trace.h"
+#include "core/profiling/flight_recorder.h"
+#include "core/profiling/metrics.h"
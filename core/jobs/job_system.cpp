@@ -0,0 +1,337 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "job_system.h"
+
+#include "core/logging.h"
+#include "core/uassert.h"
+#include "core/string/string.h"
+#include "core/jobs/work_stealing_deque.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mapo
+{
+	using JobDeque = WorkStealingDeque<Job, JobSystem::MAX_JOBS_PER_THREAD>;
+
+	struct JobThreadData
+	{
+		JobDeque			deque;
+		UniqueRef<Job[]>	jobPool{};
+		U32					nextJob = 0;
+		U32					randomState = 0;
+	};
+
+	struct JobSystemData
+	{
+		JobSystemSettings settings{};
+
+		std::vector<UniqueRef<JobThreadData>> threads{}; // [0] is the main thread
+		std::vector<std::thread>			  workers{};
+		U32									  workerCount = 0;
+
+		std::atomic<bool> running{ false };
+
+		// Idle workers sleep until a job is submitted.
+		std::atomic<I32>		pendingJobs{ 0 };
+		std::atomic<U32>		sleepingWorkers{ 0 };
+		std::mutex				wakeUpMutex;
+		std::condition_variable wakeUp;
+	};
+
+	static JobSystemData s_data;
+
+	static thread_local U32 t_threadIndex = JobSystem::INVALID_THREAD_INDEX;
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	JobSystemSettings JobSystemSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		JobSystemSettings settings{};
+		String			  value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			if (StringOp::ParseOption(args[i], "--job-workers", value))
+			{
+				settings.workerCount = static_cast<U32>(std::max(0, std::atoi(value.c_str())));
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Scheduling
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static U32 NextRandom(U32& state)
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	static Job* GetJob(U32 threadIndex)
+	{
+		JobThreadData& thread = *s_data.threads[threadIndex];
+
+		Job* job = thread.deque.Pop();
+
+		if (!job)
+		{
+			const U32 threadCount = static_cast<U32>(s_data.threads.size());
+			const U32 start = NextRandom(thread.randomState);
+
+			for (U32 i = 0; i < threadCount && !job; ++i)
+			{
+				const U32 victim = (start + i) % threadCount;
+				if (victim != threadIndex)
+				{
+					job = s_data.threads[victim]->deque.Steal();
+				}
+			}
+		}
+
+		if (job)
+		{
+			s_data.pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	void Job::Execute()
+	{
+		invoke(payload);
+		destroy(payload);
+
+		if (counter)
+		{
+			counter->m_value.fetch_sub(1, std::memory_order_release);
+		}
+
+		inUse.store(false, std::memory_order_release);
+	}
+
+	static bool RunPendingJob(U32 threadIndex)
+	{
+		if (Job* job = GetJob(threadIndex))
+		{
+			job->Execute();
+			return true;
+		}
+
+		return false;
+	}
+
+	static void RunWorker(U32 threadIndex)
+	{
+		t_threadIndex = threadIndex;
+
+		if (s_data.settings.onWorkerStart)
+		{
+			s_data.settings.onWorkerStart(threadIndex);
+		}
+
+		while (s_data.running.load(std::memory_order_acquire))
+		{
+			if (RunPendingJob(threadIndex))
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(s_data.wakeUpMutex);
+			s_data.sleepingWorkers.fetch_add(1);
+			s_data.wakeUp.wait(lock, [] {
+				return s_data.pendingJobs.load() > 0 || !s_data.running.load(std::memory_order_relaxed);
+			});
+			s_data.sleepingWorkers.fetch_sub(1);
+		}
+
+		if (s_data.settings.onWorkerStop)
+		{
+			s_data.settings.onWorkerStop(threadIndex);
+		}
+
+		t_threadIndex = JobSystem::INVALID_THREAD_INDEX;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Job system
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void JobSystem::Init(const JobSystemSettings& settings)
+	{
+		MP_ASSERT(!IsInitialized(), "Job system is already initialized!");
+
+		U32 workerCount = settings.workerCount;
+		if (workerCount == JobSystemSettings::AUTO_WORKER_COUNT)
+		{
+			const U32 hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+		workerCount = std::min(workerCount, MAX_THREADS - 1);
+
+		s_data.settings = settings;
+		s_data.threads.clear();
+
+		for (U32 i = 0; i <= workerCount; ++i)
+		{
+			UniqueRef<JobThreadData> thread = MakeUnique<JobThreadData>();
+			thread->jobPool = MakeUnique<Job[]>(MAX_JOBS_PER_THREAD);
+			thread->randomState = 0x9E3779B9u * (i + 1);
+			s_data.threads.push_back(std::move(thread));
+		}
+
+		t_threadIndex = 0;
+		s_data.workerCount = workerCount;
+		s_data.running.store(true, std::memory_order_release);
+
+		for (U32 i = 1; i <= workerCount; ++i)
+		{
+			s_data.workers.emplace_back(RunWorker, i);
+		}
+
+		MP_INFO("JobSystem: {} worker threads.", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!IsInitialized())
+		{
+			return;
+		}
+
+		MP_ASSERT(t_threadIndex == 0, "Job system must be shut down on the main thread!");
+
+		// Finish what is left so that no counter is waited on forever.
+		while (RunPendingJob(0))
+		{
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_data.wakeUpMutex);
+			s_data.running.store(false, std::memory_order_release);
+		}
+		s_data.wakeUp.notify_all();
+
+		for (std::thread& worker : s_data.workers)
+		{
+			worker.join();
+		}
+
+		s_data.workers.clear();
+		s_data.workerCount = 0;
+		s_data.threads.clear();
+		s_data.pendingJobs.store(0, std::memory_order_relaxed);
+
+		t_threadIndex = INVALID_THREAD_INDEX;
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_data.running.load(std::memory_order_acquire);
+	}
+
+	U32 JobSystem::GetWorkerCount()
+	{
+		return s_data.workerCount;
+	}
+
+	U32 JobSystem::GetThreadIndex()
+	{
+		return t_threadIndex;
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		const U32 threadIndex = t_threadIndex;
+
+		while (!counter.IsDone())
+		{
+			if (threadIndex == INVALID_THREAD_INDEX || !RunPendingJob(threadIndex))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		const U32 threadIndex = t_threadIndex;
+
+		if (threadIndex == INVALID_THREAD_INDEX)
+		{
+			// Run inline, see Submit.
+			Job* job = new Job();
+			job->inUse.store(true, std::memory_order_relaxed);
+			return job;
+		}
+
+		JobThreadData& thread = *s_data.threads[threadIndex];
+
+		while (true)
+		{
+			Job& job = thread.jobPool[thread.nextJob++ & (MAX_JOBS_PER_THREAD - 1)];
+
+			if (!job.inUse.load(std::memory_order_acquire))
+			{
+				job.inUse.store(true, std::memory_order_relaxed);
+				return &job;
+			}
+
+			// The ring wrapped around onto a job that is still queued or running. Help until it frees up.
+			RunPendingJob(threadIndex);
+		}
+	}
+
+	void JobSystem::Submit(Job* job, JobCounter* counter)
+	{
+		job->counter = counter;
+
+		if (counter)
+		{
+			counter->m_value.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const U32 threadIndex = t_threadIndex;
+
+		if (threadIndex == INVALID_THREAD_INDEX)
+		{
+			job->Execute();
+			delete job;
+			return;
+		}
+
+		if (!s_data.threads[threadIndex]->deque.Push(job))
+		{
+			// Deque is full. Running the job right away is always correct, just not parallel.
+			job->Execute();
+			return;
+		}
+
+		// Sequentially consistent with the sleeping count: either this thread sees the sleeper, or the sleeper
+		// sees the job before it waits.
+		s_data.pendingJobs.fetch_add(1);
+
+		if (s_data.sleepingWorkers.load() > 0)
+		{
+			// Taking the lock orders the notification with a worker that is about to wait.
+			{
+				std::lock_guard<std::mutex> lock(s_data.wakeUpMutex);
+			}
+			s_data.wakeUp.notify_one();
+		}
+	}
+
+} // namespace Mapo
@@ -0,0 +1,171 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+#include "core/command_line.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace Mapo
+{
+	// Job system options parsed from the command line:
+	//
+	//   --job-workers=<N>    Number of worker threads (default: hardware threads - 1). 0 runs every job on the main thread.
+	struct JobSystemSettings
+	{
+		static constexpr U32 AUTO_WORKER_COUNT = UINT32_MAX;
+
+		U32 workerCount = AUTO_WORKER_COUNT;
+
+		// Called on each worker thread right after it starts and right before it exits,
+		// e.g. to register the thread with a profiler.
+		std::function<void(U32 threadIndex)> onWorkerStart{};
+		std::function<void(U32 threadIndex)> onWorkerStop{};
+
+		static JobSystemSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	// Number of unfinished jobs. Jobs decrement it when they finish; JobSystem::Wait blocks until it is zero.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<U32> m_value{ 0 };
+
+		friend class JobSystem;
+		friend struct Job;
+	};
+
+	struct Job
+	{
+		static constexpr size_t PAYLOAD_SIZE = 48;
+
+		void (*invoke)(void* payload) = nullptr;
+		void (*destroy)(void* payload) = nullptr;
+		JobCounter*		  counter = nullptr;
+		std::atomic<bool> inUse{ false };
+
+		alignas(16) U8 payload[PAYLOAD_SIZE];
+
+		// Runs the function, signals the counter and releases the job.
+		void Execute();
+	};
+
+	// Work-stealing job system. Every thread (the main thread is index 0, workers are 1..N) owns a Chase-Lev
+	// deque. New jobs go to the bottom of the submitting thread's deque; idle workers steal from the top of a
+	// random other deque. Jobs are stored in per-thread pools and submitting never allocates.
+	//
+	// Fork-join is expressed with counters: submit children with a counter, then Wait on it. Waiting threads
+	// run pending jobs instead of blocking, so a job may wait on its own children and the main thread helps
+	// while it waits.
+	//
+	// Init and Shutdown must be called on the main thread. Threads that are not owned by the job system run
+	// submitted jobs inline.
+	class JobSystem
+	{
+	public:
+		static constexpr U32 MAX_THREADS = 64;
+		static constexpr U32 MAX_JOBS_PER_THREAD = 4096;
+		static constexpr U32 INVALID_THREAD_INDEX = UINT32_MAX;
+
+		static void Init(const JobSystemSettings& settings = {});
+		static void Shutdown();
+
+		static bool IsInitialized();
+
+		static U32 GetWorkerCount();
+		static U32 GetThreadCount() { return GetWorkerCount() + 1; }
+
+		// 0 on the main thread, 1..N on workers, INVALID_THREAD_INDEX elsewhere.
+		static U32 GetThreadIndex();
+
+		// The function must be callable as void() and fit in Job::PAYLOAD_SIZE (capture pointers, not containers).
+		template <typename Function>
+		static void Run(Function&& function, JobCounter* counter = nullptr);
+
+		// Runs pending jobs on this thread until the counter reaches zero.
+		static void Wait(JobCounter& counter);
+
+		// Calls function(begin, end) over [0, count) split into batches across all threads, and returns
+		// when every batch is done. Batches are sized for a few batches per thread but never smaller than
+		// minBatchSize, so cheap per-item work should pass a larger minimum.
+		template <typename Function>
+		static void ParallelFor(U32 count, const Function& function, U32 minBatchSize = 1);
+
+	private:
+		static Job* AllocateJob();
+		static void Submit(Job* job, JobCounter* counter);
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Implementation
+	/////////////////////////////////////////////////////////////////////////////////
+
+	template <typename Function>
+	void JobSystem::Run(Function&& function, JobCounter* counter)
+	{
+		using FunctionType = std::decay_t<Function>;
+
+		static_assert(sizeof(FunctionType) <= Job::PAYLOAD_SIZE, "Job function is too large!");
+		static_assert(alignof(FunctionType) <= 16, "Job function is over-aligned!");
+
+		Job* job = AllocateJob();
+
+		new (job->payload) FunctionType(std::forward<Function>(function));
+		job->invoke = [](void* payload) { (*static_cast<FunctionType*>(payload))(); };
+		job->destroy = [](void* payload) { static_cast<FunctionType*>(payload)->~FunctionType(); };
+
+		Submit(job, counter);
+	}
+
+	template <typename Function>
+	void JobSystem::ParallelFor(U32 count, const Function& function, U32 minBatchSize)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		constexpr U32 BATCHES_PER_THREAD = 4;
+
+		const U32 targetBatchCount = GetThreadCount() * BATCHES_PER_THREAD;
+		const U32 batchSize = std::max({ minBatchSize, (count + targetBatchCount - 1) / targetBatchCount, 1u });
+
+		if (batchSize >= count || GetWorkerCount() == 0 || GetThreadIndex() == INVALID_THREAD_INDEX)
+		{
+			function(0u, count);
+			return;
+		}
+
+		JobCounter counter{};
+		const Function* functionPtr = &function;
+
+		// The calling thread takes the first batch itself.
+		for (U32 begin = batchSize; begin < count; begin += batchSize)
+		{
+			const U32 end = std::min(begin + batchSize, count);
+			Run([functionPtr, begin, end]() { (*functionPtr)(begin, end); }, &counter);
+		}
+
+		function(0u, batchSize);
+
+		Wait(counter);
+	}
+
+} // namespace Mapo
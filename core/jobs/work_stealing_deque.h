@@ -0,0 +1,99 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+namespace Mapo
+{
+	// Fixed-capacity Chase-Lev deque ("Correct and Efficient Work-Stealing for Weak Memory Models",
+	// Lê et al. 2013). The owning thread pushes and pops at the bottom (LIFO, cache-warm), other threads
+	// steal from the top (FIFO, oldest and usually largest work first).
+	template <typename T, U32 Capacity>
+	class WorkStealingDeque
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two!");
+
+	public:
+		// Owner only. Returns false if the deque is full.
+		bool Push(T* item)
+		{
+			const I64 bottom = m_bottom.load(std::memory_order_relaxed);
+			const I64 top = m_top.load(std::memory_order_acquire);
+
+			if (bottom - top >= static_cast<I64>(Capacity))
+			{
+				return false;
+			}
+
+			m_items[bottom & MASK].store(item, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_release); // publishes the item to thieves
+			return true;
+		}
+
+		// Owner only.
+		T* Pop()
+		{
+			const I64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			I64 top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty.
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_items[bottom & MASK].load(std::memory_order_relaxed);
+
+			if (top == bottom)
+			{
+				// Last item: race against thieves for it.
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					item = nullptr;
+				}
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		// Any thread. Returns nullptr if the deque is empty or another thread won the race.
+		T* Steal()
+		{
+			I64 top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const I64 bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+			{
+				return nullptr;
+			}
+
+			T* item = m_items[top & MASK].load(std::memory_order_acquire);
+
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return nullptr;
+			}
+
+			return item;
+		}
+
+	private:
+		static constexpr I64 MASK = Capacity - 1;
+
+		// Thieves hammer the top, the owner the bottom. Keep them on separate cache lines.
+		alignas(64) std::atomic<I64> m_top{ 0 };
+		alignas(64) std::atomic<I64> m_bottom{ 0 };
+		alignas(64) std::atomic<T*> m_items[Capacity]{};
+	};
+
+} // namespace Mapo
@@ -7,6 +7,9 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <cmath>
+#include <utility>
+
 namespace Mapo
 {
 	namespace MathOp
@@ -83,6 +86,78 @@ namespace Mapo
 			return true;
 		}
 
+		bool IntersectRayAABB(const Ray& ray, const AABB& box, F32 maxDistance, F32& distance)
+		{
+			F32 enter = 0.0f;
+			F32 exit = maxDistance;
+
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				// A zero direction component gives infinite slab distances, which compare correctly. The NaN
+				// from an origin exactly on a slab plane fails both comparisons and leaves the interval as is.
+				const F32 inverse = 1.0f / ray.direction[axis];
+				F32		  t0 = (box.min[axis] - ray.origin[axis]) * inverse;
+				F32		  t1 = (box.max[axis] - ray.origin[axis]) * inverse;
+
+				if (t0 > t1)
+				{
+					std::swap(t0, t1);
+				}
+
+				enter = (t0 > enter) ? t0 : enter;
+				exit = (t1 < exit) ? t1 : exit;
+
+				if (enter > exit)
+				{
+					return false;
+				}
+			}
+
+			distance = enter;
+			return true;
+		}
+
+		bool IntersectRayTriangle(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, F32 maxDistance, F32& distance)
+		{
+			const Vector3 edge1 = v1 - v0;
+			const Vector3 edge2 = v2 - v0;
+			const Vector3 p = Cross(ray.direction, edge2);
+			const F32	  determinant = Dot(edge1, p);
+
+			// Parallel to the triangle's plane, or degenerate.
+			if (std::abs(determinant) < 1e-12f)
+			{
+				return false;
+			}
+
+			const F32	  inverse = 1.0f / determinant;
+			const Vector3 s = ray.origin - v0;
+			const F32	  u = Dot(s, p) * inverse;
+
+			if (u < 0.0f || u > 1.0f)
+			{
+				return false;
+			}
+
+			const Vector3 q = Cross(s, edge1);
+			const F32	  v = Dot(ray.direction, q) * inverse;
+
+			if (v < 0.0f || u + v > 1.0f)
+			{
+				return false;
+			}
+
+			const F32 t = Dot(edge2, q) * inverse;
+
+			if (t <= 0.0f || t > maxDistance)
+			{
+				return false;
+			}
+
+			distance = t;
+			return true;
+		}
+
 	} // namespace MathOp
 
 } // namespace Mapo
@@ -42,6 +42,27 @@ namespace Mapo
 	using Matrix4x2 = glm::mat4x2;
 	using Matrix3x2 = glm::mat3x2;
 
+	// Axis-aligned bounding box.
+	struct AABB
+	{
+		Vector3 min{ 0.0f };
+		Vector3 max{ 0.0f };
+	};
+
+	struct BoundingSphere
+	{
+		Vector3 center{ 0.0f };
+		F32		radius = 0.0f;
+	};
+
+	// Half-line from `origin`. The direction does not need to be normalized; distances along the ray are
+	// measured in multiples of it.
+	struct Ray
+	{
+		Vector3 origin{ 0.0f };
+		Vector3 direction{ 0.0f, 0.0f, -1.0f };
+	};
+
 #define GLM_PI glm::pi<F32>()
 #define GLM_2_PI glm::two_pi<F32>()
 
@@ -103,6 +124,18 @@ namespace Mapo
 			return glm::cross(v1, v2);
 		}
 
+		template <typename T>
+		MP_FORCE_INLINE T Inverse(const T& matrix)
+		{
+			return glm::inverse(matrix);
+		}
+
+		template <typename T>
+		MP_FORCE_INLINE T Transpose(const T& matrix)
+		{
+			return glm::transpose(matrix);
+		}
+
 		template <typename T>
 		MP_FORCE_INLINE T Clamp(T value, T minValue, T maxValue)
 		{
@@ -118,7 +151,7 @@ namespace Mapo
 		template <typename T>
 		MP_FORCE_INLINE T Min(T v1, T v2)
 		{
-			return glm::max(v1, v2);
+			return glm::min(v1, v2);
 		}
 
 		/////////////////////////////////////////////////////////////////////////////////
@@ -126,5 +159,13 @@ namespace Mapo
 		bool DecomposeTransform(const Matrix4& transform, Vector3& translation,
 			Vector3& rotation, Vector3& scale);
 
+		// Slab test. On a hit within [0, maxDistance] returns true and the distance where the ray enters the
+		// box (0 if it starts inside).
+		bool IntersectRayAABB(const Ray& ray, const AABB& box, F32 maxDistance, F32& distance);
+
+		// Moller-Trumbore, hits both sides. On a hit within (0, maxDistance] returns true and its distance in
+		// units of the ray direction.
+		bool IntersectRayTriangle(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, F32 maxDistance, F32& distance);
+
 	} // namespace MathOp
 } // namespace Mapo
@@ -0,0 +1,93 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "range_allocator.h"
+
+#include "core/uassert.h"
+
+namespace Mapo
+{
+	RangeAllocator::RangeAllocator(U32 capacity)
+	{
+		Grow(capacity);
+	}
+
+	U32 RangeAllocator::Allocate(U32 count)
+	{
+		MP_ASSERT(count > 0, "Cannot allocate an empty range!");
+
+		for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+		{
+			if (it->second < count)
+			{
+				continue;
+			}
+
+			const U32 offset = it->first;
+			const U32 remaining = it->second - count;
+
+			m_freeRanges.erase(it);
+			if (remaining > 0)
+			{
+				m_freeRanges.emplace(offset + count, remaining);
+			}
+
+			m_usedCount += count;
+			return offset;
+		}
+
+		return INVALID_OFFSET;
+	}
+
+	void RangeAllocator::Free(U32 offset, U32 count)
+	{
+		MP_ASSERT(count > 0 && offset + count <= m_capacity, "Freeing a range outside of the allocator!");
+		MP_ASSERT(count <= m_usedCount, "Freeing more than was allocated!");
+
+		m_usedCount -= count;
+		InsertFreeRange(offset, count);
+	}
+
+	void RangeAllocator::Grow(U32 newCapacity)
+	{
+		MP_ASSERT(newCapacity >= m_capacity, "RangeAllocator cannot shrink!");
+
+		if (newCapacity > m_capacity)
+		{
+			const U32 oldCapacity = m_capacity;
+			m_capacity = newCapacity;
+			InsertFreeRange(oldCapacity, newCapacity - oldCapacity);
+		}
+	}
+
+	void RangeAllocator::InsertFreeRange(U32 offset, U32 count)
+	{
+		auto next = m_freeRanges.lower_bound(offset);
+		MP_ASSERT(next == m_freeRanges.end() || offset + count <= next->first, "Freeing a range that is already free!");
+
+		// Merge with the free range that ends where this one starts.
+		if (next != m_freeRanges.begin())
+		{
+			auto previous = std::prev(next);
+			MP_ASSERT(previous->first + previous->second <= offset, "Freeing a range that is already free!");
+
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				count += previous->second;
+				m_freeRanges.erase(previous);
+			}
+		}
+
+		// Merge with the free range that starts where this one ends.
+		if (next != m_freeRanges.end() && offset + count == next->first)
+		{
+			count += next->second;
+			m_freeRanges.erase(next);
+		}
+
+		m_freeRanges.emplace(offset, count);
+	}
+
+} // namespace Mapo
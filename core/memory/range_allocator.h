@@ -0,0 +1,43 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <map>
+
+namespace Mapo
+{
+	// Hands out ranges of an address space it does not own, e.g. elements of a GPU buffer. First fit over the
+	// free ranges sorted by offset; a freed range merges with free neighbors, so the space does not fragment
+	// into pieces that are free next to each other.
+	class RangeAllocator
+	{
+	public:
+		static constexpr U32 INVALID_OFFSET = ~0u;
+
+		explicit RangeAllocator(U32 capacity = 0);
+
+		// Returns the offset of `count` contiguous elements, or INVALID_OFFSET if no free range is large enough.
+		U32	 Allocate(U32 count);
+		void Free(U32 offset, U32 count);
+
+		// Adds free space at the end.
+		void Grow(U32 newCapacity);
+
+		U32 GetCapacity() const { return m_capacity; }
+		U32 GetUsedCount() const { return m_usedCount; }
+		U32 GetFreeRangeCount() const { return static_cast<U32>(m_freeRanges.size()); }
+
+	private:
+		void InsertFreeRange(U32 offset, U32 count);
+
+	private:
+		std::map<U32, U32> m_freeRanges{}; // offset -> count
+		U32				   m_capacity = 0;
+		U32				   m_usedCount = 0;
+	};
+
+} // namespace Mapo
@@ -0,0 +1,627 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "flight_recorder.h"
+
+#include "core/logging.h"
+#include "core/uassert.h"
+#include "core/string/string.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+
+#if defined(__APPLE__) || defined(__unix__)
+	#define MP_FLIGHT_RECORDER_POSIX
+	#include <fcntl.h>
+	#include <signal.h>
+	#include <unistd.h>
+#endif
+
+namespace Mapo
+{
+	// The first frames create the swapchain, upload fonts and so on. They are always slow and never a hitch.
+	static constexpr U64 IGNORED_STARTUP_FRAMES = 8;
+
+	static constexpr U32 FRAME_TRACK_ID = 1000;
+
+	struct ScopeRecord
+	{
+		const char* name;
+		U32			threadIndex;
+		I64			startUs;
+		I64			durationUs;
+	};
+
+	struct AssetLoadRecord
+	{
+		char name[FlightRecorder::MAX_ASSET_NAME_LENGTH];
+		U32	 threadIndex;
+		I64	 startUs;
+		I64	 durationUs;
+	};
+
+	struct FrameRecord
+	{
+		bool			 valid = false;
+		bool			 isStartup = false; // work recorded before the first frame
+		U64				 frameNumber = 0;
+		I64				 startUs = 0;
+		I64				 durationUs = 0;
+		FlightFrameStats stats{};
+
+		std::atomic<U32> scopeCount{ 0 };
+		std::atomic<U32> assetLoadCount{ 0 };
+
+		ScopeRecord		scopes[FlightRecorder::MAX_SCOPES_PER_FRAME];
+		AssetLoadRecord assetLoads[FlightRecorder::MAX_ASSET_LOADS_PER_FRAME];
+	};
+
+	struct FlightRecorderData
+	{
+		FlightRecorderSettings settings{};
+
+		UniqueRef<FrameRecord[]> frames{};
+		U32						 capacity = 0;
+		std::atomic<U32>		 currentSlot{ 0 };
+		std::atomic<bool>		 enabled{ false };
+		std::atomic<bool>		 dumping{ false };
+
+		Timer::Clock::time_point startTime{};
+		Timer::Clock::time_point frameStartTime{};
+
+		U64	 frameCount = 0;
+		U64	 lastDumpFrame = 0;
+		U32	 dumpCount = 0;
+		char pathPrefix[512]{};
+	};
+
+	static FlightRecorderData s_data;
+
+	static std::atomic<U32>	 s_nextThreadIndex{ 0 };
+	static thread_local U32	 t_threadIndex = UINT32_MAX;
+
+	static U32 GetThreadIndex()
+	{
+		if (t_threadIndex == UINT32_MAX)
+		{
+			t_threadIndex = s_nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+		}
+		return t_threadIndex;
+	}
+
+	static I64 ToMicroseconds(Timer::Clock::time_point time)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(time - s_data.startTime).count();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	FlightRecorderSettings FlightRecorderSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		FlightRecorderSettings settings{};
+		String				   value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			const char* arg = args[i];
+
+			if (strcmp(arg, "--no-flight-recorder") == 0)
+			{
+				settings.enabled = false;
+			}
+			else if (StringOp::ParseOption(arg, "--flight-recorder-frames", value))
+			{
+				settings.frameCount = std::max(2, std::atoi(value.c_str()));
+			}
+			else if (StringOp::ParseOption(arg, "--frame-budget-ms", value))
+			{
+				settings.frameBudgetMs = std::max(0.0f, static_cast<F32>(std::atof(value.c_str())));
+			}
+			else if (StringOp::ParseOption(arg, "--flight-recorder-dir", value))
+			{
+				settings.outputDirectory = value;
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Trace writer
+	/////////////////////////////////////////////////////////////////////////////////
+
+	// Formats JSON into a fixed buffer and writes it with write(2). No allocation, no stdio, no locale,
+	// so it can run inside a signal handler.
+	class TraceWriter
+	{
+	public:
+		TraceWriter(int fd)
+			: m_fd(fd)
+		{
+		}
+
+		~TraceWriter() { Flush(); }
+
+		void Append(const char* text)
+		{
+			while (*text)
+			{
+				Put(*text++);
+			}
+		}
+
+		void AppendEscaped(const char* text, size_t maxLength)
+		{
+			for (size_t i = 0; i < maxLength && text[i]; ++i)
+			{
+				char c = text[i];
+				if (c == '"' || c == '\\')
+				{
+					Put('\\');
+				}
+				Put(static_cast<unsigned char>(c) < 0x20 ? ' ' : c);
+			}
+		}
+
+		void AppendInt(I64 value)
+		{
+			char digits[24];
+			int	 count = 0;
+			U64	 magnitude = value < 0 ? static_cast<U64>(-(value + 1)) + 1 : static_cast<U64>(value);
+
+			do
+			{
+				digits[count++] = static_cast<char>('0' + magnitude % 10);
+				magnitude /= 10;
+			} while (magnitude > 0);
+
+			if (value < 0)
+			{
+				Put('-');
+			}
+
+			while (count > 0)
+			{
+				Put(digits[--count]);
+			}
+		}
+
+		// Starts a new element of the traceEvents array.
+		void BeginEvent()
+		{
+			Append(m_firstEvent ? "\n    { " : ",\n    { ");
+			m_firstEvent = false;
+		}
+
+		void Flush()
+		{
+#ifdef MP_FLIGHT_RECORDER_POSIX
+			size_t offset = 0;
+			while (offset < m_size)
+			{
+				ssize_t written = write(m_fd, m_buffer + offset, m_size - offset);
+				if (written <= 0)
+				{
+					break;
+				}
+				offset += static_cast<size_t>(written);
+			}
+#endif
+			m_size = 0;
+		}
+
+	private:
+		void Put(char c)
+		{
+			if (m_size == sizeof(m_buffer))
+			{
+				Flush();
+			}
+			m_buffer[m_size++] = c;
+		}
+
+	private:
+		int	   m_fd;
+		char   m_buffer[8192];
+		size_t m_size = 0;
+		bool   m_firstEvent = true;
+	};
+
+	static void WriteTrace(TraceWriter& writer, const char* reason)
+	{
+		writer.Append("{\n  \"displayTimeUnit\": \"ms\",\n  \"otherData\": { \"reason\": \"");
+		writer.AppendEscaped(reason, 64);
+		writer.Append("\", \"frame_budget_us\": ");
+		writer.AppendInt(static_cast<I64>(s_data.settings.frameBudgetMs * 1000.0f));
+		writer.Append(" },\n  \"traceEvents\": [");
+
+		writer.BeginEvent();
+		writer.Append("\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": ");
+		writer.AppendInt(FRAME_TRACK_ID);
+		writer.Append(", \"args\": { \"name\": \"Frames\" } }");
+
+		// Oldest frame first.
+		const U32 current = s_data.currentSlot.load(std::memory_order_acquire);
+
+		for (U32 i = 1; i <= s_data.capacity; ++i)
+		{
+			const FrameRecord& frame = s_data.frames[(current + i) % s_data.capacity];
+
+			if (!frame.valid)
+			{
+				continue;
+			}
+
+			writer.BeginEvent();
+			writer.Append("\"name\": \"");
+			if (frame.isStartup)
+			{
+				writer.Append("Startup");
+			}
+			else
+			{
+				writer.Append("Frame ");
+				writer.AppendInt(static_cast<I64>(frame.frameNumber));
+			}
+			writer.Append("\", \"cat\": \"frame\", \"ph\": \"X\", \"pid\": 1, \"tid\": ");
+			writer.AppendInt(FRAME_TRACK_ID);
+			writer.Append(", \"ts\": ");
+			writer.AppendInt(frame.startUs);
+			writer.Append(", \"dur\": ");
+			writer.AppendInt(frame.durationUs);
+			writer.Append(", \"args\": { \"draw_calls\": ");
+			writer.AppendInt(frame.stats.drawCalls);
+			writer.Append(", \"triangles\": ");
+			writer.AppendInt(frame.stats.triangleCount);
+			writer.Append(" } }");
+
+			const U32 scopeCount = std::min(frame.scopeCount.load(std::memory_order_acquire), FlightRecorder::MAX_SCOPES_PER_FRAME);
+
+			for (U32 j = 0; j < scopeCount; ++j)
+			{
+				const ScopeRecord& scope = frame.scopes[j];
+
+				writer.BeginEvent();
+				writer.Append("\"name\": \"");
+				writer.AppendEscaped(scope.name ? scope.name : "?", 128);
+				writer.Append("\", \"cat\": \"cpu\", \"ph\": \"X\", \"pid\": 1, \"tid\": ");
+				writer.AppendInt(scope.threadIndex);
+				writer.Append(", \"ts\": ");
+				writer.AppendInt(scope.startUs);
+				writer.Append(", \"dur\": ");
+				writer.AppendInt(scope.durationUs);
+				writer.Append(" }");
+			}
+
+			const U32 assetLoadCount = std::min(frame.assetLoadCount.load(std::memory_order_acquire), FlightRecorder::MAX_ASSET_LOADS_PER_FRAME);
+
+			for (U32 j = 0; j < assetLoadCount; ++j)
+			{
+				const AssetLoadRecord& load = frame.assetLoads[j];
+
+				writer.BeginEvent();
+				writer.Append("\"name\": \"Load ");
+				writer.AppendEscaped(load.name, FlightRecorder::MAX_ASSET_NAME_LENGTH);
+				writer.Append("\", \"cat\": \"asset\", \"ph\": \"X\", \"pid\": 1, \"tid\": ");
+				writer.AppendInt(load.threadIndex);
+				writer.Append(", \"ts\": ");
+				writer.AppendInt(load.startUs);
+				writer.Append(", \"dur\": ");
+				writer.AppendInt(load.durationUs);
+				writer.Append(" }");
+			}
+		}
+
+		writer.Append("\n  ]\n}\n");
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Crash handler
+	/////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MP_FLIGHT_RECORDER_POSIX
+	struct CrashSignal
+	{
+		int				 signal;
+		const char*		 reason;
+		struct sigaction previousAction;
+	};
+
+	static CrashSignal s_crashSignals[] = {
+		{ SIGSEGV, "crash_sigsegv", {} },
+		{ SIGBUS, "crash_sigbus", {} },
+		{ SIGFPE, "crash_sigfpe", {} },
+		{ SIGILL, "crash_sigill", {} },
+		{ SIGABRT, "crash_sigabrt", {} },
+	};
+
+	static void OnCrashSignal(int signal)
+	{
+		for (CrashSignal& crashSignal : s_crashSignals)
+		{
+			if (crashSignal.signal == signal)
+			{
+				FlightRecorder::Dump(crashSignal.reason);
+
+				// Hand the signal to whoever was installed before us (by default: terminate and dump core).
+				sigaction(signal, &crashSignal.previousAction, nullptr);
+				raise(signal);
+				return;
+			}
+		}
+	}
+
+	static void InstallCrashHandler()
+	{
+		struct sigaction action{};
+		action.sa_handler = OnCrashSignal;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_RESETHAND;
+
+		for (CrashSignal& crashSignal : s_crashSignals)
+		{
+			sigaction(crashSignal.signal, &action, &crashSignal.previousAction);
+		}
+	}
+
+	static void UninstallCrashHandler()
+	{
+		for (CrashSignal& crashSignal : s_crashSignals)
+		{
+			sigaction(crashSignal.signal, &crashSignal.previousAction, nullptr);
+		}
+	}
+#else
+	static void InstallCrashHandler() { }
+	static void UninstallCrashHandler() { }
+#endif
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Flight recorder
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void FlightRecorder::Init(const FlightRecorderSettings& settings)
+	{
+		MP_ASSERT(!s_data.enabled, "The flight recorder has already been initialized!");
+
+		if (!settings.enabled)
+		{
+			return;
+		}
+
+		s_data.settings = settings;
+		s_data.capacity = settings.frameCount;
+		s_data.frames = MakeUnique<FrameRecord[]>(settings.frameCount);
+		s_data.startTime = Timer::Clock::now();
+		s_data.frameStartTime = s_data.startTime;
+		s_data.frameCount = 0;
+		s_data.dumpCount = 0;
+
+		std::error_code error{};
+		std::filesystem::create_directories(settings.outputDirectory, error);
+		snprintf(s_data.pathPrefix, sizeof(s_data.pathPrefix), "%s/flight_recorder_", settings.outputDirectory.c_str());
+
+		// Slot 0 collects everything before the first frame.
+		FrameRecord& startup = s_data.frames[0];
+		startup.valid = true;
+		startup.isStartup = true;
+		s_data.currentSlot.store(0, std::memory_order_release);
+
+		GetThreadIndex(); // the main thread is thread 0
+
+		s_data.enabled.store(true, std::memory_order_release);
+
+		if (settings.crashHandler)
+		{
+			InstallCrashHandler();
+		}
+
+		MP_INFO("Flight recorder: {} frames, frame budget {:.1f} ms, output {}", settings.frameCount, settings.frameBudgetMs,
+			settings.outputDirectory);
+	}
+
+	void FlightRecorder::Shutdown()
+	{
+		if (!s_data.enabled)
+		{
+			return;
+		}
+
+		if (s_data.settings.crashHandler)
+		{
+			UninstallCrashHandler();
+		}
+
+		s_data.enabled.store(false, std::memory_order_release);
+		s_data.frames.reset();
+		s_data.capacity = 0;
+	}
+
+	bool FlightRecorder::IsEnabled()
+	{
+		return s_data.enabled.load(std::memory_order_relaxed);
+	}
+
+	void FlightRecorder::BeginFrame(U64 frameNumber)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		Timer::Clock::time_point now = Timer::Clock::now();
+
+		U32 slot = s_data.currentSlot.load(std::memory_order_relaxed);
+
+		if (s_data.frameCount == 0)
+		{
+			s_data.frames[slot].durationUs = ToMicroseconds(now);
+		}
+
+		slot = (slot + 1) % s_data.capacity;
+
+		FrameRecord& frame = s_data.frames[slot];
+		frame.valid = true;
+		frame.isStartup = false;
+		frame.frameNumber = frameNumber;
+		frame.startUs = ToMicroseconds(now);
+		frame.durationUs = 0;
+		frame.stats = {};
+		frame.scopeCount.store(0, std::memory_order_relaxed);
+		frame.assetLoadCount.store(0, std::memory_order_relaxed);
+
+		s_data.frameStartTime = now;
+		s_data.currentSlot.store(slot, std::memory_order_release);
+	}
+
+	void FlightRecorder::EndFrame(const FlightFrameStats& stats)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		FrameRecord& frame = s_data.frames[s_data.currentSlot.load(std::memory_order_relaxed)];
+		frame.durationUs = ToMicroseconds(Timer::Clock::now()) - frame.startUs;
+		frame.stats = stats;
+
+		s_data.frameCount++;
+
+		const FlightRecorderSettings& settings = s_data.settings;
+		const F32					  frameMs = frame.durationUs / 1000.0f;
+
+		if (settings.frameBudgetMs <= 0.0f || frameMs <= settings.frameBudgetMs || s_data.frameCount <= IGNORED_STARTUP_FRAMES)
+		{
+			return;
+		}
+
+		// Do not dump overlapping rings and do not flood the disk.
+		bool recentlyDumped = s_data.dumpCount > 0 && s_data.frameCount - s_data.lastDumpFrame < s_data.capacity;
+		if (recentlyDumped || s_data.dumpCount >= settings.maxDumps)
+		{
+			return;
+		}
+
+		s_data.lastDumpFrame = s_data.frameCount;
+		s_data.dumpCount++;
+
+		MP_WARN("Frame {} took {:.2f} ms (budget: {:.2f} ms). Dumping the flight recorder.", frame.frameNumber, frameMs,
+			settings.frameBudgetMs);
+
+		if (!Dump("hitch"))
+		{
+			MP_ERROR("Failed to write the flight recorder trace to {}", settings.outputDirectory);
+		}
+	}
+
+	void FlightRecorder::RecordScope(const char* name, Timer::Clock::time_point start, Timer::Clock::time_point end)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		FrameRecord& frame = s_data.frames[s_data.currentSlot.load(std::memory_order_acquire)];
+		U32			 index = frame.scopeCount.fetch_add(1, std::memory_order_acq_rel);
+
+		if (index >= MAX_SCOPES_PER_FRAME)
+		{
+			return;
+		}
+
+		ScopeRecord& scope = frame.scopes[index];
+		scope.name = name;
+		scope.threadIndex = GetThreadIndex();
+		scope.startUs = ToMicroseconds(start);
+		scope.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	}
+
+	void FlightRecorder::RecordAssetLoad(const char* name, Timer::Clock::time_point start, Timer::Clock::time_point end)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		FrameRecord& frame = s_data.frames[s_data.currentSlot.load(std::memory_order_acquire)];
+		U32			 index = frame.assetLoadCount.fetch_add(1, std::memory_order_acq_rel);
+
+		if (index >= MAX_ASSET_LOADS_PER_FRAME)
+		{
+			return;
+		}
+
+		AssetLoadRecord& load = frame.assetLoads[index];
+		strncpy(load.name, name, MAX_ASSET_NAME_LENGTH - 1);
+		load.name[MAX_ASSET_NAME_LENGTH - 1] = '\0';
+		load.threadIndex = GetThreadIndex();
+		load.startUs = ToMicroseconds(start);
+		load.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	}
+
+	bool FlightRecorder::Dump(const char* reason)
+	{
+#ifdef MP_FLIGHT_RECORDER_POSIX
+		// Also guards against a crash while dumping.
+		if (!IsEnabled() || s_data.dumping.exchange(true))
+		{
+			return false;
+		}
+
+		// <prefix><reason>_<frame>.json, built without allocating.
+		char path[sizeof(s_data.pathPrefix) + 96];
+		size_t length = 0;
+
+		auto appendPath = [&path, &length](const char* text) {
+			while (*text && length + 1 < sizeof(path))
+			{
+				path[length++] = *text++;
+			}
+		};
+
+		char frameDigits[24];
+		int	 digitCount = 0;
+		U64	 frameNumber = s_data.frames[s_data.currentSlot.load(std::memory_order_acquire)].frameNumber;
+		do
+		{
+			frameDigits[digitCount++] = static_cast<char>('0' + frameNumber % 10);
+			frameNumber /= 10;
+		} while (frameNumber > 0);
+
+		appendPath(s_data.pathPrefix);
+		appendPath(reason);
+		appendPath("_");
+		while (digitCount > 0 && length + 1 < sizeof(path))
+		{
+			path[length++] = frameDigits[--digitCount];
+		}
+		appendPath(".json");
+		path[length] = '\0';
+
+		int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+		{
+			s_data.dumping.store(false);
+			return false;
+		}
+
+		{
+			TraceWriter writer(fd);
+			WriteTrace(writer, reason);
+		}
+
+		close(fd);
+
+		s_data.dumping.store(false);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+} // namespace Mapo
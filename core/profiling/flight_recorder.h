@@ -0,0 +1,96 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+#include "core/timer.h"
+#include "core/command_line.h"
+
+#include <string>
+
+namespace Mapo
+{
+	// Flight recorder options parsed from the command line:
+	//
+	//   --flight-recorder-frames=<N>    Number of frames kept in the ring (default: 300).
+	//   --frame-budget-ms=<ms>          Dumps the ring when a frame takes longer than this (default: 50). 0 disables it.
+	//   --flight-recorder-dir=<path>    Directory of the trace files (default: working directory).
+	//   --no-flight-recorder            Disables the recorder and the crash handler.
+	struct FlightRecorderSettings
+	{
+		bool   enabled = true;
+		bool   crashHandler = true;
+		U32	   frameCount = 300;
+		F32	   frameBudgetMs = 50.0f;
+		U32	   maxDumps = 8; // per session
+		String outputDirectory = ".";
+
+		static FlightRecorderSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	struct FlightFrameStats
+	{
+		U32 drawCalls = 0;
+		U32 triangleCount = 0;
+	};
+
+	// Always-on, low-overhead recorder of the last few hundred frames. Each frame keeps its time, render stats,
+	// CPU scopes (MP_PROFILE_SCOPE) and asset loads in a preallocated ring; recording never allocates.
+	//
+	// The ring is written as a Chrome trace (chrome://tracing, Perfetto) to
+	// <dir>/flight_recorder_<reason>_<frame>.json when a frame exceeds the budget or the process receives a
+	// crash signal. Dumping only uses async-signal-safe calls so the same code path serves both cases.
+	//
+	// Scopes may be recorded from any thread and are attributed to the frame that is current on the main thread.
+	class FlightRecorder
+	{
+	public:
+		static constexpr U32 MAX_SCOPES_PER_FRAME = 128;
+		static constexpr U32 MAX_ASSET_LOADS_PER_FRAME = 16;
+		static constexpr U32 MAX_ASSET_NAME_LENGTH = 96;
+
+		static void Init(const FlightRecorderSettings& settings);
+		static void Shutdown();
+
+		static bool IsEnabled();
+
+		// Called by the main loop around each frame.
+		static void BeginFrame(U64 frameNumber);
+		static void EndFrame(const FlightFrameStats& stats);
+
+		// The name must outlive the recorder (e.g. a string literal).
+		static void RecordScope(const char* name, Timer::Clock::time_point start, Timer::Clock::time_point end);
+
+		// The name is copied (truncated to MAX_ASSET_NAME_LENGTH).
+		static void RecordAssetLoad(const char* name, Timer::Clock::time_point start, Timer::Clock::time_point end);
+
+		// Writes the ring to a trace file. Returns false if the recorder is disabled or the file cannot be written.
+		static bool Dump(const char* reason);
+	};
+
+	class ScopedFlightRecorderScope
+	{
+	public:
+		ScopedFlightRecorderScope(const char* name)
+			: m_name(name), m_start(Timer::Clock::now())
+		{
+		}
+
+		~ScopedFlightRecorderScope()
+		{
+			FlightRecorder::RecordScope(m_name, m_start, Timer::Clock::now());
+		}
+
+		ScopedFlightRecorderScope(const ScopedFlightRecorderScope&) = delete;
+		ScopedFlightRecorderScope& operator=(const ScopedFlightRecorderScope&) = delete;
+
+	private:
+		const char*				 m_name;
+		Timer::Clock::time_point m_start;
+	};
+
+} // namespace Mapo
+
+#define MP_PROFILE_SCOPE(name) ::Mapo::ScopedFlightRecorderScope MP_CONCAT(flightRecorderScope, __LINE__)(name)
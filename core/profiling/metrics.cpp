@@ -0,0 +1,522 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "metrics.h"
+
+#include "core/logging.h"
+#include "core/uassert.h"
+#include "core/string/string.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#if defined(__APPLE__)
+	#include <mach/mach.h>
+	#include <sys/resource.h>
+#elif defined(__linux__)
+	#include <sys/resource.h>
+	#include <unistd.h>
+#endif
+
+namespace Mapo
+{
+	template <typename T>
+	struct MetricSlot
+	{
+		char name[Metrics::MAX_NAME_LENGTH]{};
+		T	 metric{};
+	};
+
+	template <typename T>
+	struct MetricTable
+	{
+		MetricSlot<T>	 slots[Metrics::MAX_METRICS_PER_KIND];
+		std::atomic<U32> count{ 0 }; // published after a slot is initialized
+	};
+
+	struct MetricsData
+	{
+		MetricsSettings settings{};
+
+		std::mutex registryMutex;
+
+		MetricTable<MetricCounter>	 counters;
+		MetricTable<MetricGauge>	 gauges;
+		MetricTable<MetricHistogram> histograms;
+
+		// Exporter
+		std::thread				exporter;
+		std::mutex				exporterMutex;
+		std::condition_variable exporterWakeUp;
+		bool					running = false;
+
+		FILE* file = nullptr;
+		U64	  fileBytes = 0;
+
+		std::chrono::steady_clock::time_point startTime{};
+		std::chrono::steady_clock::time_point lastSnapshotTime{};
+	};
+
+	static MetricsData s_data;
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	MetricsSettings MetricsSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		MetricsSettings settings{};
+		String			value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			const char* arg = args[i];
+
+			if (StringOp::ParseOption(arg, "--metrics-file", value))
+			{
+				settings.filepath = value;
+			}
+			else if (StringOp::ParseOption(arg, "--metrics-interval-ms", value))
+			{
+				settings.intervalMs = std::max(10, std::atoi(value.c_str()));
+			}
+			else if (StringOp::ParseOption(arg, "--metrics-max-file-mb", value))
+			{
+				settings.maxFileBytes = static_cast<U64>(std::max(1, std::atoi(value.c_str()))) * 1024 * 1024;
+			}
+			else if (StringOp::ParseOption(arg, "--metrics-max-files", value))
+			{
+				settings.maxFiles = std::max(1, std::atoi(value.c_str()));
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Metric types
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static void AtomicAdd(std::atomic<F64>& target, F64 delta)
+	{
+		F64 current = target.load(std::memory_order_relaxed);
+		while (!target.compare_exchange_weak(current, current + delta, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	static void AtomicMin(std::atomic<F64>& target, F64 value)
+	{
+		F64 current = target.load(std::memory_order_relaxed);
+		while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	static void AtomicMax(std::atomic<F64>& target, F64 value)
+	{
+		F64 current = target.load(std::memory_order_relaxed);
+		while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void MetricGauge::Add(F64 delta)
+	{
+		AtomicAdd(m_value, delta);
+	}
+
+	void MetricHistogram::SetRange(F64 minValue, F64 maxValue)
+	{
+		MP_ASSERT(minValue > 0.0 && maxValue > minValue, "Invalid histogram range!");
+
+		m_minValue = minValue;
+		m_logMin = std::log(minValue);
+		m_bucketsPerLog = BUCKET_COUNT / (std::log(maxValue) - m_logMin);
+
+		m_min.store(std::numeric_limits<F64>::infinity(), std::memory_order_relaxed);
+		m_max.store(-std::numeric_limits<F64>::infinity(), std::memory_order_relaxed);
+	}
+
+	F64 MetricHistogram::GetBucketValue(U32 bucket) const
+	{
+		// Geometric middle of the bucket.
+		return std::exp(m_logMin + (bucket + 0.5) / m_bucketsPerLog);
+	}
+
+	void MetricHistogram::Record(F64 value)
+	{
+		U32 bucket = 0;
+
+		if (value > m_minValue)
+		{
+			F64 index = (std::log(value) - m_logMin) * m_bucketsPerLog;
+			bucket = static_cast<U32>(std::min(index, static_cast<F64>(BUCKET_COUNT - 1)));
+		}
+
+		m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		AtomicAdd(m_sum, value);
+		AtomicMin(m_min, value);
+		AtomicMax(m_max, value);
+	}
+
+	MetricHistogram::Snapshot MetricHistogram::TakeSnapshot()
+	{
+		// Each field is swapped out on its own, so a value recorded concurrently may be split across two
+		// intervals. That is fine for monitoring and keeps Record wait-free.
+		U64 buckets[BUCKET_COUNT];
+		U64 bucketTotal = 0;
+
+		for (U32 i = 0; i < BUCKET_COUNT; ++i)
+		{
+			buckets[i] = m_buckets[i].exchange(0, std::memory_order_relaxed);
+			bucketTotal += buckets[i];
+		}
+
+		Snapshot snapshot{};
+		snapshot.count = m_count.exchange(0, std::memory_order_relaxed);
+		snapshot.sum = m_sum.exchange(0.0, std::memory_order_relaxed);
+		snapshot.min = m_min.exchange(std::numeric_limits<F64>::infinity(), std::memory_order_relaxed);
+		snapshot.max = m_max.exchange(-std::numeric_limits<F64>::infinity(), std::memory_order_relaxed);
+
+		if (snapshot.count == 0 || bucketTotal == 0)
+		{
+			return Snapshot{};
+		}
+
+		auto percentile = [&](F64 fraction) {
+			const U64 rank = static_cast<U64>(std::ceil(fraction * bucketTotal));
+			U64		  cumulative = 0;
+
+			for (U32 i = 0; i < BUCKET_COUNT; ++i)
+			{
+				cumulative += buckets[i];
+				if (cumulative >= rank)
+				{
+					return std::clamp(GetBucketValue(i), snapshot.min, snapshot.max);
+				}
+			}
+
+			return snapshot.max;
+		};
+
+		snapshot.p50 = percentile(0.50);
+		snapshot.p90 = percentile(0.90);
+		snapshot.p99 = percentile(0.99);
+		return snapshot;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Registry
+	/////////////////////////////////////////////////////////////////////////////////
+
+	template <typename T, typename InitFunc>
+	static T& FindOrRegister(MetricTable<T>& table, const char* name, InitFunc initFunc)
+	{
+		std::lock_guard<std::mutex> lock(s_data.registryMutex);
+
+		const U32 count = table.count.load(std::memory_order_relaxed);
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (strncmp(table.slots[i].name, name, Metrics::MAX_NAME_LENGTH - 1) == 0)
+			{
+				return table.slots[i].metric;
+			}
+		}
+
+		MP_ASSERT(count < Metrics::MAX_METRICS_PER_KIND, "Too many metrics!");
+
+		MetricSlot<T>& slot = table.slots[count];
+		strncpy(slot.name, name, Metrics::MAX_NAME_LENGTH - 1);
+		initFunc(slot.metric);
+
+		table.count.store(count + 1, std::memory_order_release);
+		return slot.metric;
+	}
+
+	MetricCounter& Metrics::GetCounter(const char* name)
+	{
+		return FindOrRegister(s_data.counters, name, [](MetricCounter&) {});
+	}
+
+	MetricGauge& Metrics::GetGauge(const char* name)
+	{
+		return FindOrRegister(s_data.gauges, name, [](MetricGauge&) {});
+	}
+
+	MetricHistogram& Metrics::GetHistogram(const char* name, F64 minValue, F64 maxValue)
+	{
+		return FindOrRegister(s_data.histograms, name,
+			[minValue, maxValue](MetricHistogram& histogram) { histogram.SetRange(minValue, maxValue); });
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Exporter
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static void SampleProcessMemory()
+	{
+		static MetricGauge& residentMemory = Metrics::GetGauge("memory.resident_mb");
+		static MetricGauge& peakResidentMemory = Metrics::GetGauge("memory.peak_resident_mb");
+
+		constexpr F64 MB = 1024.0 * 1024.0;
+
+#if defined(__APPLE__)
+		mach_task_basic_info_data_t info{};
+		mach_msg_type_number_t		count = MACH_TASK_BASIC_INFO_COUNT;
+		if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+		{
+			residentMemory.Set(info.resident_size / MB);
+		}
+
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+			peakResidentMemory.Set(usage.ru_maxrss / MB); // bytes on macOS
+		}
+#elif defined(__linux__)
+		if (FILE* statm = fopen("/proc/self/statm", "r"))
+		{
+			unsigned long long sizePages = 0;
+			unsigned long long residentPages = 0;
+			if (fscanf(statm, "%llu %llu", &sizePages, &residentPages) == 2)
+			{
+				residentMemory.Set(residentPages * static_cast<F64>(sysconf(_SC_PAGESIZE)) / MB);
+			}
+			fclose(statm);
+		}
+
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+			peakResidentMemory.Set(usage.ru_maxrss * 1024.0 / MB); // kilobytes on Linux
+		}
+#endif
+	}
+
+	static bool OpenMetricsFile()
+	{
+		s_data.file = fopen(s_data.settings.filepath.c_str(), "ab");
+
+		if (!s_data.file)
+		{
+			MP_ERROR("Metrics: Failed to open {}", s_data.settings.filepath);
+			return false;
+		}
+
+		fseek(s_data.file, 0, SEEK_END);
+		s_data.fileBytes = static_cast<U64>(std::max(0L, ftell(s_data.file)));
+		return true;
+	}
+
+	// <path> becomes <path>.1, <path>.1 becomes <path>.2 and so on. The oldest file is removed.
+	static void RotateMetricsFile()
+	{
+		fclose(s_data.file);
+		s_data.file = nullptr;
+
+		const String& path = s_data.settings.filepath;
+		const U32	  maxFiles = s_data.settings.maxFiles;
+
+		if (maxFiles <= 1)
+		{
+			std::remove(path.c_str());
+		}
+		else
+		{
+			std::remove((path + "." + std::to_string(maxFiles - 1)).c_str());
+
+			for (U32 i = maxFiles - 1; i > 1; --i)
+			{
+				std::rename((path + "." + std::to_string(i - 1)).c_str(), (path + "." + std::to_string(i)).c_str());
+			}
+
+			std::rename(path.c_str(), (path + ".1").c_str());
+		}
+
+		OpenMetricsFile();
+	}
+
+	static void AppendNumber(String& line, F64 value)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%.6g", std::isfinite(value) ? value : 0.0);
+		line += buffer;
+	}
+
+	static void AppendName(String& line, const char* name)
+	{
+		// Names are code-defined identifiers; quotes and backslashes are the only characters to escape.
+		line += '"';
+		for (const char* c = name; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				line += '\\';
+			}
+			line += *c;
+		}
+		line += "\":";
+	}
+
+	static void WriteSnapshot()
+	{
+		SampleProcessMemory();
+
+		const auto now = std::chrono::steady_clock::now();
+		const F64  uptime = std::chrono::duration<F64>(now - s_data.startTime).count();
+		const F64  interval = std::chrono::duration<F64>(now - s_data.lastSnapshotTime).count();
+		const I64  timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now().time_since_epoch())
+									.count();
+		s_data.lastSnapshotTime = now;
+
+		String line{};
+		line.reserve(4096);
+
+		line += "{\"timestamp_ms\":" + std::to_string(timestampMs);
+		line += ",\"uptime_s\":";
+		AppendNumber(line, uptime);
+		line += ",\"interval_s\":";
+		AppendNumber(line, interval);
+
+		line += ",\"counters\":{";
+		const U32 counterCount = s_data.counters.count.load(std::memory_order_acquire);
+		for (U32 i = 0; i < counterCount; ++i)
+		{
+			line += i == 0 ? "" : ",";
+			AppendName(line, s_data.counters.slots[i].name);
+			line += std::to_string(s_data.counters.slots[i].metric.GetValue());
+		}
+
+		line += "},\"gauges\":{";
+		const U32 gaugeCount = s_data.gauges.count.load(std::memory_order_acquire);
+		for (U32 i = 0; i < gaugeCount; ++i)
+		{
+			line += i == 0 ? "" : ",";
+			AppendName(line, s_data.gauges.slots[i].name);
+			AppendNumber(line, s_data.gauges.slots[i].metric.GetValue());
+		}
+
+		line += "},\"histograms\":{";
+		const U32 histogramCount = s_data.histograms.count.load(std::memory_order_acquire);
+		for (U32 i = 0; i < histogramCount; ++i)
+		{
+			MetricHistogram::Snapshot snapshot = s_data.histograms.slots[i].metric.TakeSnapshot();
+
+			line += i == 0 ? "" : ",";
+			AppendName(line, s_data.histograms.slots[i].name);
+			line += "{\"count\":" + std::to_string(snapshot.count);
+			line += ",\"sum\":";
+			AppendNumber(line, snapshot.sum);
+			line += ",\"min\":";
+			AppendNumber(line, snapshot.min);
+			line += ",\"max\":";
+			AppendNumber(line, snapshot.max);
+			line += ",\"p50\":";
+			AppendNumber(line, snapshot.p50);
+			line += ",\"p90\":";
+			AppendNumber(line, snapshot.p90);
+			line += ",\"p99\":";
+			AppendNumber(line, snapshot.p99);
+			line += '}';
+		}
+
+		line += "}}\n";
+
+		if (s_data.file && s_data.fileBytes + line.size() > s_data.settings.maxFileBytes && s_data.fileBytes > 0)
+		{
+			RotateMetricsFile();
+		}
+
+		if (s_data.file)
+		{
+			fwrite(line.data(), 1, line.size(), s_data.file);
+			fflush(s_data.file); // keep the file useful if the process dies
+			s_data.fileBytes += line.size();
+		}
+	}
+
+	static void RunExporter()
+	{
+		const auto interval = std::chrono::milliseconds(s_data.settings.intervalMs);
+
+		std::unique_lock<std::mutex> lock(s_data.exporterMutex);
+
+		while (s_data.running)
+		{
+			s_data.exporterWakeUp.wait_for(lock, interval, [] { return !s_data.running; });
+
+			lock.unlock();
+			WriteSnapshot();
+			lock.lock();
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Metrics
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void Metrics::Init(const MetricsSettings& settings)
+	{
+		MP_ASSERT(!IsEnabled(), "Metrics are already initialized!");
+
+		if (!settings.IsEnabled())
+		{
+			return;
+		}
+
+		s_data.settings = settings;
+
+		if (!OpenMetricsFile())
+		{
+			return;
+		}
+
+		s_data.startTime = std::chrono::steady_clock::now();
+		s_data.lastSnapshotTime = s_data.startTime;
+		s_data.running = true;
+		s_data.exporter = std::thread(RunExporter);
+
+		MP_INFO("Metrics: Writing snapshots every {} ms to {}", settings.intervalMs, settings.filepath);
+	}
+
+	void Metrics::Shutdown()
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_data.exporterMutex);
+			s_data.running = false;
+		}
+
+		// The exporter writes a final snapshot on its way out.
+		s_data.exporterWakeUp.notify_one();
+		s_data.exporter.join();
+
+		if (s_data.file)
+		{
+			fclose(s_data.file);
+			s_data.file = nullptr;
+		}
+	}
+
+	bool Metrics::IsEnabled()
+	{
+		return s_data.exporter.joinable();
+	}
+
+} // namespace Mapo
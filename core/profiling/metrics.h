@@ -0,0 +1,123 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+#include "core/command_line.h"
+
+#include <atomic>
+#include <string>
+
+namespace Mapo
+{
+	// Metrics options parsed from the command line:
+	//
+	//   --metrics-file=<path>         Enables the exporter and appends JSON lines to this file.
+	//   --metrics-interval-ms=<ms>    Time between snapshots (default: 1000).
+	//   --metrics-max-file-mb=<MB>    Rotates the file when it grows past this size (default: 16).
+	//   --metrics-max-files=<N>       Number of files kept including the current one (default: 4).
+	struct MetricsSettings
+	{
+		String filepath{};
+		U32	   intervalMs = 1000;
+		U64	   maxFileBytes = 16ull * 1024 * 1024;
+		U32	   maxFiles = 4;
+
+		bool IsEnabled() const { return !filepath.empty(); }
+
+		static MetricsSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	// Monotonic total. Reported as the cumulative value; rates are left to the charting side.
+	class MetricCounter
+	{
+	public:
+		void Add(U64 value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+		U64 GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<U64> m_value{ 0 };
+	};
+
+	// Last written value.
+	class MetricGauge
+	{
+	public:
+		void Set(F64 value) { m_value.store(value, std::memory_order_relaxed); }
+		void Add(F64 delta);
+
+		F64 GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<F64> m_value{ 0.0 };
+	};
+
+	// Distribution over an export interval. Buckets are spaced logarithmically between the min and max
+	// given at registration, so percentiles have a constant relative error (about 10% with the defaults).
+	class MetricHistogram
+	{
+	public:
+		static constexpr U32 BUCKET_COUNT = 64;
+
+		struct Snapshot
+		{
+			U64 count = 0;
+			F64 sum = 0.0;
+			F64 min = 0.0;
+			F64 max = 0.0;
+			F64 p50 = 0.0;
+			F64 p90 = 0.0;
+			F64 p99 = 0.0;
+		};
+
+		void Record(F64 value);
+
+		// Returns the distribution since the last call and starts a new interval. Exporter only.
+		Snapshot TakeSnapshot();
+
+	private:
+		void SetRange(F64 minValue, F64 maxValue);
+		F64	 GetBucketValue(U32 bucket) const;
+
+	private:
+		F64 m_minValue = 1.0;
+		F64 m_logMin = 0.0;
+		F64 m_bucketsPerLog = 1.0;
+
+		std::atomic<U64> m_buckets[BUCKET_COUNT]{};
+		std::atomic<U64> m_count{ 0 };
+		std::atomic<F64> m_sum{ 0.0 };
+		std::atomic<F64> m_min{ 0.0 };
+		std::atomic<F64> m_max{ 0.0 };
+
+		friend class Metrics;
+	};
+
+	// Process-wide metrics registry. Registration takes a lock and returns a reference that stays valid for
+	// the lifetime of the process, so call sites look metrics up once and keep the reference. Updates are
+	// relaxed atomics and safe from any thread.
+	//
+	// When enabled, a background thread appends a snapshot of every metric as one JSON object per line and
+	// rotates the file (<path>, <path>.1, ...). The process memory gauges are sampled on that thread too, so
+	// the frame loop never does I/O for metrics.
+	class Metrics
+	{
+	public:
+		static constexpr U32 MAX_METRICS_PER_KIND = 128;
+		static constexpr U32 MAX_NAME_LENGTH = 64;
+
+		static void Init(const MetricsSettings& settings);
+		static void Shutdown();
+
+		static bool IsEnabled();
+
+		// Names are copied and truncated to MAX_NAME_LENGTH. Asserts if a kind runs out of slots.
+		static MetricCounter&	GetCounter(const char* name);
+		static MetricGauge&		GetGauge(const char* name);
+		static MetricHistogram& GetHistogram(const char* name, F64 minValue = 0.01, F64 maxValue = 10000.0);
+	};
+
+} // namespace Mapo
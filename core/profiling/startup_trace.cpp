@@ -0,0 +1,112 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "startup_trace.h"
+
+#include "core/logging.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace Mapo
+{
+	// Startup is short and phases are coarse, so a mutex is good enough here.
+	struct StartupTraceData
+	{
+		std::mutex				 mutex;
+		Timer::Clock::time_point startTime = Timer::Clock::now();
+		F64						 timeToFirstFrameMs = 0.0;
+		bool					 finished = false;
+
+		std::vector<StartupTrace::Phase> phases{};
+		std::vector<std::thread::id>	 threads{};
+	};
+
+	static StartupTraceData& GetData()
+	{
+		static StartupTraceData s_data;
+		return s_data;
+	}
+
+	static F64 ToMilliseconds(Timer::Clock::duration duration)
+	{
+		return std::chrono::duration<F64, Timer::Milliseconds>(duration).count();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void StartupTrace::Start()
+	{
+		StartupTraceData&			data = GetData();
+		std::lock_guard<std::mutex> lock(data.mutex);
+
+		data.startTime = Timer::Clock::now();
+		data.threads.assign(1, std::this_thread::get_id());
+	}
+
+	void StartupTrace::AddPhase(String name, Timer::Clock::time_point start, Timer::Clock::time_point end)
+	{
+		StartupTraceData&			data = GetData();
+		std::lock_guard<std::mutex> lock(data.mutex);
+
+		if (data.finished)
+		{
+			return;
+		}
+
+		std::thread::id threadId = std::this_thread::get_id();
+		auto			iter = std::find(data.threads.begin(), data.threads.end(), threadId);
+		if (iter == data.threads.end())
+		{
+			iter = data.threads.insert(data.threads.end(), threadId);
+		}
+
+		Phase phase{};
+		phase.name = std::move(name);
+		phase.threadIndex = static_cast<U32>(iter - data.threads.begin());
+		phase.startMs = ToMilliseconds(start - data.startTime);
+		phase.durationMs = ToMilliseconds(end - start);
+		data.phases.push_back(std::move(phase));
+	}
+
+	void StartupTrace::MarkFirstFrame()
+	{
+		StartupTraceData&			data = GetData();
+		std::lock_guard<std::mutex> lock(data.mutex);
+
+		if (data.finished)
+		{
+			return;
+		}
+
+		data.finished = true;
+		data.timeToFirstFrameMs = ToMilliseconds(Timer::Clock::now() - data.startTime);
+
+		std::stable_sort(data.phases.begin(), data.phases.end(),
+			[](const Phase& a, const Phase& b) { return a.startMs < b.startMs; });
+
+		MP_INFO("Startup phases:");
+		for (const Phase& phase : data.phases)
+		{
+			MP_INFO("  [thread {}] {:>9.2f} ms  +{:>8.2f} ms  {}", phase.threadIndex, phase.startMs, phase.durationMs, phase.name);
+		}
+		MP_INFO("Time to first frame: {:.2f} ms ({} threads)", data.timeToFirstFrameMs, data.threads.size());
+	}
+
+	F64 StartupTrace::GetTimeToFirstFrame()
+	{
+		StartupTraceData&			data = GetData();
+		std::lock_guard<std::mutex> lock(data.mutex);
+		return data.timeToFirstFrameMs;
+	}
+
+	std::vector<StartupTrace::Phase> StartupTrace::GetPhases()
+	{
+		StartupTraceData&			data = GetData();
+		std::lock_guard<std::mutex> lock(data.mutex);
+		return data.phases;
+	}
+
+} // namespace Mapo
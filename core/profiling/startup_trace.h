@@ -0,0 +1,68 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+#include "core/timer.h"
+
+#include <string>
+#include <vector>
+
+namespace Mapo
+{
+	// Records engine initialization phases on all threads and the time to the first presented frame.
+	//
+	//   MP_STARTUP_PHASE("RenderContext::Init");
+	//
+	// Phases ending after the first frame are ignored, so the macro is free to use in code that also runs later.
+	class StartupTrace
+	{
+	public:
+		struct Phase
+		{
+			String name{};
+			U32	   threadIndex = 0; // 0 is the thread that called Start
+			F64	   startMs = 0.0;	// relative to Start
+			F64	   durationMs = 0.0;
+		};
+
+		// Called once at process entry.
+		static void Start();
+
+		static void AddPhase(String name, Timer::Clock::time_point start, Timer::Clock::time_point end);
+
+		// Called after the first frame has been submitted. Logs the startup report once.
+		static void MarkFirstFrame();
+
+		// Returns 0 until the first frame has been submitted.
+		static F64 GetTimeToFirstFrame();
+
+		static std::vector<Phase> GetPhases();
+	};
+
+	class ScopedStartupPhase
+	{
+	public:
+		ScopedStartupPhase(String name)
+			: m_name(std::move(name)), m_start(Timer::Clock::now())
+		{
+		}
+
+		~ScopedStartupPhase()
+		{
+			StartupTrace::AddPhase(std::move(m_name), m_start, Timer::Clock::now());
+		}
+
+		ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+		ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+	private:
+		String					 m_name;
+		Timer::Clock::time_point m_start;
+	};
+
+} // namespace Mapo
+
+#define MP_STARTUP_PHASE(name) ::Mapo::ScopedStartupPhase MP_CONCAT(startupPhase, __LINE__)(name)
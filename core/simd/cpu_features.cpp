@@ -0,0 +1,141 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "cpu_features.h"
+
+#include <atomic>
+
+#if MP_SIMD_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace Mapo
+{
+	namespace Simd
+	{
+#if MP_SIMD_X86
+		static void Cpuid(U32 leaf, U32 subleaf, U32 registers[4])
+		{
+	#if defined(_MSC_VER)
+			int info[4];
+			__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+			for (int i = 0; i < 4; ++i)
+			{
+				registers[i] = static_cast<U32>(info[i]);
+			}
+	#else
+			__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+	#endif
+		}
+
+		// Register state enabled by the OS (XCR0).
+		static U64 ReadXcr0()
+		{
+	#if defined(_MSC_VER)
+			return _xgetbv(0);
+	#else
+			U32 eax = 0;
+			U32 edx = 0;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<U64>(edx) << 32) | eax;
+	#endif
+		}
+#endif
+
+		static CpuFeatures DetectCpuFeatures()
+		{
+			CpuFeatures features{};
+
+#if MP_SIMD_X86
+			U32 registers[4]{}; // eax, ebx, ecx, edx
+
+			Cpuid(0, 0, registers);
+			const U32 maxLeaf = registers[0];
+
+			Cpuid(1, 0, registers);
+			const U32 ecx1 = registers[2];
+
+			features.sse41 = (ecx1 & (1u << 19)) != 0;
+
+			const bool osxsave = (ecx1 & (1u << 27)) != 0;
+			const bool ymmEnabled = osxsave && (ReadXcr0() & 0x6) == 0x6; // XMM and YMM state
+
+			features.avx = ymmEnabled && (ecx1 & (1u << 28)) != 0;
+			features.fma = features.avx && (ecx1 & (1u << 12)) != 0;
+
+			if (maxLeaf >= 7)
+			{
+				Cpuid(7, 0, registers);
+				features.avx2 = features.avx && (registers[1] & (1u << 5)) != 0;
+			}
+#elif MP_SIMD_NEON
+			features.neon = true; // mandatory on AArch64
+#endif
+
+			return features;
+		}
+
+		static std::atomic<U8> s_simdLevelLimit{ static_cast<U8>(SimdLevel::NEON) };
+
+		const CpuFeatures& GetCpuFeatures()
+		{
+			static const CpuFeatures s_features = DetectCpuFeatures();
+			return s_features;
+		}
+
+		SimdLevel GetBestSimdLevel()
+		{
+			const CpuFeatures& features = GetCpuFeatures();
+
+			if (features.neon)
+				return SimdLevel::NEON;
+			if (features.avx2 && features.fma)
+				return SimdLevel::AVX2;
+			if (features.sse41)
+				return SimdLevel::SSE41;
+
+			return SimdLevel::Scalar;
+		}
+
+		SimdLevel GetSimdLevel()
+		{
+			const SimdLevel best = GetBestSimdLevel();
+			const SimdLevel limit = static_cast<SimdLevel>(s_simdLevelLimit.load(std::memory_order_relaxed));
+
+			// NEON and the x86 levels are exclusive, so a limit only lowers the level on its own architecture.
+			if (limit == SimdLevel::Scalar)
+				return SimdLevel::Scalar;
+
+			return static_cast<U8>(limit) < static_cast<U8>(best) && best != SimdLevel::NEON ? limit : best;
+		}
+
+		void SetSimdLevelLimit(SimdLevel level)
+		{
+			s_simdLevelLimit.store(static_cast<U8>(level), std::memory_order_relaxed);
+		}
+
+		const char* GetSimdLevelName(SimdLevel level)
+		{
+			switch (level)
+			{
+				case SimdLevel::Scalar:
+					return "Scalar";
+				case SimdLevel::SSE41:
+					return "SSE4.1";
+				case SimdLevel::AVX2:
+					return "AVX2";
+				case SimdLevel::NEON:
+					return "NEON";
+			}
+
+			return "Unknown";
+		}
+
+	} // namespace Simd
+
+} // namespace Mapo
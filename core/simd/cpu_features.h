@@ -0,0 +1,52 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define MP_SIMD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define MP_SIMD_NEON 1
+#endif
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		// Instruction sets with their own code paths. Source files of a level are built with the matching
+		// compiler flags and only called after the CPU has been checked.
+		enum class SimdLevel : U8
+		{
+			Scalar = 0,
+			SSE41,
+			AVX2, // includes FMA
+			NEON,
+		};
+
+		struct CpuFeatures
+		{
+			bool sse41 = false;
+			bool avx = false; // also checks that the OS saves the YMM registers
+			bool avx2 = false;
+			bool fma = false;
+			bool neon = false;
+		};
+
+		// Detected once on first use.
+		const CpuFeatures& GetCpuFeatures();
+
+		// Best level supported by this CPU, lowered by SetSimdLevelLimit.
+		SimdLevel GetSimdLevel();
+		SimdLevel GetBestSimdLevel();
+
+		// Restricts dispatch to a lower level, e.g. to compare code paths. Scalar forces the reference paths.
+		void SetSimdLevelLimit(SimdLevel level);
+
+		const char* GetSimdLevelName(SimdLevel level);
+
+	} // namespace Simd
+
+} // namespace Mapo
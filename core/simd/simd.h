@@ -0,0 +1,498 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/math.h"
+#include "core/simd/cpu_features.h"
+
+// float4 and float4x4 are built on the instruction set every target of its architecture has (SSE2 on
+// x86-64, NEON on AArch64), plus SSE4.1 rounding when the whole build enables it. They can be used anywhere
+// without a CPU check. Wider code paths (AVX2) live in separate source files and are picked at runtime,
+// see simd_batch.h.
+
+#if MP_SIMD_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MP_SIMD_SSE 1
+	#include <emmintrin.h>
+	#if defined(__SSE4_1__)
+		#include <smmintrin.h>
+	#endif
+#elif MP_SIMD_NEON
+	#include <arm_neon.h>
+#else
+	#include <cmath>
+	#include <cstring>
+#endif
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		// Four floats in one register. Comparisons return masks with all bits of a lane set or cleared.
+		struct alignas(16) float4
+		{
+#if MP_SIMD_SSE
+			__m128 v;
+#elif MP_SIMD_NEON
+			float32x4_t v;
+#else
+			F32 v[4];
+#endif
+		};
+
+		// Column-major like Matrix4.
+		struct float4x4
+		{
+			float4 columns[4];
+		};
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Load / Store
+		/////////////////////////////////////////////////////////////////////////////////
+
+		MP_FORCE_INLINE float4 Load(const F32* data)
+		{
+#if MP_SIMD_SSE
+			return { _mm_loadu_ps(data) };
+#elif MP_SIMD_NEON
+			return { vld1q_f32(data) };
+#else
+			return { { data[0], data[1], data[2], data[3] } };
+#endif
+		}
+
+		MP_FORCE_INLINE void Store(float4 a, F32* data)
+		{
+#if MP_SIMD_SSE
+			_mm_storeu_ps(data, a.v);
+#elif MP_SIMD_NEON
+			vst1q_f32(data, a.v);
+#else
+			memcpy(data, a.v, sizeof(a.v));
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Set(F32 x, F32 y, F32 z, F32 w)
+		{
+#if MP_SIMD_SSE
+			return { _mm_setr_ps(x, y, z, w) };
+#elif MP_SIMD_NEON
+			const F32 values[4] = { x, y, z, w };
+			return { vld1q_f32(values) };
+#else
+			return { { x, y, z, w } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Splat(F32 value)
+		{
+#if MP_SIMD_SSE
+			return { _mm_set1_ps(value) };
+#elif MP_SIMD_NEON
+			return { vdupq_n_f32(value) };
+#else
+			return { { value, value, value, value } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Zero()
+		{
+			return Splat(0.0f);
+		}
+
+		// Reads exactly three floats, so it is safe at the end of a Vector3 array. W is set to `w`.
+		MP_FORCE_INLINE float4 LoadVector3(const Vector3& vector, F32 w)
+		{
+			return Set(vector.x, vector.y, vector.z, w);
+		}
+
+		// Writes exactly three floats.
+		MP_FORCE_INLINE void StoreVector3(float4 a, Vector3& vector)
+		{
+#if MP_SIMD_SSE
+			_mm_storel_pi(reinterpret_cast<__m64*>(&vector.x), a.v);
+			_mm_store_ss(&vector.z, _mm_movehl_ps(a.v, a.v));
+#elif MP_SIMD_NEON
+			vst1_f32(&vector.x, vget_low_f32(a.v));
+			vst1q_lane_f32(&vector.z, a.v, 2);
+#else
+			vector = { a.v[0], a.v[1], a.v[2] };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 LoadVector4(const Vector4& vector)
+		{
+			return Load(GLM_PTR(vector));
+		}
+
+		MP_FORCE_INLINE Vector4 ToVector4(float4 a)
+		{
+			Vector4 vector;
+			Store(a, GLM_PTR(vector));
+			return vector;
+		}
+
+		MP_FORCE_INLINE F32 GetX(float4 a)
+		{
+#if MP_SIMD_SSE
+			return _mm_cvtss_f32(a.v);
+#elif MP_SIMD_NEON
+			return vgetq_lane_f32(a.v, 0);
+#else
+			return a.v[0];
+#endif
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Arithmetic
+		/////////////////////////////////////////////////////////////////////////////////
+
+		MP_FORCE_INLINE float4 operator+(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_add_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vaddq_f32(a.v, b.v) };
+#else
+			return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 operator-(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_sub_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vsubq_f32(a.v, b.v) };
+#else
+			return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 operator*(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_mul_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vmulq_f32(a.v, b.v) };
+#else
+			return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 operator/(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_div_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vdivq_f32(a.v, b.v) };
+#else
+			return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 operator-(float4 a)
+		{
+			return Zero() - a;
+		}
+
+		// a * b + c. Fused on NEON, so results may differ from x86 in the last bit.
+		MP_FORCE_INLINE float4 MulAdd(float4 a, float4 b, float4 c)
+		{
+#if MP_SIMD_NEON
+			return { vfmaq_f32(c.v, a.v, b.v) };
+#else
+			return a * b + c;
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Min(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_min_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vminq_f32(a.v, b.v) };
+#else
+			return { { std::fmin(a.v[0], b.v[0]), std::fmin(a.v[1], b.v[1]), std::fmin(a.v[2], b.v[2]), std::fmin(a.v[3], b.v[3]) } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Max(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_max_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vmaxq_f32(a.v, b.v) };
+#else
+			return { { std::fmax(a.v[0], b.v[0]), std::fmax(a.v[1], b.v[1]), std::fmax(a.v[2], b.v[2]), std::fmax(a.v[3], b.v[3]) } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Abs(float4 a)
+		{
+#if MP_SIMD_SSE
+			return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) };
+#elif MP_SIMD_NEON
+			return { vabsq_f32(a.v) };
+#else
+			return { { std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]), std::fabs(a.v[3]) } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Sqrt(float4 a)
+		{
+#if MP_SIMD_SSE
+			return { _mm_sqrt_ps(a.v) };
+#elif MP_SIMD_NEON
+			return { vsqrtq_f32(a.v) };
+#else
+			return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } };
+#endif
+		}
+
+		// Without SSE4.1 only valid for |a| < 2^31, which covers every value with a fractional part.
+		MP_FORCE_INLINE float4 Floor(float4 a)
+		{
+#if MP_SIMD_SSE && defined(__SSE4_1__)
+			return { _mm_floor_ps(a.v) };
+#elif MP_SIMD_SSE
+			const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+			const __m128 correction = _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f));
+			return { _mm_sub_ps(truncated, correction) };
+#elif MP_SIMD_NEON
+			return { vrndmq_f32(a.v) };
+#else
+			return { { std::floor(a.v[0]), std::floor(a.v[1]), std::floor(a.v[2]), std::floor(a.v[3]) } };
+#endif
+		}
+
+		// Rounds to the nearest integer, ties to even. Same range as Floor.
+		MP_FORCE_INLINE float4 Round(float4 a)
+		{
+#if MP_SIMD_SSE && defined(__SSE4_1__)
+			return { _mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+#elif MP_SIMD_SSE
+			return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) };
+#elif MP_SIMD_NEON
+			return { vrndnq_f32(a.v) };
+#else
+			return { { std::nearbyint(a.v[0]), std::nearbyint(a.v[1]), std::nearbyint(a.v[2]), std::nearbyint(a.v[3]) } };
+#endif
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Comparison / Selection
+		/////////////////////////////////////////////////////////////////////////////////
+
+#if !MP_SIMD_SSE && !MP_SIMD_NEON
+		namespace Detail
+		{
+			MP_FORCE_INLINE F32 MaskLane(bool value)
+			{
+				const U32 bits = value ? 0xFFFFFFFFu : 0u;
+				F32		  lane;
+				memcpy(&lane, &bits, sizeof(lane));
+				return lane;
+			}
+
+			MP_FORCE_INLINE bool IsLaneSet(F32 lane)
+			{
+				U32 bits;
+				memcpy(&bits, &lane, sizeof(bits));
+				return bits != 0;
+			}
+		} // namespace Detail
+#endif
+
+		MP_FORCE_INLINE float4 CmpLess(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_cmplt_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)) };
+#else
+			return { { Detail::MaskLane(a.v[0] < b.v[0]), Detail::MaskLane(a.v[1] < b.v[1]), Detail::MaskLane(a.v[2] < b.v[2]), Detail::MaskLane(a.v[3] < b.v[3]) } };
+#endif
+		}
+
+		MP_FORCE_INLINE float4 CmpGreater(float4 a, float4 b)
+		{
+			return CmpLess(b, a);
+		}
+
+		// mask ? a : b for each lane.
+		MP_FORCE_INLINE float4 Select(float4 mask, float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+#elif MP_SIMD_NEON
+			return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+#else
+			float4 result;
+			for (U32 i = 0; i < 4; ++i)
+			{
+				result.v[i] = Detail::IsLaneSet(mask.v[i]) ? a.v[i] : b.v[i];
+			}
+			return result;
+#endif
+		}
+
+		// Bitwise, for combining masks.
+		MP_FORCE_INLINE float4 And(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_and_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+#else
+			return Select(a, b, Zero());
+#endif
+		}
+
+		MP_FORCE_INLINE float4 Or(float4 a, float4 b)
+		{
+#if MP_SIMD_SSE
+			return { _mm_or_ps(a.v, b.v) };
+#elif MP_SIMD_NEON
+			return { vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+#else
+			return Select(a, a, b);
+#endif
+		}
+
+		// Bit i is set if lane i of the mask is set.
+		MP_FORCE_INLINE U32 MoveMask(float4 mask)
+		{
+#if MP_SIMD_SSE
+			return static_cast<U32>(_mm_movemask_ps(mask.v));
+#elif MP_SIMD_NEON
+			const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask.v), 31);
+			return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3);
+#else
+			return (Detail::IsLaneSet(mask.v[0]) ? 1u : 0u) | (Detail::IsLaneSet(mask.v[1]) ? 2u : 0u) | (Detail::IsLaneSet(mask.v[2]) ? 4u : 0u) | (Detail::IsLaneSet(mask.v[3]) ? 8u : 0u);
+#endif
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Swizzle / Reduction
+		/////////////////////////////////////////////////////////////////////////////////
+
+		template <U32 Lane>
+		MP_FORCE_INLINE float4 SplatLane(float4 a)
+		{
+			static_assert(Lane < 4, "float4 has four lanes!");
+#if MP_SIMD_SSE
+			return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)) };
+#elif MP_SIMD_NEON
+			return { vdupq_laneq_f32(a.v, Lane) };
+#else
+			return Splat(a.v[Lane]);
+#endif
+		}
+
+		MP_FORCE_INLINE float4 SplatX(float4 a) { return SplatLane<0>(a); }
+		MP_FORCE_INLINE float4 SplatY(float4 a) { return SplatLane<1>(a); }
+		MP_FORCE_INLINE float4 SplatZ(float4 a) { return SplatLane<2>(a); }
+		MP_FORCE_INLINE float4 SplatW(float4 a) { return SplatLane<3>(a); }
+
+		MP_FORCE_INLINE F32 HorizontalAdd(float4 a)
+		{
+#if MP_SIMD_SSE
+			const __m128 pairs = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+			return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+#elif MP_SIMD_NEON
+			return vaddvq_f32(a.v);
+#else
+			return (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]);
+#endif
+		}
+
+		MP_FORCE_INLINE F32 Dot4(float4 a, float4 b)
+		{
+			return HorizontalAdd(a * b);
+		}
+
+		// Ignores w.
+		MP_FORCE_INLINE F32 Dot3(float4 a, float4 b)
+		{
+			const float4 product = a * b;
+			return GetX(product) + GetX(SplatY(product)) + GetX(SplatZ(product));
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// float4x4
+		/////////////////////////////////////////////////////////////////////////////////
+
+		MP_FORCE_INLINE float4x4 LoadMatrix4(const Matrix4& matrix)
+		{
+			const F32* data = GLM_PTR(matrix);
+			return { { Load(data), Load(data + 4), Load(data + 8), Load(data + 12) } };
+		}
+
+		MP_FORCE_INLINE void StoreMatrix4(const float4x4& m, Matrix4& matrix)
+		{
+			F32* data = GLM_PTR(matrix);
+			Store(m.columns[0], data);
+			Store(m.columns[1], data + 4);
+			Store(m.columns[2], data + 8);
+			Store(m.columns[3], data + 12);
+		}
+
+		MP_FORCE_INLINE Matrix4 ToMatrix4(const float4x4& m)
+		{
+			Matrix4 matrix;
+			StoreMatrix4(m, matrix);
+			return matrix;
+		}
+
+		// m * v
+		MP_FORCE_INLINE float4 Transform(const float4x4& m, float4 v)
+		{
+			float4 result = m.columns[0] * SplatX(v);
+			result = MulAdd(m.columns[1], SplatY(v), result);
+			result = MulAdd(m.columns[2], SplatZ(v), result);
+			return MulAdd(m.columns[3], SplatW(v), result);
+		}
+
+		// m * (p.xyz, 1). The w of `point` is ignored.
+		MP_FORCE_INLINE float4 TransformPoint(const float4x4& m, float4 point)
+		{
+			float4 result = MulAdd(m.columns[0], SplatX(point), m.columns[3]);
+			result = MulAdd(m.columns[1], SplatY(point), result);
+			return MulAdd(m.columns[2], SplatZ(point), result);
+		}
+
+		// m * (v.xyz, 0). The w of `vector` is ignored.
+		MP_FORCE_INLINE float4 TransformVector(const float4x4& m, float4 vector)
+		{
+			float4 result = m.columns[0] * SplatX(vector);
+			result = MulAdd(m.columns[1], SplatY(vector), result);
+			return MulAdd(m.columns[2], SplatZ(vector), result);
+		}
+
+		MP_FORCE_INLINE float4x4 operator*(const float4x4& a, const float4x4& b)
+		{
+			return { { Transform(a, b.columns[0]), Transform(a, b.columns[1]), Transform(a, b.columns[2]), Transform(a, b.columns[3]) } };
+		}
+
+		MP_FORCE_INLINE float4x4 Transpose(const float4x4& m)
+		{
+#if MP_SIMD_SSE
+			float4x4 result = m;
+			_MM_TRANSPOSE4_PS(result.columns[0].v, result.columns[1].v, result.columns[2].v, result.columns[3].v);
+			return result;
+#else
+			F32 data[16];
+			for (U32 column = 0; column < 4; ++column)
+			{
+				Store(m.columns[column], data + column * 4);
+			}
+			return { { Set(data[0], data[4], data[8], data[12]), Set(data[1], data[5], data[9], data[13]),
+				Set(data[2], data[6], data[10], data[14]), Set(data[3], data[7], data[11], data[15]) } };
+#endif
+		}
+
+	} // namespace Simd
+
+} // namespace Mapo
@@ -0,0 +1,310 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "simd_batch.h"
+
+#include "core/uassert.h"
+#include "core/simd/simd.h"
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		static_assert(sizeof(Vector3) == 3 * sizeof(F32), "The AVX2 paths read Vector3 arrays as packed floats!");
+		static_assert(sizeof(AABB) == 6 * sizeof(F32), "The AVX2 paths read AABB arrays as packed floats!");
+		static_assert(sizeof(Matrix4) == 16 * sizeof(F32), "The AVX2 paths read Matrix4 arrays as packed floats!");
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Reference (glm)
+		/////////////////////////////////////////////////////////////////////////////////
+
+		static void TransformPointsScalar(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count)
+		{
+			for (U32 i = 0; i < count; ++i)
+			{
+				output[i] = Vector3(matrix * Vector4(points[i], 1.0f));
+			}
+		}
+
+		static void TransformAABBsScalar(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count)
+		{
+			const Vector3 column0 = MathOp::Abs(Vector3(matrix[0]));
+			const Vector3 column1 = MathOp::Abs(Vector3(matrix[1]));
+			const Vector3 column2 = MathOp::Abs(Vector3(matrix[2]));
+
+			for (U32 i = 0; i < count; ++i)
+			{
+				const Vector3 center = (boxes[i].min + boxes[i].max) * 0.5f;
+				const Vector3 extent = (boxes[i].max - boxes[i].min) * 0.5f;
+
+				// The extent along each axis is the projection of the box on that axis.
+				const Vector3 newCenter = Vector3(matrix * Vector4(center, 1.0f));
+				const Vector3 newExtent = column0 * extent.x + column1 * extent.y + column2 * extent.z;
+
+				output[i].min = newCenter - newExtent;
+				output[i].max = newCenter + newExtent;
+			}
+		}
+
+		static void MultiplyMatricesScalar(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count)
+		{
+			for (U32 i = 0; i < count; ++i)
+			{
+				output[i] = a[i] * b[i];
+			}
+		}
+
+		static bool IsBoundInside(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 index)
+		{
+			const Vector3 center = { bounds.center[0][index], bounds.center[1][index], bounds.center[2][index] };
+			const Vector3 extent = { bounds.extent[0][index], bounds.extent[1][index], bounds.extent[2][index] };
+
+			for (U32 p = 0; p < planeCount; ++p)
+			{
+				const Vector3 normal = Vector3(planes[p]);
+				const F32	  distance = MathOp::Dot(normal, center) + planes[p].w;
+				const F32	  radius = MathOp::Min(bounds.radius[index], MathOp::Dot(MathOp::Abs(normal), extent));
+
+				if (distance < -radius)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		static U32 CullBoundsScalar(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 first, U32 count, U32* visibleIndices)
+		{
+			U32 visibleCount = 0;
+
+			for (U32 i = first; i < count; ++i)
+			{
+				if (IsBoundInside(planes, planeCount, bounds, i))
+				{
+					visibleIndices[visibleCount++] = i;
+				}
+			}
+
+			return visibleCount;
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// float4
+		/////////////////////////////////////////////////////////////////////////////////
+
+		static void TransformPointsFloat4(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count)
+		{
+			const float4x4 m = LoadMatrix4(matrix);
+
+			for (U32 i = 0; i < count; ++i)
+			{
+				StoreVector3(TransformPoint(m, LoadVector3(points[i], 1.0f)), output[i]);
+			}
+		}
+
+		static void TransformAABBsFloat4(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count)
+		{
+			const float4x4 m = LoadMatrix4(matrix);
+			const float4x4 absolute = { { Abs(m.columns[0]), Abs(m.columns[1]), Abs(m.columns[2]), Zero() } };
+			const float4   half = Splat(0.5f);
+
+			for (U32 i = 0; i < count; ++i)
+			{
+				const float4 min = LoadVector3(boxes[i].min, 0.0f);
+				const float4 max = LoadVector3(boxes[i].max, 0.0f);
+
+				const float4 center = TransformPoint(m, (min + max) * half);
+				const float4 extent = TransformVector(absolute, (max - min) * half);
+
+				StoreVector3(center - extent, output[i].min);
+				StoreVector3(center + extent, output[i].max);
+			}
+		}
+
+		static void MultiplyMatricesFloat4(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count)
+		{
+			for (U32 i = 0; i < count; ++i)
+			{
+				StoreMatrix4(LoadMatrix4(a[i]) * LoadMatrix4(b[i]), output[i]);
+			}
+		}
+
+		// Four bounds per iteration, tested against one plane at a time.
+		static U32 CullBoundsFloat4(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 count, U32* visibleIndices)
+		{
+			float4 normalX[MAX_CULL_PLANES], normalY[MAX_CULL_PLANES], normalZ[MAX_CULL_PLANES], offset[MAX_CULL_PLANES];
+			float4 absoluteX[MAX_CULL_PLANES], absoluteY[MAX_CULL_PLANES], absoluteZ[MAX_CULL_PLANES];
+
+			for (U32 p = 0; p < planeCount; ++p)
+			{
+				normalX[p] = Splat(planes[p].x);
+				normalY[p] = Splat(planes[p].y);
+				normalZ[p] = Splat(planes[p].z);
+				offset[p] = Splat(planes[p].w);
+				absoluteX[p] = Abs(normalX[p]);
+				absoluteY[p] = Abs(normalY[p]);
+				absoluteZ[p] = Abs(normalZ[p]);
+			}
+
+			U32 visibleCount = 0;
+			U32 i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const float4 centerX = Load(bounds.center[0] + i);
+				const float4 centerY = Load(bounds.center[1] + i);
+				const float4 centerZ = Load(bounds.center[2] + i);
+				const float4 extentX = Load(bounds.extent[0] + i);
+				const float4 extentY = Load(bounds.extent[1] + i);
+				const float4 extentZ = Load(bounds.extent[2] + i);
+				const float4 radius = Load(bounds.radius + i);
+
+				float4 outside = Zero();
+
+				for (U32 p = 0; p < planeCount; ++p)
+				{
+					const float4 distance = MulAdd(normalZ[p], centerZ, MulAdd(normalY[p], centerY, MulAdd(normalX[p], centerX, offset[p])));
+					const float4 boxRadius = MulAdd(absoluteZ[p], extentZ, MulAdd(absoluteY[p], extentY, absoluteX[p] * extentX));
+
+					outside = Or(outside, CmpLess(distance, -Min(radius, boxRadius)));
+				}
+
+				// Branchless append: every lane is written, only visible ones advance the count.
+				const U32 visibleMask = ~MoveMask(outside);
+				for (U32 lane = 0; lane < 4; ++lane)
+				{
+					visibleIndices[visibleCount] = i + lane;
+					visibleCount += (visibleMask >> lane) & 1;
+				}
+			}
+
+			return visibleCount + CullBoundsScalar(planes, planeCount, bounds, i, count, visibleIndices + visibleCount);
+		}
+
+		/////////////////////////////////////////////////////////////////////////////////
+		// Dispatch
+		/////////////////////////////////////////////////////////////////////////////////
+
+		void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count)
+		{
+			TransformPoints(matrix, points, output, count, GetSimdLevel());
+		}
+
+		void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count, SimdLevel level)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			switch (level)
+			{
+				case SimdLevel::Scalar:
+					TransformPointsScalar(matrix, points, output, count);
+					return;
+#if MP_SIMD_X86
+				case SimdLevel::AVX2:
+					Detail::TransformPointsAVX2(GLM_PTR(matrix), GLM_PTR(points[0]), GLM_PTR(output[0]), count);
+					return;
+#endif
+				default:
+					TransformPointsFloat4(matrix, points, output, count);
+					return;
+			}
+		}
+
+		void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count)
+		{
+			TransformAABBs(matrix, boxes, output, count, GetSimdLevel());
+		}
+
+		void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count, SimdLevel level)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			switch (level)
+			{
+				case SimdLevel::Scalar:
+					TransformAABBsScalar(matrix, boxes, output, count);
+					return;
+#if MP_SIMD_X86
+				case SimdLevel::AVX2:
+					Detail::TransformAABBsAVX2(GLM_PTR(matrix), GLM_PTR(boxes[0].min), GLM_PTR(output[0].min), count);
+					return;
+#endif
+				default:
+					TransformAABBsFloat4(matrix, boxes, output, count);
+					return;
+			}
+		}
+
+		void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count)
+		{
+			MultiplyMatrices(a, b, output, count, GetSimdLevel());
+		}
+
+		void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count, SimdLevel level)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			switch (level)
+			{
+				case SimdLevel::Scalar:
+					MultiplyMatricesScalar(a, b, output, count);
+					return;
+#if MP_SIMD_X86
+				case SimdLevel::AVX2:
+					Detail::MultiplyMatricesAVX2(GLM_PTR(a[0]), GLM_PTR(b[0]), GLM_PTR(output[0]), count);
+					return;
+#endif
+				default:
+					MultiplyMatricesFloat4(a, b, output, count);
+					return;
+			}
+		}
+
+		U32 CullBounds(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 count, U32* visibleIndices)
+		{
+			return CullBounds(planes, planeCount, bounds, count, visibleIndices, GetSimdLevel());
+		}
+
+		U32 CullBounds(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 count, U32* visibleIndices, SimdLevel level)
+		{
+			MP_ASSERT(planeCount <= MAX_CULL_PLANES, "Too many culling planes!");
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			switch (level)
+			{
+				case SimdLevel::Scalar:
+					return CullBoundsScalar(planes, planeCount, bounds, 0, count, visibleIndices);
+#if MP_SIMD_X86
+				case SimdLevel::AVX2:
+				{
+					const F32* soa[7] = {
+						bounds.center[0], bounds.center[1], bounds.center[2],
+						bounds.extent[0], bounds.extent[1], bounds.extent[2],
+						bounds.radius
+					};
+					return Detail::CullBoundsAVX2(GLM_PTR(planes[0]), planeCount, soa, count, visibleIndices);
+				}
+#endif
+				default:
+					return CullBoundsFloat4(planes, planeCount, bounds, count, visibleIndices);
+			}
+		}
+
+	} // namespace Simd
+
+} // namespace Mapo
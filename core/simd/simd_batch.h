@@ -0,0 +1,62 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/math.h"
+#include "core/simd/cpu_features.h"
+
+// Batch routines over arrays of glm types. Each one dispatches at runtime to the AVX2 path, the float4 path
+// (SSE4.1 or NEON level) or the plain glm reference, following GetSimdLevel(). Input and output arrays may be
+// the same array but must not partially overlap.
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		// Bounding boxes (center and half extent) and bounding spheres around the same centers, in
+		// structure-of-arrays layout. Each pointer addresses `count` values.
+		struct BoundsSoA
+		{
+			const F32* center[3]{};
+			const F32* extent[3]{};
+			const F32* radius = nullptr;
+		};
+
+		// output[i] = (matrix * Vector4(points[i], 1)).xyz. No perspective divide.
+		void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count);
+		void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, U32 count, SimdLevel level);
+
+		// Bounds of each box after an affine transform: the smallest AABB that contains the eight transformed
+		// corners (the row below the 3x4 part of the matrix is ignored).
+		void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count);
+		void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* output, U32 count, SimdLevel level);
+
+		// output[i] = a[i] * b[i]
+		void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count);
+		void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* output, U32 count, SimdLevel level);
+
+		static constexpr U32 MAX_CULL_PLANES = 8;
+
+		// Tests bounds against up to MAX_CULL_PLANES planes given as (normal, offset) with unit normals pointing
+		// inside. A bound is rejected when it lies completely outside one plane, measured with the tighter of its
+		// box and sphere along the plane normal. Writes the indices of the remaining bounds to `visibleIndices`,
+		// which needs room for `count` entries, and returns their number.
+		U32 CullBounds(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 count, U32* visibleIndices);
+		U32 CullBounds(const Vector4* planes, U32 planeCount, const BoundsSoA& bounds, U32 count, U32* visibleIndices, SimdLevel level);
+
+		namespace Detail
+		{
+			// Defined in simd_batch_avx2.cpp on raw floats, see the note there. Only present on x86.
+			void TransformPointsAVX2(const F32* matrix, const F32* points, F32* output, U32 count);
+			void TransformAABBsAVX2(const F32* matrix, const F32* boxes, F32* output, U32 count);
+			void MultiplyMatricesAVX2(const F32* a, const F32* b, F32* output, U32 count);
+
+			// `soa` holds the seven BoundsSoA arrays in declaration order, `planes` four floats per plane.
+			U32 CullBoundsAVX2(const F32* planes, U32 planeCount, const F32* const* soa, U32 count, U32* visibleIndices);
+		} // namespace Detail
+
+	} // namespace Simd
+
+} // namespace Mapo
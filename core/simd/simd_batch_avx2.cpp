@@ -0,0 +1,308 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Built with AVX2 and FMA enabled. Only called when the CPU supports both.
+//
+// Nothing here may call inline functions shared with other files (glm and simd.h included): the linker could
+// keep a copy built for AVX2 and run it on any CPU. The arrays are therefore read as raw floats.
+
+#include "core/typedefs.h"
+#include "core/simd/cpu_features.h"
+
+#if MP_SIMD_X86
+
+	#include <cmath>
+	#include <immintrin.h>
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		namespace
+		{
+			// Matrix element at (column, row) of a column-major 4x4 matrix.
+			MP_FORCE_INLINE __m256 BroadcastElement(const F32* matrix, U32 column, U32 row)
+			{
+				return _mm256_broadcast_ss(matrix + column * 4 + row);
+			}
+
+			// Both 128-bit halves hold the same column.
+			MP_FORCE_INLINE __m256 BroadcastColumn(const F32* matrix, U32 column)
+			{
+				return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix + column * 4));
+			}
+
+			MP_FORCE_INLINE __m256 LoadHalves(const F32* low, const F32* high)
+			{
+				return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+			}
+
+			// Writes exactly three floats.
+			MP_FORCE_INLINE void Store3(__m128 value, F32* data)
+			{
+				_mm_storel_pi(reinterpret_cast<__m64*>(data), value);
+				_mm_store_ss(data + 2, _mm_movehl_ps(value, value));
+			}
+
+			void TransformPointScalar(const F32* m, const F32* point, F32* output)
+			{
+				const F32 x = point[0];
+				const F32 y = point[1];
+				const F32 z = point[2];
+
+				for (U32 row = 0; row < 3; ++row)
+				{
+					output[row] = m[row] * x + m[4 + row] * y + m[8 + row] * z + m[12 + row];
+				}
+			}
+
+			void TransformAABBScalar(const F32* m, const F32* box, F32* output)
+			{
+				F32 center[3];
+				F32 extent[3];
+
+				for (U32 axis = 0; axis < 3; ++axis)
+				{
+					center[axis] = (box[axis] + box[3 + axis]) * 0.5f;
+					extent[axis] = (box[3 + axis] - box[axis]) * 0.5f;
+				}
+
+				for (U32 row = 0; row < 3; ++row)
+				{
+					const F32 newCenter = m[row] * center[0] + m[4 + row] * center[1] + m[8 + row] * center[2] + m[12 + row];
+					const F32 newExtent = std::fabs(m[row]) * extent[0] + std::fabs(m[4 + row]) * extent[1] + std::fabs(m[8 + row]) * extent[2];
+
+					output[row] = newCenter - newExtent;
+					output[3 + row] = newCenter + newExtent;
+				}
+			}
+
+			bool IsBoundInsideScalar(const F32* planes, U32 planeCount, const F32* const* soa, U32 index)
+			{
+				for (U32 p = 0; p < planeCount; ++p)
+				{
+					const F32* plane = planes + p * 4;
+
+					const F32 distance = plane[0] * soa[0][index] + plane[1] * soa[1][index] + plane[2] * soa[2][index] + plane[3];
+					const F32 boxRadius = std::fabs(plane[0]) * soa[3][index] + std::fabs(plane[1]) * soa[4][index] + std::fabs(plane[2]) * soa[5][index];
+					const F32 radius = soa[6][index] < boxRadius ? soa[6][index] : boxRadius;
+
+					if (distance < -radius)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		} // namespace
+
+		namespace Detail
+		{
+			// Eight points per iteration. The 24 floats are loaded as six 128-bit rows, shuffled into x, y and z
+			// registers, transformed, and shuffled back.
+			void TransformPointsAVX2(const F32* matrix, const F32* points, F32* output, U32 count)
+			{
+				const __m256 m00 = BroadcastElement(matrix, 0, 0), m01 = BroadcastElement(matrix, 0, 1), m02 = BroadcastElement(matrix, 0, 2);
+				const __m256 m10 = BroadcastElement(matrix, 1, 0), m11 = BroadcastElement(matrix, 1, 1), m12 = BroadcastElement(matrix, 1, 2);
+				const __m256 m20 = BroadcastElement(matrix, 2, 0), m21 = BroadcastElement(matrix, 2, 1), m22 = BroadcastElement(matrix, 2, 2);
+				const __m256 m30 = BroadcastElement(matrix, 3, 0), m31 = BroadcastElement(matrix, 3, 1), m32 = BroadcastElement(matrix, 3, 2);
+
+				U32 i = 0;
+				for (; i + 8 <= count; i += 8)
+				{
+					const F32* in = points + i * 3;
+
+					// Low halves hold points 0-3, high halves points 4-7.
+					const __m256 m03 = LoadHalves(in, in + 12);
+					const __m256 m14 = LoadHalves(in + 4, in + 16);
+					const __m256 m25 = LoadHalves(in + 8, in + 20);
+
+					const __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+					const __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+					const __m256 x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+					const __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+					const __m256 z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+					const __m256 rx = _mm256_fmadd_ps(m20, z, _mm256_fmadd_ps(m10, y, _mm256_fmadd_ps(m00, x, m30)));
+					const __m256 ry = _mm256_fmadd_ps(m21, z, _mm256_fmadd_ps(m11, y, _mm256_fmadd_ps(m01, x, m31)));
+					const __m256 rz = _mm256_fmadd_ps(m22, z, _mm256_fmadd_ps(m12, y, _mm256_fmadd_ps(m02, x, m32)));
+
+					const __m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+					const __m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+					const __m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+
+					const __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+					const __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+					const __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+					F32* out = output + i * 3;
+					_mm_storeu_ps(out, _mm256_castps256_ps128(r03));
+					_mm_storeu_ps(out + 4, _mm256_castps256_ps128(r14));
+					_mm_storeu_ps(out + 8, _mm256_castps256_ps128(r25));
+					_mm_storeu_ps(out + 12, _mm256_extractf128_ps(r03, 1));
+					_mm_storeu_ps(out + 16, _mm256_extractf128_ps(r14, 1));
+					_mm_storeu_ps(out + 20, _mm256_extractf128_ps(r25, 1));
+				}
+
+				for (; i < count; ++i)
+				{
+					TransformPointScalar(matrix, points + i * 3, output + i * 3);
+				}
+			}
+
+			// Two boxes per iteration, one in each 128-bit half. The max corner is loaded with four floats, so
+			// the last box always takes the scalar path to stay inside the array.
+			void TransformAABBsAVX2(const F32* matrix, const F32* boxes, F32* output, U32 count)
+			{
+				const __m256 column0 = BroadcastColumn(matrix, 0);
+				const __m256 column1 = BroadcastColumn(matrix, 1);
+				const __m256 column2 = BroadcastColumn(matrix, 2);
+				const __m256 column3 = BroadcastColumn(matrix, 3);
+
+				const __m256 signMask = _mm256_set1_ps(-0.0f);
+				const __m256 absolute0 = _mm256_andnot_ps(signMask, column0);
+				const __m256 absolute1 = _mm256_andnot_ps(signMask, column1);
+				const __m256 absolute2 = _mm256_andnot_ps(signMask, column2);
+
+				const __m256 half = _mm256_set1_ps(0.5f);
+
+				U32 i = 0;
+				for (; i + 2 < count; i += 2)
+				{
+					const F32* in = boxes + i * 6;
+
+					const __m256 min = LoadHalves(in, in + 6);
+					const __m256 max = LoadHalves(in + 3, in + 9);
+
+					const __m256 center = _mm256_mul_ps(_mm256_add_ps(min, max), half);
+					const __m256 extent = _mm256_mul_ps(_mm256_sub_ps(max, min), half);
+
+					__m256 newCenter = _mm256_fmadd_ps(column0, _mm256_permute_ps(center, 0x00), column3);
+					newCenter = _mm256_fmadd_ps(column1, _mm256_permute_ps(center, 0x55), newCenter);
+					newCenter = _mm256_fmadd_ps(column2, _mm256_permute_ps(center, 0xAA), newCenter);
+
+					__m256 newExtent = _mm256_mul_ps(absolute0, _mm256_permute_ps(extent, 0x00));
+					newExtent = _mm256_fmadd_ps(absolute1, _mm256_permute_ps(extent, 0x55), newExtent);
+					newExtent = _mm256_fmadd_ps(absolute2, _mm256_permute_ps(extent, 0xAA), newExtent);
+
+					const __m256 newMin = _mm256_sub_ps(newCenter, newExtent);
+					const __m256 newMax = _mm256_add_ps(newCenter, newExtent);
+
+					// Each min store spills into max.x of the same box, which the max store then overwrites.
+					F32* out = output + i * 6;
+					_mm_storeu_ps(out, _mm256_castps256_ps128(newMin));
+					Store3(_mm256_castps256_ps128(newMax), out + 3);
+					_mm_storeu_ps(out + 6, _mm256_extractf128_ps(newMin, 1));
+					Store3(_mm256_extractf128_ps(newMax, 1), out + 9);
+				}
+
+				for (; i < count; ++i)
+				{
+					TransformAABBScalar(matrix, boxes + i * 6, output + i * 6);
+				}
+			}
+
+			// Two result columns per register: the columns of `a` are repeated in both halves and each half
+			// takes its weights from one column of `b`.
+			void MultiplyMatricesAVX2(const F32* a, const F32* b, F32* output, U32 count)
+			{
+				for (U32 i = 0; i < count; ++i)
+				{
+					const F32* left = a + i * 16;
+					const F32* right = b + i * 16;
+					F32*	   out = output + i * 16;
+
+					const __m256 column0 = BroadcastColumn(left, 0);
+					const __m256 column1 = BroadcastColumn(left, 1);
+					const __m256 column2 = BroadcastColumn(left, 2);
+					const __m256 column3 = BroadcastColumn(left, 3);
+
+					const __m256 right01 = _mm256_loadu_ps(right);
+					const __m256 right23 = _mm256_loadu_ps(right + 8);
+
+					__m256 result01 = _mm256_mul_ps(column0, _mm256_permute_ps(right01, 0x00));
+					result01 = _mm256_fmadd_ps(column1, _mm256_permute_ps(right01, 0x55), result01);
+					result01 = _mm256_fmadd_ps(column2, _mm256_permute_ps(right01, 0xAA), result01);
+					result01 = _mm256_fmadd_ps(column3, _mm256_permute_ps(right01, 0xFF), result01);
+
+					__m256 result23 = _mm256_mul_ps(column0, _mm256_permute_ps(right23, 0x00));
+					result23 = _mm256_fmadd_ps(column1, _mm256_permute_ps(right23, 0x55), result23);
+					result23 = _mm256_fmadd_ps(column2, _mm256_permute_ps(right23, 0xAA), result23);
+					result23 = _mm256_fmadd_ps(column3, _mm256_permute_ps(right23, 0xFF), result23);
+
+					_mm256_storeu_ps(out, result01);
+					_mm256_storeu_ps(out + 8, result23);
+				}
+			}
+
+			// Eight bounds per iteration, tested against one plane at a time.
+			U32 CullBoundsAVX2(const F32* planes, U32 planeCount, const F32* const* soa, U32 count, U32* visibleIndices)
+			{
+				static constexpr U32 MAX_PLANES = 8; // MAX_CULL_PLANES, checked by the caller
+
+				const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+				__m256 normalX[MAX_PLANES], normalY[MAX_PLANES], normalZ[MAX_PLANES], offset[MAX_PLANES];
+				__m256 absoluteX[MAX_PLANES], absoluteY[MAX_PLANES], absoluteZ[MAX_PLANES];
+
+				for (U32 p = 0; p < planeCount; ++p)
+				{
+					normalX[p] = _mm256_broadcast_ss(planes + p * 4);
+					normalY[p] = _mm256_broadcast_ss(planes + p * 4 + 1);
+					normalZ[p] = _mm256_broadcast_ss(planes + p * 4 + 2);
+					offset[p] = _mm256_broadcast_ss(planes + p * 4 + 3);
+					absoluteX[p] = _mm256_andnot_ps(signMask, normalX[p]);
+					absoluteY[p] = _mm256_andnot_ps(signMask, normalY[p]);
+					absoluteZ[p] = _mm256_andnot_ps(signMask, normalZ[p]);
+				}
+
+				U32 visibleCount = 0;
+				U32 i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 centerX = _mm256_loadu_ps(soa[0] + i);
+					const __m256 centerY = _mm256_loadu_ps(soa[1] + i);
+					const __m256 centerZ = _mm256_loadu_ps(soa[2] + i);
+					const __m256 extentX = _mm256_loadu_ps(soa[3] + i);
+					const __m256 extentY = _mm256_loadu_ps(soa[4] + i);
+					const __m256 extentZ = _mm256_loadu_ps(soa[5] + i);
+					const __m256 radius = _mm256_loadu_ps(soa[6] + i);
+
+					__m256 outside = _mm256_setzero_ps();
+
+					for (U32 p = 0; p < planeCount; ++p)
+					{
+						const __m256 distance = _mm256_fmadd_ps(normalZ[p], centerZ, _mm256_fmadd_ps(normalY[p], centerY, _mm256_fmadd_ps(normalX[p], centerX, offset[p])));
+						const __m256 boxRadius = _mm256_fmadd_ps(absoluteZ[p], extentZ, _mm256_fmadd_ps(absoluteY[p], extentY, _mm256_mul_ps(absoluteX[p], extentX)));
+						const __m256 negativeRadius = _mm256_xor_ps(_mm256_min_ps(radius, boxRadius), signMask);
+
+						outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+					}
+
+					// Branchless append: every lane is written, only visible ones advance the count.
+					const U32 visibleMask = ~static_cast<U32>(_mm256_movemask_ps(outside));
+					for (U32 lane = 0; lane < 8; ++lane)
+					{
+						visibleIndices[visibleCount] = i + lane;
+						visibleCount += (visibleMask >> lane) & 1;
+					}
+				}
+
+				for (; i < count; ++i)
+				{
+					visibleIndices[visibleCount] = i;
+					visibleCount += IsBoundInsideScalar(planes, planeCount, soa, i) ? 1 : 0;
+				}
+
+				return visibleCount;
+			}
+		} // namespace Detail
+
+	} // namespace Simd
+
+} // namespace Mapo
+
+#endif
@@ -0,0 +1,86 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/simd/simd.h"
+#include "core/simd/simd_sincos.h"
+
+// Vectorized approximations. The error bounds below are measured against the double precision results of
+// the C library over the stated ranges, and checked again by the Simd_* benchmarks in mapo-bench.
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		namespace Detail
+		{
+			struct Float4Ops
+			{
+				using V = float4;
+
+				static float4 Set1(F32 value) { return Splat(value); }
+				static float4 Sub(float4 a, float4 b) { return a - b; }
+				static float4 Mul(float4 a, float4 b) { return a * b; }
+				static float4 MulAdd(float4 a, float4 b, float4 c) { return Simd::MulAdd(a, b, c); }
+				static float4 Floor(float4 a) { return Simd::Floor(a); }
+				static float4 Abs(float4 a) { return Simd::Abs(a); }
+				static float4 CmpLess(float4 a, float4 b) { return Simd::CmpLess(a, b); }
+				static float4 Select(float4 mask, float4 a, float4 b) { return Simd::Select(mask, a, b); }
+			};
+		} // namespace Detail
+
+		// Sine and cosine of angles in radians. Absolute error below 1.5e-7 for |x| <= 8192. Larger angles lose
+		// precision in the range reduction (about 1e-6 at 1e5), use MathOp::Sin / Cos for those.
+		MP_FORCE_INLINE void SinCos(float4 x, float4& outSin, float4& outCos)
+		{
+			Detail::SinCosKernel<Detail::Float4Ops>(x, outSin, outCos);
+		}
+
+		MP_FORCE_INLINE float4 Sin(float4 x)
+		{
+			float4 sinValue, cosValue;
+			SinCos(x, sinValue, cosValue);
+			return sinValue;
+		}
+
+		MP_FORCE_INLINE float4 Cos(float4 x)
+		{
+			float4 sinValue, cosValue;
+			SinCos(x, sinValue, cosValue);
+			return cosValue;
+		}
+
+		// Hardware estimate of 1 / sqrt(x). Relative error below 3.7e-4 (x86, documented by Intel) or 3e-5
+		// (NEON, after one refinement step). Valid for positive finite x.
+		MP_FORCE_INLINE float4 RsqrtEstimate(float4 x)
+		{
+#if MP_SIMD_SSE
+			return { _mm_rsqrt_ps(x.v) };
+#elif MP_SIMD_NEON
+			const float32x4_t estimate = vrsqrteq_f32(x.v);
+			return { vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(x.v, estimate), estimate)) };
+#else
+			return Splat(1.0f) / Sqrt(x);
+#endif
+		}
+
+		// 1 / sqrt(x) refined with one Newton-Raphson step. Relative error below 3e-7. Valid for positive
+		// finite x; zero gives NaN rather than infinity.
+		MP_FORCE_INLINE float4 Rsqrt(float4 x)
+		{
+#if MP_SIMD_SSE || MP_SIMD_NEON
+			const float4 estimate = RsqrtEstimate(x);
+
+			// e * (1.5 - 0.5 * x * e * e)
+			const float4 halfX = x * Splat(0.5f);
+			return estimate * MulAdd(-(halfX * estimate), estimate, Splat(1.5f));
+#else
+			return Splat(1.0f) / Sqrt(x);
+#endif
+		}
+
+	} // namespace Simd
+
+} // namespace Mapo
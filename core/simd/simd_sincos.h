@@ -0,0 +1,82 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// The sine / cosine kernel behind Simd::SinCos and the batched transform kernels, written once over an `Ops`
+// struct that wraps one register type:
+//
+//   using V;
+//   Set1, Sub, Mul, MulAdd (a * b + c), Floor, Abs, CmpLess, Select (mask ? a : b)
+//
+// Only core/typedefs.h is included, so source files built with their own instruction set flags can use it.
+// Their Ops structs live in anonymous namespaces, which keeps every instantiation local to its file.
+
+namespace Mapo
+{
+	namespace Simd
+	{
+		namespace Detail
+		{
+			// Cephes single precision constants. Pi / 2 is split in three parts so the quadrant reduction stays
+			// exact for |x| <= 8192.
+			constexpr F32 TWO_OVER_PI = 0.636619772367581343f;
+			constexpr F32 PI_OVER_2_PART1 = 1.5703125f;
+			constexpr F32 PI_OVER_2_PART2 = 4.837512969970703125e-4f;
+			constexpr F32 PI_OVER_2_PART3 = 7.54978995489188216e-8f;
+
+			constexpr F32 SIN_C0 = -1.9515295891e-4f;
+			constexpr F32 SIN_C1 = 8.3321608736e-3f;
+			constexpr F32 SIN_C2 = -1.6666654611e-1f;
+
+			constexpr F32 COS_C0 = 2.443315711809948e-5f;
+			constexpr F32 COS_C1 = -1.388731625493765e-3f;
+			constexpr F32 COS_C2 = 4.166664568298827e-2f;
+
+			// Sine and cosine of angles in radians. Absolute error below 1.5e-7 for |x| <= 8192.
+			template <typename Ops>
+			MP_FORCE_INLINE void SinCosKernel(typename Ops::V x, typename Ops::V& outSin, typename Ops::V& outCos)
+			{
+				using V = typename Ops::V;
+
+				// Quadrant j, and the remainder r in [-pi / 4, pi / 4].
+				const V j = Ops::Floor(Ops::MulAdd(x, Ops::Set1(TWO_OVER_PI), Ops::Set1(0.5f)));
+
+				V r = Ops::MulAdd(j, Ops::Set1(-PI_OVER_2_PART1), x);
+				r = Ops::MulAdd(j, Ops::Set1(-PI_OVER_2_PART2), r);
+				r = Ops::MulAdd(j, Ops::Set1(-PI_OVER_2_PART3), r);
+
+				const V z = Ops::Mul(r, r);
+
+				V sinPoly = Ops::MulAdd(Ops::Set1(SIN_C0), z, Ops::Set1(SIN_C1));
+				sinPoly = Ops::MulAdd(sinPoly, z, Ops::Set1(SIN_C2));
+				sinPoly = Ops::MulAdd(Ops::Mul(sinPoly, z), r, r);
+
+				V cosPoly = Ops::MulAdd(Ops::Set1(COS_C0), z, Ops::Set1(COS_C1));
+				cosPoly = Ops::MulAdd(cosPoly, z, Ops::Set1(COS_C2));
+				cosPoly = Ops::MulAdd(Ops::Mul(cosPoly, z), z, Ops::MulAdd(z, Ops::Set1(-0.5f), Ops::Set1(1.0f)));
+
+				// Quadrant modulo 4: odd quadrants swap the polynomials, quadrants 2 and 3 negate the sine, and
+				// quadrants 1 and 2 negate the cosine.
+				const V quadrant = Ops::MulAdd(Ops::Floor(Ops::Mul(j, Ops::Set1(0.25f))), Ops::Set1(-4.0f), j);
+				const V odd = Ops::MulAdd(Ops::Floor(Ops::Mul(quadrant, Ops::Set1(0.5f))), Ops::Set1(-2.0f), quadrant);
+
+				const V swap = Ops::CmpLess(Ops::Set1(0.5f), odd);
+				const V sinValue = Ops::Select(swap, cosPoly, sinPoly);
+				const V cosValue = Ops::Select(swap, sinPoly, cosPoly);
+
+				const V sinNegative = Ops::CmpLess(Ops::Set1(1.5f), quadrant);
+				const V cosNegative = Ops::CmpLess(Ops::Abs(Ops::Sub(quadrant, Ops::Set1(1.5f))), Ops::Set1(1.0f));
+
+				const V zero = Ops::Set1(0.0f);
+				outSin = Ops::Select(sinNegative, Ops::Sub(zero, sinValue), sinValue);
+				outCos = Ops::Select(cosNegative, Ops::Sub(zero, cosValue), cosValue);
+			}
+		} // namespace Detail
+
+	} // namespace Simd
+
+} // namespace Mapo
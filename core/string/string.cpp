@@ -6,6 +6,7 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
 
 #include "core/uassert.h"
 
@@ -31,5 +32,18 @@ namespace Mapo
 			return buffer;
 		}
 
+		bool ParseOption(const char* arg, const char* name, String& value)
+		{
+			const size_t length = strlen(name);
+
+			if (strncmp(arg, name, length) == 0 && arg[length] == '=')
+			{
+				value = arg + length + 1;
+				return true;
+			}
+
+			return false;
+		}
+
 	} // namespace StringOp
 } // namespace Mapo
@@ -14,6 +14,9 @@ namespace Mapo
 	{
 		String Format(const char* fmt, ...);
 
+		// Matches a `--name=value` command-line argument and stores the part after '='.
+		bool ParseOption(const char* arg, const char* name, String& value);
+
 	} // namespace StringOp
 
 } // namespace Mapo
@@ -15,8 +15,8 @@ namespace Mapo
 	public:
 		using Seconds = std::ratio<1>;
 		using Milliseconds = std::ratio<1, 1000>;
-		using Microseconds = std::ratio<1, 10000000>;
-		using Nanoseconds = std::ratio<1, 100000000000>;
+		using Microseconds = std::ratio<1, 1000000>;
+		using Nanoseconds = std::ratio<1, 1000000000>;
 
 		using Clock = std::chrono::steady_clock;
 		using DefaultResolution = Seconds;
@@ -36,7 +36,7 @@ namespace Mapo
 			}
 
 			m_running = false;
-			auto duration = std::chrono::duration_cast<F64, T>(Clock::now() - m_startTime);
+			auto duration = std::chrono::duration<F64, T>(Clock::now() - m_startTime);
 			m_startTime = Clock::now();
 
 			return duration.count();
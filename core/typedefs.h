@@ -55,6 +55,9 @@ namespace Mapo
 #define BIT(x) (1 << x)
 #define STR(x) #x
 
+#define MP_CONCAT_IMPL(a, b) a##b
+#define MP_CONCAT(a, b) MP_CONCAT_IMPL(a, b)
+
 // Inline macros
 #ifndef MP_ALWAYS_INLINE
 	#if defined(__GNUC__)
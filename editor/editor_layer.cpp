@@ -8,6 +8,8 @@
 #include "engine/window.h"
 #include "engine/model.h"
 
+#include "engine/benchmark/benchmark.h"
+
 #include "engine/scene/scene.h"
 #include "engine/scene/game_object.h"
 #include "engine/scene/component.h"
@@ -26,6 +28,7 @@
 
 #include "engine/system/simple_render_system.h"
 #include "engine/system/point_light_system.h"
+#include "engine/system/rainbow_system.h"
 
 #include <imgui/imgui.h>
 
@@ -58,7 +61,6 @@ namespace Mapo
 	void EditorLayer::OnAttach()
 	{
 		Init();
-		CreateScene();
 	}
 
 	void EditorLayer::Init()
@@ -97,9 +99,32 @@ namespace Mapo
 				.Build(s_globalDescriptorSets[i]);
 		}
 
-		// Set up systems.
-		m_renderSystem = MakeUnique<SimpleRenderSystem>(renderer.GetRenderPass(), globalSetLayout->GetDescriptorSetLayout());
-		m_pointLightSystem = MakeUnique<PointLightSystem>(renderer.GetRenderPass(), globalSetLayout->GetDescriptorSetLayout());
+		// Set up systems. Pipeline creation (shader file reads, shader modules and pipeline compilation)
+		// runs as jobs while the scene models are loaded.
+		VkRenderPass		  renderPass = renderer.GetRenderPass();
+		VkDescriptorSetLayout setLayout = globalSetLayout->GetDescriptorSetLayout();
+
+		JobCounter systemCounter{};
+
+		UniqueRef<SimpleRenderSystem>* renderSystem = &m_renderSystem;
+		JobSystem::Run(
+			[renderSystem, renderPass, setLayout]() {
+				MP_STARTUP_PHASE("SimpleRenderSystem");
+				*renderSystem = MakeUnique<SimpleRenderSystem>(renderPass, setLayout);
+			},
+			&systemCounter);
+
+		UniqueRef<PointLightSystem>* pointLightSystem = &m_pointLightSystem;
+		JobSystem::Run(
+			[pointLightSystem, renderPass, setLayout]() {
+				MP_STARTUP_PHASE("PointLightSystem");
+				*pointLightSystem = MakeUnique<PointLightSystem>(renderPass, setLayout);
+			},
+			&systemCounter);
+
+		CreateScene();
+
+		JobSystem::Wait(systemCounter);
 
 		// Default gizmo type.
 		m_gizmoType = ImGuizmo::OPERATION::TRANSLATE;
@@ -121,11 +146,6 @@ namespace Mapo
 
 	void EditorLayer::OnUpdate(Timestep dt)
 	{
-		Renderer& renderer = RenderContext::GetRenderer();
-
-		// Retrieve all game objects before the loop. // GameObject is a lightweight class that just contains entity ids.
-		std::vector<GameObject> sceneGameObjects = m_scene->GetGameObjects();
-
 		// / Resize
 		Window& window = Application::Get().GetWindow();
 		if (window.WasFramebufferResized())
@@ -134,24 +154,25 @@ namespace Mapo
 		}
 
 		// Update
-		m_camera.OnUpdate(dt);
+		if (Benchmark* benchmark = Application::Get().GetBenchmark())
+		{
+			// Benchmarks fly the camera along a scripted path instead of reading input.
+			CameraKeyframe pose = benchmark->GetCameraPose();
+			m_camera.SetPose(pose.position, MathOp::Radians(pose.pitch), MathOp::Radians(pose.yaw));
+		}
+		else
+		{
+			m_camera.OnUpdate(dt);
+		}
+
 		m_scene->OnUpdateEditor(dt, m_camera);
 
 		/////////////////////////////////////////////////////////////////////////////////
 
 		// TODO: The below code should be moved to the scene class?
 
-		// Prepare frame info
-		U32 frameIndex = renderer.GetCurrentFrameIndex();
-
-		FrameInfo frameInfo{
-			.frameIndex = frameIndex,
-			.frameTime = dt,
-			.commandBuffer = renderer.GetCurrentCommandBuffer(),
-			.globalDescriptorSet = s_globalDescriptorSets[frameIndex],
-			.camera = m_camera,
-			.gameObjects = sceneGameObjects
-		};
+		m_frameTime = dt;
+		FrameInfo frameInfo = CreateFrameInfo();
 
 		// Update
 		GlobalUbo ubo{};
@@ -162,25 +183,73 @@ namespace Mapo
 		s_uboBuffers[frameInfo.frameIndex]->WriteToBuffer(&ubo);
 		s_uboBuffers[frameInfo.frameIndex]->Flush();
 
+		// GPU culling runs here, before the render pass begins. Frames it cannot handle are culled by the scene.
+		m_renderSystem->PrepareGameObjects(frameInfo);
+
+		if (!m_renderSystem->IsGpuCulled())
+		{
+			m_scene->CullRenderProxies(m_camera);
+		}
+	}
+
+	void EditorLayer::OnRender()
+	{
+		FrameInfo frameInfo = CreateFrameInfo();
+
 		m_renderSystem->RenderGameObjects(frameInfo);
 		m_pointLightSystem->Render(frameInfo);
 	}
 
+	FrameInfo EditorLayer::CreateFrameInfo()
+	{
+		Renderer& renderer = RenderContext::GetRenderer();
+		U32		  frameIndex = renderer.GetCurrentFrameIndex();
+
+		return FrameInfo{
+			.frameIndex = frameIndex,
+			.frameTime = m_frameTime,
+			.commandBuffer = renderer.GetCurrentCommandBuffer(),
+			.globalDescriptorSet = s_globalDescriptorSets[frameIndex],
+			.camera = m_camera,
+			.renderProxies = m_scene->GetRenderProxies(),
+			.renderProxyBounds = m_scene->GetRenderProxyBounds(),
+			.changedRenderProxies = m_scene->GetChangedRenderProxies(),
+			.visibleRenderProxies = m_scene->GetVisibleRenderProxies(),
+			.culledRenderProxyCount = m_scene->GetCulledRenderProxyCount()
+		};
+	}
+
 	void EditorLayer::CreateScene()
 	{
 		m_scene = MakeRef<Scene>();
 		m_scenePanel.SetContext(m_scene);
+		m_profilerPanel.SetContext(m_scene);
+
+		// Systems (toggled in the profiler panel)
+		m_scene->GetSystemScheduler().AddSystem<RainbowSystem>(0.5f).SetEnabled(false);
 
 		// Model
-		Ref<Model> bunnyModel = Model::CreateModelFromFile("assets/models/bunny.obj");
-		Ref<Model> smoothModel = Model::CreateModelFromFile("assets/models/smooth_vase.obj");
-		Ref<Model> flatModel = Model::CreateModelFromFile("assets/models/flat_vase.obj");
-		Ref<Model> vikingRoomModel = Model::CreateModelFromFile("assets/models/viking_room/viking_room.obj");
-		Ref<Model> quadModel = Model::CreateModelFromFile("assets/models/quad.obj");
-		Ref<Model> coloredCube = Model::CreateModelFromFile("assets/models/colored_cube.obj");
-		Ref<Model> cubeModel = Model::CreateModelFromFile("assets/models/cube.obj");
-		Ref<Model> catModel = Model::CreateModelFromFile("assets/models/cat/cat.obj");
-		Ref<Model> fatCatModel = Model::CreateModelFromFile("assets/models/fat_cat/fat_cat.obj");
+		std::vector<Ref<Model>> models = Model::CreateModelsFromFiles({
+			"assets/models/bunny.obj",
+			"assets/models/smooth_vase.obj",
+			"assets/models/flat_vase.obj",
+			"assets/models/viking_room/viking_room.obj",
+			"assets/models/quad.obj",
+			"assets/models/colored_cube.obj",
+			"assets/models/cube.obj",
+			"assets/models/cat/cat.obj",
+			"assets/models/fat_cat/fat_cat.obj",
+		});
+
+		Ref<Model> bunnyModel = models[0];
+		Ref<Model> smoothModel = models[1];
+		Ref<Model> flatModel = models[2];
+		Ref<Model> vikingRoomModel = models[3];
+		Ref<Model> quadModel = models[4];
+		Ref<Model> coloredCube = models[5];
+		Ref<Model> cubeModel = models[6];
+		Ref<Model> catModel = models[7];
+		Ref<Model> fatCatModel = models[8];
 		// Ref<Model> cubeModel = Model::CreateCubeModel();
 
 		// Plane
@@ -222,6 +291,7 @@ namespace Mapo
 		auto& roomTransform = roomObject.GetComponent<TransformComponent>();
 		roomTransform.translation = { 2.0f, -0.9f, -1.0f };
 		roomTransform.rotation = { -90, -180, 3.0f };
+		roomObject.GetComponent<MeshComponent>().occluder = true;
 
 		// Cat
 		GameObject catObject = m_scene->CreateGameObject("Cat V1");
@@ -250,6 +320,7 @@ namespace Mapo
 		m_scenePanel.OnImGuiRender(m_camera);
 		m_infoPanel.OnImGuiRender();
 		m_logPanel.OnImGuiRender();
+		m_profilerPanel.OnImGuiRender();
 
 		OnGizmoUpdate();
 	}
@@ -278,8 +349,10 @@ namespace Mapo
 			F32	 snapValue = m_gizmoType == ImGuizmo::OPERATION::ROTATE ? 45.0f : 0.5f;
 			F32	 snapValues[3]{ snapValue, snapValue, snapValue };
 
+			// The gizmo works in world space; the transform is local to the parent.
 			auto&	transform = selected.GetComponent<TransformComponent>();
-			Matrix4 transformMatrix = transform.GetTransformMatrix();
+			Matrix4 parentMatrix = m_scene->GetParentWorldMatrix(selected);
+			Matrix4 transformMatrix = parentMatrix * transform.GetTransformMatrix();
 
 			Matrix4 projectionMatrix = m_camera.GetProjectionMatrix();
 			projectionMatrix[1][1] *= -1; // flip back to the OpenGL version
@@ -303,7 +376,7 @@ namespace Mapo
 				Vector3 newTranslation{};
 				Vector3 newRotation{};
 				Vector3 newScale{};
-				MathOp::DecomposeTransform(transformMatrix, newTranslation, newRotation, newScale);
+				MathOp::DecomposeTransform(MathOp::Inverse(parentMatrix) * transformMatrix, newTranslation, newRotation, newScale);
 				Vector3 rotationDelta = newRotation - transform.rotation; // avoid gimbal lock
 
 				transform.translation = newTranslation;
@@ -425,8 +498,19 @@ namespace Mapo
 
 	bool EditorLayer::OnMouseButtonPressed(MouseButtonPressedEvent& event)
 	{
-		// TODO: Handles entity selection.
-		return false;
+		// Alt (Cmd) + left button orbits the camera, and clicks on the gizmo belong to the gizmo.
+		bool modifier = Input::IsKeyPressed(Key::LeftAlt) || Input::IsKeyPressed(Key::LeftSuper);
+
+		if (event.GetMouseButton() != Mouse::ButtonLeft || modifier || ImGuizmo::IsOver())
+		{
+			return false;
+		}
+
+		// Clicking empty space clears the selection.
+		Ray ray = m_camera.ScreenPointToRay(Input::GetMousePosition());
+		m_scenePanel.SetSelection(m_scene->Raycast(ray, m_camera.GetFarClip()));
+
+		return true;
 	}
 
 	/////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #include "editor/panel/scene_panel.h"
 #include "editor/panel/info_panel.h"
 #include "editor/panel/log_panel.h"
+#include "editor/panel/profiler_panel.h"
 
 class ImVec2;
 
@@ -23,6 +24,7 @@ namespace Mapo
 	class PointLightSystem;
 	class Buffer;
 	class Scene;
+	class FrameInfo;
 
 	class EditorLayer : public Layer
 	{
@@ -35,6 +37,7 @@ namespace Mapo
 		virtual void OnDetach() override;
 
 		virtual void OnUpdate(Timestep dt) override;
+		virtual void OnRender() override;
 		virtual void OnImGuiRender() override;
 		virtual void OnEvent(Event& event) override;
 
@@ -42,6 +45,8 @@ namespace Mapo
 		void Init();
 		void CreateScene();
 
+		FrameInfo CreateFrameInfo();
+
 		// Event callbacks
 		bool OnKeyPressed(KeyPressedEvent& event);
 		bool OnMouseButtonPressed(MouseButtonPressedEvent& event);
@@ -64,6 +69,7 @@ namespace Mapo
 		Ref<Scene> m_scene;
 
 		EditorCamera m_camera;
+		F32			 m_frameTime = 0.0f;
 
 		int m_gizmoType{ INVALID_GIZMO_TYPE };
 
@@ -75,6 +81,7 @@ namespace Mapo
 		ScenePanel m_scenePanel;
 		InfoPanel  m_infoPanel;
 		LogPanel m_logPanel;
+		ProfilerPanel m_profilerPanel;
 	};
 
 } // namespace Mapo
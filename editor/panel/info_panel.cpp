@@ -43,6 +43,10 @@ namespace Mapo
 
 		ImGui::Text("#Images: %u | #Frames: %u", renderer.GetImageCount(), RenderContext::GetMaxFramesInFlight());
 
+		const RenderStats& stats = renderer.GetStats();
+		ImGui::Text("Draw calls: %u | Triangles: %u", stats.drawCalls, stats.triangleCount);
+		ImGui::Text("Visible: %u | Culled: %u", stats.visibleObjectCount, stats.culledObjectCount);
+
 		// ImGui demo
 		static bool showDemo = false;
 		ImGui::Checkbox("ImGui Demo", &showDemo);
@@ -0,0 +1,152 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "profiler_panel.h"
+
+#include "engine/profiling/sampling_profiler.h"
+#include "engine/scene/scene.h"
+
+#include <imgui/imgui.h>
+
+namespace Mapo
+{
+	ProfilerPanel::ProfilerPanel()
+		: Panel("Profiler")
+	{
+	}
+
+	void ProfilerPanel::OnImGuiRender()
+	{
+		ImGui::SetNextWindowSize(ImVec2(520.0f, 360.0f), ImGuiCond_FirstUseEver);
+		ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+
+		ImGui::Begin(GetPanelName().c_str());
+
+		if (ImGui::CollapsingHeader("Systems", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			DrawSystemTimings();
+		}
+
+		if (ImGui::CollapsingHeader("Sampling Profiler", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			DrawSamplingProfiler();
+		}
+
+		ImGui::End(); // root
+	}
+
+	void ProfilerPanel::DrawSystemTimings()
+	{
+		if (!m_scene)
+		{
+			return;
+		}
+
+		const SystemScheduler& scheduler = m_scene->GetSystemScheduler();
+
+		ImGui::Text("Job threads: %u", JobSystem::GetThreadCount());
+
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+
+		if (ImGui::BeginTable("##SystemTimings", 4, tableFlags))
+		{
+			ImGui::TableSetupColumn("System", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+			ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+			ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+			ImGui::TableHeadersRow();
+
+			for (size_t i = 0; i < scheduler.GetSystems().size(); ++i)
+			{
+				SceneSystem&		system = *scheduler.GetSystems()[i];
+				const SystemTiming& timing = scheduler.GetTimings()[i];
+
+				ImGui::TableNextRow();
+
+				ImGui::TableNextColumn();
+				ImGui::PushID(static_cast<int>(i));
+				ImGui::Checkbox(system.GetName().c_str(), &system.GetEnabled());
+				ImGui::PopID();
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", timing.lastMs);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", timing.averageMs);
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", timing.threadIndex);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+
+	void ProfilerPanel::DrawSamplingProfiler()
+	{
+		if (!SamplingProfiler::IsSupported())
+		{
+			ImGui::TextDisabled("The sampling profiler is not supported on this platform.");
+			return;
+		}
+
+		if (SamplingProfiler::IsRunning())
+		{
+			if (ImGui::Button("Stop"))
+			{
+				SamplingProfiler::Stop();
+			}
+		}
+		else if (ImGui::Button("Start"))
+		{
+			SamplingProfiler::Start();
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Reset"))
+		{
+			SamplingProfiler::Reset();
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Write Folded Stacks"))
+		{
+			SamplingProfiler::WriteFoldedStacks("mapo_profile.folded");
+		}
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Sort by Self", &m_sortBySelf);
+
+		const U64 sampleCount = SamplingProfiler::GetSampleCount();
+		ImGui::Text("Samples: %llu | Dropped: %llu", static_cast<unsigned long long>(sampleCount),
+			static_cast<unsigned long long>(SamplingProfiler::GetDroppedSampleCount()));
+
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+
+		if (sampleCount > 0 && ImGui::BeginTable("##HotFunctions", 3, tableFlags))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Self %", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+			ImGui::TableSetupColumn("Total %", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+			ImGui::TableSetupColumn("Function", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableHeadersRow();
+
+			for (const HotFunction& function : SamplingProfiler::GetTopFunctions(TOP_FUNCTION_COUNT, m_sortBySelf))
+			{
+				ImGui::TableNextRow();
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%5.1f", 100.0 * static_cast<F64>(function.selfSamples) / static_cast<F64>(sampleCount));
+
+				ImGui::TableNextColumn();
+				ImGui::Text("%5.1f", 100.0 * static_cast<F64>(function.totalSamples) / static_cast<F64>(sampleCount));
+
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(function.name.c_str());
+			}
+
+			ImGui::EndTable();
+		}
+	}
+} // namespace Mapo
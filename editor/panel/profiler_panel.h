@@ -0,0 +1,35 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "editor/panel/panel.h"
+
+namespace Mapo
+{
+	class Scene;
+
+	class ProfilerPanel : public Panel
+	{
+	public:
+		virtual ~ProfilerPanel() = default;
+
+		ProfilerPanel();
+
+		void SetContext(const Ref<Scene>& scene) { m_scene = scene; }
+
+		void OnImGuiRender();
+
+	private:
+		void DrawSamplingProfiler();
+		void DrawSystemTimings();
+
+	private:
+		static constexpr U32 TOP_FUNCTION_COUNT = 20;
+
+		Ref<Scene> m_scene;
+
+		bool m_sortBySelf = true;
+	};
+} // namespace Mapo
@@ -89,6 +89,31 @@ namespace Mapo
 		}
 
 		ImGui::ColorEdit3("Clear color", GLM_PTR(renderer.ClearColor()));
+		ImGui::Checkbox("Occlusion culling", &renderer.OcclusionCulling());
+		ImGui::Checkbox("Software occlusion culling", &m_scene->SoftwareOcclusionCulling());
+		ImGui::Checkbox("PVS culling", &m_scene->PotentiallyVisibleSetCulling());
+
+		if (ImGui::Button("Bake PVS"))
+		{
+			m_scene->BakePotentiallyVisibleSet();
+		}
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Clear PVS"))
+		{
+			m_scene->ClearPotentiallyVisibleSet();
+		}
+
+		if (const PotentiallyVisibleSet& pvs = m_scene->GetPotentiallyVisibleSet(); pvs.IsBaked())
+		{
+			ImGui::Text("PVS: %u cells, %u objects, %zu bytes", pvs.GetCellCount(), pvs.GetObjectCount(), pvs.GetMemorySize());
+
+			if (m_scene->IsPotentiallyVisibleSetStale())
+			{
+				ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "PVS is stale, bake again");
+			}
+		}
 
 		// Game Objects
 		std::vector<GameObject> gameObjectList = m_scene->GetGameObjects();
@@ -272,6 +297,17 @@ namespace Mapo
 			ImGui::DragFloat3("Scale", GLM_PTR(component.scale), 1.0f, 0.0f, 0.0f, "%.2f");
 		});
 
+		DrawComponent<HierarchyComponent>(gameObject, [this, &gameObject](auto& component) {
+			GameObject parent = m_scene->GetParent(gameObject);
+			ImGui::Text("Parent: %s", parent ? parent.GetName().c_str() : "None");
+			ImGui::Text("Depth: %u", component.depth);
+
+			if (parent && ImGui::Button("Detach"))
+			{
+				m_scene->SetParent(gameObject, GameObject{});
+			}
+		});
+
 		DrawComponent<MeshComponent>(gameObject, [](auto& component) {
 			if (component.model)
 			{
@@ -282,6 +318,7 @@ namespace Mapo
 				// ImGui::LabelText("Model name: %s", component.model->GetModelName().c_str());
 				ImGui::Text("Vertex count: %u", component.model->GetVertexCount());
 				ImGui::Text("Index count: %u", component.model->GetIndexCount());
+				ImGui::Checkbox("Occluder", &component.occluder);
 			}
 			else
 			{
@@ -26,6 +26,7 @@ namespace Mapo
 		void OnImGuiRender(EditorCamera& camera);
 
 		GameObject& GetSelection() { return m_selectedGameObject; };
+		void		SetSelection(GameObject gameObject) { m_selectedGameObject = gameObject; }
 
 	private:
 		// Scene Hierarchy
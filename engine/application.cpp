@@ -8,6 +8,10 @@
 #include "engine/renderer/device.h"
 #include "engine/renderer/renderer.h"
 
+#include "engine/benchmark/benchmark.h"
+#include "engine/input/input_recorder.h"
+#include "engine/profiling/sampling_profiler.h"
+
 namespace Mapo
 {
 	Application* Application::s_appInstance = nullptr;
@@ -18,13 +22,49 @@ namespace Mapo
 		// Self assign.
 		s_appInstance = this;
 
+		// Started first so that startup asset loads are recorded too.
+		FlightRecorder::Init(FlightRecorderSettings::Parse(args));
+		Metrics::Init(MetricsSettings::Parse(args));
+
+		SamplingProfilerSettings samplingProfilerSettings = SamplingProfilerSettings::Parse(args);
+
+		if (samplingProfilerSettings.enabled && SamplingProfiler::Start(samplingProfilerSettings.frequencyHz))
+		{
+			m_samplingProfilerOutput = samplingProfilerSettings.foldedOutputPath;
+		}
+
+		// Workers register with the sampling profiler so that it sees every thread that runs engine code.
+		JobSystemSettings jobSystemSettings = JobSystemSettings::Parse(args);
+		jobSystemSettings.onWorkerStart = [](U32 threadIndex) {
+			SamplingProfiler::RegisterCurrentThread(("Worker " + std::to_string(threadIndex)).c_str());
+		};
+		jobSystemSettings.onWorkerStop = []([[maybe_unused]] U32 threadIndex) { SamplingProfiler::UnregisterCurrentThread(); };
+		JobSystem::Init(jobSystemSettings);
+
+		BenchmarkSettings benchmarkSettings = BenchmarkSettings::Parse(args);
+
 		// Create a window and the render context.
-		m_window = Window::Create(WindowProps(name, WIDTH, HEIGHT));
-		m_window->SetEventCallback(MP_BIND_EVENT_FN(Application::OnEvent));
-		// Alternatively you can just pass in the application ptr.
+		{
+			MP_STARTUP_PHASE("Window::Create");
+			m_window = Window::Create(WindowProps(name, WIDTH, HEIGHT, benchmarkSettings.headless));
+			m_window->SetEventCallback(MP_BIND_EVENT_FN(Application::OnEvent));
+			// Alternatively you can just pass in the application ptr.
+		}
 
 		RenderContext::Init();
 
+		if (benchmarkSettings.enabled)
+		{
+			m_benchmark = MakeUnique<Benchmark>(benchmarkSettings);
+		}
+
+		InputRecorderSettings inputRecorderSettings = InputRecorderSettings::Parse(args);
+
+		if (inputRecorderSettings.IsEnabled())
+		{
+			m_inputRecorder = MakeUnique<InputRecorder>(inputRecorderSettings);
+		}
+
 		// Layers
 		m_layerStack = MP_NEW(LayerStack);
 
@@ -36,7 +76,22 @@ namespace Mapo
 	{
 		MP_DELETE(m_layerStack);
 
+		JobSystem::Shutdown();
+
+		m_benchmark.reset();
+		m_inputRecorder.reset();
+
 		RenderContext::Release();
+
+		SamplingProfiler::Stop();
+
+		if (!m_samplingProfilerOutput.empty())
+		{
+			SamplingProfiler::WriteFoldedStacks(m_samplingProfilerOutput);
+		}
+
+		Metrics::Shutdown();
+		FlightRecorder::Shutdown();
 	}
 
 	bool Application::Start()
@@ -50,10 +105,37 @@ namespace Mapo
 	{
 		m_timer.Start();
 
+		Timer::Clock::time_point runStartTime = Timer::Clock::now();
+
+		// Looked up once; updating them is a few relaxed atomics per frame.
+		MetricHistogram& frameTimeMetric = Metrics::GetHistogram("frame.time_ms");
+		MetricCounter&	 frameCountMetric = Metrics::GetCounter("frame.count");
+		MetricGauge&	 drawCallsMetric = Metrics::GetGauge("render.draw_calls");
+		MetricGauge&	 trianglesMetric = Metrics::GetGauge("render.triangles");
+		MetricGauge&	 visibleMetric = Metrics::GetGauge("render.visible_objects");
+		MetricGauge&	 culledMetric = Metrics::GetGauge("render.culled_objects");
+
 		while (m_running)
 		{
 			Timestep deltaTime = static_cast<Timestep>(m_timer.Tick());
 
+			// Replays run with a fixed timestep and override the live input state.
+			if (m_inputRecorder)
+			{
+				deltaTime = m_inputRecorder->BeginFrame(deltaTime);
+			}
+
+			// Benchmarks use a fixed timestep so that runs are reproducible.
+			if (m_benchmark)
+			{
+				deltaTime = m_benchmark->GetDeltaTime();
+			}
+
+			Timer frameTimer;
+			frameTimer.Start();
+
+			FlightRecorder::BeginFrame(RenderContext::GetRenderer().GetFrameNumber());
+
 			if (!m_minimalized)
 			{
 				Renderer& renderer = RenderContext::GetRenderer();
@@ -72,33 +154,101 @@ namespace Mapo
 					// -   Render objects
 					// - End shading pass
 					// - Post processing...
-					renderer.BeginRenderPass();
-
-					// TODO: Render pass should be put inside!
+					// Update (outside the render pass, so layers can record transfers and compute work)
+					Timer sectionTimer;
+					sectionTimer.Start();
 
-					// Update
 					for (Layer* layer : *m_layerStack)
 					{
+						MP_PROFILE_SCOPE("Layer::OnUpdate");
 						layer->OnUpdate(deltaTime);
 					}
 
-					// ImGui
-					m_imguiLayer->Begin();
+					renderer.BeginRenderPass();
 
 					for (Layer* layer : *m_layerStack)
 					{
-						layer->OnImGuiRender();
+						MP_PROFILE_SCOPE("Layer::OnRender");
+						layer->OnRender();
 					}
 
-					m_imguiLayer->End();
+					F64 updateTime = sectionTimer.Stop<Timer::Milliseconds>();
+
+					// ImGui
+					sectionTimer.Start();
+
+					{
+						MP_PROFILE_SCOPE("ImGui");
+						m_imguiLayer->Begin();
+
+						for (Layer* layer : *m_layerStack)
+						{
+							layer->OnImGuiRender();
+						}
+
+						m_imguiLayer->End();
+					}
+
+					F64 imguiTime = sectionTimer.Stop<Timer::Milliseconds>();
 
 					renderer.EndRenderPass();
 
+					U64 rendererFrame = renderer.GetFrameNumber();
 					renderer.EndFrame();
+
+					if (rendererFrame == 0)
+					{
+						StartupTrace::AddPhase("First frame", runStartTime, Timer::Clock::now());
+						StartupTrace::MarkFirstFrame();
+					}
+
+					if (m_benchmark)
+					{
+						const RenderStats& stats = renderer.GetStats();
+
+						BenchmarkFrameSample sample{};
+						sample.rendererFrame = rendererFrame;
+						sample.cpuFrameMs = static_cast<F32>(frameTimer.Elapsed<Timer::Milliseconds>());
+						sample.cpuUpdateMs = static_cast<F32>(updateTime);
+						sample.cpuImGuiMs = static_cast<F32>(imguiTime);
+						sample.drawCalls = stats.drawCalls;
+						sample.triangleCount = stats.triangleCount;
+						sample.vertexCount = stats.vertexCount;
+						m_benchmark->RecordFrame(sample, renderer);
+
+						if (m_benchmark->IsFinished())
+						{
+							m_benchmark->WriteReports();
+							m_running = false;
+						}
+					}
+				}
+			}
+
+			{
+				MP_PROFILE_SCOPE("Window::OnUpdate");
+				m_window->OnUpdate(); // glfwPollEvents()
+			}
+
+			if (m_inputRecorder)
+			{
+				m_inputRecorder->EndFrame(MP_BIND_EVENT_FN(Application::OnEvent));
+
+				if (m_inputRecorder->IsFinished())
+				{
+					m_running = false;
 				}
 			}
 
-			m_window->OnUpdate(); // glfwPollEvents()
+			const RenderStats& stats = RenderContext::GetRenderer().GetStats();
+			FlightRecorder::EndFrame({ stats.drawCalls, stats.triangleCount });
+
+			frameTimeMetric.Record(frameTimer.Elapsed<Timer::Milliseconds>());
+			frameCountMetric.Add();
+			drawCallsMetric.Set(stats.drawCalls);
+			trianglesMetric.Set(stats.triangleCount);
+			visibleMetric.Set(stats.visibleObjectCount);
+			culledMetric.Set(stats.culledObjectCount);
 		}
 
 		RenderContext::GetDevice().WaitIdle();
@@ -110,6 +260,12 @@ namespace Mapo
 
 	void Application::OnEvent(Event& event)
 	{
+		// Records input events, or drops live input events while a replay is running.
+		if (m_inputRecorder && !m_inputRecorder->ProcessEvent(event))
+		{
+			return;
+		}
+
 		// Handles events received from window.
 		EventDispatcher dispatcher(event);
 
@@ -165,12 +321,16 @@ namespace Mapo
 
 	void Application::PushLayer(Layer* layer)
 	{
+		MP_STARTUP_PHASE(layer->GetDebugName() + "::OnAttach");
+
 		m_layerStack->PushLayer(layer);
 		layer->OnAttach();
 	}
 
 	void Application::PushOverlay(Layer* overlay)
 	{
+		MP_STARTUP_PHASE(overlay->GetDebugName() + "::OnAttach");
+
 		m_layerStack->PushOverlay(overlay);
 		overlay->OnAttach();
 	}
@@ -19,17 +19,8 @@ int MapoMain(int argc, char** argv);
 namespace Mapo
 {
 	class RenderContext;
-
-	struct ApplicationCommandLineArgs
-	{
-		int	   count = 0;
-		char** args = nullptr;
-
-		const char* operator[](int index) const
-		{
-			return args[index];
-		}
-	};
+	class Benchmark;
+	class InputRecorder;
 
 	// Application base class
 	class Application
@@ -54,6 +45,12 @@ namespace Mapo
 
 		ImGuiLayer* GetImGuiLayer() { return m_imguiLayer; }
 
+		// Returns nullptr if the application is not running in benchmark mode.
+		Benchmark* GetBenchmark() { return m_benchmark.get(); }
+
+		// Returns nullptr if input is neither recorded nor replayed.
+		InputRecorder* GetInputRecorder() { return m_inputRecorder.get(); }
+
 	private:
 		// Subclass cannot override.
 		void Run();
@@ -81,6 +78,12 @@ namespace Mapo
 
 		Timer m_timer;
 
+		UniqueRef<Benchmark>	 m_benchmark;
+		UniqueRef<InputRecorder> m_inputRecorder;
+
+		// Folded stacks are written here on exit if the sampling profiler was started from the command line.
+		String m_samplingProfilerOutput{};
+
 		// Holds one application instance.
 		static Application* s_appInstance;
 
@@ -0,0 +1,409 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "benchmark.h"
+
+#include "engine/application.h"
+
+#include "engine/renderer/render_context.h"
+#include "engine/renderer/renderer.h"
+#include "engine/renderer/device.h"
+#include "engine/renderer/swapchain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+namespace Mapo
+{
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	BenchmarkSettings BenchmarkSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		BenchmarkSettings settings{};
+		String			  value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			const char* arg = args[i];
+
+			if (strcmp(arg, "--benchmark") == 0)
+			{
+				settings.enabled = true;
+			}
+			else if (strcmp(arg, "--headless") == 0)
+			{
+				settings.headless = true;
+			}
+			else if (StringOp::ParseOption(arg, "--benchmark-frames", value))
+			{
+				settings.measuredFrames = std::max(1, std::atoi(value.c_str()));
+			}
+			else if (StringOp::ParseOption(arg, "--benchmark-warmup", value))
+			{
+				settings.warmupFrames = std::max(0, std::atoi(value.c_str()));
+			}
+			else if (StringOp::ParseOption(arg, "--benchmark-output", value))
+			{
+				settings.outputPath = value;
+			}
+			else if (StringOp::ParseOption(arg, "--benchmark-camera", value))
+			{
+				settings.cameraPathFile = value;
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Camera path
+	/////////////////////////////////////////////////////////////////////////////////
+
+	CameraPath CameraPath::CreateDefaultOrbit(F32 radius, F32 height, F32 duration)
+	{
+		// Orbits the scene origin once while looking at it.
+		constexpr U32 SEGMENTS = 36;
+
+		CameraPath path{};
+		F32		   pitch = MathOp::Degrees(std::atan2(height, radius));
+
+		for (U32 i = 0; i <= SEGMENTS; ++i)
+		{
+			F32 t = static_cast<F32>(i) / SEGMENTS;
+			F32 angle = t * 2.0f * GLM_PI;
+
+			CameraKeyframe keyframe{};
+			keyframe.time = t * duration;
+			keyframe.position = { radius * MathOp::Sin(angle), height, radius * MathOp::Cos(angle) };
+			keyframe.pitch = pitch;
+			keyframe.yaw = -MathOp::Degrees(angle);
+			path.m_keyframes.push_back(keyframe);
+		}
+
+		return path;
+	}
+
+	CameraPath CameraPath::LoadFromFile(const String& filepath)
+	{
+		CameraPath	  path{};
+		std::ifstream file(filepath);
+
+		if (!file.is_open())
+		{
+			MP_ERROR("Failed to open camera path file: {}", filepath);
+			return path;
+		}
+
+		String line{};
+
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#')
+			{
+				continue;
+			}
+
+			std::istringstream ss(line);
+			CameraKeyframe	   keyframe{};
+
+			if (ss >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.pitch >> keyframe.yaw)
+			{
+				path.m_keyframes.push_back(keyframe);
+			}
+			else
+			{
+				MP_WARN("Skipping invalid camera path line: {}", line);
+			}
+		}
+
+		std::sort(path.m_keyframes.begin(), path.m_keyframes.end(),
+			[](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+
+		return path;
+	}
+
+	CameraKeyframe CameraPath::Evaluate(F32 time) const
+	{
+		if (m_keyframes.empty())
+		{
+			return {};
+		}
+
+		F32 duration = GetDuration();
+
+		if (m_keyframes.size() == 1 || duration <= 0.0f)
+		{
+			return m_keyframes.front();
+		}
+
+		time = std::fmod(time, duration);
+
+		auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+			[](F32 value, const CameraKeyframe& keyframe) { return value < keyframe.time; });
+
+		if (next == m_keyframes.begin())
+		{
+			return m_keyframes.front();
+		}
+
+		if (next == m_keyframes.end())
+		{
+			return m_keyframes.back();
+		}
+
+		const CameraKeyframe& a = *(next - 1);
+		const CameraKeyframe& b = *next;
+
+		F32 span = b.time - a.time;
+		F32 alpha = span > 0.0f ? (time - a.time) / span : 0.0f;
+
+		CameraKeyframe result{};
+		result.time = time;
+		result.position = a.position + (b.position - a.position) * alpha;
+		result.pitch = a.pitch + (b.pitch - a.pitch) * alpha;
+		result.yaw = a.yaw + (b.yaw - a.yaw) * alpha;
+		return result;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Benchmark
+	/////////////////////////////////////////////////////////////////////////////////
+
+	Benchmark::Benchmark(const BenchmarkSettings& settings)
+		: m_settings(settings)
+	{
+		if (!m_settings.cameraPathFile.empty())
+		{
+			m_cameraPath = CameraPath::LoadFromFile(m_settings.cameraPathFile);
+		}
+
+		if (m_cameraPath.IsEmpty())
+		{
+			m_cameraPath = CameraPath::CreateDefaultOrbit();
+		}
+
+		m_samples.reserve(m_settings.measuredFrames);
+		m_gpuTimingAvailable = RenderContext::GetDevice().SupportsTimestamps();
+
+		MP_INFO("Benchmark: {} warmup frames, {} measured frames, dt = {:.4f}s, output = {}", m_settings.warmupFrames,
+			m_settings.measuredFrames, m_settings.fixedDeltaTime, m_settings.outputPath);
+	}
+
+	bool Benchmark::IsFinished() const
+	{
+		if (m_samples.size() < m_settings.measuredFrames)
+		{
+			return false;
+		}
+
+		// GPU timestamps lag behind by the number of frames in flight.
+		return !m_gpuTimingAvailable || m_pendingGpuFrames == 0 || m_drainFrames > Swapchain::MAX_FRAMES_IN_FLIGHT;
+	}
+
+	void Benchmark::RecordFrame(BenchmarkFrameSample sample, const Renderer& renderer)
+	{
+		ResolveGpuTiming(renderer);
+
+		bool warmingUp = IsWarmingUp();
+		m_frameCount++;
+
+		if (warmingUp)
+		{
+			return;
+		}
+
+		if (m_samples.size() >= m_settings.measuredFrames)
+		{
+			m_drainFrames++;
+			return;
+		}
+
+		sample.frame = static_cast<U32>(m_samples.size());
+		m_samples.push_back(sample);
+		m_pendingGpuFrames++;
+	}
+
+	void Benchmark::ResolveGpuTiming(const Renderer& renderer)
+	{
+		const GpuFrameTiming& timing = renderer.GetLastGpuTiming();
+
+		if (!timing.valid)
+		{
+			return;
+		}
+
+		// Search from the back since the resolved frame is at most a few frames old.
+		for (auto it = m_samples.rbegin(); it != m_samples.rend(); ++it)
+		{
+			if (it->rendererFrame == timing.frameNumber)
+			{
+				if (it->gpuFrameMs < 0.0f)
+				{
+					it->gpuFrameMs = timing.gpuTimeMs;
+					m_pendingGpuFrames--;
+				}
+				break;
+			}
+
+			if (it->rendererFrame < timing.frameNumber)
+			{
+				break;
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Reports
+	/////////////////////////////////////////////////////////////////////////////////
+
+	struct BenchmarkSummary
+	{
+		F64 mean = 0.0;
+		F64 min = 0.0;
+		F64 max = 0.0;
+		F64 p50 = 0.0;
+		F64 p95 = 0.0;
+		F64 p99 = 0.0;
+		U32 count = 0;
+	};
+
+	template <typename Getter>
+	static BenchmarkSummary Summarize(const std::vector<BenchmarkFrameSample>& samples, Getter getter)
+	{
+		std::vector<F64> values;
+		values.reserve(samples.size());
+
+		for (const BenchmarkFrameSample& sample : samples)
+		{
+			F64 value = getter(sample);
+			if (value >= 0.0)
+			{
+				values.push_back(value);
+			}
+		}
+
+		BenchmarkSummary summary{};
+
+		if (values.empty())
+		{
+			return summary;
+		}
+
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&values](F64 p) {
+			size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+			return values[index];
+		};
+
+		F64 total = 0.0;
+		for (F64 value : values)
+		{
+			total += value;
+		}
+
+		summary.count = static_cast<U32>(values.size());
+		summary.mean = total / values.size();
+		summary.min = values.front();
+		summary.max = values.back();
+		summary.p50 = percentile(0.50);
+		summary.p95 = percentile(0.95);
+		summary.p99 = percentile(0.99);
+		return summary;
+	}
+
+	static void WriteJsonSummary(std::ofstream& file, const char* name, const BenchmarkSummary& summary, bool last)
+	{
+		file << "    \"" << name << "\": { \"count\": " << summary.count << ", \"mean\": " << summary.mean
+			 << ", \"min\": " << summary.min << ", \"max\": " << summary.max << ", \"p50\": " << summary.p50
+			 << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99 << " }" << (last ? "\n" : ",\n");
+	}
+
+	void Benchmark::WriteReports() const
+	{
+		WriteCsv(m_settings.outputPath + ".csv");
+		WriteJson(m_settings.outputPath + ".json");
+
+		BenchmarkSummary cpu = Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.cpuFrameMs; });
+		BenchmarkSummary gpu = Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.gpuFrameMs; });
+
+		MP_INFO("Benchmark finished: {} frames | CPU mean {:.3f} ms (p95 {:.3f}) | GPU mean {:.3f} ms (p95 {:.3f})",
+			m_samples.size(), cpu.mean, cpu.p95, gpu.mean, gpu.p95);
+	}
+
+	void Benchmark::WriteCsv(const String& filepath) const
+	{
+		std::ofstream file(filepath);
+
+		if (!file.is_open())
+		{
+			MP_ERROR("Failed to write benchmark report: {}", filepath);
+			return;
+		}
+
+		file << "frame,cpu_frame_ms,cpu_update_ms,cpu_imgui_ms,gpu_frame_ms,draw_calls,triangles,vertices\n";
+
+		for (const BenchmarkFrameSample& sample : m_samples)
+		{
+			file << sample.frame << ',' << sample.cpuFrameMs << ',' << sample.cpuUpdateMs << ',' << sample.cpuImGuiMs << ','
+				 << sample.gpuFrameMs << ',' << sample.drawCalls << ',' << sample.triangleCount << ',' << sample.vertexCount << '\n';
+		}
+
+		MP_INFO("Benchmark report written: {}", filepath);
+	}
+
+	void Benchmark::WriteJson(const String& filepath) const
+	{
+		std::ofstream file(filepath);
+
+		if (!file.is_open())
+		{
+			MP_ERROR("Failed to write benchmark report: {}", filepath);
+			return;
+		}
+
+		Renderer& renderer = RenderContext::GetRenderer();
+
+		file << "{\n";
+		file << "  \"renderer\": \"Vulkan " << renderer.GetVersion() << "\",\n";
+		file << "  \"device\": \"" << RenderContext::GetDevice().properties.deviceName << "\",\n";
+		file << "  \"resolution\": [" << renderer.GetSwapchainWidth() << ", " << renderer.GetSwapchainHeight() << "],\n";
+		file << "  \"headless\": " << (m_settings.headless ? "true" : "false") << ",\n";
+		file << "  \"warmup_frames\": " << m_settings.warmupFrames << ",\n";
+		file << "  \"measured_frames\": " << m_samples.size() << ",\n";
+		file << "  \"fixed_delta_time\": " << m_settings.fixedDeltaTime << ",\n";
+		file << "  \"time_to_first_frame_ms\": " << StartupTrace::GetTimeToFirstFrame() << ",\n";
+
+		file << "  \"summary\": {\n";
+		WriteJsonSummary(file, "cpu_frame_ms", Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.cpuFrameMs; }), false);
+		WriteJsonSummary(file, "cpu_update_ms", Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.cpuUpdateMs; }), false);
+		WriteJsonSummary(file, "cpu_imgui_ms", Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.cpuImGuiMs; }), false);
+		WriteJsonSummary(file, "gpu_frame_ms", Summarize(m_samples, [](const BenchmarkFrameSample& s) { return s.gpuFrameMs; }), true);
+		file << "  },\n";
+
+		file << "  \"frames\": [\n";
+
+		for (size_t i = 0; i < m_samples.size(); ++i)
+		{
+			const BenchmarkFrameSample& sample = m_samples[i];
+
+			file << "    { \"frame\": " << sample.frame << ", \"cpu_frame_ms\": " << sample.cpuFrameMs
+				 << ", \"cpu_update_ms\": " << sample.cpuUpdateMs << ", \"cpu_imgui_ms\": " << sample.cpuImGuiMs
+				 << ", \"gpu_frame_ms\": " << sample.gpuFrameMs << ", \"draw_calls\": " << sample.drawCalls
+				 << ", \"triangles\": " << sample.triangleCount << ", \"vertices\": " << sample.vertexCount << " }"
+				 << (i + 1 < m_samples.size() ? ",\n" : "\n");
+		}
+
+		file << "  ]\n";
+		file << "}\n";
+
+		MP_INFO("Benchmark report written: {}", filepath);
+	}
+
+} // namespace Mapo
@@ -0,0 +1,112 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	struct ApplicationCommandLineArgs;
+	class Renderer;
+
+	// Benchmark options parsed from the command line:
+	//
+	//   --benchmark                  Enables the benchmark mode.
+	//   --benchmark-frames=<N>       Number of measured frames (default: 600).
+	//   --benchmark-warmup=<N>       Number of warmup frames that are not recorded (default: 60).
+	//   --benchmark-output=<path>    Output path without extension. Writes <path>.csv and <path>.json.
+	//   --benchmark-camera=<file>    Camera path file. Each line is "time x y z pitch yaw" (degrees).
+	//   --headless                   Runs without a display (VK_EXT_headless_surface, works with lavapipe).
+	struct BenchmarkSettings
+	{
+		bool   enabled = false;
+		bool   headless = false;
+		U32	   warmupFrames = 60;
+		U32	   measuredFrames = 600;
+		F32	   fixedDeltaTime = 1.0f / 60.0f;
+		String outputPath = "benchmark";
+		String cameraPathFile{};
+
+		static BenchmarkSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	struct CameraKeyframe
+	{
+		F32		time = 0.0f;
+		Vector3 position{ 0.0f };
+		F32		pitch = 0.0f; // degrees
+		F32		yaw = 0.0f;	  // degrees
+	};
+
+	// Scripted camera path. Keyframes are linearly interpolated and the path loops.
+	class CameraPath
+	{
+	public:
+		static CameraPath CreateDefaultOrbit(F32 radius = 8.0f, F32 height = 1.5f, F32 duration = 10.0f);
+		static CameraPath LoadFromFile(const String& filepath);
+
+		CameraKeyframe Evaluate(F32 time) const;
+
+		F32	 GetDuration() const { return m_keyframes.empty() ? 0.0f : m_keyframes.back().time; }
+		bool IsEmpty() const { return m_keyframes.empty(); }
+
+	private:
+		std::vector<CameraKeyframe> m_keyframes;
+	};
+
+	struct BenchmarkFrameSample
+	{
+		U32 frame = 0;
+		U64 rendererFrame = 0;
+		F32 cpuFrameMs = 0.0f;
+		F32 cpuUpdateMs = 0.0f;
+		F32 cpuImGuiMs = 0.0f;
+		F32 gpuFrameMs = -1.0f; // -1 if not available
+		U32 drawCalls = 0;
+		U32 triangleCount = 0;
+		U32 vertexCount = 0;
+	};
+
+	// Plays the scene for a fixed number of frames with a fixed timestep and writes per-frame reports.
+	class Benchmark
+	{
+	public:
+		Benchmark(const BenchmarkSettings& settings);
+
+		// Timing of the current frame (fixed timestep).
+		Timestep GetDeltaTime() const { return m_settings.fixedDeltaTime; }
+		F32		 GetTime() const { return m_frameCount * m_settings.fixedDeltaTime; }
+
+		CameraKeyframe GetCameraPose() const { return m_cameraPath.Evaluate(GetTime()); }
+
+		bool IsWarmingUp() const { return m_frameCount < m_settings.warmupFrames; }
+		bool IsFinished() const;
+
+		// Called once per rendered frame after the frame has been submitted.
+		void RecordFrame(BenchmarkFrameSample sample, const Renderer& renderer);
+
+		void WriteReports() const;
+
+		const BenchmarkSettings& GetSettings() const { return m_settings; }
+
+	private:
+		void ResolveGpuTiming(const Renderer& renderer);
+		void WriteCsv(const String& filepath) const;
+		void WriteJson(const String& filepath) const;
+
+	private:
+		BenchmarkSettings				  m_settings;
+		CameraPath						  m_cameraPath;
+		std::vector<BenchmarkFrameSample> m_samples;
+
+		U32	 m_frameCount = 0;		  // including warmup frames
+		U32	 m_pendingGpuFrames = 0;  // measured frames still waiting for GPU timestamps
+		U32	 m_drainFrames = 0;		  // extra frames rendered after measurement to collect timestamps
+		bool m_gpuTimingAvailable = true;
+	};
+
+} // namespace Mapo
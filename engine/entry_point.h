@@ -13,6 +13,8 @@ extern Mapo::Application* Mapo::CreateApplication(ApplicationCommandLineArgs cmd
 
 int main(int argc, char** argv)
 {
+	Mapo::StartupTrace::Start();
+
 	Mapo::Log::Init();
 
 	MapoMain(argc, argv);
@@ -0,0 +1,496 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "input_recorder.h"
+
+#include "engine/application.h"
+#include "engine/input/input.h"
+
+#include "engine/event/event.h"
+#include "engine/event/key_event.h"
+#include "engine/event/mouse_event.h"
+
+#include <cstring>
+
+namespace Mapo
+{
+	// File layout (native endianness):
+	//
+	//   Header: char magic[4] = "MPIR", U32 version
+	//   Frame:  F32 deltaTime, F32 mouseX, F32 mouseY, U8 mouseButtons,
+	//           U16 keyCount, U16 keys[keyCount],
+	//           U16 eventCount, events[eventCount]
+	//   Event:  U8 type, followed by U16 code (+ U16 repeatCount for KeyPressed) or F32 x, F32 y
+	//
+	// The file has no frame count so that a recording cut short by a crash can still be replayed.
+	static constexpr char INPUT_FILE_MAGIC[4] = { 'M', 'P', 'I', 'R' };
+	static constexpr U32  INPUT_FILE_VERSION = 1;
+
+	static constexpr size_t WRITE_BUFFER_FLUSH_SIZE = 64 * 1024;
+
+	InputRecorder* InputRecorder::s_instance = nullptr;
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	InputRecorderSettings InputRecorderSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		InputRecorderSettings settings{};
+		String				  value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			const char* arg = args[i];
+
+			if (StringOp::ParseOption(arg, "--record-input", value))
+			{
+				settings.recordPath = value;
+			}
+			else if (StringOp::ParseOption(arg, "--replay-input", value))
+			{
+				settings.replayPath = value;
+			}
+			else if (StringOp::ParseOption(arg, "--replay-timestep", value))
+			{
+				settings.replayDeltaTime = std::max(0.0f, static_cast<F32>(std::atof(value.c_str())));
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Serialization
+	/////////////////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	static void WriteValue(std::vector<U8>& buffer, const T& value)
+	{
+		const U8* bytes = reinterpret_cast<const U8*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	class ByteReader
+	{
+	public:
+		ByteReader(const std::vector<U8>& data, size_t offset)
+			: m_data(data), m_offset(offset)
+		{
+		}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			if (m_offset + sizeof(T) > m_data.size())
+			{
+				return false;
+			}
+
+			memcpy(&value, m_data.data() + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		bool IsAtEnd() const { return m_offset >= m_data.size(); }
+
+	private:
+		const std::vector<U8>& m_data;
+		size_t				   m_offset;
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Input recorder
+	/////////////////////////////////////////////////////////////////////////////////
+
+	InputRecorder::InputRecorder(const InputRecorderSettings& settings)
+		: m_replayDeltaTime(settings.replayDeltaTime)
+	{
+		MP_ASSERT(s_instance == nullptr, "Only one input recorder can exist!");
+		s_instance = this;
+
+		if (!settings.replayPath.empty())
+		{
+			if (!settings.recordPath.empty())
+			{
+				MP_WARN("Input recording is ignored while replaying: {}", settings.recordPath);
+			}
+
+			if (LoadReplay(settings.replayPath))
+			{
+				m_mode = Mode::Replay;
+			}
+		}
+		else if (!settings.recordPath.empty())
+		{
+			OpenRecording(settings.recordPath);
+		}
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		if (IsRecording())
+		{
+			m_file.write(reinterpret_cast<const char*>(m_writeBuffer.data()), static_cast<std::streamsize>(m_writeBuffer.size()));
+			m_file.close();
+
+			MP_INFO("Recorded {} frames of input.", m_recordedFrameCount);
+		}
+
+		s_instance = nullptr;
+	}
+
+	const InputState* InputRecorder::GetReplayState()
+	{
+		if (s_instance && s_instance->IsReplaying())
+		{
+			return &s_instance->m_replayState;
+		}
+
+		return nullptr;
+	}
+
+	F32 InputRecorder::BeginFrame(F32 deltaTime)
+	{
+		if (IsRecording())
+		{
+			m_currentFrame.deltaTime = deltaTime;
+			m_currentFrame.events.clear();
+			PollInputState(m_currentFrame.state);
+			return deltaTime;
+		}
+
+		if (IsReplaying() && !IsFinished())
+		{
+			const RecordedFrame& frame = m_replayFrames[m_replayFrameIndex];
+			m_replayState = frame.state;
+			return m_replayDeltaTime > 0.0f ? m_replayDeltaTime : frame.deltaTime;
+		}
+
+		return deltaTime;
+	}
+
+	void InputRecorder::EndFrame(const EventCallbackFn& callback)
+	{
+		if (IsRecording())
+		{
+			WriteFrame(m_currentFrame);
+			return;
+		}
+
+		if (!IsReplaying() || IsFinished())
+		{
+			return;
+		}
+
+		m_dispatchingReplay = true;
+
+		for (const RecordedEvent& recorded : m_replayFrames[m_replayFrameIndex].events)
+		{
+			switch (static_cast<EventType>(recorded.type))
+			{
+				case EventType::KeyPressed:
+				{
+					KeyPressedEvent event(recorded.code, recorded.repeatCount);
+					callback(event);
+					break;
+				}
+				case EventType::KeyReleased:
+				{
+					KeyReleasedEvent event(recorded.code);
+					callback(event);
+					break;
+				}
+				case EventType::KeyTyped:
+				{
+					KeyTypedEvent event(recorded.code);
+					callback(event);
+					break;
+				}
+				case EventType::MouseButtonPressed:
+				{
+					MouseButtonPressedEvent event(recorded.code);
+					callback(event);
+					break;
+				}
+				case EventType::MouseButtonReleased:
+				{
+					MouseButtonReleasedEvent event(recorded.code);
+					callback(event);
+					break;
+				}
+				case EventType::MouseMoved:
+				{
+					MouseMovedEvent event(recorded.x, recorded.y);
+					callback(event);
+					break;
+				}
+				case EventType::MouseScrolled:
+				{
+					MouseScrolledEvent event(recorded.x, recorded.y);
+					callback(event);
+					break;
+				}
+				default:
+					break;
+			}
+		}
+
+		m_dispatchingReplay = false;
+		m_replayFrameIndex++;
+
+		if (IsFinished())
+		{
+			MP_INFO("Input replay finished after {} frames.", m_replayFrames.size());
+		}
+	}
+
+	bool InputRecorder::ProcessEvent(Event& event)
+	{
+		if (!event.InCategory(EventCategoryInput))
+		{
+			return true; // window events always stay live
+		}
+
+		if (IsReplaying())
+		{
+			return m_dispatchingReplay;
+		}
+
+		if (!IsRecording())
+		{
+			return true;
+		}
+
+		RecordedEvent recorded{};
+		recorded.type = static_cast<U8>(event.GetEventType());
+
+		switch (event.GetEventType())
+		{
+			case EventType::KeyPressed:
+			{
+				KeyPressedEvent& keyEvent = static_cast<KeyPressedEvent&>(event);
+				recorded.code = keyEvent.GetKeyCode();
+				recorded.repeatCount = keyEvent.GetRepeatCount();
+				break;
+			}
+			case EventType::KeyReleased:
+			case EventType::KeyTyped:
+				recorded.code = static_cast<KeyEvent&>(event).GetKeyCode();
+				break;
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+				recorded.code = static_cast<MouseButtonEvent&>(event).GetMouseButton();
+				break;
+			case EventType::MouseMoved:
+			{
+				MouseMovedEvent& mouseEvent = static_cast<MouseMovedEvent&>(event);
+				recorded.x = mouseEvent.GetX();
+				recorded.y = mouseEvent.GetY();
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				MouseScrolledEvent& mouseEvent = static_cast<MouseScrolledEvent&>(event);
+				recorded.x = mouseEvent.GetOffsetX();
+				recorded.y = mouseEvent.GetOffsetY();
+				break;
+			}
+			default:
+				return true;
+		}
+
+		m_currentFrame.events.push_back(recorded);
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Helpers
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void InputRecorder::OpenRecording(const String& filepath)
+	{
+		m_file.open(filepath, std::ios::binary | std::ios::trunc);
+
+		if (!m_file.is_open())
+		{
+			MP_ERROR("Failed to open input recording file: {}", filepath);
+			return;
+		}
+
+		m_file.write(INPUT_FILE_MAGIC, sizeof(INPUT_FILE_MAGIC));
+		m_file.write(reinterpret_cast<const char*>(&INPUT_FILE_VERSION), sizeof(INPUT_FILE_VERSION));
+
+		m_writeBuffer.reserve(WRITE_BUFFER_FLUSH_SIZE * 2);
+		m_mode = Mode::Record;
+
+		MP_INFO("Recording input to {}", filepath);
+	}
+
+	bool InputRecorder::LoadReplay(const String& filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+		{
+			MP_ERROR("Failed to open input recording file: {}", filepath);
+			return false;
+		}
+
+		std::vector<U8> data(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+		U32 version = 0;
+		if (data.size() < sizeof(INPUT_FILE_MAGIC) + sizeof(version) || memcmp(data.data(), INPUT_FILE_MAGIC, sizeof(INPUT_FILE_MAGIC)) != 0)
+		{
+			MP_ERROR("Invalid input recording file: {}", filepath);
+			return false;
+		}
+
+		ByteReader reader(data, sizeof(INPUT_FILE_MAGIC));
+		reader.Read(version);
+
+		if (version != INPUT_FILE_VERSION)
+		{
+			MP_ERROR("Unsupported input recording version {} (expected {}): {}", version, INPUT_FILE_VERSION, filepath);
+			return false;
+		}
+
+		while (!reader.IsAtEnd())
+		{
+			RecordedFrame frame{};
+			U16			  keyCount = 0;
+			U16			  eventCount = 0;
+
+			bool valid = reader.Read(frame.deltaTime) && reader.Read(frame.state.mousePosition.x) && reader.Read(frame.state.mousePosition.y)
+				&& reader.Read(frame.state.mouseButtons) && reader.Read(keyCount);
+
+			for (U16 i = 0; valid && i < keyCount; ++i)
+			{
+				KeyCode key = 0;
+				valid = reader.Read(key) && key < InputState::KEY_COUNT;
+				if (valid)
+				{
+					frame.state.keys.set(key);
+				}
+			}
+
+			valid = valid && reader.Read(eventCount);
+
+			for (U16 i = 0; valid && i < eventCount; ++i)
+			{
+				RecordedEvent event{};
+				valid = reader.Read(event.type);
+
+				switch (static_cast<EventType>(event.type))
+				{
+					case EventType::KeyPressed:
+						valid = valid && reader.Read(event.code) && reader.Read(event.repeatCount);
+						break;
+					case EventType::KeyReleased:
+					case EventType::KeyTyped:
+					case EventType::MouseButtonPressed:
+					case EventType::MouseButtonReleased:
+						valid = valid && reader.Read(event.code);
+						break;
+					case EventType::MouseMoved:
+					case EventType::MouseScrolled:
+						valid = valid && reader.Read(event.x) && reader.Read(event.y);
+						break;
+					default:
+						valid = false;
+						break;
+				}
+
+				frame.events.push_back(event);
+			}
+
+			if (!valid)
+			{
+				// A truncated tail (e.g. the recording process crashed) still replays up to the last complete frame.
+				MP_WARN("Input recording is truncated after {} frames: {}", m_replayFrames.size(), filepath);
+				break;
+			}
+
+			m_replayFrames.push_back(std::move(frame));
+		}
+
+		MP_INFO("Replaying {} frames of input from {}", m_replayFrames.size(), filepath);
+		return true;
+	}
+
+	void InputRecorder::WriteFrame(const RecordedFrame& frame)
+	{
+		WriteValue(m_writeBuffer, frame.deltaTime);
+		WriteValue(m_writeBuffer, frame.state.mousePosition.x);
+		WriteValue(m_writeBuffer, frame.state.mousePosition.y);
+		WriteValue(m_writeBuffer, frame.state.mouseButtons);
+
+		WriteValue(m_writeBuffer, static_cast<U16>(frame.state.keys.count()));
+		for (KeyCode key = 0; key < InputState::KEY_COUNT; ++key)
+		{
+			if (frame.state.keys.test(key))
+			{
+				WriteValue(m_writeBuffer, key);
+			}
+		}
+
+		WriteValue(m_writeBuffer, static_cast<U16>(frame.events.size()));
+		for (const RecordedEvent& event : frame.events)
+		{
+			WriteValue(m_writeBuffer, event.type);
+
+			switch (static_cast<EventType>(event.type))
+			{
+				case EventType::KeyPressed:
+					WriteValue(m_writeBuffer, event.code);
+					WriteValue(m_writeBuffer, event.repeatCount);
+					break;
+				case EventType::MouseMoved:
+				case EventType::MouseScrolled:
+					WriteValue(m_writeBuffer, event.x);
+					WriteValue(m_writeBuffer, event.y);
+					break;
+				default:
+					WriteValue(m_writeBuffer, event.code);
+					break;
+			}
+		}
+
+		m_recordedFrameCount++;
+
+		if (m_writeBuffer.size() >= WRITE_BUFFER_FLUSH_SIZE)
+		{
+			m_file.write(reinterpret_cast<const char*>(m_writeBuffer.data()), static_cast<std::streamsize>(m_writeBuffer.size()));
+			m_writeBuffer.clear();
+		}
+	}
+
+	void InputRecorder::PollInputState(InputState& state)
+	{
+		state.keys.reset();
+
+		// Key codes below Key::Space are unused by GLFW.
+		for (KeyCode key = Key::Space; key < InputState::KEY_COUNT; ++key)
+		{
+			if (Input::IsKeyPressed(key))
+			{
+				state.keys.set(key);
+			}
+		}
+
+		state.mouseButtons = 0;
+		for (MouseCode button = 0; button <= Mouse::ButtonLast; ++button)
+		{
+			if (Input::IsMouseButtonPressed(button))
+			{
+				state.mouseButtons |= BIT(button);
+			}
+		}
+
+		state.mousePosition = Input::GetMousePosition();
+	}
+
+} // namespace Mapo
@@ -0,0 +1,134 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "engine/input/key_codes.h"
+#include "engine/input/mouse_codes.h"
+
+#include <bitset>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+namespace Mapo
+{
+	struct ApplicationCommandLineArgs;
+	class Event;
+
+	// Input recording options parsed from the command line:
+	//
+	//   --record-input=<file>        Records per-frame input state, input events and frame times.
+	//   --replay-input=<file>        Replays a recording instead of the live input and closes the app at the end.
+	//   --replay-timestep=<seconds>  Fixed timestep used for replay (default: 1/60). 0 uses the recorded frame times.
+	struct InputRecorderSettings
+	{
+		String recordPath{};
+		String replayPath{};
+		F32	   replayDeltaTime = 1.0f / 60.0f;
+
+		bool IsEnabled() const { return !recordPath.empty() || !replayPath.empty(); }
+
+		static InputRecorderSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	// Input state as seen by the Input queries at the beginning of a frame.
+	struct InputState
+	{
+		static constexpr U32 KEY_COUNT = Key::Menu + 1;
+
+		std::bitset<KEY_COUNT> keys{};
+		U8					   mouseButtons = 0; // one bit per MouseCode
+		Vector2				   mousePosition{ 0.0f };
+
+		bool IsKeyPressed(KeyCode keycode) const { return keycode < KEY_COUNT && keys.test(keycode); }
+		bool IsMouseButtonPressed(MouseCode button) const { return button <= Mouse::ButtonLast && (mouseButtons & BIT(button)); }
+	};
+
+	// Records the input of a session to a compact binary file and plays it back deterministically.
+	//
+	// A frame stores the input state polled before the layers update, the frame time and the input events
+	// received while polling the window at the end of the frame. During replay the state answers the
+	// Input::IsKeyPressed/GetMousePosition queries and the events are fed through Application::OnEvent
+	// at the same point of the frame, so EditorCamera movement and editor shortcuts are reproduced exactly.
+	// ImGui reads GLFW directly and is not replayed.
+	class InputRecorder
+	{
+	public:
+		using EventCallbackFn = std::function<void(Event&)>;
+
+		InputRecorder(const InputRecorderSettings& settings);
+		~InputRecorder();
+
+		InputRecorder(const InputRecorder&) = delete;
+		InputRecorder& operator=(const InputRecorder&) = delete;
+
+		// Returns the replayed input state, or nullptr if no replay is running.
+		static const InputState* GetReplayState();
+
+		bool IsRecording() const { return m_mode == Mode::Record; }
+		bool IsReplaying() const { return m_mode == Mode::Replay; }
+		bool IsFinished() const { return IsReplaying() && m_replayFrameIndex >= m_replayFrames.size(); }
+
+		// Called at the beginning of a frame. Returns the delta time the frame should use.
+		F32 BeginFrame(F32 deltaTime);
+
+		// Called after the window has polled its events. Writes the recorded frame or dispatches the replayed events.
+		void EndFrame(const EventCallbackFn& callback);
+
+		// Called for every window event. Returns false if a live event should be dropped because a replay is running.
+		bool ProcessEvent(Event& event);
+
+	private:
+		enum class Mode
+		{
+			None,
+			Record,
+			Replay
+		};
+
+		struct RecordedEvent
+		{
+			U8	type = 0; // EventType
+			U16 code = 0; // key or mouse button
+			U16 repeatCount = 0;
+			F32 x = 0.0f;
+			F32 y = 0.0f;
+		};
+
+		struct RecordedFrame
+		{
+			F32						   deltaTime = 0.0f;
+			InputState				   state{};
+			std::vector<RecordedEvent> events{};
+		};
+
+		void OpenRecording(const String& filepath);
+		bool LoadReplay(const String& filepath);
+
+		void		WriteFrame(const RecordedFrame& frame);
+		static void PollInputState(InputState& state);
+
+	private:
+		Mode m_mode = Mode::None;
+		F32	 m_replayDeltaTime = 0.0f;
+
+		// Recording
+		std::ofstream	m_file;
+		std::vector<U8> m_writeBuffer{};
+		RecordedFrame	m_currentFrame{};
+		U32				m_recordedFrameCount = 0;
+
+		// Replay
+		std::vector<RecordedFrame> m_replayFrames{};
+		size_t					   m_replayFrameIndex = 0;
+		InputState				   m_replayState{};
+		bool					   m_dispatchingReplay = false;
+
+		static InputRecorder* s_instance;
+	};
+
+} // namespace Mapo
@@ -19,7 +19,10 @@ namespace Mapo
 
 		virtual void OnAttach() { }
 		virtual void OnDetach() { }
+		// Called once per frame after the command buffer begins, before the render pass.
 		virtual void OnUpdate(Timestep dt) { }
+		// Records draws inside the render pass.
+		virtual void OnRender() { }
 		virtual void OnImGuiRender() { }
 		virtual void OnEvent(Event& event) { }
 
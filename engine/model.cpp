@@ -8,8 +8,9 @@
 
 #include "engine/renderer/vk_common.h"
 #include "engine/renderer/render_context.h"
-#include "engine/renderer/device.h"
-#include "engine/renderer/buffer.h"
+#include "engine/renderer/renderer.h"
+
+#include <numeric>
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
@@ -51,106 +52,86 @@ namespace Mapo
 	}
 
 	Model::Model(const Builder& builder)
-		: m_device(RenderContext::GetDevice())
 	{
 		m_modelName = builder.modelName;
 
-		CreateVertexBuffers(builder.vertices);
-		CreateIndexBuffers(builder.indices);
+		const U32 vertexCount = static_cast<U32>(builder.vertices.size());
+		const U32 indexCount = static_cast<U32>(builder.indices.size());
+		MP_ASSERT(vertexCount >= 3, "Failed to create model. Vertex count must be at least 3!");
+
+		m_geometry = RenderContext::GetGeometryPool().Allocate(builder.vertices.data(), vertexCount, builder.indices.data(), indexCount);
+
+		ComputeBounds(builder.vertices);
+
+		m_positions.reserve(vertexCount);
+		for (const Vertex& vertex : builder.vertices)
+		{
+			m_positions.push_back(vertex.position);
+		}
+
+		m_indices = builder.indices;
+		if (m_indices.empty())
+		{
+			m_indices.resize(vertexCount);
+			std::iota(m_indices.begin(), m_indices.end(), 0u);
+		}
 	}
 
 	Model::~Model()
 	{
+		RenderContext::GetGeometryPool().Free(m_geometry);
 	}
 
 	void Model::Bind(VkCommandBuffer commandBuffer)
 	{
-		VkBuffer	 buffers[] = { m_vertexBuffer->GetBuffer() };
-		VkDeviceSize offsets[] = { 0 };
-		// TODO: Consider adding a Bind() function in the buffer class.
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
-
-		if (m_hasIndexBuffer)
-		{
-			vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
-		}
+		RenderContext::GetGeometryPool().Bind(commandBuffer);
 	}
 
-	void Model::Draw(VkCommandBuffer commandBuffer)
+	void Model::Draw(VkCommandBuffer commandBuffer, U32 instanceCount, U32 firstInstance)
 	{
-		if (m_hasIndexBuffer)
+		RenderStats& stats = RenderContext::GetRenderer().GetStats();
+		stats.drawCalls++;
+		stats.vertexCount += m_geometry.vertexCount * instanceCount;
+
+		// Indices are relative to the model's first vertex, vertexOffset moves them into the pool.
+		if (m_geometry.indexCount > 0)
 		{
-			vkCmdDrawIndexed(commandBuffer, m_indexCount, 1, 0, 0, 0);
+			vkCmdDrawIndexed(commandBuffer, m_geometry.indexCount, instanceCount, m_geometry.firstIndex, static_cast<I32>(m_geometry.firstVertex), firstInstance);
+			stats.triangleCount += m_geometry.indexCount / 3 * instanceCount;
 		}
 		else
 		{
-			vkCmdDraw(commandBuffer, m_vertexCount, 1, 0, 0);
+			vkCmdDraw(commandBuffer, m_geometry.vertexCount, instanceCount, m_geometry.firstVertex, firstInstance);
+			stats.triangleCount += m_geometry.vertexCount / 3 * instanceCount;
 		}
 	}
 
-	void Model::CreateVertexBuffers(const std::vector<Vertex>& vertices)
+	void Model::ComputeBounds(const std::vector<Vertex>& vertices)
 	{
-		m_vertexCount = static_cast<U32>(vertices.size());
-		MP_ASSERT(m_vertexCount >= 3, "Failed to create vertex buffer. Vertex count must be at least 3!");
-
-		U32			 vertexSize = sizeof(vertices[0]);
-		VkDeviceSize bufferSize = vertexSize * m_vertexCount;
-
-		// Create staging buffer and it will be auto deleted.
-		Buffer stagingBuffer{
-			vertexSize,
-			m_vertexCount,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-		};
-
-		stagingBuffer.Map();
-		stagingBuffer.WriteToBuffer((void*)vertices.data());
-
-		// Create vertex buffer.
-		m_vertexBuffer = MakeUnique<Buffer>(
-			vertexSize,
-			m_vertexCount,
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-		// Copy staging to vertex buffer.
-		m_device.CopyBuffer(stagingBuffer.GetBuffer(), m_vertexBuffer->GetBuffer(), bufferSize);
-	}
-
-	void Model::CreateIndexBuffers(const std::vector<U32>& indices)
-	{
-		m_indexCount = static_cast<U32>(indices.size());
-		m_hasIndexBuffer = m_indexCount > 0;
-
-		if (!m_hasIndexBuffer)
+		if (vertices.empty())
 		{
 			return;
 		}
 
-		U32			 indexSize = sizeof(indices[0]);
-		VkDeviceSize bufferSize = indexSize * m_indexCount;
-
-		// Create staging buffer and it will be auto deleted.
-		Buffer stagingBuffer{
-			indexSize,
-			m_indexCount,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		};
+		AABB box{ vertices[0].position, vertices[0].position };
+		for (const Vertex& vertex : vertices)
+		{
+			box.min = MathOp::Min(box.min, vertex.position);
+			box.max = MathOp::Max(box.max, vertex.position);
+		}
 
-		stagingBuffer.Map();
-		stagingBuffer.WriteToBuffer((void*)indices.data());
+		// Not the smallest sphere, but sharing the center with the box lets culling use whichever is tighter.
+		const Vector3 center = (box.min + box.max) * 0.5f;
 
-		// Create index buffer.
-		m_indexBuffer = MakeUnique<Buffer>(
-			indexSize,
-			m_indexCount,
-			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		F32 radiusSquared = 0.0f;
+		for (const Vertex& vertex : vertices)
+		{
+			const Vector3 offset = vertex.position - center;
+			radiusSquared = MathOp::Max(radiusSquared, MathOp::Dot(offset, offset));
+		}
 
-		// Copy staging to vertex buffer.
-		m_device.CopyBuffer(stagingBuffer.GetBuffer(), m_indexBuffer->GetBuffer(), bufferSize);
+		m_boundingBox = box;
+		m_boundingSphere = { center, std::sqrt(radiusSquared) };
 	}
 
 	UniqueRef<Model> Model::CreateCubeModel()
@@ -214,8 +195,53 @@ namespace Mapo
 		return MakeUnique<Model>(builder);
 	}
 
+	std::vector<Ref<Model>> Model::CreateModelsFromFiles(const std::vector<String>& filepaths)
+	{
+		// OBJ parsing is CPU-only and runs as jobs. Buffer creation submits transfer commands to the graphics
+		// queue, so it stays on this thread and consumes the builders in order, running parse jobs while it waits.
+		const U32				builderCount = static_cast<U32>(filepaths.size());
+		std::vector<Builder>	builders(builderCount);
+		UniqueRef<JobCounter[]> builderCounters = MakeUnique<JobCounter[]>(builderCount);
+
+		// Loads that are parsing or waiting for their upload.
+		static MetricGauge& pendingLoadsMetric = Metrics::GetGauge("assets.pending_loads");
+		pendingLoadsMetric.Add(static_cast<F64>(builderCount));
+
+		for (U32 i = 0; i < builderCount; ++i)
+		{
+			const String* filepath = &filepaths[i];
+			Builder*	  builder = &builders[i];
+
+			JobSystem::Run(
+				[filepath, builder]() {
+					MP_STARTUP_PHASE("Parse " + *filepath);
+					builder->LoadModel(*filepath);
+				},
+				&builderCounters[i]);
+		}
+
+		std::vector<Ref<Model>> models{};
+		models.reserve(filepaths.size());
+
+		for (U32 i = 0; i < builderCount; ++i)
+		{
+			JobSystem::Wait(builderCounters[i]);
+			const Builder& builder = builders[i];
+
+			MP_STARTUP_PHASE("Upload " + filepaths[i]);
+			MP_INFO("Vertex count: {} ({})", builder.vertices.size(), filepaths[i]);
+			models.push_back(MakeRef<Model>(builder));
+
+			pendingLoadsMetric.Add(-1.0);
+		}
+
+		return models;
+	}
+
 	void Model::Builder::LoadModel(const String& filepath)
 	{
+		Timer::Clock::time_point loadStartTime = Timer::Clock::now();
+
 		modelName = filepath;
 
 		using tinyobj::attrib_t;
@@ -288,6 +314,14 @@ namespace Mapo
 				indices.push_back(uniqueVertices[vertex]);
 			}
 		}
+
+		Timer::Clock::time_point loadEndTime = Timer::Clock::now();
+		FlightRecorder::RecordAssetLoad(filepath.c_str(), loadStartTime, loadEndTime);
+
+		static MetricHistogram& loadTimeMetric = Metrics::GetHistogram("assets.load_time_ms");
+		static MetricCounter&	loadCountMetric = Metrics::GetCounter("assets.loaded");
+		loadTimeMetric.Record(std::chrono::duration<F64, std::milli>(loadEndTime - loadStartTime).count());
+		loadCountMetric.Add();
 	}
 
 } // namespace Mapo
@@ -6,13 +6,12 @@
 
 #include "core/core.h"
 
+#include "engine/renderer/geometry_pool.h"
+
 #include <vulkan/vulkan.h>
 
 namespace Mapo
 {
-	class Device;
-	class Buffer;
-
 	class Model
 	{
 	public:
@@ -49,31 +48,45 @@ namespace Mapo
 		Model(const Model&) = delete;
 		Model& operator=(const Model&) = delete;
 
+		// Binds the geometry pool, which holds the buffers of all models. Draws of any model can follow.
 		void Bind(VkCommandBuffer commandBuffer);
-		void Draw(VkCommandBuffer commandBuffer);
+		void Draw(VkCommandBuffer commandBuffer, U32 instanceCount = 1, U32 firstInstance = 0);
 
 		const String& GetModelName() const { return m_modelName; }
-		U32			  GetVertexCount() const { return m_vertexCount; }
-		U32			  GetIndexCount() const { return m_indexCount; }
+		U32			  GetVertexCount() const { return m_geometry.vertexCount; }
+		U32			  GetIndexCount() const { return m_geometry.indexCount; }
+
+		// Vertex and index range in the geometry pool.
+		const GeometryRange& GetGeometryRange() const { return m_geometry; }
+
+		// Local-space bounds of the vertices. The sphere is centered on the box.
+		const AABB&			  GetBoundingBox() const { return m_boundingBox; }
+		const BoundingSphere& GetBoundingSphere() const { return m_boundingSphere; }
+
+		// Local-space positions and triangle indices kept on the CPU for software occlusion. Non-indexed models
+		// get sequential indices.
+		const std::vector<Vector3>& GetPositions() const { return m_positions; }
+		const std::vector<U32>&		GetIndices() const { return m_indices; }
 
 		static UniqueRef<Model> CreateCubeModel();
 		static UniqueRef<Model> CreateModelFromFile(const String& filepath);
 
+		// Parses the files concurrently. The returned models are in the same order as the file paths.
+		static std::vector<Ref<Model>> CreateModelsFromFiles(const std::vector<String>& filepaths);
+
 	private:
-		void CreateVertexBuffers(const std::vector<Vertex>& vertices);
-		void CreateIndexBuffers(const std::vector<U32>& indices);
+		void ComputeBounds(const std::vector<Vertex>& vertices);
 
 	private:
-		Device& m_device;
+		GeometryRange m_geometry{};
 
-		UniqueRef<Buffer> m_vertexBuffer;
-		U32				  m_vertexCount;
+		String m_modelName{};
 
-		bool			  m_hasIndexBuffer = false;
-		UniqueRef<Buffer> m_indexBuffer;
-		U32				  m_indexCount;
+		AABB		   m_boundingBox{};
+		BoundingSphere m_boundingSphere{};
 
-		String m_modelName{};
+		std::vector<Vector3> m_positions{};
+		std::vector<U32>	 m_indices{};
 	};
 
 } // namespace Mapo
@@ -0,0 +1,43 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/typedefs.h"
+
+namespace Mapo
+{
+	// Call stack captured by the platform sampler. frames[0] is the interrupted instruction,
+	// the rest are return addresses from the innermost to the outermost frame.
+	struct RawSample
+	{
+		static constexpr U32 MAX_STACK_DEPTH = 64;
+
+		U32		  threadIndex = 0;
+		U32		  depth = 0;
+		uintptr_t frames[MAX_STACK_DEPTH];
+	};
+
+	// Implemented by different platform! Used by SamplingProfiler only.
+	namespace SamplerBackend
+	{
+		bool IsSupported();
+
+		bool Start(U32 frequencyHz);
+		void Stop();
+
+		// Threads must be registered to be sampled, and unregistered before they exit.
+		void RegisterCurrentThread(const char* name);
+		void UnregisterCurrentThread();
+
+		const char* GetThreadName(U32 threadIndex);
+
+		// Single consumer. Returns false if no sample is pending.
+		bool PopSample(RawSample& sample);
+
+		U64 GetDroppedSampleCount();
+
+	} // namespace SamplerBackend
+
+} // namespace Mapo
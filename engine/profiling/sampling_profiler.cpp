@@ -0,0 +1,378 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "sampling_profiler.h"
+
+#include "engine/application.h"
+#include "engine/profiling/sampler_backend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+namespace Mapo
+{
+	static constexpr auto AGGREGATION_INTERVAL = std::chrono::milliseconds(50);
+
+	struct SamplingProfilerData
+	{
+		std::mutex		  mutex; // guards everything below except the thread handle
+		std::thread		  aggregator;
+		std::atomic<bool> running{ false };
+
+		HashMap<uintptr_t, U32> addressToSymbol{};
+		HashMap<String, U32>	nameToSymbol{};
+		std::vector<String>		symbolNames{};
+		std::vector<U64>		selfSamples{};
+		std::vector<U64>		totalSamples{};
+		HashMap<String, U64>	foldedStacks{};
+		U64						sampleCount = 0;
+	};
+
+	static SamplingProfilerData s_data;
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Settings
+	/////////////////////////////////////////////////////////////////////////////////
+
+	SamplingProfilerSettings SamplingProfilerSettings::Parse(const ApplicationCommandLineArgs& args)
+	{
+		SamplingProfilerSettings settings{};
+		String					 value{};
+
+		for (int i = 1; i < args.count; ++i)
+		{
+			const char* arg = args[i];
+
+			if (strcmp(arg, "--sampling-profiler") == 0)
+			{
+				settings.enabled = true;
+			}
+			else if (StringOp::ParseOption(arg, "--sampling-profiler-hz", value))
+			{
+				settings.frequencyHz = std::clamp(std::atoi(value.c_str()), 10, 10000);
+			}
+			else if (StringOp::ParseOption(arg, "--sampling-profiler-output", value))
+			{
+				settings.foldedOutputPath = value;
+				settings.enabled = true;
+			}
+		}
+
+		return settings;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Aggregation
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static String SymbolizeAddress(uintptr_t address)
+	{
+		Dl_info info{};
+
+		if (dladdr(reinterpret_cast<void*>(address), &info) == 0)
+		{
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(address));
+			return buffer;
+		}
+
+		if (info.dli_sname)
+		{
+			int	  status = 0;
+			char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+			String name = (status == 0 && demangled) ? demangled : info.dli_sname;
+			free(demangled);
+			return name;
+		}
+
+		// No exported symbol (local functions, stripped libraries). Attribute the sample to the module,
+		// otherwise every address would become its own entry.
+		const char* module = info.dli_fname ? info.dli_fname : "?";
+		if (const char* slash = strrchr(module, '/'))
+		{
+			module = slash + 1;
+		}
+
+		return String("[") + module + "]";
+	}
+
+	// Must be called with the mutex held.
+	static U32 GetSymbol(uintptr_t address)
+	{
+		auto iter = s_data.addressToSymbol.find(address);
+		if (iter != s_data.addressToSymbol.end())
+		{
+			return iter->second;
+		}
+
+		String name = SymbolizeAddress(address);
+
+		// Folded stacks use ';' as the frame separator.
+		std::replace(name.begin(), name.end(), ';', ':');
+
+		auto [nameIter, inserted] = s_data.nameToSymbol.try_emplace(name, static_cast<U32>(s_data.symbolNames.size()));
+		if (inserted)
+		{
+			s_data.symbolNames.push_back(name);
+			s_data.selfSamples.push_back(0);
+			s_data.totalSamples.push_back(0);
+		}
+
+		s_data.addressToSymbol.emplace(address, nameIter->second);
+		return nameIter->second;
+	}
+
+	// Must be called with the mutex held.
+	static void AggregateSample(const RawSample& sample)
+	{
+		if (sample.depth == 0)
+		{
+			return;
+		}
+
+		U32 symbols[RawSample::MAX_STACK_DEPTH];
+		U32 uniqueSymbols[RawSample::MAX_STACK_DEPTH];
+		U32 uniqueCount = 0;
+
+		for (U32 i = 0; i < sample.depth; ++i)
+		{
+			// Return addresses point after the call instruction.
+			uintptr_t address = i == 0 ? sample.frames[i] : sample.frames[i] - 1;
+			symbols[i] = GetSymbol(address);
+
+			// Count recursive functions once per sample.
+			if (std::find(uniqueSymbols, uniqueSymbols + uniqueCount, symbols[i]) == uniqueSymbols + uniqueCount)
+			{
+				uniqueSymbols[uniqueCount++] = symbols[i];
+				s_data.totalSamples[symbols[i]]++;
+			}
+		}
+
+		s_data.selfSamples[symbols[0]]++;
+		s_data.sampleCount++;
+
+		String stack = SamplerBackend::GetThreadName(sample.threadIndex);
+		for (U32 i = sample.depth; i > 0; --i)
+		{
+			stack += ';';
+			stack += s_data.symbolNames[symbols[i - 1]];
+		}
+
+		s_data.foldedStacks[stack]++;
+	}
+
+	static void DrainSamples()
+	{
+		RawSample					sample{};
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+
+		while (SamplerBackend::PopSample(sample))
+		{
+			AggregateSample(sample);
+		}
+	}
+
+	static void RunAggregator()
+	{
+		while (s_data.running.load(std::memory_order_acquire))
+		{
+			DrainSamples();
+			std::this_thread::sleep_for(AGGREGATION_INTERVAL);
+		}
+
+		DrainSamples();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Sampling profiler
+	/////////////////////////////////////////////////////////////////////////////////
+
+	bool SamplingProfiler::IsSupported()
+	{
+		return SamplerBackend::IsSupported();
+	}
+
+	bool SamplingProfiler::Start(U32 frequencyHz)
+	{
+		if (IsRunning())
+		{
+			return true;
+		}
+
+		if (!IsSupported())
+		{
+			MP_WARN("SamplingProfiler: Not supported on this platform.");
+			return false;
+		}
+
+		SamplerBackend::RegisterCurrentThread("Main");
+
+		if (!SamplerBackend::Start(frequencyHz))
+		{
+			return false;
+		}
+
+		s_data.running.store(true, std::memory_order_release);
+		s_data.aggregator = std::thread(RunAggregator);
+
+		MP_INFO("SamplingProfiler: Started at {} Hz.", frequencyHz);
+		return true;
+	}
+
+	void SamplingProfiler::Stop()
+	{
+		if (!IsRunning())
+		{
+			return;
+		}
+
+		SamplerBackend::Stop();
+
+		s_data.running.store(false, std::memory_order_release);
+		s_data.aggregator.join();
+
+		MP_INFO("SamplingProfiler: Stopped. {} samples, {} dropped.", GetSampleCount(), GetDroppedSampleCount());
+	}
+
+	bool SamplingProfiler::IsRunning()
+	{
+		return s_data.running.load(std::memory_order_acquire);
+	}
+
+	void SamplingProfiler::RegisterCurrentThread(const char* name)
+	{
+		SamplerBackend::RegisterCurrentThread(name);
+	}
+
+	void SamplingProfiler::UnregisterCurrentThread()
+	{
+		SamplerBackend::UnregisterCurrentThread();
+	}
+
+	void SamplingProfiler::Reset()
+	{
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+
+		std::fill(s_data.selfSamples.begin(), s_data.selfSamples.end(), 0);
+		std::fill(s_data.totalSamples.begin(), s_data.totalSamples.end(), 0);
+		s_data.foldedStacks.clear();
+		s_data.sampleCount = 0;
+	}
+
+	std::vector<HotFunction> SamplingProfiler::GetTopFunctions(U32 count, bool sortBySelf)
+	{
+		std::vector<HotFunction> functions{};
+
+		{
+			std::lock_guard<std::mutex> lock(s_data.mutex);
+
+			for (size_t i = 0; i < s_data.symbolNames.size(); ++i)
+			{
+				if (s_data.totalSamples[i] > 0)
+				{
+					functions.push_back({ s_data.symbolNames[i], s_data.selfSamples[i], s_data.totalSamples[i] });
+				}
+			}
+		}
+
+		auto compare = [sortBySelf](const HotFunction& a, const HotFunction& b) {
+			return sortBySelf ? a.selfSamples > b.selfSamples : a.totalSamples > b.totalSamples;
+		};
+
+		if (functions.size() > count)
+		{
+			std::partial_sort(functions.begin(), functions.begin() + count, functions.end(), compare);
+			functions.resize(count);
+		}
+		else
+		{
+			std::sort(functions.begin(), functions.end(), compare);
+		}
+
+		return functions;
+	}
+
+	U64 SamplingProfiler::GetSampleCount()
+	{
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+		return s_data.sampleCount;
+	}
+
+	U64 SamplingProfiler::GetDroppedSampleCount()
+	{
+		return SamplerBackend::GetDroppedSampleCount();
+	}
+
+	bool SamplingProfiler::WriteFoldedStacks(const String& filepath)
+	{
+		std::ofstream file(filepath);
+
+		if (!file.is_open())
+		{
+			MP_ERROR("SamplingProfiler: Failed to write folded stacks: {}", filepath);
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(s_data.mutex);
+
+		for (const auto& [stack, samples] : s_data.foldedStacks)
+		{
+			file << stack << ' ' << samples << '\n';
+		}
+
+		MP_INFO("SamplingProfiler: Wrote {} stacks to {}", s_data.foldedStacks.size(), filepath);
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Fallback backend
+	/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MP_LINUX_BUILD
+	bool SamplerBackend::IsSupported()
+	{
+		return false;
+	}
+
+	bool SamplerBackend::Start([[maybe_unused]] U32 frequencyHz)
+	{
+		return false;
+	}
+
+	void SamplerBackend::Stop()
+	{
+	}
+
+	void SamplerBackend::RegisterCurrentThread([[maybe_unused]] const char* name)
+	{
+	}
+
+	void SamplerBackend::UnregisterCurrentThread()
+	{
+	}
+
+	const char* SamplerBackend::GetThreadName([[maybe_unused]] U32 threadIndex)
+	{
+		return "?";
+	}
+
+	bool SamplerBackend::PopSample([[maybe_unused]] RawSample& sample)
+	{
+		return false;
+	}
+
+	U64 SamplerBackend::GetDroppedSampleCount()
+	{
+		return 0;
+	}
+#endif
+
+} // namespace Mapo
@@ -0,0 +1,68 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	struct ApplicationCommandLineArgs;
+
+	// Sampling profiler options parsed from the command line:
+	//
+	//   --sampling-profiler                Starts sampling at startup.
+	//   --sampling-profiler-hz=<N>         Samples per second of CPU time per thread (default: 1000).
+	//   --sampling-profiler-output=<file>  Writes folded stacks (flamegraph.pl, speedscope) on exit.
+	struct SamplingProfilerSettings
+	{
+		bool   enabled = false;
+		U32	   frequencyHz = 1000;
+		String foldedOutputPath{};
+
+		static SamplingProfilerSettings Parse(const ApplicationCommandLineArgs& args);
+	};
+
+	struct HotFunction
+	{
+		String name{};
+		U64	   selfSamples = 0;	 // samples with the function on top of the stack
+		U64	   totalSamples = 0; // samples with the function anywhere on the stack
+	};
+
+	// In-process sampling profiler. Registered threads are interrupted periodically (SIGPROF on Linux) and
+	// their call stacks are aggregated by symbol on a background thread. Catches everything that is not
+	// annotated with MP_PROFILE_SCOPE, without any external tool.
+	//
+	// Only Linux has a sampler backend for now. Symbols come from dladdr, so the executable exports its
+	// symbols (ENABLE_EXPORTS) to resolve static code.
+	class SamplingProfiler
+	{
+	public:
+		static bool IsSupported();
+
+		// Start registers the calling thread (usually the main thread).
+		static bool Start(U32 frequencyHz = 1000);
+		static void Stop();
+		static bool IsRunning();
+
+		// Worker threads opt in. Unregister before the thread exits.
+		static void RegisterCurrentThread(const char* name);
+		static void UnregisterCurrentThread();
+
+		// Clears the aggregated samples.
+		static void Reset();
+
+		static std::vector<HotFunction> GetTopFunctions(U32 count, bool sortBySelf = true);
+
+		static U64 GetSampleCount();
+		static U64 GetDroppedSampleCount();
+
+		// One line per unique stack: "thread;outer;...;inner <samples>".
+		static bool WriteFoldedStacks(const String& filepath);
+	};
+
+} // namespace Mapo
@@ -77,6 +77,11 @@ namespace Mapo
 
 	Device::~Device()
 	{
+		for (VkCommandPool commandPool : m_singleTimeCommandPools)
+		{
+			vkDestroyCommandPool(m_device, commandPool, nullptr);
+		}
+
 		vkDestroyCommandPool(m_device, m_commandPool, nullptr);
 		vkDestroyDevice(m_device, nullptr);
 
@@ -95,9 +100,22 @@ namespace Mapo
 
 	void Device::WaitIdle()
 	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
 		VK_CHECK(vkDeviceWaitIdle(m_device));
 	}
 
+	void Device::SubmitGraphics(const VkSubmitInfo& submitInfo, VkFence fence)
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		VK_CHECK(vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, fence));
+	}
+
+	VkResult Device::Present(const VkPresentInfoKHR& presentInfo)
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		return vkQueuePresentKHR(m_presentQueue, &presentInfo);
+	}
+
 	/////////////////////////////////////////////////////////////////////////////////
 	// Public helper functions
 	/////////////////////////////////////////////////////////////////////////////////
@@ -186,13 +204,13 @@ namespace Mapo
 		vkBindBufferMemory(m_device, buffer, bufferMemory, 0);
 	}
 
-	void Device::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
+	void Device::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset)
 	{
 		VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
 
 		VkBufferCopy copyRegion{};
-		copyRegion.srcOffset = 0;
-		copyRegion.dstOffset = 0;
+		copyRegion.srcOffset = srcOffset;
+		copyRegion.dstOffset = dstOffset;
 		copyRegion.size = size;
 		vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
@@ -223,10 +241,13 @@ namespace Mapo
 
 	VkCommandBuffer Device::BeginSingleTimeCommands()
 	{
+		const U32 threadIndex = JobSystem::GetThreadIndex();
+		MP_ASSERT(threadIndex < m_singleTimeCommandPools.size(), "Single-time commands can only be recorded on job system threads!");
+
 		VkCommandBufferAllocateInfo allocateInfo{};
 		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-		allocateInfo.commandPool = m_commandPool;
+		allocateInfo.commandPool = m_singleTimeCommandPools[threadIndex];
 		allocateInfo.commandBufferCount = 1;
 
 		VkCommandBuffer commandBuffer;
@@ -250,10 +271,18 @@ namespace Mapo
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &commandBuffer;
 
-		vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-		vkQueueWaitIdle(m_graphicsQueue);
+		// Waiting on a fence instead of the queue lets other threads submit in the meantime.
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 
-		vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+		VkFence fence;
+		VK_CHECK(vkCreateFence(m_device, &fenceInfo, nullptr, &fence));
+
+		SubmitGraphics(submitInfo, fence);
+		VK_CHECK(vkWaitForFences(m_device, 1, &fence, VK_TRUE, UINT64_MAX));
+
+		vkDestroyFence(m_device, fence, nullptr);
+		vkFreeCommandBuffers(m_device, m_singleTimeCommandPools[JobSystem::GetThreadIndex()], 1, &commandBuffer);
 	}
 
 	/////////////////////////////////////////////////////////////////////////////////
@@ -307,7 +336,10 @@ namespace Mapo
 		createInfo.ppEnabledExtensionNames = requiredExtensions.data();
 
 		// Additional settings for macOS, otherwise you would get VK_ERROR_INCOMPATIBLE_DRIVER.
-		createInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+		if (IsInstanceExtensionAvailable(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME))
+		{
+			createInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+		}
 
 		// Placed outside if for longer lifecycle before instance will be created.
 		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{};
@@ -374,6 +406,15 @@ namespace Mapo
 
 		vkGetPhysicalDeviceProperties(m_gpu, &properties);
 		MP_INFO("Physical device: {}", properties.deviceName);
+
+		// Timestamps are only meaningful if the graphics queue has valid timestamp bits.
+		U32 queueFamilyCount{};
+		vkGetPhysicalDeviceQueueFamilyProperties(m_gpu, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(m_gpu, &queueFamilyCount, queueFamilies.data());
+
+		U32 graphicsFamily = FindQueueFamilies(m_gpu).graphicsFamily.value();
+		m_supportsTimestamps = properties.limits.timestampPeriod > 0.0f && queueFamilies[graphicsFamily].timestampValidBits > 0;
 	}
 
 	void Device::CreateLogicalDevice()
@@ -399,8 +440,16 @@ namespace Mapo
 		}
 
 		// Device features
+		VkPhysicalDeviceFeatures supportedFeatures{};
+		vkGetPhysicalDeviceFeatures(m_gpu, &supportedFeatures);
+
+		m_supportsMultiDrawIndirect = supportedFeatures.multiDrawIndirect == VK_TRUE;
+		m_supportsDrawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance == VK_TRUE;
+
 		VkPhysicalDeviceFeatures deviceFeatures{};
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
+		deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+		deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
 
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -408,8 +457,22 @@ namespace Mapo
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
 		createInfo.pEnabledFeatures = &deviceFeatures;
 
-		createInfo.enabledExtensionCount = static_cast<U32>(m_deviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = m_deviceExtensions.data(); // e.g. swap chain
+		std::vector<const char*> deviceExtensions = m_deviceExtensions;
+
+		if (IsDeviceExtensionAvailable(m_gpu, PORTABILITY_SUBSET_EXTENSION_NAME))
+		{
+			deviceExtensions.emplace_back(PORTABILITY_SUBSET_EXTENSION_NAME);
+		}
+
+		const bool hasDrawIndirectCount = IsDeviceExtensionAvailable(m_gpu, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+		if (hasDrawIndirectCount)
+		{
+			deviceExtensions.emplace_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+		}
+
+		createInfo.enabledExtensionCount = static_cast<U32>(deviceExtensions.size());
+		createInfo.ppEnabledExtensionNames = deviceExtensions.data(); // e.g. swap chain
 
 		// Might not really be necessary anymore because device specific validation layers
 		// have been deprecated.
@@ -428,6 +491,12 @@ namespace Mapo
 		// Fetch queue handle.
 		vkGetDeviceQueue(m_device, queueFamilyData.graphicsFamily.value(), 0, &m_graphicsQueue);
 		vkGetDeviceQueue(m_device, queueFamilyData.presentFamily.value(), 0, &m_presentQueue);
+
+		if (hasDrawIndirectCount)
+		{
+			m_drawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+				vkGetDeviceProcAddr(m_device, "vkCmdDrawIndexedIndirectCountKHR"));
+		}
 	}
 
 	void Device::CreateCommandPool()
@@ -443,6 +512,16 @@ namespace Mapo
 
 		// Command buffers are executed by submitting them on one of the device queues, e.g. graphics queue.
 		VK_CHECK(vkCreateCommandPool(m_device, &poolCreateInfo, nullptr, &m_commandPool));
+
+		// Command pools cannot be used by several threads at once, so each job system thread gets one for its
+		// single-time commands.
+		poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		m_singleTimeCommandPools.resize(JobSystem::GetThreadCount());
+
+		for (VkCommandPool& commandPool : m_singleTimeCommandPools)
+		{
+			VK_CHECK(vkCreateCommandPool(m_device, &poolCreateInfo, nullptr, &commandPool));
+		}
 	}
 
 	/////////////////////////////////////////////////////////////////////////////////
@@ -481,7 +560,10 @@ namespace Mapo
 		}
 
 		// Additional settings for macOS, otherwise you would get VK_ERROR_INCOMPATIBLE_DRIVER.
-		extensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+		if (IsInstanceExtensionAvailable(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME))
+		{
+			extensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+		}
 
 		// Fixing the device error on macOS.
 		extensions.emplace_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
@@ -502,7 +584,7 @@ namespace Mapo
 		{
 			auto it = std::find_if(availableLayers.begin(), availableLayers.end(),
 				[layerName](VkLayerProperties layerProperties) {
-					return strcmp(layerProperties.layerName, layerName);
+					return strcmp(layerProperties.layerName, layerName) == 0;
 				});
 
 			if (it == availableLayers.end())
@@ -617,6 +699,28 @@ namespace Mapo
 		return requiredExtensions.empty();
 	}
 
+	bool Device::IsInstanceExtensionAvailable(const char* extensionName)
+	{
+		U32 extensionCount{};
+		vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
+
+		return std::any_of(extensions.begin(), extensions.end(),
+			[extensionName](const VkExtensionProperties& extension) { return strcmp(extension.extensionName, extensionName) == 0; });
+	}
+
+	bool Device::IsDeviceExtensionAvailable(VkPhysicalDevice physicalDevice, const char* extensionName)
+	{
+		U32 extensionCount{};
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+		return std::any_of(extensions.begin(), extensions.end(),
+			[extensionName](const VkExtensionProperties& extension) { return strcmp(extension.extensionName, extensionName) == 0; });
+	}
+
 	SwapchainSupportDetails Device::QuerySwapchainSupport(VkPhysicalDevice physicalDevice)
 	{
 		SwapchainSupportDetails details{};
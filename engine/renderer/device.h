@@ -8,6 +8,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <mutex>
 #include <vector>
 
 namespace Mapo
@@ -45,7 +46,7 @@ namespace Mapo
 		Device& operator=(Device&&) = delete;
 
 		// Public functions
-		void WaitIdle();
+		void WaitIdle(); // holds the queues, so other threads cannot submit meanwhile
 
 		// Getter for Vulkan resources
 		VkCommandPool	 GetCommandPool() { return m_commandPool; }
@@ -56,6 +57,16 @@ namespace Mapo
 		VkQueue			 GetGraphicsQueue() { return m_graphicsQueue; }
 		VkQueue			 GetPresentQueue() { return m_presentQueue; }
 
+		// GPU timestamps (used for profiling).
+		bool SupportsTimestamps() const { return m_supportsTimestamps; }
+		F32	 GetTimestampPeriod() const { return properties.limits.timestampPeriod; } // nanoseconds per tick
+
+		// Indirect drawing (used for GPU culling). The features are enabled when the GPU has them.
+		bool SupportsMultiDrawIndirect() const { return m_supportsMultiDrawIndirect; }
+		bool SupportsDrawIndirectFirstInstance() const { return m_supportsDrawIndirectFirstInstance; }
+		// vkCmdDrawIndexedIndirectCountKHR, or nullptr if VK_KHR_draw_indirect_count is not available.
+		PFN_vkCmdDrawIndexedIndirectCountKHR GetDrawIndexedIndirectCount() const { return m_drawIndexedIndirectCount; }
+
 		// Public helper functions
 		SwapchainSupportDetails GetSwapchainSupport() { return QuerySwapchainSupport(m_gpu); };
 		QueueFamilyIndices		FindPhysicalQueueFamilies() { return FindQueueFamilies(m_gpu); }
@@ -66,12 +77,20 @@ namespace Mapo
 		// Buffer helper functions
 		void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkBuffer& buffer,
 			VkDeviceMemory& bufferMemory);
-		void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+		void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
 		void CopyBufferToImage(VkBuffer buffer, VkImage image, U32 width, U32 height, U32 layerCount);
 
+		// Single-time commands can be recorded from any job system thread. Each thread records into its own command
+		// pool, and End only waits for the thread's own submission.
 		VkCommandBuffer BeginSingleTimeCommands();
 		void			EndSingleTimeCommands(VkCommandBuffer commandBuffer);
 
+		// The graphics and present queues (possibly the same one) are shared by all threads. Every submission goes
+		// through these, and code that uses the queues directly (the ImGui backend) holds LockQueues meanwhile.
+		void						 SubmitGraphics(const VkSubmitInfo& submitInfo, VkFence fence);
+		VkResult					 Present(const VkPresentInfoKHR& presentInfo);
+		std::unique_lock<std::mutex> LockQueues() { return std::unique_lock<std::mutex>(m_queueMutex); }
+
 		// Image helper functions
 		void CreateImageWithInfo(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags propertyFlags, VkImage& image,
 			VkDeviceMemory& imageMemory);
@@ -93,6 +112,8 @@ namespace Mapo
 		void					 PopulateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
 		void					 HasGlfwRequiredInstanceExtensions();
 		bool					 CheckDeviceExtensionSupport(VkPhysicalDevice physicalDevice);
+		bool					 IsInstanceExtensionAvailable(const char* extensionName);
+		bool					 IsDeviceExtensionAvailable(VkPhysicalDevice physicalDevice, const char* extensionName);
 		SwapchainSupportDetails	 QuerySwapchainSupport(VkPhysicalDevice physicalDevice);
 
 	public:
@@ -110,14 +131,28 @@ namespace Mapo
 		VkQueue					 m_presentQueue = VK_NULL_HANDLE;
 		VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
 
-#ifdef NDBUG
+		bool m_supportsTimestamps = false;
+		bool m_supportsMultiDrawIndirect = false;
+		bool m_supportsDrawIndirectFirstInstance = false;
+
+		PFN_vkCmdDrawIndexedIndirectCountKHR m_drawIndexedIndirectCount = nullptr;
+
+		// One per job system thread, only used by that thread.
+		std::vector<VkCommandPool> m_singleTimeCommandPools{};
+
+		std::mutex m_queueMutex{};
+
+#ifdef NDEBUG
 		const bool m_enableValidationLayers = false;
 #else
 		const bool m_enableValidationLayers = true;
 #endif
 
 		const std::vector<const char*> m_validationLayers{ "VK_LAYER_KHRONOS_validation" };
-		const std::vector<const char*> m_deviceExtensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME, "VK_KHR_portability_subset" };
+		const std::vector<const char*> m_deviceExtensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+
+		// Must be enabled when the implementation exposes it (MoltenVK), but is absent on other drivers.
+		static constexpr const char* PORTABILITY_SUBSET_EXTENSION_NAME = "VK_KHR_portability_subset";
 	};
 
 } // namespace Mapo
@@ -7,7 +7,7 @@
 #include "core/core.h"
 
 #include "engine/scene/editor_camera.h"
-#include "engine/scene/game_object.h"
+#include "engine/scene/render_proxy.h"
 
 #include <vulkan/vulkan.h>
 
@@ -20,7 +20,11 @@ namespace Mapo
 		VkCommandBuffer commandBuffer;
 		VkDescriptorSet globalDescriptorSet;
 		EditorCamera& camera;
-		std::vector<GameObject>& gameObjects;
+		const std::vector<RenderProxy>& renderProxies;
+		const RenderProxyBounds& renderProxyBounds; // world-space bounds, entry i belongs to renderProxies[i]
+		const std::vector<U32>& changedRenderProxies; // indices into renderProxies changed by the last scene update
+		const std::vector<U32>& visibleRenderProxies; // indices into renderProxies that passed CPU culling
+		U32 culledRenderProxyCount;
 	};
 
 } // namespace Mapo
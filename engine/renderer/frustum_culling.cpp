@@ -0,0 +1,64 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "frustum_culling.h"
+
+namespace Mapo
+{
+	Frustum Frustum::FromViewProjection(const Matrix4& viewProjection)
+	{
+		// glm is column-major, so row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i]).
+		const Matrix4 m = MathOp::Transpose(viewProjection);
+		const Vector4 row0 = m[0];
+		const Vector4 row1 = m[1];
+		const Vector4 row2 = m[2];
+		const Vector4 row3 = m[3];
+
+		Frustum frustum{};
+		frustum.planes[PLANE_LEFT] = row3 + row0;
+		frustum.planes[PLANE_RIGHT] = row3 - row0;
+		frustum.planes[PLANE_BOTTOM] = row3 + row1;
+		frustum.planes[PLANE_TOP] = row3 - row1;
+		frustum.planes[PLANE_NEAR] = row2;
+		frustum.planes[PLANE_FAR] = row3 - row2;
+
+		for (Vector4& plane : frustum.planes)
+		{
+			plane /= MathOp::Length(Vector3(plane));
+		}
+
+		return frustum;
+	}
+
+	U32 CullRenderProxies(const Frustum& frustum, const std::vector<RenderProxy>& proxies, const RenderProxyBounds& bounds,
+		std::vector<U32>& visibleIndices)
+	{
+		MP_PROFILE_SCOPE("CullRenderProxies");
+
+		const U32 count = static_cast<U32>(proxies.size());
+		visibleIndices.resize(count);
+
+		const U32 insideCount = Simd::CullBounds(frustum.planes, Frustum::PLANE_COUNT, bounds.GetBounds(), count, visibleIndices.data());
+
+		// Drop the disabled proxies in place; they count as neither visible nor culled.
+		U32 visibleCount = 0;
+		U32 enabledCount = 0;
+
+		for (U32 i = 0; i < insideCount; ++i)
+		{
+			const U32 index = visibleIndices[i];
+			visibleIndices[visibleCount] = index;
+			visibleCount += (proxies[index].flags & RENDER_PROXY_VISIBLE) ? 1 : 0;
+		}
+
+		for (const RenderProxy& proxy : proxies)
+		{
+			enabledCount += (proxy.flags & RENDER_PROXY_VISIBLE) ? 1 : 0;
+		}
+
+		visibleIndices.resize(visibleCount);
+		return enabledCount - visibleCount;
+	}
+
+} // namespace Mapo
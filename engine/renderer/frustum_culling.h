@@ -0,0 +1,40 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "engine/scene/render_proxy.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	// View frustum as planes (normal, offset) with unit normals pointing inside.
+	struct Frustum
+	{
+		enum Plane : U32
+		{
+			PLANE_LEFT = 0,
+			PLANE_RIGHT,
+			PLANE_BOTTOM,
+			PLANE_TOP,
+			PLANE_NEAR,
+			PLANE_FAR,
+			PLANE_COUNT
+		};
+
+		Vector4 planes[PLANE_COUNT]{};
+
+		// Gribb-Hartmann extraction for clip space with depth in [0, 1] (GLM_FORCE_DEPTH_ZERO_TO_ONE).
+		static Frustum FromViewProjection(const Matrix4& viewProjection);
+	};
+
+	// Writes the indices of the proxies that are visible (RENDER_PROXY_VISIBLE) and inside the frustum to
+	// `visibleIndices` in proxy order, and returns how many visible proxies were culled by the frustum.
+	U32 CullRenderProxies(const Frustum& frustum, const std::vector<RenderProxy>& proxies, const RenderProxyBounds& bounds,
+		std::vector<U32>& visibleIndices);
+
+} // namespace Mapo
@@ -0,0 +1,124 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "geometry_pool.h"
+
+#include "engine/renderer/render_context.h"
+#include "engine/renderer/device.h"
+#include "engine/renderer/buffer.h"
+
+namespace Mapo
+{
+	static constexpr VkBufferUsageFlags VERTEX_BUFFER_USAGE = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+	static constexpr VkBufferUsageFlags INDEX_BUFFER_USAGE = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+
+	GeometryPool::GeometryPool(U32 vertexStride)
+		: m_device(RenderContext::GetDevice()), m_vertexStride(vertexStride)
+	{
+		Grow(m_vertexBuffer, m_vertexRanges, m_vertexStride, INITIAL_VERTEX_CAPACITY, VERTEX_BUFFER_USAGE);
+		Grow(m_indexBuffer, m_indexRanges, sizeof(U32), INITIAL_INDEX_CAPACITY, INDEX_BUFFER_USAGE);
+	}
+
+	GeometryPool::~GeometryPool()
+	{
+		if (m_vertexRanges.GetUsedCount() > 0)
+		{
+			MP_WARN("GeometryPool is destroyed with {} vertices still in use!", m_vertexRanges.GetUsedCount());
+		}
+	}
+
+	GeometryRange GeometryPool::Allocate(const void* vertices, U32 vertexCount, const U32* indices, U32 indexCount)
+	{
+		MP_PROFILE_SCOPE("GeometryPool::Allocate");
+		MP_ASSERT(vertexCount > 0, "Cannot allocate a mesh without vertices!");
+
+		GeometryRange range{};
+		range.vertexCount = vertexCount;
+		range.indexCount = indexCount;
+
+		range.firstVertex = m_vertexRanges.Allocate(vertexCount);
+		if (range.firstVertex == RangeAllocator::INVALID_OFFSET)
+		{
+			Grow(m_vertexBuffer, m_vertexRanges, m_vertexStride, vertexCount, VERTEX_BUFFER_USAGE);
+			range.firstVertex = m_vertexRanges.Allocate(vertexCount);
+		}
+
+		Upload(*m_vertexBuffer, static_cast<VkDeviceSize>(range.firstVertex) * m_vertexStride, vertices, static_cast<VkDeviceSize>(vertexCount) * m_vertexStride);
+
+		if (indexCount > 0)
+		{
+			range.firstIndex = m_indexRanges.Allocate(indexCount);
+			if (range.firstIndex == RangeAllocator::INVALID_OFFSET)
+			{
+				Grow(m_indexBuffer, m_indexRanges, sizeof(U32), indexCount, INDEX_BUFFER_USAGE);
+				range.firstIndex = m_indexRanges.Allocate(indexCount);
+			}
+
+			Upload(*m_indexBuffer, static_cast<VkDeviceSize>(range.firstIndex) * sizeof(U32), indices, static_cast<VkDeviceSize>(indexCount) * sizeof(U32));
+		}
+
+		MP_ASSERT(range.firstVertex != RangeAllocator::INVALID_OFFSET && range.firstIndex != RangeAllocator::INVALID_OFFSET, "GeometryPool is out of space!");
+		return range;
+	}
+
+	void GeometryPool::Free(const GeometryRange& range)
+	{
+		m_vertexRanges.Free(range.firstVertex, range.vertexCount);
+
+		if (range.indexCount > 0)
+		{
+			m_indexRanges.Free(range.firstIndex, range.indexCount);
+		}
+	}
+
+	void GeometryPool::Bind(VkCommandBuffer commandBuffer) const
+	{
+		VkBuffer	 buffers[] = { m_vertexBuffer->GetBuffer() };
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+
+		vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+	}
+
+	void GeometryPool::Grow(UniqueRef<Buffer>& buffer, RangeAllocator& ranges, U32 elementSize, U32 count, VkBufferUsageFlags usage)
+	{
+		// The new space is appended, so `count` elements always fit at the end afterwards.
+		const U32 capacity = MathOp::Max(ranges.GetCapacity() * 2, ranges.GetCapacity() + count);
+
+		MP_INFO("GeometryPool: growing a buffer from {} to {} elements", ranges.GetCapacity(), capacity);
+
+		UniqueRef<Buffer> newBuffer = MakeUnique<Buffer>(
+			elementSize,
+			capacity,
+			usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		// The copy waits for the graphics queue to be idle, so no submitted frame still reads the old buffer.
+		// Growing while a frame is being recorded is not supported.
+		if (buffer)
+		{
+			m_device.CopyBuffer(buffer->GetBuffer(), newBuffer->GetBuffer(), buffer->GetBufferSize());
+		}
+
+		buffer = std::move(newBuffer);
+		ranges.Grow(capacity);
+	}
+
+	void GeometryPool::Upload(Buffer& buffer, VkDeviceSize offset, const void* data, VkDeviceSize size)
+	{
+		// Create staging buffer and it will be auto deleted.
+		Buffer stagingBuffer{
+			size,
+			1,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		};
+
+		stagingBuffer.Map();
+		stagingBuffer.WriteToBuffer(const_cast<void*>(data));
+
+		m_device.CopyBuffer(stagingBuffer.GetBuffer(), buffer.GetBuffer(), size, 0, offset);
+	}
+
+} // namespace Mapo
@@ -0,0 +1,69 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+#include "core/memory/range_allocator.h"
+
+#include <vulkan/vulkan.h>
+
+namespace Mapo
+{
+	class Device;
+	class Buffer;
+
+	// Where a mesh lives in the geometry pool, in elements (not bytes).
+	struct GeometryRange
+	{
+		U32 firstVertex = 0;
+		U32 vertexCount = 0;
+		U32 firstIndex = 0;
+		U32 indexCount = 0; // 0 for non-indexed meshes
+	};
+
+	// One device-local vertex buffer and one index buffer shared by all meshes. Meshes are sub-allocated as
+	// ranges and drawn with firstIndex/vertexOffset, so a single bind covers every draw of a frame. Both
+	// buffers double when they run out of space.
+	class GeometryPool
+	{
+	public:
+		static constexpr U32 INITIAL_VERTEX_CAPACITY = 1 << 18;
+		static constexpr U32 INITIAL_INDEX_CAPACITY = 1 << 20;
+
+		virtual ~GeometryPool();
+
+		explicit GeometryPool(U32 vertexStride);
+
+		GeometryPool(const GeometryPool&) = delete;
+		GeometryPool& operator=(const GeometryPool&) = delete;
+
+		// Uploads the vertices (vertexStride bytes each) and 32-bit indices. Indices stay relative to the
+		// mesh's first vertex.
+		GeometryRange Allocate(const void* vertices, U32 vertexCount, const U32* indices, U32 indexCount);
+		void		  Free(const GeometryRange& range);
+
+		// Binds the vertex buffer to binding 0 and the index buffer.
+		void Bind(VkCommandBuffer commandBuffer) const;
+
+		U32 GetVertexStride() const { return m_vertexStride; }
+		U32 GetUsedVertexCount() const { return m_vertexRanges.GetUsedCount(); }
+		U32 GetUsedIndexCount() const { return m_indexRanges.GetUsedCount(); }
+
+	private:
+		// Replaces the buffer with a larger one that keeps its contents and has room for `count` more elements.
+		void Grow(UniqueRef<Buffer>& buffer, RangeAllocator& ranges, U32 elementSize, U32 count, VkBufferUsageFlags usage);
+		void Upload(Buffer& buffer, VkDeviceSize offset, const void* data, VkDeviceSize size);
+
+	private:
+		Device& m_device;
+		U32		m_vertexStride;
+
+		UniqueRef<Buffer> m_vertexBuffer{};
+		UniqueRef<Buffer> m_indexBuffer{};
+		RangeAllocator	  m_vertexRanges{};
+		RangeAllocator	  m_indexRanges{};
+	};
+
+} // namespace Mapo
@@ -0,0 +1,463 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "gpu_culling.h"
+
+#include "engine/renderer/vk_common.h"
+#include "engine/renderer/render_context.h"
+#include "engine/renderer/renderer.h"
+#include "engine/renderer/device.h"
+#include "engine/renderer/buffer.h"
+#include "engine/renderer/pipeline.h"
+#include "engine/renderer/descriptors.h"
+#include "engine/renderer/hiz_pyramid.h"
+
+#include <filesystem>
+#include <cstring>
+
+namespace Mapo
+{
+	static constexpr U32 MIN_OBJECT_CAPACITY = 256;
+	static constexpr U32 MIN_BATCH_CAPACITY = 64;
+	static constexpr U32 WORKGROUP_SIZE = 64; // local_size_x of both compute shaders
+
+	static constexpr VkDeviceSize COMMAND_STRIDE = sizeof(VkDrawIndexedIndirectCommand);
+
+	// Matches the push constants of cull_instances.comp and compact_draws.comp.
+	struct CullPushConstants
+	{
+		Matrix4 viewProjection{ 1.0f }; // frustum planes are extracted in the shader
+		Vector2 pyramidSize{ 0.0f };
+		U32		objectCount = 0;
+		U32		batchCount = 0;
+		U32		phase = 0;
+	};
+
+	// Matches the phases in cull_instances.comp.
+	enum CullPhase : U32
+	{
+		CULL_PHASE_FRUSTUM = 0,	  // every object against the frustum
+		CULL_PHASE_OCCLUDERS = 1, // objects visible last frame against the frustum, into the occluder draws
+		CULL_PHASE_OCCLUSION = 2, // every object against the frustum and the Hi-Z pyramid
+	};
+
+	// Compute set bindings.
+	enum CullBinding : U32
+	{
+		CULL_BINDING_OBJECTS = 0,
+		CULL_BINDING_COMMANDS,
+		CULL_BINDING_VISIBLE,
+		CULL_BINDING_COMPACTED_COMMANDS,
+		CULL_BINDING_DRAW_COUNT,
+		CULL_BINDING_VISIBILITY,
+		CULL_BINDING_DEPTH_PYRAMID,
+		CULL_BINDING_COUNT
+	};
+
+	static constexpr U32 CULL_STORAGE_BUFFER_COUNT = CULL_BINDING_DEPTH_PYRAMID;
+
+	bool GpuCulling::IsSupported()
+	{
+		if (!RenderContext::GetDevice().SupportsDrawIndirectFirstInstance())
+		{
+			return false;
+		}
+
+		// Shaders are compiled offline (assets/shaders/compile.sh).
+		return std::filesystem::exists(CULL_SHADER) && std::filesystem::exists(COMPACT_SHADER)
+			&& std::filesystem::exists(HiZPyramid::DOWNSAMPLE_SHADER);
+	}
+
+	GpuCulling::GpuCulling()
+		: m_device(RenderContext::GetDevice())
+	{
+		const U32 frameCount = RenderContext::GetMaxFramesInFlight();
+
+		DescriptorSetLayout::Builder computeSetLayoutBuilder{};
+		for (U32 binding = 0; binding < CULL_STORAGE_BUFFER_COUNT; ++binding)
+		{
+			computeSetLayoutBuilder.AddBinding(binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT);
+		}
+		computeSetLayoutBuilder.AddBinding(CULL_BINDING_DEPTH_PYRAMID, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT);
+		m_computeSetLayout = computeSetLayoutBuilder.Build();
+
+		m_drawSetLayout = DescriptorSetLayout::Builder()
+							  .AddBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+							  .Build();
+
+		m_descriptorPool = DescriptorPool::Builder()
+							   .SetMaxSets(frameCount * 2)
+							   .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frameCount * (CULL_STORAGE_BUFFER_COUNT + 1))
+							   .AddPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount)
+							   .Build();
+
+		CreatePipelines();
+
+		// The culling shader always binds the pyramid, so it needs images before the first descriptor write.
+		Renderer& renderer = RenderContext::GetRenderer();
+		m_hiZPyramid = MakeUnique<HiZPyramid>();
+		m_hiZPyramid->Resize(renderer.GetSwapchainWidth(), renderer.GetSwapchainHeight());
+
+		m_frames.resize(frameCount);
+
+		for (U32 i = 0; i < frameCount; ++i)
+		{
+			m_frames[i].drawCountBuffer = MakeUnique<Buffer>(
+				sizeof(U32),
+				1,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+			ReserveObjects(i, MIN_OBJECT_CAPACITY);
+			ReserveBatches(i, MIN_BATCH_CAPACITY);
+		}
+	}
+
+	GpuCulling::~GpuCulling()
+	{
+		vkDestroyPipelineLayout(m_device.GetDevice(), m_computePipelineLayout, nullptr);
+	}
+
+	void GpuCulling::CreatePipelines()
+	{
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(CullPushConstants);
+
+		VkDescriptorSetLayout descriptorSetLayout = m_computeSetLayout->GetDescriptorSetLayout();
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+		VK_CHECK(vkCreatePipelineLayout(m_device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_computePipelineLayout));
+
+		m_cullPipeline = MakeUnique<Pipeline>(CULL_SHADER, m_computePipelineLayout);
+
+		// Without a GPU draw count every batch is drawn, empty ones included, so there is nothing to compact.
+		if (m_device.GetDrawIndexedIndirectCount())
+		{
+			m_compactPipeline = MakeUnique<Pipeline>(COMPACT_SHADER, m_computePipelineLayout);
+		}
+	}
+
+	VkDescriptorSetLayout GpuCulling::GetDrawSetLayout() const
+	{
+		return m_drawSetLayout->GetDescriptorSetLayout();
+	}
+
+	GpuCullData* GpuCulling::MapCullData(U32 frameIndex, U32 objectCount)
+	{
+		ReserveObjects(frameIndex, objectCount);
+		return static_cast<GpuCullData*>(m_frames[frameIndex].cullBuffer->GetMappedMemory());
+	}
+
+	VkDrawIndexedIndirectCommand* GpuCulling::MapDrawCommands(U32 frameIndex, U32 batchCount)
+	{
+		ReserveBatches(frameIndex, batchCount);
+		return static_cast<VkDrawIndexedIndirectCommand*>(m_frames[frameIndex].commandBuffer->GetMappedMemory());
+	}
+
+	const VkDrawIndexedIndirectCommand* GpuCulling::GetCulledDrawCommands(U32 frameIndex) const
+	{
+		return static_cast<const VkDrawIndexedIndirectCommand*>(m_frames[frameIndex].commandBuffer->GetMappedMemory());
+	}
+
+	void GpuCulling::SetViewportSize(U32 width, U32 height)
+	{
+		if (!m_hiZPyramid->Resize(width, height))
+		{
+			return;
+		}
+
+		// The device is idle, so every frame's set can be rewritten.
+		for (U32 i = 0; i < static_cast<U32>(m_frames.size()); ++i)
+		{
+			WriteDescriptorSets(i);
+		}
+	}
+
+	void GpuCulling::DispatchOccluders(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount)
+	{
+		MP_PROFILE_SCOPE("GpuCulling::DispatchOccluders");
+
+		// Like Dispatch, the occluder commands are written even without objects, since they are drawn anyway.
+		if (batchCount == 0)
+		{
+			return;
+		}
+
+		// The occluder commands follow the main ones, and their instances follow the main visible list.
+		VkDrawIndexedIndirectCommand* commands = static_cast<VkDrawIndexedIndirectCommand*>(m_frames[frameIndex].commandBuffer->GetMappedMemory());
+		std::memcpy(commands + batchCount, commands, batchCount * COMMAND_STRIDE);
+
+		for (U32 batch = batchCount; batch < batchCount * 2; ++batch)
+		{
+			commands[batch].firstInstance += objectCount;
+		}
+
+		DispatchCull(commandBuffer, frameIndex, viewProjection, objectCount, batchCount, CULL_PHASE_OCCLUDERS);
+	}
+
+	U32 GpuCulling::DrawOccluders(VkCommandBuffer commandBuffer, U32 frameIndex, U32 batchCount) const
+	{
+		return DrawCommands(commandBuffer, m_frames[frameIndex].commandBuffer->GetBuffer(), batchCount * COMMAND_STRIDE, batchCount);
+	}
+
+	void GpuCulling::Dispatch(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount,
+		bool occlusion)
+	{
+		MP_PROFILE_SCOPE("GpuCulling::Dispatch");
+
+		// Without objects the batches stay empty, but the draw count still has to be cleared.
+		if (batchCount == 0)
+		{
+			return;
+		}
+
+		if (occlusion)
+		{
+			m_hiZPyramid->Build(commandBuffer);
+		}
+
+		const FrameResources& frame = m_frames[frameIndex];
+
+		// The compaction pass appends to the draw count.
+		vkCmdFillBuffer(commandBuffer, frame.drawCountBuffer->GetBuffer(), 0, sizeof(U32), 0);
+
+		DispatchCull(commandBuffer, frameIndex, viewProjection, objectCount, batchCount, occlusion ? CULL_PHASE_OCCLUSION : CULL_PHASE_FRUSTUM);
+
+		if (m_compactPipeline)
+		{
+			// Same layout and push constants, so the bound set and constants stay valid.
+			m_compactPipeline->Bind(commandBuffer);
+			vkCmdDispatch(commandBuffer, (batchCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+			VkMemoryBarrier compactBarrier{};
+			compactBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			compactBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			compactBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0,
+				1, &compactBarrier, 0, nullptr, 0, nullptr);
+		}
+	}
+
+	U32 GpuCulling::Draw(VkCommandBuffer commandBuffer, U32 frameIndex, U32 batchCount) const
+	{
+		const FrameResources& frame = m_frames[frameIndex];
+
+		if (batchCount > 0 && m_compactPipeline)
+		{
+			m_device.GetDrawIndexedIndirectCount()(commandBuffer, frame.compactedCommandBuffer->GetBuffer(), 0,
+				frame.drawCountBuffer->GetBuffer(), 0, batchCount, static_cast<U32>(COMMAND_STRIDE));
+			return 1;
+		}
+
+		return DrawCommands(commandBuffer, frame.commandBuffer->GetBuffer(), 0, batchCount);
+	}
+
+	void GpuCulling::DispatchCull(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount,
+		U32 phase)
+	{
+		const FrameResources& frame = m_frames[frameIndex];
+
+		CullPushConstants push{};
+		push.viewProjection = viewProjection;
+		push.pyramidSize = m_hiZPyramid->GetSize();
+		push.objectCount = objectCount;
+		push.batchCount = batchCount;
+		push.phase = phase;
+
+		// Visibility was written by the last culling pass, possibly of the previous frame; the draw count may
+		// just have been cleared.
+		VkMemoryBarrier inputBarrier{};
+		inputBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		inputBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		inputBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &inputBarrier, 0, nullptr, 0, nullptr);
+
+		m_cullPipeline->Bind(commandBuffer);
+
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipelineLayout, 0, 1, &frame.computeSet, 0, nullptr);
+		vkCmdPushConstants(commandBuffer, m_computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push);
+		vkCmdDispatch(commandBuffer, (objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+		// Draws read the commands as indirect arguments and the visible list in the vertex shader; the
+		// compaction pass reads the commands too, and the host reads the instance counts back for the stats.
+		VkMemoryBarrier cullBarrier{};
+		cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+			| VK_ACCESS_HOST_READ_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+				| VK_PIPELINE_STAGE_HOST_BIT,
+			0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	U32 GpuCulling::DrawCommands(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, U32 batchCount) const
+	{
+		if (batchCount == 0)
+		{
+			return 0;
+		}
+
+		// Empty batches are drawn with zero instances.
+		if (m_device.SupportsMultiDrawIndirect())
+		{
+			vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, batchCount, static_cast<U32>(COMMAND_STRIDE));
+			return 1;
+		}
+
+		for (U32 batch = 0; batch < batchCount; ++batch)
+		{
+			vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset + batch * COMMAND_STRIDE, 1, static_cast<U32>(COMMAND_STRIDE));
+		}
+
+		return batchCount;
+	}
+
+	void GpuCulling::ReserveObjects(U32 frameIndex, U32 objectCount)
+	{
+		FrameResources& frame = m_frames[frameIndex];
+
+		if (frame.cullBuffer && frame.cullBuffer->GetInstanceCount() >= objectCount)
+		{
+			return;
+		}
+
+		// The fence of this frame has been waited on, so neither the old buffers nor the sets are in use.
+		U32 capacity = frame.cullBuffer ? frame.cullBuffer->GetInstanceCount() * 2 : MIN_OBJECT_CAPACITY;
+		capacity = MathOp::Max(capacity, objectCount);
+
+		UniqueRef<Buffer> cullBuffer = MakeUnique<Buffer>(
+			sizeof(GpuCullData),
+			capacity,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		cullBuffer->Map();
+
+		// Objects are only written when they change, so the old ones move along.
+		if (frame.cullBuffer)
+		{
+			std::memcpy(cullBuffer->GetMappedMemory(), frame.cullBuffer->GetMappedMemory(), frame.cullBuffer->GetBufferSize());
+		}
+
+		frame.cullBuffer = std::move(cullBuffer);
+
+		// Every object can be visible, and every object can be an occluder.
+		frame.visibleBuffer = MakeUnique<Buffer>(
+			sizeof(U32),
+			capacity * 2,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		if (m_visibilityBuffer && m_visibilityBuffer->GetInstanceCount() >= capacity)
+		{
+			WriteDescriptorSets(frameIndex);
+			return;
+		}
+
+		// The other frames still use the shared visibility. Growing is rare, so wait for them.
+		m_device.WaitIdle();
+
+		m_visibilityBuffer = MakeUnique<Buffer>(
+			sizeof(U32),
+			capacity,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		// Nothing was visible: the next occluder pass draws nothing and occlusion culls nothing for a frame.
+		VkCommandBuffer fillCommandBuffer = m_device.BeginSingleTimeCommands();
+		vkCmdFillBuffer(fillCommandBuffer, m_visibilityBuffer->GetBuffer(), 0, VK_WHOLE_SIZE, 0);
+		m_device.EndSingleTimeCommands(fillCommandBuffer);
+
+		for (U32 i = 0; i < static_cast<U32>(m_frames.size()); ++i)
+		{
+			WriteDescriptorSets(i);
+		}
+	}
+
+	void GpuCulling::ReserveBatches(U32 frameIndex, U32 batchCount)
+	{
+		FrameResources& frame = m_frames[frameIndex];
+
+		if (frame.commandBuffer && frame.commandBuffer->GetInstanceCount() >= batchCount * 2)
+		{
+			return;
+		}
+
+		U32 capacity = frame.commandBuffer ? frame.commandBuffer->GetInstanceCount() : MIN_BATCH_CAPACITY;
+		capacity = MathOp::Max(capacity, batchCount);
+
+		// Main commands, then the occluder commands.
+		frame.commandBuffer = MakeUnique<Buffer>(
+			COMMAND_STRIDE,
+			capacity * 2,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		frame.commandBuffer->Map();
+
+		frame.compactedCommandBuffer = MakeUnique<Buffer>(
+			COMMAND_STRIDE,
+			capacity,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		WriteDescriptorSets(frameIndex);
+	}
+
+	void GpuCulling::WriteDescriptorSets(U32 frameIndex)
+	{
+		FrameResources& frame = m_frames[frameIndex];
+
+		// The constructor reserves objects before batches; wait until both exist.
+		if (!frame.cullBuffer || !frame.commandBuffer)
+		{
+			return;
+		}
+
+		VkDescriptorBufferInfo objectsInfo = frame.cullBuffer->DescriptorInfo();
+		VkDescriptorBufferInfo commandsInfo = frame.commandBuffer->DescriptorInfo();
+		VkDescriptorBufferInfo visibleInfo = frame.visibleBuffer->DescriptorInfo();
+		VkDescriptorBufferInfo compactedInfo = frame.compactedCommandBuffer->DescriptorInfo();
+		VkDescriptorBufferInfo drawCountInfo = frame.drawCountBuffer->DescriptorInfo();
+		VkDescriptorBufferInfo visibilityInfo = m_visibilityBuffer->DescriptorInfo();
+		VkDescriptorImageInfo  pyramidInfo = m_hiZPyramid->GetDescriptorInfo();
+
+		DescriptorWriter computeWriter(*m_computeSetLayout, *m_descriptorPool);
+		computeWriter.WriteBuffer(CULL_BINDING_OBJECTS, &objectsInfo)
+			.WriteBuffer(CULL_BINDING_COMMANDS, &commandsInfo)
+			.WriteBuffer(CULL_BINDING_VISIBLE, &visibleInfo)
+			.WriteBuffer(CULL_BINDING_COMPACTED_COMMANDS, &compactedInfo)
+			.WriteBuffer(CULL_BINDING_DRAW_COUNT, &drawCountInfo)
+			.WriteBuffer(CULL_BINDING_VISIBILITY, &visibilityInfo)
+			.WriteImage(CULL_BINDING_DEPTH_PYRAMID, &pyramidInfo);
+
+		DescriptorWriter drawWriter(*m_drawSetLayout, *m_descriptorPool);
+		drawWriter.WriteBuffer(0, &visibleInfo);
+
+		if (frame.computeSet == VK_NULL_HANDLE)
+		{
+			computeWriter.Build(frame.computeSet);
+			drawWriter.Build(frame.drawSet);
+		}
+		else
+		{
+			computeWriter.Overwrite(frame.computeSet);
+			drawWriter.Overwrite(frame.drawSet);
+		}
+	}
+
+} // namespace Mapo
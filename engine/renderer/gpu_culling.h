@@ -0,0 +1,140 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace Mapo
+{
+	class Device;
+	class Buffer;
+	class Pipeline;
+	class DescriptorSetLayout;
+	class DescriptorPool;
+	class HiZPyramid;
+
+	// Bounds of one object as the culling shader reads them, std430 layout. Matches CullData in cull_instances.comp.
+	struct GpuCullData
+	{
+		static constexpr U32 INVALID_BATCH = ~0u; // the object is never drawn
+
+		Vector3 center{ 0.0f };
+		F32		radius = 0.0f;
+		Vector3 extent{ 0.0f };
+		U32		batchIndex = INVALID_BATCH;
+	};
+
+	static_assert(sizeof(GpuCullData) == 32, "GpuCullData must match the std430 layout in the shaders!");
+
+	// Frustum culling and draw generation on the GPU. Objects are grouped into batches, one indexed indirect
+	// draw each. The CPU writes every batch's command with instanceCount 0 and firstInstance at the start of the
+	// batch's slice in the visible list; the culling shader appends each visible object to its batch's slice
+	// with an atomic add on instanceCount. With VK_KHR_draw_indirect_count a second pass compacts the non-empty
+	// commands, so the draw count comes from the GPU as well.
+	//
+	// Occlusion culling is two-phase. The objects visible last frame are drawn as occluders into a depth prepass,
+	// the Hi-Z pyramid is built from that depth, and then every object is tested against the pyramid. The result
+	// is drawn and becomes next frame's occluder set. The pyramid only contains geometry that is really there,
+	// so nothing visible is culled; objects that come into view are caught in the same frame instead of popping
+	// in one frame late.
+	class GpuCulling
+	{
+	public:
+		static constexpr const char* CULL_SHADER = "assets/shaders/cull_instances.comp.spv";
+		static constexpr const char* COMPACT_SHADER = "assets/shaders/compact_draws.comp.spv";
+
+		// The device needs drawIndirectFirstInstance and the compute shaders need to be compiled.
+		static bool IsSupported();
+
+		virtual ~GpuCulling();
+
+		GpuCulling();
+
+		GpuCulling(const GpuCulling&) = delete;
+		GpuCulling& operator=(const GpuCulling&) = delete;
+
+		// Mapped inputs of the frame, valid until the next Map of the same frame. The memory is host coherent,
+		// so writing it is the upload. Cull data is kept when the buffer grows, so only changed objects need
+		// writing; draw commands are not.
+		GpuCullData*				  MapCullData(U32 frameIndex, U32 objectCount);
+		VkDrawIndexedIndirectCommand* MapDrawCommands(U32 frameIndex, U32 batchCount);
+
+		// Draw commands as the frame was last culled, with the instance counts the shader wrote. Only valid
+		// once the frame's fence has been waited on, and before MapDrawCommands of the same frame.
+		const VkDrawIndexedIndirectCommand* GetCulledDrawCommands(U32 frameIndex) const;
+
+		// Sizes the Hi-Z pyramid like the render target. Call before any culling of the frame is recorded.
+		void SetViewportSize(U32 width, U32 height);
+
+		// Phase 1 of occlusion culling: frustum culls the objects visible last frame into the occluder draws.
+		// The draw commands must be written. Must be recorded outside of a render pass.
+		void DispatchOccluders(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount);
+
+		// Records the occluder draws and returns how many draw calls that took. Same requirements as Draw, inside
+		// the depth pass of GetHiZPyramid().
+		U32 DrawOccluders(VkCommandBuffer commandBuffer, U32 frameIndex, U32 batchCount) const;
+
+		// Records the culling of all objects, against the frustum and, after DispatchOccluders and the depth pass,
+		// the Hi-Z pyramid built here. Must be recorded outside of a render pass, before Draw.
+		void Dispatch(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount,
+			bool occlusion);
+
+		// Records the draws of all batches and returns how many draw calls that took. The geometry pool and a
+		// pipeline whose layout includes GetDrawSetLayout() must be bound.
+		U32 Draw(VkCommandBuffer commandBuffer, U32 frameIndex, U32 batchCount) const;
+
+		HiZPyramid& GetHiZPyramid() const { return *m_hiZPyramid; }
+
+		// Binding 0 holds the object index of every visible instance, read with gl_InstanceIndex.
+		VkDescriptorSetLayout GetDrawSetLayout() const;
+		VkDescriptorSet		  GetDrawSet(U32 frameIndex) const { return m_frames[frameIndex].drawSet; }
+
+	private:
+		struct FrameResources
+		{
+			UniqueRef<Buffer> cullBuffer{};				// GpuCullData per object, host visible
+			UniqueRef<Buffer> visibleBuffer{};			// object index per visible instance, then per occluder
+			UniqueRef<Buffer> commandBuffer{};			// draw command per batch, then per occluder batch
+			UniqueRef<Buffer> compactedCommandBuffer{}; // non-empty draw commands
+			UniqueRef<Buffer> drawCountBuffer{};		// number of compacted commands
+
+			VkDescriptorSet computeSet = VK_NULL_HANDLE;
+			VkDescriptorSet drawSet = VK_NULL_HANDLE;
+		};
+
+		void CreatePipelines();
+
+		void DispatchCull(VkCommandBuffer commandBuffer, U32 frameIndex, const Matrix4& viewProjection, U32 objectCount, U32 batchCount,
+			U32 phase);
+		U32	 DrawCommands(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, U32 batchCount) const;
+
+		// Grow the frame's buffers and point its descriptor sets at the new ones. Visibility is shared by all
+		// frames, since each frame reads what the previous one wrote.
+		void ReserveObjects(U32 frameIndex, U32 objectCount);
+		void ReserveBatches(U32 frameIndex, U32 batchCount);
+		void WriteDescriptorSets(U32 frameIndex);
+
+	private:
+		Device& m_device;
+
+		UniqueRef<DescriptorSetLayout> m_computeSetLayout{};
+		UniqueRef<DescriptorSetLayout> m_drawSetLayout{};
+		UniqueRef<DescriptorPool>	   m_descriptorPool{};
+
+		VkPipelineLayout	m_computePipelineLayout = VK_NULL_HANDLE;
+		UniqueRef<Pipeline> m_cullPipeline{};
+		UniqueRef<Pipeline> m_compactPipeline{}; // null without VK_KHR_draw_indirect_count
+
+		UniqueRef<HiZPyramid> m_hiZPyramid{};
+		UniqueRef<Buffer>	  m_visibilityBuffer{}; // 1 for every object visible in the last culled frame
+
+		std::vector<FrameResources> m_frames{};
+	};
+
+} // namespace Mapo
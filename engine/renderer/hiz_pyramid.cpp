@@ -0,0 +1,410 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "hiz_pyramid.h"
+
+#include "engine/renderer/vk_common.h"
+#include "engine/renderer/render_context.h"
+#include "engine/renderer/device.h"
+#include "engine/renderer/pipeline.h"
+#include "engine/renderer/descriptors.h"
+
+#include <array>
+
+namespace Mapo
+{
+	static constexpr U32 WORKGROUP_SIZE = 8; // local_size_x and local_size_y of hiz_downsample.comp
+
+	// Matches the push constants of hiz_downsample.comp.
+	struct DownsamplePushConstants
+	{
+		U32 inputWidth = 0;
+		U32 inputHeight = 0;
+		U32 outputWidth = 0;
+		U32 outputHeight = 0;
+	};
+
+	static U32 PreviousPowerOfTwo(U32 value)
+	{
+		U32 result = 1;
+		while (result * 2 <= value)
+		{
+			result *= 2;
+		}
+		return result;
+	}
+
+	HiZPyramid::HiZPyramid()
+		: m_device(RenderContext::GetDevice())
+	{
+		m_depthFormat = m_device.FindSupportedFormat({ VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
+			VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+
+		CreateDepthRenderPass();
+		CreateSampler();
+		CreateDownsamplePipeline();
+	}
+
+	HiZPyramid::~HiZPyramid()
+	{
+		DestroyImages();
+
+		vkDestroyPipelineLayout(m_device.GetDevice(), m_pipelineLayout, nullptr);
+		vkDestroySampler(m_device.GetDevice(), m_sampler, nullptr);
+		vkDestroyRenderPass(m_device.GetDevice(), m_depthRenderPass, nullptr);
+	}
+
+	bool HiZPyramid::Resize(U32 width, U32 height)
+	{
+		// A minimized window keeps the old images.
+		if ((width == m_depthWidth && height == m_depthHeight) || width == 0 || height == 0)
+		{
+			return false;
+		}
+
+		// Frames in flight may still read the old images.
+		m_device.WaitIdle();
+
+		DestroyImages();
+
+		m_depthWidth = width;
+		m_depthHeight = height;
+		CreateImages();
+
+		return true;
+	}
+
+	VkDescriptorImageInfo HiZPyramid::GetDescriptorInfo() const
+	{
+		return VkDescriptorImageInfo{ m_sampler, m_pyramidImageView, VK_IMAGE_LAYOUT_GENERAL };
+	}
+
+	void HiZPyramid::BeginDepthPass(VkCommandBuffer commandBuffer)
+	{
+		MP_ASSERT(m_framebuffer != VK_NULL_HANDLE, "HiZPyramid has not been sized yet!");
+
+		VkClearValue clearValue{};
+		clearValue.depthStencil = { 1.0f, 0 };
+
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.renderPass = m_depthRenderPass;
+		renderPassBeginInfo.framebuffer = m_framebuffer;
+		renderPassBeginInfo.renderArea.offset = { 0, 0 };
+		renderPassBeginInfo.renderArea.extent = { m_depthWidth, m_depthHeight };
+		renderPassBeginInfo.clearValueCount = 1;
+		renderPassBeginInfo.pClearValues = &clearValue;
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = static_cast<F32>(m_depthWidth);
+		viewport.height = static_cast<F32>(m_depthHeight);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = { m_depthWidth, m_depthHeight };
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	}
+
+	void HiZPyramid::EndDepthPass(VkCommandBuffer commandBuffer)
+	{
+		vkCmdEndRenderPass(commandBuffer);
+	}
+
+	void HiZPyramid::Build(VkCommandBuffer commandBuffer)
+	{
+		MP_PROFILE_SCOPE("HiZPyramid::Build");
+
+		// The previous frame may still be culling against the pyramid (write after read).
+		VkMemoryBarrier readBarrier{};
+		readBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		readBarrier.srcAccessMask = 0;
+		readBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			1, &readBarrier, 0, nullptr, 0, nullptr);
+
+		m_downsamplePipeline->Bind(commandBuffer);
+
+		U32 inputWidth = m_depthWidth;
+		U32 inputHeight = m_depthHeight;
+
+		for (U32 level = 0; level < m_levelCount; ++level)
+		{
+			DownsamplePushConstants push{};
+			push.inputWidth = inputWidth;
+			push.inputHeight = inputHeight;
+			push.outputWidth = MathOp::Max(m_pyramidWidth >> level, 1u);
+			push.outputHeight = MathOp::Max(m_pyramidHeight >> level, 1u);
+
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &m_levelSets[level], 0, nullptr);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DownsamplePushConstants), &push);
+			vkCmdDispatch(commandBuffer,
+				(push.outputWidth + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+				(push.outputHeight + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+				1);
+
+			// The next level reads this one; after the last level the culling shader reads the pyramid.
+			VkMemoryBarrier levelBarrier{};
+			levelBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+				1, &levelBarrier, 0, nullptr, 0, nullptr);
+
+			inputWidth = push.outputWidth;
+			inputHeight = push.outputHeight;
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Functions to create Vulkan resources
+	/////////////////////////////////////////////////////////////////////////////////
+
+	void HiZPyramid::CreateDepthRenderPass()
+	{
+		VkAttachmentDescription depthAttachment{};
+		depthAttachment.format = m_depthFormat;
+		depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // read by the downsample shader
+		depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		depthAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		VkAttachmentReference depthAttachmentRef{};
+		depthAttachmentRef.attachment = 0;
+		depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDescription subpassDescription{};
+		subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpassDescription.colorAttachmentCount = 0;
+		subpassDescription.pDepthStencilAttachment = &depthAttachmentRef;
+
+		std::array<VkSubpassDependency, 2> dependencies{};
+
+		// The previous frame's downsample has to finish reading the depth before it is cleared.
+		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		dependencies[0].srcAccessMask = 0;
+		dependencies[0].dstSubpass = 0;
+		dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+		// The downsample reads the depth after the pass.
+		dependencies[1].srcSubpass = 0;
+		dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		VkRenderPassCreateInfo renderPassCreateInfo{};
+		renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassCreateInfo.attachmentCount = 1;
+		renderPassCreateInfo.pAttachments = &depthAttachment;
+		renderPassCreateInfo.subpassCount = 1;
+		renderPassCreateInfo.pSubpasses = &subpassDescription;
+		renderPassCreateInfo.dependencyCount = static_cast<U32>(dependencies.size());
+		renderPassCreateInfo.pDependencies = dependencies.data();
+
+		VK_CHECK(vkCreateRenderPass(m_device.GetDevice(), &renderPassCreateInfo, nullptr, &m_depthRenderPass));
+	}
+
+	void HiZPyramid::CreateSampler()
+	{
+		// Texels are read whole; the culling shader picks a level where a bound covers at most 2x2 of them.
+		VkSamplerCreateInfo samplerInfo{};
+		samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerInfo.magFilter = VK_FILTER_NEAREST;
+		samplerInfo.minFilter = VK_FILTER_NEAREST;
+		samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.minLod = 0.0f;
+		samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+		VK_CHECK(vkCreateSampler(m_device.GetDevice(), &samplerInfo, nullptr, &m_sampler));
+	}
+
+	void HiZPyramid::CreateDownsamplePipeline()
+	{
+		m_setLayout = DescriptorSetLayout::Builder()
+						  .AddBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT)
+						  .AddBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT)
+						  .Build();
+
+		m_descriptorPool = DescriptorPool::Builder()
+							   .SetMaxSets(MAX_LEVEL_COUNT)
+							   .AddPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_LEVEL_COUNT)
+							   .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, MAX_LEVEL_COUNT)
+							   .Build();
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(DownsamplePushConstants);
+
+		VkDescriptorSetLayout descriptorSetLayout = m_setLayout->GetDescriptorSetLayout();
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+		VK_CHECK(vkCreatePipelineLayout(m_device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout));
+
+		m_downsamplePipeline = MakeUnique<Pipeline>(DOWNSAMPLE_SHADER, m_pipelineLayout);
+	}
+
+	void HiZPyramid::CreateImages()
+	{
+		MP_INFO("HiZPyramid: creating images for {} x {}", m_depthWidth, m_depthHeight);
+
+		// Prepass depth
+		VkImageCreateInfo depthImageInfo{};
+		depthImageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		depthImageInfo.imageType = VK_IMAGE_TYPE_2D;
+		depthImageInfo.extent = { m_depthWidth, m_depthHeight, 1 };
+		depthImageInfo.mipLevels = 1;
+		depthImageInfo.arrayLayers = 1;
+		depthImageInfo.format = m_depthFormat;
+		depthImageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		depthImageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		depthImageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		depthImageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		depthImageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+		m_device.CreateImageWithInfo(depthImageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_depthImage, m_depthImageMemory);
+		m_depthImageView = CreateImageView(m_depthImage, m_depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1);
+
+		VkFramebufferCreateInfo framebufferCreateInfo{};
+		framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferCreateInfo.renderPass = m_depthRenderPass;
+		framebufferCreateInfo.attachmentCount = 1;
+		framebufferCreateInfo.pAttachments = &m_depthImageView;
+		framebufferCreateInfo.width = m_depthWidth;
+		framebufferCreateInfo.height = m_depthHeight;
+		framebufferCreateInfo.layers = 1;
+
+		VK_CHECK(vkCreateFramebuffer(m_device.GetDevice(), &framebufferCreateInfo, nullptr, &m_framebuffer));
+
+		// Pyramid
+		m_pyramidWidth = PreviousPowerOfTwo(m_depthWidth);
+		m_pyramidHeight = PreviousPowerOfTwo(m_depthHeight);
+		m_levelCount = 1;
+		while ((MathOp::Max(m_pyramidWidth, m_pyramidHeight) >> m_levelCount) > 0 && m_levelCount < MAX_LEVEL_COUNT)
+		{
+			++m_levelCount;
+		}
+
+		VkImageCreateInfo pyramidImageInfo = depthImageInfo;
+		pyramidImageInfo.extent = { m_pyramidWidth, m_pyramidHeight, 1 };
+		pyramidImageInfo.mipLevels = m_levelCount;
+		pyramidImageInfo.format = VK_FORMAT_R32_SFLOAT;
+		pyramidImageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+		m_device.CreateImageWithInfo(pyramidImageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_pyramidImage, m_pyramidImageMemory);
+		m_pyramidImageView = CreateImageView(m_pyramidImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, 0, m_levelCount);
+
+		// The pyramid is written and read as a storage and sampled image, so it lives in the general layout.
+		VkCommandBuffer commandBuffer = m_device.BeginSingleTimeCommands();
+
+		VkImageMemoryBarrier layoutBarrier{};
+		layoutBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		layoutBarrier.srcAccessMask = 0;
+		layoutBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		layoutBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		layoutBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+		layoutBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		layoutBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		layoutBarrier.image = m_pyramidImage;
+		layoutBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_levelCount, 0, 1 };
+
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			0, nullptr, 0, nullptr, 1, &layoutBarrier);
+
+		m_device.EndSingleTimeCommands(commandBuffer);
+
+		// Level i reads level i - 1, level 0 reads the depth.
+		m_descriptorPool->ResetPool();
+
+		for (U32 level = 0; level < m_levelCount; ++level)
+		{
+			m_levelViews[level] = CreateImageView(m_pyramidImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, level, 1);
+
+			VkDescriptorImageInfo inputInfo = level == 0
+				? VkDescriptorImageInfo{ m_sampler, m_depthImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL }
+				: VkDescriptorImageInfo{ m_sampler, m_levelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL };
+			VkDescriptorImageInfo outputInfo{ VK_NULL_HANDLE, m_levelViews[level], VK_IMAGE_LAYOUT_GENERAL };
+
+			DescriptorWriter(*m_setLayout, *m_descriptorPool)
+				.WriteImage(0, &inputInfo)
+				.WriteImage(1, &outputInfo)
+				.Build(m_levelSets[level]);
+		}
+	}
+
+	void HiZPyramid::DestroyImages()
+	{
+		VkDevice device = m_device.GetDevice();
+
+		for (U32 level = 0; level < m_levelCount; ++level)
+		{
+			vkDestroyImageView(device, m_levelViews[level], nullptr);
+			m_levelViews[level] = VK_NULL_HANDLE;
+			m_levelSets[level] = VK_NULL_HANDLE;
+		}
+
+		// Destroying null handles is a no-op.
+		vkDestroyImageView(device, m_pyramidImageView, nullptr);
+		vkDestroyImage(device, m_pyramidImage, nullptr);
+		vkFreeMemory(device, m_pyramidImageMemory, nullptr);
+
+		vkDestroyFramebuffer(device, m_framebuffer, nullptr);
+		vkDestroyImageView(device, m_depthImageView, nullptr);
+		vkDestroyImage(device, m_depthImage, nullptr);
+		vkFreeMemory(device, m_depthImageMemory, nullptr);
+
+		m_pyramidImageView = VK_NULL_HANDLE;
+		m_pyramidImage = VK_NULL_HANDLE;
+		m_pyramidImageMemory = VK_NULL_HANDLE;
+		m_framebuffer = VK_NULL_HANDLE;
+		m_depthImageView = VK_NULL_HANDLE;
+		m_depthImage = VK_NULL_HANDLE;
+		m_depthImageMemory = VK_NULL_HANDLE;
+		m_levelCount = 0;
+	}
+
+	VkImageView HiZPyramid::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, U32 baseLevel, U32 levelCount)
+	{
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = format;
+		viewInfo.subresourceRange.aspectMask = aspectFlags;
+		viewInfo.subresourceRange.baseMipLevel = baseLevel;
+		viewInfo.subresourceRange.levelCount = levelCount;
+		viewInfo.subresourceRange.baseArrayLayer = 0;
+		viewInfo.subresourceRange.layerCount = 1;
+
+		VkImageView imageView;
+		VK_CHECK(vkCreateImageView(m_device.GetDevice(), &viewInfo, nullptr, &imageView));
+
+		return imageView;
+	}
+
+} // namespace Mapo
@@ -0,0 +1,91 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vulkan/vulkan.h>
+
+namespace Mapo
+{
+	class Device;
+	class Pipeline;
+	class DescriptorSetLayout;
+	class DescriptorPool;
+
+	// Depth prepass target and the hierarchical-Z pyramid reduced from it. Level 0 maps the depth buffer onto the
+	// previous power of two, and every texel holds the farthest depth of what it covers in the level below. A bound
+	// whose nearest depth is behind the pyramid texels under its screen rectangle is hidden.
+	class HiZPyramid
+	{
+	public:
+		static constexpr const char* DOWNSAMPLE_SHADER = "assets/shaders/hiz_downsample.comp.spv";
+		static constexpr U32		 MAX_LEVEL_COUNT = 16;
+
+		virtual ~HiZPyramid();
+
+		HiZPyramid();
+
+		HiZPyramid(const HiZPyramid&) = delete;
+		HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+		// Recreates the images if the depth size changed and returns whether it did. Waits for the device.
+		bool Resize(U32 width, U32 height);
+
+		// Depth-only pass into the prepass depth buffer, with viewport and scissor set.
+		void BeginDepthPass(VkCommandBuffer commandBuffer);
+		void EndDepthPass(VkCommandBuffer commandBuffer);
+
+		// Reduces the prepass depth into the pyramid. Must be recorded after EndDepthPass.
+		void Build(VkCommandBuffer commandBuffer);
+
+		VkRenderPass GetDepthRenderPass() const { return m_depthRenderPass; }
+
+		// All levels with a nearest, clamped sampler. The pyramid stays in VK_IMAGE_LAYOUT_GENERAL.
+		VkDescriptorImageInfo GetDescriptorInfo() const;
+		Vector2				  GetSize() const { return { static_cast<F32>(m_pyramidWidth), static_cast<F32>(m_pyramidHeight) }; }
+
+	private:
+		void CreateDepthRenderPass();
+		void CreateSampler();
+		void CreateDownsamplePipeline();
+
+		void CreateImages();
+		void DestroyImages();
+
+		VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, U32 baseLevel, U32 levelCount);
+
+	private:
+		Device&	 m_device;
+		VkFormat m_depthFormat = VK_FORMAT_UNDEFINED;
+
+		VkRenderPass m_depthRenderPass = VK_NULL_HANDLE;
+		VkSampler	 m_sampler = VK_NULL_HANDLE;
+
+		UniqueRef<DescriptorSetLayout> m_setLayout{};
+		UniqueRef<DescriptorPool>	   m_descriptorPool{};
+		VkPipelineLayout			   m_pipelineLayout = VK_NULL_HANDLE;
+		UniqueRef<Pipeline>			   m_downsamplePipeline{};
+
+		// Prepass depth, sized like the swapchain
+		U32			   m_depthWidth = 0;
+		U32			   m_depthHeight = 0;
+		VkImage		   m_depthImage = VK_NULL_HANDLE;
+		VkDeviceMemory m_depthImageMemory = VK_NULL_HANDLE;
+		VkImageView	   m_depthImageView = VK_NULL_HANDLE;
+		VkFramebuffer  m_framebuffer = VK_NULL_HANDLE;
+
+		// Pyramid, one view and downsample set per level
+		U32				m_pyramidWidth = 0;
+		U32				m_pyramidHeight = 0;
+		U32				m_levelCount = 0;
+		VkImage			m_pyramidImage = VK_NULL_HANDLE;
+		VkDeviceMemory	m_pyramidImageMemory = VK_NULL_HANDLE;
+		VkImageView		m_pyramidImageView = VK_NULL_HANDLE;
+		VkImageView		m_levelViews[MAX_LEVEL_COUNT]{};
+		VkDescriptorSet m_levelSets[MAX_LEVEL_COUNT]{};
+	};
+
+} // namespace Mapo
@@ -0,0 +1,109 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "object_buffer.h"
+
+#include "engine/renderer/render_context.h"
+#include "engine/renderer/buffer.h"
+#include "engine/renderer/descriptors.h"
+
+#include <cstring>
+
+namespace Mapo
+{
+	static constexpr U32 MIN_OBJECT_CAPACITY = 256;
+
+	void ObjectData::Set(const Matrix4& modelMatrix, const Matrix4& normalMatrix, U32 material)
+	{
+		for (U32 row = 0; row < 3; ++row)
+		{
+			modelRows[row] = { modelMatrix[0][row], modelMatrix[1][row], modelMatrix[2][row], modelMatrix[3][row] };
+		}
+
+		normalColumn0 = Vector3(normalMatrix[0]);
+		normalColumn1 = Vector3(normalMatrix[1]);
+		normalColumn2 = Vector3(normalMatrix[2]);
+		materialIndex = material;
+	}
+
+	ObjectBuffer::ObjectBuffer()
+	{
+		const U32 frameCount = RenderContext::GetMaxFramesInFlight();
+
+		m_setLayout = DescriptorSetLayout::Builder()
+						  .AddBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+						  .Build();
+
+		m_descriptorPool = DescriptorPool::Builder()
+							   .SetMaxSets(frameCount)
+							   .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frameCount)
+							   .Build();
+
+		m_buffers.resize(frameCount);
+		m_descriptorSets.resize(frameCount, VK_NULL_HANDLE);
+
+		for (U32 i = 0; i < frameCount; ++i)
+		{
+			Reserve(i, MIN_OBJECT_CAPACITY);
+		}
+	}
+
+	ObjectBuffer::~ObjectBuffer()
+	{
+	}
+
+	VkDescriptorSetLayout ObjectBuffer::GetDescriptorSetLayout() const
+	{
+		return m_setLayout->GetDescriptorSetLayout();
+	}
+
+	ObjectData* ObjectBuffer::Map(U32 frameIndex, U32 objectCount)
+	{
+		Reserve(frameIndex, objectCount);
+		return static_cast<ObjectData*>(m_buffers[frameIndex]->GetMappedMemory());
+	}
+
+	void ObjectBuffer::Reserve(U32 frameIndex, U32 objectCount)
+	{
+		UniqueRef<Buffer>& buffer = m_buffers[frameIndex];
+
+		if (buffer && buffer->GetInstanceCount() >= objectCount)
+		{
+			return;
+		}
+
+		// The fence of this frame has been waited on, so neither the old buffer nor the set is in use.
+		U32 capacity = buffer ? buffer->GetInstanceCount() * 2 : MIN_OBJECT_CAPACITY;
+		capacity = MathOp::Max(capacity, objectCount);
+
+		UniqueRef<Buffer> grownBuffer = MakeUnique<Buffer>(
+			sizeof(ObjectData),
+			capacity,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		grownBuffer->Map();
+
+		if (buffer)
+		{
+			std::memcpy(grownBuffer->GetMappedMemory(), buffer->GetMappedMemory(), buffer->GetBufferSize());
+		}
+
+		buffer = std::move(grownBuffer);
+
+		VkDescriptorBufferInfo bufferInfo = buffer->DescriptorInfo();
+		DescriptorWriter	   writer(*m_setLayout, *m_descriptorPool);
+		writer.WriteBuffer(0, &bufferInfo);
+
+		if (m_descriptorSets[frameIndex] == VK_NULL_HANDLE)
+		{
+			writer.Build(m_descriptorSets[frameIndex]);
+		}
+		else
+		{
+			writer.Overwrite(m_descriptorSets[frameIndex]);
+		}
+	}
+
+} // namespace Mapo
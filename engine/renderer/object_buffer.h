@@ -0,0 +1,68 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace Mapo
+{
+	class Buffer;
+	class DescriptorSetLayout;
+	class DescriptorPool;
+
+	// Per-object shader data, std430 layout. Matches ObjectData in the simple_shader vertex shaders.
+	struct ObjectData
+	{
+		Vector4 modelRows[3]; // 3x4 model matrix, stored by rows
+		Vector3 normalColumn0;
+		U32		materialIndex = 0;
+		Vector3 normalColumn1;
+		F32		padding0 = 0.0f;
+		Vector3 normalColumn2;
+		F32		padding1 = 0.0f;
+
+		void Set(const Matrix4& modelMatrix, const Matrix4& normalMatrix, U32 material = 0);
+	};
+
+	static_assert(sizeof(ObjectData) == 96, "ObjectData must match the std430 layout in the shaders!");
+
+	// Storage buffer with the ObjectData of everything drawn in a frame, one per frame in flight. Shaders read
+	// it from its own descriptor set. Instanced and indirect draws index it with gl_InstanceIndex and pick their
+	// objects through firstInstance; per-object draws push the index.
+	class ObjectBuffer
+	{
+	public:
+		virtual ~ObjectBuffer();
+
+		ObjectBuffer();
+
+		ObjectBuffer(const ObjectBuffer&) = delete;
+		ObjectBuffer& operator=(const ObjectBuffer&) = delete;
+
+		// Mapped storage for `objectCount` objects of the frame, valid until the next Map of the same frame.
+		// The memory is host coherent, so writing it is the upload. The contents are kept when the buffer grows,
+		// so callers that keep the objects in place only write the ones that changed.
+		ObjectData* Map(U32 frameIndex, U32 objectCount);
+
+		VkDescriptorSet		  GetDescriptorSet(U32 frameIndex) const { return m_descriptorSets[frameIndex]; }
+		VkDescriptorSetLayout GetDescriptorSetLayout() const;
+
+	private:
+		// Grows the frame's buffer and points its descriptor set at the new one.
+		void Reserve(U32 frameIndex, U32 objectCount);
+
+	private:
+		UniqueRef<DescriptorSetLayout> m_setLayout{};
+		UniqueRef<DescriptorPool>	   m_descriptorPool{};
+
+		std::vector<UniqueRef<Buffer>> m_buffers{};
+		std::vector<VkDescriptorSet>   m_descriptorSets{};
+	};
+
+} // namespace Mapo
@@ -21,6 +21,12 @@ namespace Mapo
 		CreateGraphicsPipeline(vertFilepath, fragFilepath, configInfo);
 	}
 
+	Pipeline::Pipeline(const std::string& compFilepath, VkPipelineLayout pipelineLayout)
+		: m_device(RenderContext::GetDevice()), m_bindPoint(VK_PIPELINE_BIND_POINT_COMPUTE)
+	{
+		CreateComputePipeline(compFilepath, pipelineLayout);
+	}
+
 	Pipeline::~Pipeline()
 	{
 		if (m_fragShaderModule != VK_NULL_HANDLE)
@@ -33,7 +39,7 @@ namespace Mapo
 			vkDestroyShaderModule(m_device.GetDevice(), m_vertShaderModule, nullptr);
 		}
 
-		vkDestroyPipeline(m_device.GetDevice(), m_graphicsPipeline, nullptr);
+		vkDestroyPipeline(m_device.GetDevice(), m_pipeline, nullptr);
 	}
 
 	void Pipeline::CreateGraphicsPipeline(const std::string& vertFilepath, const std::string& fragFilepath,
@@ -99,7 +105,7 @@ namespace Mapo
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 		pipelineInfo.basePipelineIndex = -1;			  // Optional
 
-		VK_CHECK(vkCreateGraphicsPipelines(m_device.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_graphicsPipeline));
+		VK_CHECK(vkCreateGraphicsPipelines(m_device.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
 
 		// Cleanup shader modules after pipeline creation.
 		vkDestroyShaderModule(m_device.GetDevice(), m_fragShaderModule, nullptr);
@@ -108,9 +114,32 @@ namespace Mapo
 		m_vertShaderModule = VK_NULL_HANDLE;
 	}
 
+	void Pipeline::CreateComputePipeline(const std::string& compFilepath, VkPipelineLayout pipelineLayout)
+	{
+		MP_ASSERT(pipelineLayout, "Could not create compute pipeline: No pipeline layout provided!");
+
+		std::vector<char> computeShaderCode = ReadFile(compFilepath);
+		VkShaderModule	  computeShaderModule = VK_NULL_HANDLE;
+		CreateShaderModule(computeShaderCode, &computeShaderModule);
+
+		VkComputePipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		pipelineInfo.stage.module = computeShaderModule;
+		pipelineInfo.stage.pName = "main"; // entry point
+		pipelineInfo.layout = pipelineLayout;
+		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		pipelineInfo.basePipelineIndex = -1;
+
+		VK_CHECK(vkCreateComputePipelines(m_device.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+
+		vkDestroyShaderModule(m_device.GetDevice(), computeShaderModule, nullptr);
+	}
+
 	void Pipeline::Bind(VkCommandBuffer commandBuffer)
 	{
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
+		vkCmdBindPipeline(commandBuffer, m_bindPoint, m_pipeline);
 	}
 
 	void Pipeline::DefaultPipelineConfigInfo(PipelineConfigInfo& configInfo)
@@ -45,6 +45,9 @@ namespace Mapo
 		Pipeline(const std::string& vertFilepath, const std::string& fragFilepath,
 			const PipelineConfigInfo& configInfo);
 
+		// Compute pipeline.
+		Pipeline(const std::string& compFilepath, VkPipelineLayout pipelineLayout);
+
 		Pipeline(const Pipeline&) = delete;
 		Pipeline& operator=(const Pipeline&) = delete;
 
@@ -55,16 +58,18 @@ namespace Mapo
 	private:
 		void CreateGraphicsPipeline(const std::string& vertFilepath, const std::string& fragFilepath,
 			const PipelineConfigInfo& configInfo);
+		void CreateComputePipeline(const std::string& compFilepath, VkPipelineLayout pipelineLayout);
 
 		void CreateShaderModule(const std::vector<char>& code, VkShaderModule* pShaderModule);
 
 		static std::vector<char> ReadFile(const std::string& filepath);
 
 	private:
-		Device&		   m_device;
-		VkPipeline	   m_graphicsPipeline;
-		VkShaderModule m_vertShaderModule;
-		VkShaderModule m_fragShaderModule;
+		Device&				m_device;
+		VkPipeline			m_pipeline = VK_NULL_HANDLE;
+		VkPipelineBindPoint m_bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		VkShaderModule		m_vertShaderModule = VK_NULL_HANDLE;
+		VkShaderModule		m_fragShaderModule = VK_NULL_HANDLE;
 	};
 
 } // namespace Mapo
@@ -11,6 +11,9 @@
 #include "engine/renderer/renderer.h"
 #include "engine/renderer/swapchain.h"
 #include "engine/renderer/descriptors.h"
+#include "engine/renderer/geometry_pool.h"
+
+#include "engine/model.h"
 
 namespace Mapo
 {
@@ -24,9 +27,15 @@ namespace Mapo
 
 		s_context = MP_NEW(RenderContext);
 
-		s_context->m_device = MakeUnique<Device>(window);
+		{
+			MP_STARTUP_PHASE("Device");
+			s_context->m_device = MakeUnique<Device>(window);
+		}
 
-		s_context->m_renderer = MakeUnique<Renderer>();
+		{
+			MP_STARTUP_PHASE("Renderer");
+			s_context->m_renderer = MakeUnique<Renderer>();
+		}
 
 		s_context->m_descriptorPool =
 			DescriptorPool::Builder()
@@ -35,6 +44,8 @@ namespace Mapo
 				// How many descriptors of this type are available in the pool.
 				.AddPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, Swapchain::MAX_FRAMES_IN_FLIGHT)
 				.Build();
+
+		s_context->m_geometryPool = MakeUnique<GeometryPool>(static_cast<U32>(sizeof(Model::Vertex)));
 	}
 
 	void RenderContext::Release()
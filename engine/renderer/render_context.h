@@ -11,6 +11,7 @@ namespace Mapo
 	class Device;
 	class Renderer;
 	class DescriptorPool;
+	class GeometryPool;
 
 	class RenderContext final
 	{
@@ -28,6 +29,7 @@ namespace Mapo
 		static Device&		   GetDevice() { return *s_context->m_device; }
 		static Renderer&	   GetRenderer() { return *s_context->m_renderer; }
 		static DescriptorPool& GetDescriptorPool() { return *s_context->m_descriptorPool; }
+		static GeometryPool&   GetGeometryPool() { return *s_context->m_geometryPool; }
 
 	private:
 		RenderContext() = default;
@@ -42,6 +44,7 @@ namespace Mapo
 		UniqueRef<Device>		  m_device{};
 		UniqueRef<Renderer>		  m_renderer{};
 		UniqueRef<DescriptorPool> m_descriptorPool{};
+		UniqueRef<GeometryPool>	  m_geometryPool{}; // vertices and indices of all models
 
 		static RenderContext* s_context;
 	};
@@ -0,0 +1,87 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "render_queue.h"
+
+namespace Mapo
+{
+	static constexpr U32 RADIX_BITS = 8;
+	static constexpr U32 RADIX_SIZE = 1 << RADIX_BITS;
+	static constexpr U32 RADIX_PASSES = 64 / RADIX_BITS;
+
+	U64 RenderQueue::MakeSortKey(DrawPass pass, U32 pipeline, U32 material, U32 mesh, U32 depthBucket)
+	{
+		auto field = [](U32 value, U32 shift, U32 bits) { return (static_cast<U64>(value) & ((1ull << bits) - 1)) << shift; };
+
+		return field(pass, PASS_SHIFT, PASS_BITS)
+			| field(pipeline, PIPELINE_SHIFT, PIPELINE_BITS)
+			| field(material, MATERIAL_SHIFT, MATERIAL_BITS)
+			| field(mesh, MESH_SHIFT, MESH_BITS)
+			| field(depthBucket, DEPTH_SHIFT, DEPTH_BITS);
+	}
+
+	U32 RenderQueue::GetDepthBucket(DrawPass pass, F32 viewDepth, F32 farClip)
+	{
+		constexpr U32 MAX_BUCKET = (1 << DEPTH_BITS) - 1;
+
+		const F32 t = farClip > 0.0f ? MathOp::Clamp(viewDepth / farClip, 0.0f, 1.0f) : 0.0f;
+		const U32 bucket = static_cast<U32>(t * static_cast<F32>(MAX_BUCKET));
+
+		return pass == DRAW_PASS_TRANSPARENT ? MAX_BUCKET - bucket : bucket;
+	}
+
+	void RenderQueue::Sort()
+	{
+		MP_PROFILE_SCOPE("RenderQueue::Sort");
+
+		const U32 count = GetPacketCount();
+
+		if (count < 2)
+		{
+			return;
+		}
+
+		// All histograms in one read of the keys.
+		U32 histograms[RADIX_PASSES][RADIX_SIZE] = {};
+
+		for (const DrawPacket& packet : m_packets)
+		{
+			for (U32 pass = 0; pass < RADIX_PASSES; ++pass)
+			{
+				histograms[pass][(packet.sortKey >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+			}
+		}
+
+		m_scratch.resize(count);
+
+		for (U32 pass = 0; pass < RADIX_PASSES; ++pass)
+		{
+			U32* histogram = histograms[pass];
+			const U32 shift = pass * RADIX_BITS;
+
+			// Every key has the same byte here, the pass would not move anything.
+			if (histogram[(m_packets[0].sortKey >> shift) & (RADIX_SIZE - 1)] == count)
+			{
+				continue;
+			}
+
+			// Exclusive prefix sum turns the counts into output offsets.
+			U32 offset = 0;
+			for (U32 digit = 0; digit < RADIX_SIZE; ++digit)
+			{
+				const U32 digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (const DrawPacket& packet : m_packets)
+			{
+				m_scratch[histogram[(packet.sortKey >> shift) & (RADIX_SIZE - 1)]++] = packet;
+			}
+
+			m_packets.swap(m_scratch);
+		}
+	}
+
+} // namespace Mapo
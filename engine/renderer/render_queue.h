@@ -0,0 +1,82 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	enum DrawPass : U32
+	{
+		DRAW_PASS_OPAQUE = 0,	   // front to back
+		DRAW_PASS_TRANSPARENT = 1, // back to front
+	};
+
+	// One draw in the render queue. The payload is whatever the submitting system needs to issue the draw,
+	// e.g. a render proxy index.
+	struct DrawPacket
+	{
+		U64 sortKey = 0;
+		U32 payload = 0;
+	};
+
+	// Draw packets of a frame, sorted by their 64-bit keys before submission. The key fields, from the most
+	// significant bit down:
+	//
+	//   pass (4) | pipeline (8) | material (16) | mesh (20) | depth (16)
+	//
+	// so draws sharing a pipeline, then a material, then a mesh end up next to each other and a submitter only
+	// has to rebind when a field changes. Within a mesh, opaque draws go front to back.
+	class RenderQueue
+	{
+	public:
+		static constexpr U32 PASS_BITS = 4;
+		static constexpr U32 PIPELINE_BITS = 8;
+		static constexpr U32 MATERIAL_BITS = 16;
+		static constexpr U32 MESH_BITS = 20;
+		static constexpr U32 DEPTH_BITS = 16;
+
+		static constexpr U32 DEPTH_SHIFT = 0;
+		static constexpr U32 MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+		static constexpr U32 MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+		static constexpr U32 PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+		static constexpr U32 PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+
+		static_assert(PASS_SHIFT + PASS_BITS == 64, "Sort key fields must fill 64 bits!");
+
+		// Fields wider than their bits are truncated.
+		static U64 MakeSortKey(DrawPass pass, U32 pipeline, U32 material, U32 mesh, U32 depthBucket);
+
+		// Quantizes a view-space depth in [0, farClip] to a depth bucket. Transparent draws get inverted buckets so
+		// that they sort back to front.
+		static U32 GetDepthBucket(DrawPass pass, F32 viewDepth, F32 farClip);
+
+		static U32 GetPass(U64 sortKey) { return GetField(sortKey, PASS_SHIFT, PASS_BITS); }
+		static U32 GetPipeline(U64 sortKey) { return GetField(sortKey, PIPELINE_SHIFT, PIPELINE_BITS); }
+		static U32 GetMaterial(U64 sortKey) { return GetField(sortKey, MATERIAL_SHIFT, MATERIAL_BITS); }
+		static U32 GetMesh(U64 sortKey) { return GetField(sortKey, MESH_SHIFT, MESH_BITS); }
+
+		void Clear() { m_packets.clear(); }
+		void Reserve(U32 count) { m_packets.reserve(count); }
+		void Push(U64 sortKey, U32 payload) { m_packets.push_back({ sortKey, payload }); }
+
+		// Stable LSD radix sort on the keys, one byte per pass. Bytes that are the same in every key (usually the
+		// pass and pipeline) are skipped.
+		void Sort();
+
+		const std::vector<DrawPacket>& GetPackets() const { return m_packets; }
+		U32							   GetPacketCount() const { return static_cast<U32>(m_packets.size()); }
+
+	private:
+		static U32 GetField(U64 sortKey, U32 shift, U32 bits) { return static_cast<U32>((sortKey >> shift) & ((1ull << bits) - 1)); }
+
+	private:
+		std::vector<DrawPacket> m_packets{};
+		std::vector<DrawPacket> m_scratch{}; // ping-pong target of the radix passes
+	};
+
+} // namespace Mapo
@@ -21,10 +21,17 @@ namespace Mapo
 
 		// For now, the command buffers are created once and will be reused in frames.
 		CreateCommandBuffers();
+
+		CreateTimestampQueryPool();
 	}
 
 	Renderer::~Renderer()
 	{
+		if (m_timestampQueryPool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(m_device.GetDevice(), m_timestampQueryPool, nullptr);
+		}
+
 		FreeCommandBuffers();
 	}
 
@@ -87,6 +94,8 @@ namespace Mapo
 
 	VkCommandBuffer Renderer::BeginFrame()
 	{
+		MP_PROFILE_SCOPE("Renderer::BeginFrame");
+
 		MP_ASSERT(!IsFrameInProgress(), "Could not call BeginFrame while already in frame progress!");
 
 		// Needs to synchronize the below calls because on GPU they are executed asynchronously.
@@ -118,15 +127,35 @@ namespace Mapo
 
 		VK_CHECK(vkBeginCommandBuffer(commandBuffer, &bufferBeginInfo));
 
+		m_stats = {};
+
+		if (m_timestampQueryPool != VK_NULL_HANDLE)
+		{
+			// The in-flight fence of this frame has been waited on, so the last queries of this slot are done.
+			ResolveGpuTimestamps();
+
+			vkCmdResetQueryPool(commandBuffer, m_timestampQueryPool, m_currentFrameIndex * 2, 2);
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampQueryPool, m_currentFrameIndex * 2);
+		}
+
 		return commandBuffer;
 	}
 
 	void Renderer::EndFrame()
 	{
+		MP_PROFILE_SCOPE("Renderer::EndFrame");
+
 		MP_ASSERT(IsFrameInProgress(), "Could not call EndFrame while frame is not in progress!");
 
 		VkCommandBuffer commandBuffer = GetCurrentCommandBuffer();
 
+		if (m_timestampQueryPool != VK_NULL_HANDLE)
+		{
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampQueryPool, m_currentFrameIndex * 2 + 1);
+			m_timestampFrameNumbers[m_currentFrameIndex] = m_frameNumber;
+			m_timestampPending[m_currentFrameIndex] = true;
+		}
+
 		VK_CHECK(vkEndCommandBuffer(commandBuffer));
 
 		// Submit command buffer.
@@ -147,6 +176,7 @@ namespace Mapo
 		// Currently renderer and swapchain manages separate frame indices, but they are always identical.
 		m_isFrameStarted = false;
 		m_currentFrameIndex = (m_currentFrameIndex + 1) % Swapchain::MAX_FRAMES_IN_FLIGHT;
+		m_frameNumber++;
 	}
 
 	void Renderer::BeginRenderPass()
@@ -218,6 +248,49 @@ namespace Mapo
 		m_commandBuffers.clear();
 	}
 
+	void Renderer::CreateTimestampQueryPool()
+	{
+		if (!m_device.SupportsTimestamps())
+		{
+			MP_WARN("GPU timestamps are not supported. GPU frame times will not be available.");
+			return;
+		}
+
+		// Two queries (begin/end) per frame in flight.
+		VkQueryPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		poolInfo.queryCount = Swapchain::MAX_FRAMES_IN_FLIGHT * 2;
+
+		VK_CHECK(vkCreateQueryPool(m_device.GetDevice(), &poolInfo, nullptr, &m_timestampQueryPool));
+
+		m_timestampFrameNumbers.resize(Swapchain::MAX_FRAMES_IN_FLIGHT, 0);
+		m_timestampPending.resize(Swapchain::MAX_FRAMES_IN_FLIGHT, false);
+	}
+
+	void Renderer::ResolveGpuTimestamps()
+	{
+		if (!m_timestampPending[m_currentFrameIndex])
+		{
+			return;
+		}
+
+		U64		 timestamps[2]{};
+		VkResult result = vkGetQueryPoolResults(m_device.GetDevice(), m_timestampQueryPool, m_currentFrameIndex * 2, 2,
+			sizeof(timestamps), timestamps, sizeof(U64), VK_QUERY_RESULT_64_BIT);
+
+		if (result == VK_SUCCESS)
+		{
+			F64 nanoseconds = static_cast<F64>(timestamps[1] - timestamps[0]) * m_device.GetTimestampPeriod();
+
+			m_lastGpuTiming.frameNumber = m_timestampFrameNumbers[m_currentFrameIndex];
+			m_lastGpuTiming.gpuTimeMs = static_cast<F32>(nanoseconds / 1e6);
+			m_lastGpuTiming.valid = true;
+		}
+
+		m_timestampPending[m_currentFrameIndex] = false;
+	}
+
 	void Renderer::RecreateSwapchain()
 	{
 		Window& window = Application::Get().GetWindow();
@@ -232,7 +305,7 @@ namespace Mapo
 		}
 
 		// Need to wait for the current swapchain not being used.
-		vkDeviceWaitIdle(m_device.GetDevice());
+		m_device.WaitIdle();
 
 		if (m_swapchain == nullptr)
 		{
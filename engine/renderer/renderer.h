@@ -13,6 +13,26 @@ namespace Mapo
 	class Device;
 	class Swapchain;
 
+	// Per-frame counters. Reset in BeginFrame. When the GPU culls, the object, vertex and triangle counts are read
+	// back from its draw commands, so they are MAX_FRAMES_IN_FLIGHT frames old.
+	struct RenderStats
+	{
+		U32 drawCalls = 0;
+		U32 triangleCount = 0;
+		U32 vertexCount = 0;
+		U32 visibleObjectCount = 0; // passed frustum and occlusion culling
+		U32 culledObjectCount = 0;
+	};
+
+	// GPU time of a finished frame measured with timestamp queries.
+	// Results come back MAX_FRAMES_IN_FLIGHT frames later, so it records which frame it belongs to.
+	struct GpuFrameTiming
+	{
+		U64	 frameNumber = 0;
+		F32	 gpuTimeMs = 0.0f;
+		bool valid = false;
+	};
+
 	// Renderer class that manages swapchain and command buffers.
 	class Renderer final
 	{
@@ -32,6 +52,13 @@ namespace Mapo
 		U32			 GetSwapchainWidth() const;
 		U32			 GetSwapchainHeight() const;
 		Vector3&     ClearColor() { return m_clearColor; }
+		bool&		 OcclusionCulling() { return m_occlusionCulling; } // used where the GPU culls
+
+		// Profiling
+		U64					  GetFrameNumber() const { return m_frameNumber; }
+		RenderStats&		  GetStats() { return m_stats; }
+		const RenderStats&	  GetStats() const { return m_stats; }
+		const GpuFrameTiming& GetLastGpuTiming() const { return m_lastGpuTiming; }
 
 		VkCommandBuffer GetCurrentCommandBuffer()
 		{
@@ -56,6 +83,8 @@ namespace Mapo
 		void CreateCommandBuffers();
 		void FreeCommandBuffers();
 		void RecreateSwapchain();
+		void CreateTimestampQueryPool();
+		void ResolveGpuTimestamps();
 
 	private:
 		Device&						 m_device;
@@ -65,9 +94,18 @@ namespace Mapo
 		U32	 m_currentImageIndex = 0;
 		U32	 m_currentFrameIndex = 0;
 		bool m_isFrameStarted = false;
+		U64	 m_frameNumber = 0;
+
+		// Profiling data.
+		RenderStats			  m_stats{};
+		GpuFrameTiming		  m_lastGpuTiming{};
+		VkQueryPool			  m_timestampQueryPool = VK_NULL_HANDLE;
+		std::vector<U64>	  m_timestampFrameNumbers; // per frame in flight
+		std::vector<bool>	  m_timestampPending;
 
 		// Render data.
 		Vector3 m_clearColor { 0.117f, 0.117f, 0.117f };
+		bool	m_occlusionCulling = true;
 	};
 
 } // namespace Mapo
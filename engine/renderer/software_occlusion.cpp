@@ -0,0 +1,358 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "software_occlusion.h"
+
+#include "core/jobs/job_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Mapo
+{
+	namespace
+	{
+		// Reference path, one pixel center at a time.
+		inline U32 ComputeCoverage(const Detail::OcclusionTriangle& triangle, F32 tileX, F32 tileY)
+		{
+			U32 coverage = 0;
+
+			for (U32 row = 0; row < Detail::OCCLUSION_TILE_HEIGHT; ++row)
+			{
+				const F32 y = tileY + static_cast<F32>(row) + 0.5f;
+
+				for (U32 column = 0; column < Detail::OCCLUSION_TILE_WIDTH; ++column)
+				{
+					const F32 x = tileX + (static_cast<F32>(column) + 0.5f);
+
+					bool inside = true;
+					for (U32 edge = 0; edge < 3; ++edge)
+					{
+						inside = inside && (triangle.edgeA[edge] * x + triangle.edgeB[edge] * y + triangle.edgeC[edge] >= 0.0f);
+					}
+
+					coverage |= (inside ? 1u : 0u) << (row * Detail::OCCLUSION_TILE_WIDTH + column);
+				}
+			}
+
+			return coverage;
+		}
+
+#include "software_occlusion_kernel.inl"
+
+	} // namespace
+
+	// Depth of a tile no occluder has covered yet. Farther than anything in the frustum.
+	static constexpr F32 EMPTY_TILE_DEPTH = std::numeric_limits<F32>::max();
+
+	SoftwareOcclusion::SoftwareOcclusion(U32 width, U32 height)
+	{
+		m_tilesPerRow = (MathOp::Max(width, 1u) + Detail::OCCLUSION_TILE_WIDTH - 1) / Detail::OCCLUSION_TILE_WIDTH;
+		m_tileRowCount = (MathOp::Max(height, 1u) + Detail::OCCLUSION_TILE_HEIGHT - 1) / Detail::OCCLUSION_TILE_HEIGHT;
+		m_width = m_tilesPerRow * Detail::OCCLUSION_TILE_WIDTH;
+		m_height = m_tileRowCount * Detail::OCCLUSION_TILE_HEIGHT;
+
+		m_tiles.resize(m_tilesPerRow * m_tileRowCount, Detail::OcclusionTile{ EMPTY_TILE_DEPTH, 0.0f, 0, 0 });
+	}
+
+	void SoftwareOcclusion::RenderOccluders(const Matrix4& viewProjection, const OccluderMesh* occluders, U32 occluderCount)
+	{
+		RenderOccluders(viewProjection, occluders, occluderCount, Simd::GetSimdLevel());
+	}
+
+	void SoftwareOcclusion::RenderOccluders(const Matrix4& viewProjection, const OccluderMesh* occluders, U32 occluderCount, Simd::SimdLevel level)
+	{
+		MP_PROFILE_SCOPE("SoftwareOcclusion::RenderOccluders");
+
+		m_viewProjection = viewProjection;
+		std::fill(m_tiles.begin(), m_tiles.end(), Detail::OcclusionTile{ EMPTY_TILE_DEPTH, 0.0f, 0, 0 });
+
+		// Every occluder writes to its own slice, so the triangles end up in the same order on every run. The
+		// masked update depends on the order.
+		m_vertexOffsets.resize(occluderCount);
+		m_triangleOffsets.resize(occluderCount);
+		m_triangleCounts.resize(occluderCount);
+
+		U32 vertexCount = 0;
+		U32 triangleCapacity = 0;
+
+		for (U32 i = 0; i < occluderCount; ++i)
+		{
+			m_vertexOffsets[i] = vertexCount;
+			m_triangleOffsets[i] = triangleCapacity;
+			vertexCount += occluders[i].vertexCount;
+			triangleCapacity += occluders[i].indexCount / 3 * 2;
+		}
+
+		m_clipVertices.resize(vertexCount);
+		m_triangles.resize(triangleCapacity);
+
+		auto setupRange = [this, occluders](U32 begin, U32 end) {
+			for (U32 i = begin; i < end; ++i)
+			{
+				m_triangleCounts[i] = SetupTriangles(occluders[i], m_clipVertices.data() + m_vertexOffsets[i], m_triangles.data() + m_triangleOffsets[i]);
+			}
+		};
+
+		JobSystem::ParallelFor(occluderCount, setupRange);
+
+		U32 triangleCount = 0;
+		for (U32 i = 0; i < occluderCount; ++i)
+		{
+			const auto first = m_triangles.begin() + m_triangleOffsets[i];
+			std::copy(first, first + m_triangleCounts[i], m_triangles.begin() + triangleCount);
+			triangleCount += m_triangleCounts[i];
+		}
+
+		m_triangles.resize(triangleCount);
+
+		// Tile rows do not share tiles, so each one is rasterized by a single thread without locking.
+		auto rasterizeRange = [this, level](U32 begin, U32 end) {
+			const Detail::OcclusionTriangle* triangles = m_triangles.data();
+			const U32						 triangleCount = static_cast<U32>(m_triangles.size());
+
+			for (U32 row = begin; row < end; ++row)
+			{
+				Detail::OcclusionTile* rowTiles = m_tiles.data() + row * m_tilesPerRow;
+
+				switch (level)
+				{
+#if MP_SIMD_X86
+					case Simd::SimdLevel::AVX2:
+						Detail::RasterizeTileRowAVX2(triangles, triangleCount, row, rowTiles);
+						break;
+#endif
+					default:
+						RasterizeTileRow(triangles, triangleCount, row, rowTiles);
+						break;
+				}
+			}
+		};
+
+		JobSystem::ParallelFor(m_tileRowCount, rasterizeRange);
+	}
+
+	bool SoftwareOcclusion::IsVisible(const Vector3& center, const Vector3& extent) const
+	{
+		// Corners of the box in clip space: the center plus or minus each scaled axis.
+		const Vector4 clipCenter = m_viewProjection * Vector4(center, 1.0f);
+		const Vector4 axes[3] = { m_viewProjection[0] * extent.x, m_viewProjection[1] * extent.y, m_viewProjection[2] * extent.z };
+
+		Vector3 minimum{ std::numeric_limits<F32>::max() };
+		Vector3 maximum{ -std::numeric_limits<F32>::max() };
+
+		for (U32 corner = 0; corner < 8; ++corner)
+		{
+			Vector4 point = clipCenter;
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				point += (corner & (1u << axis)) ? axes[axis] : -axes[axis];
+			}
+
+			if (point.z < 0.0f || point.w <= 0.0f)
+			{
+				return true;
+			}
+
+			const Vector3 ndc = Vector3(point) / point.w;
+			minimum = MathOp::Min(minimum, ndc);
+			maximum = MathOp::Max(maximum, ndc);
+		}
+
+		// Every pixel the screen rectangle touches, not only those whose centers it contains.
+		const F32 minX = std::floor((minimum.x * 0.5f + 0.5f) * static_cast<F32>(m_width));
+		const F32 maxX = std::floor((maximum.x * 0.5f + 0.5f) * static_cast<F32>(m_width));
+		const F32 minY = std::floor((minimum.y * 0.5f + 0.5f) * static_cast<F32>(m_height));
+		const F32 maxY = std::floor((maximum.y * 0.5f + 0.5f) * static_cast<F32>(m_height));
+
+		if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<F32>(m_width) || minY >= static_cast<F32>(m_height))
+		{
+			return true; // passed the frustum test, so only off screen by rounding
+		}
+
+		const I32 pixelMinX = static_cast<I32>(MathOp::Max(minX, 0.0f));
+		const I32 pixelMaxX = static_cast<I32>(MathOp::Min(maxX, static_cast<F32>(m_width - 1)));
+		const I32 pixelMinY = static_cast<I32>(MathOp::Max(minY, 0.0f));
+		const I32 pixelMaxY = static_cast<I32>(MathOp::Min(maxY, static_cast<F32>(m_height - 1)));
+
+		const I32 tileWidth = static_cast<I32>(Detail::OCCLUSION_TILE_WIDTH);
+		const I32 tileHeight = static_cast<I32>(Detail::OCCLUSION_TILE_HEIGHT);
+		const F32 nearestDepth = minimum.z;
+
+		for (I32 tileY = pixelMinY / tileHeight; tileY <= pixelMaxY / tileHeight; ++tileY)
+		{
+			const I32 firstRow = MathOp::Max(pixelMinY - tileY * tileHeight, 0);
+			const I32 lastRow = MathOp::Min(pixelMaxY - tileY * tileHeight, tileHeight - 1);
+
+			// One bit at the start of every row in the rectangle; multiplying by the column bits fills the rows.
+			U32 rowStarts = 0;
+			for (I32 row = firstRow; row <= lastRow; ++row)
+			{
+				rowStarts |= 1u << (row * tileWidth);
+			}
+
+			for (I32 tileX = pixelMinX / tileWidth; tileX <= pixelMaxX / tileWidth; ++tileX)
+			{
+				const I32 firstColumn = MathOp::Max(pixelMinX - tileX * tileWidth, 0);
+				const I32 lastColumn = MathOp::Min(pixelMaxX - tileX * tileWidth, tileWidth - 1);
+				const U32 columns = ((1u << (lastColumn - firstColumn + 1)) - 1) << firstColumn;
+				const U32 rectangle = columns * rowStarts;
+
+				const Detail::OcclusionTile& tile = m_tiles[tileY * m_tilesPerRow + tileX];
+
+				if ((rectangle & ~tile.mask) && nearestDepth < tile.zMax0)
+				{
+					return true;
+				}
+
+				if ((rectangle & tile.mask) && nearestDepth < MathOp::Min(tile.zMax0, tile.zMax1))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Triangle setup
+	/////////////////////////////////////////////////////////////////////////////////
+
+	U32 SoftwareOcclusion::SetupTriangles(const OccluderMesh& occluder, Vector4* clipVertices, Detail::OcclusionTriangle* triangles) const
+	{
+		const Matrix4 modelViewProjection = m_viewProjection * occluder.modelMatrix;
+
+		for (U32 i = 0; i < occluder.vertexCount; ++i)
+		{
+			clipVertices[i] = modelViewProjection * Vector4(occluder.positions[i], 1.0f);
+		}
+
+		U32 count = 0;
+
+		for (U32 i = 0; i + 2 < occluder.indexCount; i += 3)
+		{
+			const U32 i0 = occluder.indices[i];
+			const U32 i1 = occluder.indices[i + 1];
+			const U32 i2 = occluder.indices[i + 2];
+
+			if (i0 < occluder.vertexCount && i1 < occluder.vertexCount && i2 < occluder.vertexCount)
+			{
+				count += SetupTriangle(clipVertices[i0], clipVertices[i1], clipVertices[i2], triangles + count);
+			}
+		}
+
+		return count;
+	}
+
+	U32 SoftwareOcclusion::SetupTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, Detail::OcclusionTriangle* triangles) const
+	{
+		// Clip against the near plane (z >= 0 with depth in [0, 1]), which keeps w positive. A triangle clipped
+		// by one plane has at most four corners.
+		const Vector4 input[3] = { v0, v1, v2 };
+		Vector4		  polygon[4];
+		U32			  cornerCount = 0;
+
+		for (U32 i = 0; i < 3; ++i)
+		{
+			const Vector4& a = input[i];
+			const Vector4& b = input[(i + 1) % 3];
+
+			if (a.z >= 0.0f)
+			{
+				polygon[cornerCount++] = a;
+			}
+
+			if ((a.z >= 0.0f) != (b.z >= 0.0f))
+			{
+				polygon[cornerCount++] = a + (b - a) * (a.z / (a.z - b.z));
+			}
+		}
+
+		if (cornerCount < 3)
+		{
+			return 0;
+		}
+
+		Vector3 screen[4];
+		for (U32 i = 0; i < cornerCount; ++i)
+		{
+			if (polygon[i].w <= 0.0f)
+			{
+				return 0;
+			}
+
+			const Vector3 ndc = Vector3(polygon[i]) / polygon[i].w;
+			screen[i] = { (ndc.x * 0.5f + 0.5f) * static_cast<F32>(m_width), (ndc.y * 0.5f + 0.5f) * static_cast<F32>(m_height), ndc.z };
+		}
+
+		U32 count = SetupScreenTriangle(screen[0], screen[1], screen[2], triangles);
+
+		if (cornerCount == 4)
+		{
+			count += SetupScreenTriangle(screen[0], screen[2], screen[3], triangles + count);
+		}
+
+		return count;
+	}
+
+	U32 SoftwareOcclusion::SetupScreenTriangle(Vector3 p0, Vector3 p1, Vector3 p2, Detail::OcclusionTriangle* triangle) const
+	{
+		F32 area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+
+		// Degenerate triangles cover nothing. Either winding is drawn, so back faces are turned around.
+		if (!(std::abs(area) > 0.0f))
+		{
+			return 0;
+		}
+
+		if (area < 0.0f)
+		{
+			std::swap(p1, p2);
+			area = -area;
+		}
+
+		// Pixel centers are at +0.5.
+		const F32 minX = std::ceil(MathOp::Min(p0.x, MathOp::Min(p1.x, p2.x)) - 0.5f);
+		const F32 maxX = std::floor(MathOp::Max(p0.x, MathOp::Max(p1.x, p2.x)) - 0.5f);
+		const F32 minY = std::ceil(MathOp::Min(p0.y, MathOp::Min(p1.y, p2.y)) - 0.5f);
+		const F32 maxY = std::floor(MathOp::Max(p0.y, MathOp::Max(p1.y, p2.y)) - 0.5f);
+
+		const F32 lastX = static_cast<F32>(m_width - 1);
+		const F32 lastY = static_cast<F32>(m_height - 1);
+
+		if (minX > maxX || minY > maxY || maxX < 0.0f || maxY < 0.0f || minX > lastX || minY > lastY)
+		{
+			return 0;
+		}
+
+		const Vector3 corners[3] = { p0, p1, p2 };
+		for (U32 edge = 0; edge < 3; ++edge)
+		{
+			const Vector3& a = corners[edge];
+			const Vector3& b = corners[(edge + 1) % 3];
+
+			triangle->edgeA[edge] = a.y - b.y;
+			triangle->edgeB[edge] = b.x - a.x;
+			triangle->edgeC[edge] = a.x * b.y - a.y * b.x;
+		}
+
+		const Vector3 d1 = p1 - p0;
+		const Vector3 d2 = p2 - p0;
+
+		triangle->depthA = (d1.z * d2.y - d2.z * d1.y) / area;
+		triangle->depthB = (d1.x * d2.z - d2.x * d1.z) / area;
+		triangle->depthC = p0.z - triangle->depthA * p0.x - triangle->depthB * p0.y;
+		triangle->maxDepth = MathOp::Max(p0.z, MathOp::Max(p1.z, p2.z));
+
+		triangle->minX = static_cast<I32>(MathOp::Max(minX, 0.0f));
+		triangle->maxX = static_cast<I32>(MathOp::Min(maxX, lastX));
+		triangle->minY = static_cast<I32>(MathOp::Max(minY, 0.0f));
+		triangle->maxY = static_cast<I32>(MathOp::Min(maxY, lastY));
+
+		return 1;
+	}
+
+} // namespace Mapo
@@ -0,0 +1,86 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+#include "core/simd/cpu_features.h"
+
+#include "engine/renderer/software_occlusion_raster.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	// Triangle mesh rasterized as an occluder. Indices are relative to `positions`.
+	struct OccluderMesh
+	{
+		Matrix4		   modelMatrix{ 1.0f };
+		const Vector3* positions = nullptr;
+		U32			   vertexCount = 0;
+		const U32*	   indices = nullptr;
+		U32			   indexCount = 0;
+	};
+
+	// Occlusion culling on the CPU for when the GPU does not cull. A few designated occluders are rasterized into
+	// a low-resolution masked depth buffer, and bounds are tested against it before they are drawn.
+	//
+	// The buffer keeps no per-pixel depth. Each 8x4 tile has a coverage mask and two farthest depths, one for the
+	// covered pixels and one for the whole tile (see Detail::OcclusionTile), so a tile row is rasterized with a
+	// few vector compares and triangles of any size cost the same per tile. Both windings are drawn and triangles
+	// are clipped against the near plane. Like a rasterizer, coverage is sampled at pixel centers, so occluders
+	// should be solid: gaps narrower than a buffer pixel are treated as closed.
+	class SoftwareOcclusion
+	{
+	public:
+		static constexpr U32 DEFAULT_WIDTH = 256;
+		static constexpr U32 DEFAULT_HEIGHT = 128;
+
+		// The size is rounded up to whole tiles.
+		explicit SoftwareOcclusion(U32 width = DEFAULT_WIDTH, U32 height = DEFAULT_HEIGHT);
+
+		// Clears the buffer and rasterizes the occluders as seen through `viewProjection` on the job system, using
+		// the widest instruction set the CPU supports.
+		void RenderOccluders(const Matrix4& viewProjection, const OccluderMesh* occluders, U32 occluderCount);
+
+		// Same with an explicit code path. The level must be supported by the CPU. All paths produce the same buffer.
+		void RenderOccluders(const Matrix4& viewProjection, const OccluderMesh* occluders, U32 occluderCount, Simd::SimdLevel level);
+
+		// Whether any part of the world-space box may be in front of the occluders rendered last. Boxes that
+		// cross the near plane are always visible. Safe to call from several threads.
+		bool IsVisible(const Vector3& center, const Vector3& extent) const;
+
+		U32 GetWidth() const { return m_width; }
+		U32 GetHeight() const { return m_height; }
+		U32 GetTriangleCount() const { return static_cast<U32>(m_triangles.size()); }
+
+		// Row-major, GetWidth() / 8 tiles per row.
+		const std::vector<Detail::OcclusionTile>& GetTiles() const { return m_tiles; }
+
+	private:
+		// Transforms the occluder's vertices and writes its clipped screen-space triangles, returning how many.
+		U32 SetupTriangles(const OccluderMesh& occluder, Vector4* clipVertices, Detail::OcclusionTriangle* triangles) const;
+		U32 SetupTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2, Detail::OcclusionTriangle* triangles) const;
+		U32 SetupScreenTriangle(Vector3 p0, Vector3 p1, Vector3 p2, Detail::OcclusionTriangle* triangle) const;
+
+	private:
+		U32 m_width;
+		U32 m_height;
+		U32 m_tilesPerRow;
+		U32 m_tileRowCount;
+
+		Matrix4 m_viewProjection{ 1.0f };
+
+		std::vector<Detail::OcclusionTile> m_tiles{};
+
+		// Per occluder, where its vertices and triangles start in the scratch arrays. Every triangle gets room
+		// for two, since clipping may split it.
+		std::vector<U32>					   m_vertexOffsets{};
+		std::vector<U32>					   m_triangleOffsets{};
+		std::vector<U32>					   m_triangleCounts{};
+		std::vector<Vector4>				   m_clipVertices{};
+		std::vector<Detail::OcclusionTriangle> m_triangles{};
+	};
+
+} // namespace Mapo
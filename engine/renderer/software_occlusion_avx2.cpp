@@ -0,0 +1,65 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Built with AVX2 enabled. Only called when the CPU supports it.
+
+#include "engine/renderer/software_occlusion_raster.h"
+
+#include "core/simd/cpu_features.h"
+
+#if MP_SIMD_X86
+
+	#include <immintrin.h>
+
+namespace Mapo
+{
+	namespace
+	{
+		// One row of the tile per register: eight pixel centers tested against the three edges at once.
+		inline U32 ComputeCoverage(const Detail::OcclusionTriangle& triangle, F32 tileX, F32 tileY)
+		{
+			const __m256 x = _mm256_add_ps(_mm256_set1_ps(tileX), _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f));
+			const __m256 zero = _mm256_setzero_ps();
+
+			__m256 edgeX[3];
+			for (U32 edge = 0; edge < 3; ++edge)
+			{
+				edgeX[edge] = _mm256_mul_ps(_mm256_set1_ps(triangle.edgeA[edge]), x);
+			}
+
+			U32 coverage = 0;
+
+			for (U32 row = 0; row < Detail::OCCLUSION_TILE_HEIGHT; ++row)
+			{
+				const F32 y = tileY + static_cast<F32>(row) + 0.5f;
+
+				__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (U32 edge = 0; edge < 3; ++edge)
+				{
+					const __m256 value = _mm256_add_ps(_mm256_add_ps(edgeX[edge], _mm256_set1_ps(triangle.edgeB[edge] * y)),
+						_mm256_set1_ps(triangle.edgeC[edge]));
+					inside = _mm256_and_ps(inside, _mm256_cmp_ps(value, zero, _CMP_GE_OQ));
+				}
+
+				coverage |= static_cast<U32>(_mm256_movemask_ps(inside)) << (row * Detail::OCCLUSION_TILE_WIDTH);
+			}
+
+			return coverage;
+		}
+
+	#include "software_occlusion_kernel.inl"
+
+	} // namespace
+
+	namespace Detail
+	{
+		void RasterizeTileRowAVX2(const OcclusionTriangle* triangles, U32 triangleCount, U32 tileRow, OcclusionTile* rowTiles)
+		{
+			RasterizeTileRow(triangles, triangleCount, tileRow, rowTiles);
+		}
+	} // namespace Detail
+
+} // namespace Mapo
+
+#endif
@@ -0,0 +1,93 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Tile row rasterizer shared by software_occlusion.cpp and the per-instruction-set source files. It is included
+// inside an anonymous namespace after a coverage function
+//
+//   U32 ComputeCoverage(const Detail::OcclusionTriangle& triangle, F32 tileX, F32 tileY)
+//
+// that returns the mask of the tile's pixel centers inside the triangle, where (tileX, tileY) is the tile's top
+// left corner in pixels. Centers are at +0.5 and each edge is evaluated as (a * x + b * y) + c.
+//
+// As in transform_batch_kernel.inl, nothing here may have external linkage or call inline functions shared with
+// other files. The files are built without FMA contraction, so every path produces the same buffer.
+
+using Detail::OCCLUSION_TILE_FULL_MASK;
+using Detail::OCCLUSION_TILE_HEIGHT;
+using Detail::OCCLUSION_TILE_WIDTH;
+using Detail::OcclusionTile;
+using Detail::OcclusionTriangle;
+
+inline F32 MinDepth(F32 a, F32 b)
+{
+	return a < b ? a : b;
+}
+
+// Farthest depth of the triangle's plane over the tile, which is at one of its corners. The plane is
+// extrapolated outside of the triangle, so it is capped by the farthest vertex.
+inline F32 ComputeTileDepth(const OcclusionTriangle& triangle, F32 tileX, F32 tileY)
+{
+	const F32 x = triangle.depthA > 0.0f ? tileX + static_cast<F32>(OCCLUSION_TILE_WIDTH) : tileX;
+	const F32 y = triangle.depthB > 0.0f ? tileY + static_cast<F32>(OCCLUSION_TILE_HEIGHT) : tileY;
+
+	return MinDepth(triangle.depthA * x + triangle.depthB * y + triangle.depthC, triangle.maxDepth);
+}
+
+// Merges a triangle that covers `coverage` no farther than `depth` into the tile.
+inline void UpdateTile(OcclusionTile& tile, U32 coverage, F32 depth)
+{
+	// Nothing the reference layer does not already hide.
+	if (depth >= tile.zMax0)
+	{
+		return;
+	}
+
+	// Start a new working layer when the triangle is much closer than the current one. Its pixels fall back
+	// to the reference layer, which still bounds them.
+	if (tile.zMax1 - depth > tile.zMax0 - tile.zMax1)
+	{
+		tile.zMax1 = 0.0f;
+		tile.mask = 0;
+	}
+
+	tile.zMax1 = tile.zMax1 > depth ? tile.zMax1 : depth;
+	tile.mask |= coverage;
+
+	if (tile.mask == OCCLUSION_TILE_FULL_MASK)
+	{
+		tile.zMax0 = MinDepth(tile.zMax0, tile.zMax1);
+		tile.zMax1 = 0.0f;
+		tile.mask = 0;
+	}
+}
+
+inline void RasterizeTileRow(const OcclusionTriangle* triangles, U32 triangleCount, U32 tileRow, OcclusionTile* rowTiles)
+{
+	const I32 rowMinY = static_cast<I32>(tileRow * OCCLUSION_TILE_HEIGHT);
+	const I32 rowMaxY = rowMinY + static_cast<I32>(OCCLUSION_TILE_HEIGHT) - 1;
+	const F32 tileY = static_cast<F32>(rowMinY);
+
+	for (U32 i = 0; i < triangleCount; ++i)
+	{
+		const OcclusionTriangle& triangle = triangles[i];
+
+		if (triangle.maxY < rowMinY || triangle.minY > rowMaxY)
+		{
+			continue;
+		}
+
+		const I32 lastTile = triangle.maxX / static_cast<I32>(OCCLUSION_TILE_WIDTH);
+
+		for (I32 tile = triangle.minX / static_cast<I32>(OCCLUSION_TILE_WIDTH); tile <= lastTile; ++tile)
+		{
+			const F32 tileX = static_cast<F32>(tile * static_cast<I32>(OCCLUSION_TILE_WIDTH));
+			const U32 coverage = ComputeCoverage(triangle, tileX, tileY);
+
+			if (coverage != 0)
+			{
+				UpdateTile(rowTiles[tile], coverage, ComputeTileDepth(triangle, tileX, tileY));
+			}
+		}
+	}
+}
@@ -0,0 +1,54 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+// Data shared by the software occlusion paths. Only includes core/typedefs.h, so the per-instruction-set source
+// files can use it without building shared inline code with their flags.
+
+#include "core/typedefs.h"
+
+namespace Mapo
+{
+	namespace Detail
+	{
+		constexpr U32 OCCLUSION_TILE_WIDTH = 8;
+		constexpr U32 OCCLUSION_TILE_HEIGHT = 4;
+		constexpr U32 OCCLUSION_TILE_FULL_MASK = ~0u;
+
+		// 8x4 pixels of the masked depth buffer; pixel (x, y) of the tile is bit y * 8 + x. Pixels in the mask are
+		// covered no farther than min(zMax0, zMax1), all others no farther than zMax0.
+		struct OcclusionTile
+		{
+			F32 zMax0; // reference layer
+			F32 zMax1; // working layer, merged into the reference layer once the mask is full
+			U32 mask;
+			U32 padding;
+		};
+
+		// Screen-space triangle after setup, in pixels with depth in [0, 1]. A pixel center (x, y) is covered when
+		// all three edges a * x + b * y + c are at least 0, and the depth plane is a * x + b * y + c as well.
+		struct OcclusionTriangle
+		{
+			F32 edgeA[3];
+			F32 edgeB[3];
+			F32 edgeC[3];
+			F32 depthA;
+			F32 depthB;
+			F32 depthC;
+			F32 maxDepth; // farthest vertex, bounds the plane where it is extrapolated
+
+			// Pixels whose centers may be covered, clamped to the buffer
+			I32 minX;
+			I32 maxX;
+			I32 minY;
+			I32 maxY;
+		};
+
+		// Rasterizes the triangles overlapping one row of tiles. `rowTiles` points at the first tile of the row.
+		// Defined in software_occlusion_avx2.cpp, only present on x86.
+		void RasterizeTileRowAVX2(const OcclusionTriangle* triangles, U32 triangleCount, U32 tileRow, OcclusionTile* rowTiles);
+	} // namespace Detail
+
+} // namespace Mapo
@@ -120,7 +120,7 @@ namespace Mapo
 		vkResetFences(m_device.GetDevice(), 1, &m_inFlightFences[m_currentFrame]);
 
 		// When the command buffer execution is done, it signals that the command buffer can be reused.
-		VK_CHECK(vkQueueSubmit(m_device.GetGraphicsQueue(), 1, &submitInfo, m_inFlightFences[m_currentFrame]));
+		m_device.SubmitGraphics(submitInfo, m_inFlightFences[m_currentFrame]);
 
 		// Presentation (submitting the result back to swapchain)
 		VkPresentInfoKHR presentInfo{};
@@ -134,7 +134,7 @@ namespace Mapo
 		presentInfo.pSwapchains = swapchains;
 		presentInfo.pImageIndices = imageIndex;
 
-		VkResult presentResult = vkQueuePresentKHR(m_device.GetPresentQueue(), &presentInfo);
+		VkResult presentResult = m_device.Present(presentInfo);
 
 		// Advance the current frame index.
 		m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
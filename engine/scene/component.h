@@ -8,6 +8,7 @@
 
 #include "engine/scene/scene_camera.h"
 #include "engine/scene/scriptable.h"
+#include "engine/scene/script_batch.h"
 
 #include <IconFontCppHeaders/IconsFontAwesome5.h>
 
@@ -46,18 +47,50 @@ namespace Mapo
 
 	struct TransformComponent : public Component
 	{
+		// Local to the parent game object (see HierarchyComponent), or to the world without one.
 		Vector3 translation{};
 		Vector3 rotation{};
 		Vector3 scale{ 1.0f, 1.0f, 1.0f };
 
-		Matrix4 GetTransformMatrix();
+		// Updated by the scene at the end of each update.
+		Matrix4 worldMatrix{ 1.0f };
+		Matrix4 worldNormalMatrix{ 1.0f }; // upper 3x3 is used
 
+		// Local matrices. These compute the sines and cosines on every call, so prefer the cached ones.
+		Matrix4 GetTransformMatrix();
 		Matrix3 GetNormalMatrix();
 
+		// Maintained by the scene's transform update. Local values are compared with the ones the cached
+		// matrices were built from, so transforms can be edited in place and still update.
+		struct Cache
+		{
+			Vector3 translation{};
+			Vector3 rotation{};
+			Vector3 scale{};
+			Matrix4 localMatrix{ 1.0f };
+			Matrix4 localNormalMatrix{ 1.0f };
+			bool	valid = false;
+			bool	localChanged = false;
+			bool	worldChanged = false; // in the last update
+		};
+
+		Cache cache{};
+
 		MP_COMPONENT_NAME("Transform");
 		MP_COMPONENT_ICON(ICON_FA_LOCATION_ARROW);
 	};
 
+	// Parents a game object to another one. Use Scene::SetParent to change it; the scene keeps these components
+	// sorted by depth so world transforms are updated parents first in one linear pass.
+	struct HierarchyComponent : public Component
+	{
+		entt::entity parent{ entt::null };
+		U32			 depth = 0; // set by the scene
+
+		MP_COMPONENT_NAME("Hierarchy");
+		MP_COMPONENT_ICON(ICON_FA_SITEMAP);
+	};
+
 	struct MeshComponent : public Component
 	{
 		MeshComponent(Ref<Model> m)
@@ -65,6 +98,12 @@ namespace Mapo
 
 		Ref<Model> model{};
 
+		bool occluder = false; // rasterized for software occlusion culling, should be large and solid
+
+		I32 pvsObject = -1; // object in the scene's baked PVS, managed by the scene
+
+		I32 spatialProxy = -1; // leaf in the scene's spatial tree, managed by the scene
+
 		MP_COMPONENT_NAME("Mesh");
 		MP_COMPONENT_ICON(ICON_FA_VECTOR_SQUARE);
 	};
@@ -97,26 +136,16 @@ namespace Mapo
 
 	struct NativeScriptComponent : public Component
 	{
+		// Created by the scene on its first update, stored in the scene's batch of the script type.
 		Scriptable* scriptable = nullptr;
 
-		// Create the scriptable instance.
-		Scriptable* (*InstantiateScript)();
-
-		void (*DestroyScript)(NativeScriptComponent*);
+		ScriptBatchBase& (*GetScriptBatch)(Scene&) = nullptr;
 
 		template <typename ScriptableType>
 		void Bind()
 		{
-			// Create script lambda.
-			InstantiateScript = []() {
-				return static_cast<Scriptable*>(MP_NEW(ScriptableType));
-			};
-
-			DestroyScript = [](NativeScriptComponent* scriptComponent) {
-				scriptComponent->scriptable->OnDestroy();
-
-				MP_DELETE(scriptComponent->scriptable);
-				scriptComponent->scriptable = nullptr;
+			GetScriptBatch = [](Scene& scene) -> ScriptBatchBase& {
+				return scene.GetScriptBatch<ScriptableType>();
 			};
 		}
 
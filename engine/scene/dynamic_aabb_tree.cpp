@@ -0,0 +1,326 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "dynamic_aabb_tree.h"
+
+namespace Mapo
+{
+	static AABB Union(const AABB& a, const AABB& b)
+	{
+		return { MathOp::Min(a.min, b.min), MathOp::Max(a.max, b.max) };
+	}
+
+	static F32 SurfaceArea(const AABB& box)
+	{
+		const Vector3 size = box.max - box.min;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	static bool Contains(const AABB& outer, const AABB& inner)
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+			&& outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+	}
+
+	I32 DynamicAABBTree::CreateProxy(const AABB& box, U32 userData)
+	{
+		const I32 proxy = AllocateNode();
+
+		Node& node = m_nodes[proxy];
+		node.box = { box.min - Vector3(AABB_MARGIN), box.max + Vector3(AABB_MARGIN) };
+		node.height = 0;
+		node.userData = userData;
+
+		InsertLeaf(proxy);
+		++m_proxyCount;
+
+		return proxy;
+	}
+
+	void DynamicAABBTree::DestroyProxy(I32 proxy)
+	{
+		MP_ASSERT(proxy >= 0 && proxy < static_cast<I32>(m_nodes.size()) && m_nodes[proxy].IsLeaf(), "Invalid proxy!");
+
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		--m_proxyCount;
+	}
+
+	bool DynamicAABBTree::MoveProxy(I32 proxy, const AABB& box)
+	{
+		MP_ASSERT(proxy >= 0 && proxy < static_cast<I32>(m_nodes.size()) && m_nodes[proxy].IsLeaf(), "Invalid proxy!");
+
+		if (Contains(m_nodes[proxy].box, box))
+		{
+			return false;
+		}
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].box = { box.min - Vector3(AABB_MARGIN), box.max + Vector3(AABB_MARGIN) };
+		InsertLeaf(proxy);
+
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_nodes.clear();
+		m_root = NULL_NODE;
+		m_freeList = NULL_NODE;
+		m_proxyCount = 0;
+	}
+
+	I32 DynamicAABBTree::AllocateNode()
+	{
+		if (m_freeList == NULL_NODE)
+		{
+			m_nodes.emplace_back();
+			return static_cast<I32>(m_nodes.size()) - 1;
+		}
+
+		const I32 node = m_freeList;
+		m_freeList = m_nodes[node].parent;
+		m_nodes[node] = Node{};
+
+		return node;
+	}
+
+	void DynamicAABBTree::FreeNode(I32 node)
+	{
+		m_nodes[node].parent = m_freeList;
+		m_nodes[node].height = -1;
+		m_freeList = node;
+	}
+
+	void DynamicAABBTree::InsertLeaf(I32 leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// Walk down to the best sibling. Pairing with a node costs the area of the new parent, and every
+		// ancestor on the way grows by the area it gains.
+		const AABB leafBox = m_nodes[leaf].box;
+		I32		   index = m_root;
+
+		while (!m_nodes[index].IsLeaf())
+		{
+			const Node& node = m_nodes[index];
+
+			const F32 area = SurfaceArea(node.box);
+			const F32 combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+			const F32 cost = 2.0f * combinedArea;					// new parent here
+			const F32 inheritedCost = 2.0f * (combinedArea - area); // pushing the leaf further down
+
+			F32 childCosts[2];
+			for (U32 i = 0; i < 2; ++i)
+			{
+				const Node& child = m_nodes[node.children[i]];
+				const F32	unionArea = SurfaceArea(Union(child.box, leafBox));
+
+				childCosts[i] = (child.IsLeaf() ? unionArea : unionArea - SurfaceArea(child.box)) + inheritedCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+
+			index = (childCosts[0] < childCosts[1]) ? node.children[0] : node.children[1];
+		}
+
+		const I32 sibling = index;
+		const I32 oldParent = m_nodes[sibling].parent;
+		const I32 newParent = AllocateNode();
+
+		Node& parent = m_nodes[newParent];
+		parent.parent = oldParent;
+		parent.box = Union(leafBox, m_nodes[sibling].box);
+		parent.height = m_nodes[sibling].height + 1;
+		parent.children[0] = sibling;
+		parent.children[1] = leaf;
+
+		if (oldParent != NULL_NODE)
+		{
+			ReplaceChild(oldParent, sibling, newParent);
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		Refit(m_nodes[leaf].parent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(I32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		const I32 parent = m_nodes[leaf].parent;
+		const I32 grandParent = m_nodes[parent].parent;
+		const I32 sibling = (m_nodes[parent].children[0] == leaf) ? m_nodes[parent].children[1] : m_nodes[parent].children[0];
+
+		// The sibling takes the parent's place.
+		m_nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		if (grandParent != NULL_NODE)
+		{
+			ReplaceChild(grandParent, parent, sibling);
+			Refit(grandParent);
+		}
+		else
+		{
+			m_root = sibling;
+		}
+	}
+
+	void DynamicAABBTree::Refit(I32 node)
+	{
+		for (I32 index = node; index != NULL_NODE; index = m_nodes[index].parent)
+		{
+			index = Balance(index);
+
+			Node&		current = m_nodes[index];
+			const Node& child0 = m_nodes[current.children[0]];
+			const Node& child1 = m_nodes[current.children[1]];
+
+			current.height = 1 + std::max(child0.height, child1.height);
+			current.box = Union(child0.box, child1.box);
+		}
+	}
+
+	I32 DynamicAABBTree::Balance(I32 indexA)
+	{
+		// Rotates the taller child B up if the children's heights differ by more than one. A(B(D, E), C) becomes
+		// B(A(E, C), D), where D is the taller of B's children; mirrored when C is the taller child.
+		Node& a = m_nodes[indexA];
+
+		if (a.IsLeaf() || a.height < 2)
+		{
+			return indexA;
+		}
+
+		const I32 balance = m_nodes[a.children[1]].height - m_nodes[a.children[0]].height;
+
+		if (balance >= -1 && balance <= 1)
+		{
+			return indexA;
+		}
+
+		const U32 up = (balance > 1) ? 1 : 0; // child that moves up
+		const U32 keep = 1 - up;
+
+		const I32 indexB = a.children[up];
+		const I32 indexC = a.children[keep];
+		Node&	  b = m_nodes[indexB];
+		Node&	  c = m_nodes[indexC];
+
+		const I32 indexD = b.children[0];
+		const I32 indexE = b.children[1];
+		Node&	  d = m_nodes[indexD];
+		Node&	  e = m_nodes[indexE];
+
+		// B replaces A under A's parent.
+		b.parent = a.parent;
+		if (b.parent != NULL_NODE)
+		{
+			ReplaceChild(b.parent, indexA, indexB);
+		}
+		else
+		{
+			m_root = indexB;
+		}
+
+		a.parent = indexB;
+
+		// The taller grandchild stays with B, the other one takes B's place under A.
+		const bool dTaller = d.height > e.height;
+		const I32  indexTall = dTaller ? indexD : indexE;
+		const I32  indexShort = dTaller ? indexE : indexD;
+		Node&	   tall = m_nodes[indexTall];
+		Node&	   shortNode = m_nodes[indexShort];
+
+		a.children[up] = indexShort;
+		shortNode.parent = indexA;
+		a.box = Union(c.box, shortNode.box);
+		a.height = 1 + std::max(c.height, shortNode.height);
+
+		b.children[0] = indexA;
+		b.children[1] = indexTall;
+		tall.parent = indexB;
+		b.box = Union(a.box, tall.box);
+		b.height = 1 + std::max(a.height, tall.height);
+
+		return indexB;
+	}
+
+	void DynamicAABBTree::ReplaceChild(I32 parent, I32 oldChild, I32 newChild)
+	{
+		Node& node = m_nodes[parent];
+
+		if (node.children[0] == oldChild)
+		{
+			node.children[0] = newChild;
+		}
+		else
+		{
+			MP_ASSERT(node.children[1] == oldChild, "Node is not a child of its parent!");
+			node.children[1] = newChild;
+		}
+	}
+
+	void DynamicAABBTree::Validate() const
+	{
+		if (m_root != NULL_NODE)
+		{
+			MP_ASSERT(m_nodes[m_root].parent == NULL_NODE, "Root has a parent!");
+			ValidateNode(m_root);
+		}
+
+		U32 freeCount = 0;
+		for (I32 index = m_freeList; index != NULL_NODE; index = m_nodes[index].parent)
+		{
+			MP_ASSERT(m_nodes[index].height == -1, "Node on the free list is in use!");
+			++freeCount;
+		}
+
+		// A tree with n leaves has n - 1 internal nodes.
+		const U32 usedCount = m_proxyCount == 0 ? 0 : 2 * m_proxyCount - 1;
+		MP_ASSERT(usedCount + freeCount == m_nodes.size(), "Leaked tree nodes!");
+	}
+
+	void DynamicAABBTree::ValidateNode(I32 index) const
+	{
+		const Node& node = m_nodes[index];
+
+		if (node.IsLeaf())
+		{
+			MP_ASSERT(node.height == 0, "Leaf with a height!");
+			return;
+		}
+
+		const Node& child0 = m_nodes[node.children[0]];
+		const Node& child1 = m_nodes[node.children[1]];
+
+		MP_ASSERT(child0.parent == index && child1.parent == index, "Broken parent link!");
+		MP_ASSERT(node.height == 1 + std::max(child0.height, child1.height), "Wrong node height!");
+		MP_ASSERT(Contains(node.box, child0.box) && Contains(node.box, child1.box), "Node box does not contain its children!");
+
+		ValidateNode(node.children[0]);
+		ValidateNode(node.children[1]);
+	}
+
+} // namespace Mapo
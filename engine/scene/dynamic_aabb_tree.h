@@ -0,0 +1,261 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <utility>
+#include <vector>
+
+namespace Mapo
+{
+	// Bounding volume hierarchy over moving boxes, kept balanced with tree rotations. Leaves (proxies) store a
+	// box enlarged by AABB_MARGIN, so small movements only update the leaf's stored box and the tree is only
+	// changed when a box leaves its enlarged box. New leaves are inserted next to the sibling that grows the
+	// total surface area the least.
+	//
+	// Queries report proxies whose enlarged box passes the test; callers that need exact results test their
+	// own bounds again.
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr I32 NULL_NODE = -1;
+		static constexpr F32 AABB_MARGIN = 0.1f;
+
+		I32	 CreateProxy(const AABB& box, U32 userData);
+		void DestroyProxy(I32 proxy);
+
+		// Returns true if the proxy had to be reinserted.
+		bool MoveProxy(I32 proxy, const AABB& box);
+
+		void Clear();
+
+		U32			GetUserData(I32 proxy) const { return m_nodes[proxy].userData; }
+		const AABB& GetFatAABB(I32 proxy) const { return m_nodes[proxy].box; }
+
+		U32 GetProxyCount() const { return m_proxyCount; }
+		I32 GetHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+		// Calls `callback(proxy)` for every proxy overlapping `box`. Return false from the callback to stop.
+		template <typename Callback>
+		void QueryAABB(const AABB& box, Callback&& callback) const;
+
+		// Calls `callback(proxy)` for every proxy not completely outside one of the planes (normal, offset) with
+		// normals pointing inside. Subtrees completely inside all planes are reported without further tests.
+		template <typename Callback>
+		void QueryFrustum(const Vector4* planes, U32 planeCount, Callback&& callback) const;
+
+		// Calls `callback(proxy, maxDistance)` for proxies hit within `maxDistance` along the ray, nearer
+		// subtrees first. The callback returns the new maximum distance: the current one to continue, a smaller
+		// one (e.g. the distance of an exact hit) to clip the ray, or 0 to stop.
+		template <typename Callback>
+		void RayCast(const Ray& ray, F32 maxDistance, Callback&& callback) const;
+
+		// Asserts on broken links, heights or boxes. Walks the whole tree.
+		void Validate() const;
+
+	private:
+		struct Node
+		{
+			AABB box{};
+			I32	 parent = NULL_NODE; // next free node while on the free list
+			I32	 children[2]{ NULL_NODE, NULL_NODE };
+			I32	 height = -1; // 0 for leaves, -1 for free nodes
+			U32	 userData = 0;
+
+			bool IsLeaf() const { return children[0] == NULL_NODE; }
+		};
+
+		// Deep enough for any tree that fits in memory, since the height stays logarithmic.
+		static constexpr U32 MAX_STACK_SIZE = 256;
+
+		I32	 AllocateNode();
+		void FreeNode(I32 node);
+
+		void InsertLeaf(I32 leaf);
+		void RemoveLeaf(I32 leaf);
+		void Refit(I32 node);
+		I32	 Balance(I32 node);
+		void ReplaceChild(I32 parent, I32 oldChild, I32 newChild);
+
+		void ValidateNode(I32 node) const;
+
+	private:
+		std::vector<Node> m_nodes{};
+		I32				  m_root = NULL_NODE;
+		I32				  m_freeList = NULL_NODE;
+		U32				  m_proxyCount = 0;
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Queries
+	/////////////////////////////////////////////////////////////////////////////////
+
+	template <typename Callback>
+	void DynamicAABBTree::QueryAABB(const AABB& box, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		I32 stack[MAX_STACK_SIZE];
+		U32 stackSize = 0;
+		stack[stackSize++] = m_root;
+
+		while (stackSize > 0)
+		{
+			const I32	index = stack[--stackSize];
+			const Node& node = m_nodes[index];
+
+			const bool overlaps = node.box.min.x <= box.max.x && node.box.max.x >= box.min.x
+				&& node.box.min.y <= box.max.y && node.box.max.y >= box.min.y
+				&& node.box.min.z <= box.max.z && node.box.max.z >= box.min.z;
+
+			if (!overlaps)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				if (!callback(index))
+				{
+					return;
+				}
+			}
+			else
+			{
+				MP_ASSERT(stackSize + 2 <= MAX_STACK_SIZE, "DynamicAABBTree query stack overflow!");
+				stack[stackSize++] = node.children[0];
+				stack[stackSize++] = node.children[1];
+			}
+		}
+	}
+
+	template <typename Callback>
+	void DynamicAABBTree::QueryFrustum(const Vector4* planes, U32 planeCount, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		// The low bit of a stack entry marks subtrees already known to be inside.
+		I32 stack[MAX_STACK_SIZE];
+		U32 stackSize = 0;
+		stack[stackSize++] = m_root << 1;
+
+		while (stackSize > 0)
+		{
+			const I32	entry = stack[--stackSize];
+			const I32	index = entry >> 1;
+			const Node& node = m_nodes[index];
+			bool		inside = entry & 1;
+
+			if (!inside)
+			{
+				const Vector3 center = (node.box.min + node.box.max) * 0.5f;
+				const Vector3 extent = (node.box.max - node.box.min) * 0.5f;
+
+				bool outside = false;
+				inside = true;
+
+				for (U32 p = 0; p < planeCount && !outside; ++p)
+				{
+					const Vector3 normal = Vector3(planes[p]);
+					const F32	  distance = MathOp::Dot(normal, center) + planes[p].w;
+					const F32	  radius = MathOp::Dot(MathOp::Abs(normal), extent);
+
+					outside = distance < -radius;
+					inside = inside && distance >= radius;
+				}
+
+				if (outside)
+				{
+					continue;
+				}
+			}
+
+			if (node.IsLeaf())
+			{
+				if (!callback(index))
+				{
+					return;
+				}
+			}
+			else
+			{
+				MP_ASSERT(stackSize + 2 <= MAX_STACK_SIZE, "DynamicAABBTree query stack overflow!");
+				stack[stackSize++] = (node.children[0] << 1) | (inside ? 1 : 0);
+				stack[stackSize++] = (node.children[1] << 1) | (inside ? 1 : 0);
+			}
+		}
+	}
+
+	template <typename Callback>
+	void DynamicAABBTree::RayCast(const Ray& ray, F32 maxDistance, Callback&& callback) const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return;
+		}
+
+		I32 stack[MAX_STACK_SIZE];
+		U32 stackSize = 0;
+		stack[stackSize++] = m_root;
+
+		while (stackSize > 0)
+		{
+			const I32	index = stack[--stackSize];
+			const Node& node = m_nodes[index];
+
+			// Tested again since the ray may have been clipped after the node was pushed.
+			F32 distance = 0.0f;
+			if (!MathOp::IntersectRayAABB(ray, node.box, maxDistance, distance))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				maxDistance = callback(index, maxDistance);
+
+				if (maxDistance <= 0.0f)
+				{
+					return;
+				}
+			}
+			else
+			{
+				// Visit the child the ray enters first, so hits there clip the ray for the other one.
+				I32 first = node.children[0];
+				I32 second = node.children[1];
+
+				F32	 firstDistance = 0.0f;
+				F32	 secondDistance = 0.0f;
+				bool firstHit = MathOp::IntersectRayAABB(ray, m_nodes[first].box, maxDistance, firstDistance);
+				bool secondHit = MathOp::IntersectRayAABB(ray, m_nodes[second].box, maxDistance, secondDistance);
+
+				if (secondHit && (!firstHit || secondDistance < firstDistance))
+				{
+					std::swap(first, second);
+					std::swap(firstHit, secondHit);
+				}
+
+				MP_ASSERT(stackSize + 2 <= MAX_STACK_SIZE, "DynamicAABBTree query stack overflow!");
+				if (secondHit)
+				{
+					stack[stackSize++] = second;
+				}
+				if (firstHit)
+				{
+					stack[stackSize++] = first;
+				}
+			}
+		}
+	}
+
+} // namespace Mapo
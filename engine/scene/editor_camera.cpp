@@ -158,6 +158,20 @@ namespace Mapo
 		UpdateProjection();
 	}
 
+	Ray EditorCamera::ScreenPointToRay(const Vector2& position) const
+	{
+		// The projection flips y for Vulkan, so clip space y points down like window coordinates.
+		const Vector2 ndc = { 2.0f * position.x / m_viewportWidth - 1.0f, 2.0f * position.y / m_viewportHeight - 1.0f };
+		const Matrix4 inverse = MathOp::Inverse(GetViewProjectionMatrix());
+
+		Vector4 nearPoint = inverse * Vector4(ndc.x, ndc.y, 0.0f, 1.0f);
+		Vector4 farPoint = inverse * Vector4(ndc.x, ndc.y, 1.0f, 1.0f);
+		nearPoint /= nearPoint.w;
+		farPoint /= farPoint.w;
+
+		return { Vector3(nearPoint), MathOp::Normalize(Vector3(farPoint - nearPoint)) };
+	}
+
 	/////////////////////////////////////////////////////////////////////////////////
 
 	Vector2 EditorCamera::PanSpeed() const
@@ -43,12 +43,26 @@ namespace Mapo
 		// Fov
 		F32& GetFov() { return m_fov; }
 
+		F32 GetFarClip() const { return m_far; }
+
+		// World-space ray from the near plane through a point in window coordinates (origin at the top left).
+		Ray ScreenPointToRay(const Vector2& position) const;
+
 		// Orientation
 		glm::quat GetOrientation() const { return glm::quat(Vector3(-m_pitch, -m_yaw, 0.0f)); }
 
 		F32 GetPitch() const { return m_pitch; }
 		F32 GetYaw() const { return m_yaw; }
 
+		// Places the camera directly (e.g. scripted paths). Pitch and yaw are in radians.
+		void SetPose(const Vector3& position, F32 pitch, F32 yaw)
+		{
+			m_position = position;
+			m_pitch = pitch;
+			m_yaw = yaw;
+			UpdateView();
+		}
+
 		void SetViewportSize(F32 width, F32 height);
 
 		// Update matrix
@@ -0,0 +1,244 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "entity_command_buffer.h"
+
+#include <algorithm>
+
+namespace Mapo
+{
+	EntityCommandBuffer::~EntityCommandBuffer()
+	{
+		Reset();
+	}
+
+	DeferredEntity EntityCommandBuffer::CreateGameObject(const String& name)
+	{
+		DeferredEntity deferred{ m_createCount };
+
+		String* payload = new (AllocatePayload(sizeof(String), alignof(String))) String(name);
+		Record(CommandType::CreateGameObject, deferred, nullptr, payload);
+
+		return deferred;
+	}
+
+	void EntityCommandBuffer::DestroyGameObject(Target target)
+	{
+		Record(CommandType::DestroyGameObject, target, nullptr, nullptr);
+	}
+
+	void EntityCommandBuffer::Record(CommandType type, Target target, const ComponentOpTable* ops, void* payload)
+	{
+		MP_ASSERT(target.createIndex == INVALID_INDEX || target.createIndex < m_createCount || type == CommandType::CreateGameObject,
+			"Deferred entity does not belong to this command buffer!");
+
+		if (type == CommandType::CreateGameObject)
+		{
+			m_createCount++;
+		}
+
+		m_commands.push_back({ type, target, ops, payload });
+	}
+
+	void* EntityCommandBuffer::AllocatePayload(size_t size, size_t alignment)
+	{
+		while (m_currentPage < m_pages.size())
+		{
+			Page&			page = m_pages[m_currentPage];
+			const uintptr_t base = reinterpret_cast<uintptr_t>(page.memory.get());
+			const uintptr_t aligned = AlignAddress(base + m_pageOffset, static_cast<U8>(alignment));
+
+			if (aligned + size <= base + page.size)
+			{
+				m_pageOffset = aligned + size - base;
+				return reinterpret_cast<void*>(aligned);
+			}
+
+			m_currentPage++;
+			m_pageOffset = 0;
+		}
+
+		// Out of pages. The new one is used by the next loop.
+		const size_t pageSize = std::max(PAGE_SIZE, size + alignment);
+		m_pages.push_back({ MakeUnique<U8[]>(pageSize), pageSize });
+
+		return AllocatePayload(size, alignment);
+	}
+
+	void EntityCommandBuffer::DestroyPayloads(std::vector<Command>& commands)
+	{
+		for (Command& command : commands)
+		{
+			if (!command.payload)
+			{
+				continue;
+			}
+
+			if (command.type == CommandType::CreateGameObject)
+			{
+				static_cast<String*>(command.payload)->~String();
+			}
+			else
+			{
+				command.ops->destroy(command.payload);
+			}
+		}
+
+		commands.clear();
+	}
+
+	void EntityCommandBuffer::Reset()
+	{
+		DestroyPayloads(m_commands);
+		m_createCount = 0;
+
+		m_currentPage = 0;
+		m_pageOffset = 0;
+	}
+
+	void EntityCommandBuffer::BeginPlayback()
+	{
+		MP_ASSERT(m_playbackCommands.empty(), "Command buffer is already being played back!");
+
+		// The pages go with the commands, since their payloads live there. Recording starts over in empty pages.
+		m_playbackCommands.swap(m_commands);
+		m_playbackPages.swap(m_pages);
+		m_createdEntities.assign(m_createCount, entt::null);
+
+		m_createCount = 0;
+		m_currentPage = 0;
+		m_pageOffset = 0;
+	}
+
+	void EntityCommandBuffer::EndPlayback()
+	{
+		DestroyPayloads(m_playbackCommands);
+		m_createdEntities.clear();
+
+		// Give the pages back for reuse, after any the commands recorded during playback are using.
+		for (Page& page : m_playbackPages)
+		{
+			m_pages.push_back(std::move(page));
+		}
+
+		m_playbackPages.clear();
+	}
+
+	void EntityCommandBuffer::Playback(Scene& scene, EntityCommandBuffer* const* buffers, U32 bufferCount)
+	{
+		MP_PROFILE_SCOPE("EntityCommandBuffer::Playback");
+
+		if (bufferCount == 0)
+		{
+			return;
+		}
+
+		// The first buffer keeps the sort scratch, so every set of buffers has its own.
+		std::vector<SortedCommand>& componentCommands = buffers[0]->m_sortedComponentCommands;
+		std::vector<SortedCommand>& destroyCommands = buffers[0]->m_sortedDestroyCommands;
+
+		componentCommands.clear();
+		destroyCommands.clear();
+
+		entt::registry& registry = scene.m_registry;
+
+		// Component callbacks may record into the buffers, which must not move the commands being applied.
+		for (U32 bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+		{
+			buffers[bufferIndex]->BeginPlayback();
+		}
+
+		// Create game objects in recording order so deferred entities can be resolved.
+		for (U32 bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+		{
+			EntityCommandBuffer& buffer = *buffers[bufferIndex];
+
+			for (const Command& command : buffer.m_playbackCommands)
+			{
+				if (command.type == CommandType::CreateGameObject)
+				{
+					GameObject gameObject = scene.CreateGameObject(*static_cast<String*>(command.payload));
+					buffer.m_createdEntities[command.target.createIndex] = gameObject;
+				}
+			}
+		}
+
+		// Resolve targets and drop commands on game objects that no longer exist.
+		for (U32 bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+		{
+			EntityCommandBuffer& buffer = *buffers[bufferIndex];
+
+			for (U32 commandIndex = 0; commandIndex < buffer.m_playbackCommands.size(); ++commandIndex)
+			{
+				const Command& command = buffer.m_playbackCommands[commandIndex];
+
+				if (command.type == CommandType::CreateGameObject)
+				{
+					continue;
+				}
+
+				const Target&	   target = command.target;
+				const entt::entity entity = target.createIndex != INVALID_INDEX ? buffer.m_createdEntities[target.createIndex] : target.entity;
+
+				if (!registry.valid(entity))
+				{
+					MP_WARN("EntityCommandBuffer: Skipped a command on a destroyed game object!");
+					continue;
+				}
+
+				const U32	  entityIndex = static_cast<U32>(entt::to_entity(entity));
+				SortedCommand sorted{ command.ops ? command.ops->componentType : 0, entityIndex, bufferIndex, commandIndex, entity };
+
+				if (command.type == CommandType::DestroyGameObject)
+				{
+					destroyCommands.push_back(sorted);
+				}
+				else
+				{
+					componentCommands.push_back(sorted);
+				}
+			}
+		}
+
+		std::sort(componentCommands.begin(), componentCommands.end());
+		std::sort(destroyCommands.begin(), destroyCommands.end());
+
+		for (const SortedCommand& sorted : componentCommands)
+		{
+			const Command& command = buffers[sorted.bufferIndex]->m_playbackCommands[sorted.commandIndex];
+
+			switch (command.type)
+			{
+				case CommandType::AddComponent:
+					command.ops->add(scene, sorted.entity, command.payload);
+					break;
+				case CommandType::SetComponent:
+					command.ops->set(scene, sorted.entity, command.payload);
+					break;
+				case CommandType::RemoveComponent:
+					command.ops->remove(scene, sorted.entity);
+					break;
+				default:
+					MP_ASSERT(false, "Unexpected command type!");
+					break;
+			}
+		}
+
+		// The same game object may be destroyed by several commands.
+		for (const SortedCommand& sorted : destroyCommands)
+		{
+			if (registry.valid(sorted.entity))
+			{
+				GameObject gameObject(sorted.entity, &scene);
+				scene.DestroyGameObject(gameObject);
+			}
+		}
+
+		for (U32 bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex)
+		{
+			buffers[bufferIndex]->EndPlayback();
+		}
+	}
+
+} // namespace Mapo
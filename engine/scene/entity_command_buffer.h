@@ -0,0 +1,217 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "engine/scene/game_object.h"
+
+#include <new>
+#include <vector>
+
+namespace Mapo
+{
+	// Game object created by a command buffer. It only becomes a real entity during playback, but later
+	// commands of the same buffer can already refer to it.
+	struct DeferredEntity
+	{
+		U32 index = 0;
+	};
+
+	// Records structural changes (create/destroy game objects, add/set/remove components) so they can be made
+	// while views are iterated or from job threads. Each job system thread records into its own buffer; the
+	// scene plays all of them back on the main thread at fixed points of the frame.
+	//
+	// Commands and component values are stored in a linear arena that is reused every frame. Playback creates
+	// game objects first, then applies component commands sorted by component type and entity so each storage is
+	// touched once and in order, and destroys game objects last.
+	class EntityCommandBuffer
+	{
+	public:
+		static constexpr U32 INVALID_INDEX = ~0u;
+
+		// Game object a command applies to: an existing one or one created by this buffer.
+		struct Target
+		{
+			Target(entt::entity entity)
+				: entity(entity) { }
+			Target(const GameObject& gameObject)
+				: entity(gameObject) { }
+			Target(DeferredEntity deferred)
+				: createIndex(deferred.index) { }
+
+			entt::entity entity{ entt::null };
+			U32			 createIndex = INVALID_INDEX;
+		};
+
+		// Size of an arena page. Larger values get a page of their own.
+		static constexpr size_t PAGE_SIZE = 64 * 1024;
+
+		~EntityCommandBuffer();
+
+		EntityCommandBuffer() = default;
+
+		EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+		EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+		DeferredEntity CreateGameObject(const String& name = "");
+		void		   DestroyGameObject(Target target);
+
+		// Same as GameObject::AddComponent. The game object must not have the component yet.
+		template <typename T, typename... Args>
+		void AddComponent(Target target, Args&&... args)
+		{
+			T* value = new (AllocatePayload(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			Record(CommandType::AddComponent, target, &ComponentOps<T>::s_ops, value);
+		}
+
+		// Adds the component or replaces the existing one.
+		template <typename T>
+		void SetComponent(Target target, T value)
+		{
+			T* payload = new (AllocatePayload(sizeof(T), alignof(T))) T(std::move(value));
+			Record(CommandType::SetComponent, target, &ComponentOps<T>::s_ops, payload);
+		}
+
+		template <typename T>
+		void RemoveComponent(Target target)
+		{
+			Record(CommandType::RemoveComponent, target, &ComponentOps<T>::s_ops, nullptr);
+		}
+
+		bool IsEmpty() const { return m_commands.empty(); }
+		U32	 GetCommandCount() const { return static_cast<U32>(m_commands.size()); }
+
+		// Applies the commands of all buffers to the scene and resets them. Must run on the main thread while
+		// nothing else uses the registry. Buffers are played back in order, so earlier buffers win ties.
+		//
+		// Commands recorded while playing back (by a script's OnDestroy, for example) are kept for the next playback.
+		static void Playback(Scene& scene, EntityCommandBuffer* const* buffers, U32 bufferCount);
+
+	private:
+		enum class CommandType : U8
+		{
+			CreateGameObject,
+			AddComponent,
+			SetComponent,
+			RemoveComponent,
+			DestroyGameObject,
+		};
+
+		// Type-erased component functions, one static instance per component type.
+		struct ComponentOpTable
+		{
+			entt::id_type componentType;
+			void (*add)(Scene& scene, entt::entity entity, void* value);
+			void (*set)(Scene& scene, entt::entity entity, void* value);
+			void (*remove)(Scene& scene, entt::entity entity);
+			void (*destroy)(void* value);
+		};
+
+		template <typename T>
+		struct ComponentOps
+		{
+			// Going through GameObject keeps the scene's OnComponentAdded callbacks.
+			static void Add(Scene& scene, entt::entity entity, void* value)
+			{
+				GameObject gameObject(entity, &scene);
+				gameObject.AddComponent<T>(std::move(*static_cast<T*>(value)));
+			}
+
+			static void Set(Scene& scene, entt::entity entity, void* value)
+			{
+				GameObject gameObject(entity, &scene);
+
+				if (gameObject.HasComponent<T>())
+				{
+					gameObject.GetComponent<T>() = std::move(*static_cast<T*>(value));
+				}
+				else
+				{
+					gameObject.AddComponent<T>(std::move(*static_cast<T*>(value)));
+				}
+			}
+
+			static void Remove(Scene& scene, entt::entity entity)
+			{
+				GameObject gameObject(entity, &scene);
+
+				if (gameObject.HasComponent<T>())
+				{
+					gameObject.RemoveComponent<T>();
+				}
+			}
+
+			static void Destroy(void* value) { static_cast<T*>(value)->~T(); }
+
+			static inline const ComponentOpTable s_ops{ entt::type_hash<T>::value(), &Add, &Set, &Remove, &Destroy };
+		};
+
+		struct Command
+		{
+			CommandType				type;
+			Target					target;
+			const ComponentOpTable* ops;	 // component commands only
+			void*					payload; // component value, or the name of a created game object
+		};
+
+		struct Page
+		{
+			UniqueRef<U8[]> memory;
+			size_t			size;
+		};
+
+		// Key of a command in the sorted playback. Commands on the same component and entity keep their recording order.
+		struct SortedCommand
+		{
+			entt::id_type componentType;
+			U32			  entityIndex;
+			U32			  bufferIndex;
+			U32			  commandIndex;
+			entt::entity  entity;
+
+			bool operator<(const SortedCommand& other) const
+			{
+				if (componentType != other.componentType)
+					return componentType < other.componentType;
+				if (entityIndex != other.entityIndex)
+					return entityIndex < other.entityIndex;
+				if (bufferIndex != other.bufferIndex)
+					return bufferIndex < other.bufferIndex;
+				return commandIndex < other.commandIndex;
+			}
+		};
+
+		void  Record(CommandType type, Target target, const ComponentOpTable* ops, void* payload);
+		void* AllocatePayload(size_t size, size_t alignment);
+
+		// Destroys the recorded values and rewinds the arena.
+		void Reset();
+
+		// Moves the recorded commands and their arena pages aside, so recording can continue while they are applied.
+		void BeginPlayback();
+		void EndPlayback();
+
+		static void DestroyPayloads(std::vector<Command>& commands);
+
+	private:
+		std::vector<Command> m_commands{};
+		U32					 m_createCount = 0;
+
+		// Filled during playback.
+		std::vector<Command>	  m_playbackCommands{};
+		std::vector<Page>		  m_playbackPages{};
+		std::vector<entt::entity> m_createdEntities{};
+
+		std::vector<Page> m_pages{};
+		U32				  m_currentPage = 0;
+		size_t			  m_pageOffset = 0;
+
+		// Sort scratch of Playback, used in the first buffer played back. Kept to reuse the memory.
+		std::vector<SortedCommand> m_sortedComponentCommands{};
+		std::vector<SortedCommand> m_sortedDestroyCommands{};
+	};
+
+} // namespace Mapo
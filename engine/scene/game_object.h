@@ -88,6 +88,8 @@ namespace Mapo
 		bool m_enabled{ true };
 
 		friend class Scene;
+		friend class Scriptable;
+		friend class EntityCommandBuffer;
 	};
 
 } // namespace Mapo
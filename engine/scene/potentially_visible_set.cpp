@@ -0,0 +1,249 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "potentially_visible_set.h"
+
+#include "engine/scene/dynamic_aabb_tree.h"
+
+#include "core/jobs/job_system.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Mapo
+{
+	namespace
+	{
+		struct BlockerTriangle
+		{
+			Vector3 vertices[3];
+			U32		object;
+		};
+
+		// World-space triangles of all objects in a tree, for ray casts from any thread.
+		struct BlockerScene
+		{
+			std::vector<BlockerTriangle> triangles{};
+			DynamicAABBTree				 tree{};
+
+			// Whether the segment from `from` to `to` hits a triangle of any object other than `target`.
+			bool IsBlocked(const Vector3& from, const Vector3& to, U32 target) const
+			{
+				const Vector3 offset = to - from;
+				const F32	  length = MathOp::Length(offset);
+
+				if (length <= 0.0f)
+				{
+					return false;
+				}
+
+				const Ray ray{ from, offset / length };
+				bool	  blocked = false;
+
+				tree.RayCast(ray, length, [&](I32 proxy, F32 maxDistance) {
+					const BlockerTriangle& triangle = triangles[tree.GetUserData(proxy)];
+
+					F32 distance = 0.0f;
+					if (triangle.object != target
+						&& MathOp::IntersectRayTriangle(ray, triangle.vertices[0], triangle.vertices[1], triangle.vertices[2], maxDistance, distance))
+					{
+						blocked = true;
+						return 0.0f;
+					}
+
+					return maxDistance;
+				});
+
+				return blocked;
+			}
+		};
+
+		Vector3 RandomPointInBox(std::mt19937& random, const Vector3& min, const Vector3& max)
+		{
+			std::uniform_real_distribution<F32> unit(0.0f, 1.0f);
+			return min + (max - min) * Vector3(unit(random), unit(random), unit(random));
+		}
+
+		bool Overlaps(const AABB& a, const AABB& b)
+		{
+			return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y && a.min.z <= b.max.z && a.max.z >= b.min.z;
+		}
+	} // namespace
+
+	void PotentiallyVisibleSet::Bake(const std::vector<PvsObject>& objects, const PvsBakeSettings& settings)
+	{
+		MP_PROFILE_SCOPE("PotentiallyVisibleSet::Bake");
+
+		Clear();
+
+		if (objects.empty())
+		{
+			return;
+		}
+
+		// Grid over all objects
+		AABB bounds = objects[0].bounds;
+		for (const PvsObject& object : objects)
+		{
+			bounds.min = MathOp::Min(bounds.min, object.bounds.min);
+			bounds.max = MathOp::Max(bounds.max, object.bounds.max);
+		}
+
+		bounds.min -= Vector3(settings.margin);
+		bounds.max += Vector3(settings.margin);
+
+		const Vector3 size = bounds.max - bounds.min;
+		F32			  cellSize = MathOp::Max(settings.cellSize, 0.01f);
+
+		while (true)
+		{
+			U64 cellCount = 1;
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				m_cellCounts[axis] = MathOp::Max(static_cast<U32>(std::ceil(size[axis] / cellSize)), 1u);
+				cellCount *= m_cellCounts[axis];
+			}
+
+			if (cellCount <= MathOp::Max(settings.maxCellCount, 1u))
+			{
+				break;
+			}
+
+			cellSize *= 1.25f;
+		}
+
+		m_bounds = bounds;
+		m_cellSize = cellSize;
+		m_objectCount = static_cast<U32>(objects.size());
+		m_wordsPerCell = (m_objectCount + 63) / 64;
+
+		// Blockers
+		BlockerScene blockers{};
+
+		for (U32 objectIndex = 0; objectIndex < m_objectCount; ++objectIndex)
+		{
+			const PvsObject& object = objects[objectIndex];
+
+			for (U32 i = 0; i + 2 < object.indexCount; i += 3)
+			{
+				BlockerTriangle triangle{};
+				triangle.object = objectIndex;
+
+				AABB box{ Vector3(std::numeric_limits<F32>::max()), Vector3(-std::numeric_limits<F32>::max()) };
+				for (U32 corner = 0; corner < 3; ++corner)
+				{
+					const Vector3& position = object.positions[object.indices[i + corner]];
+					triangle.vertices[corner] = Vector3(object.worldMatrix * Vector4(position, 1.0f));
+					box.min = MathOp::Min(box.min, triangle.vertices[corner]);
+					box.max = MathOp::Max(box.max, triangle.vertices[corner]);
+				}
+
+				blockers.tree.CreateProxy(box, static_cast<U32>(blockers.triangles.size()));
+				blockers.triangles.push_back(triangle);
+			}
+		}
+
+		// The same targets for every cell, so the result does not depend on how cells are split between threads.
+		const U32			 targetSamples = MathOp::Max(settings.targetSamples, 1u);
+		std::vector<Vector3> targets(static_cast<size_t>(m_objectCount) * targetSamples);
+		std::mt19937		 targetRandom(m_objectCount);
+
+		for (U32 objectIndex = 0; objectIndex < m_objectCount; ++objectIndex)
+		{
+			const AABB& box = objects[objectIndex].bounds;
+			targets[objectIndex * targetSamples] = (box.min + box.max) * 0.5f;
+
+			for (U32 i = 1; i < targetSamples; ++i)
+			{
+				targets[objectIndex * targetSamples + i] = RandomPointInBox(targetRandom, box.min, box.max);
+			}
+		}
+
+		m_bits.assign(static_cast<size_t>(GetCellCount()) * m_wordsPerCell, 0);
+
+		const U32 originSamples = MathOp::Max(settings.originSamples, 1u);
+
+		auto bakeRange = [&](U32 begin, U32 end) {
+			std::vector<Vector3> origins(originSamples);
+
+			for (U32 cell = begin; cell < end; ++cell)
+			{
+				const U32 x = cell % m_cellCounts[0];
+				const U32 y = cell / m_cellCounts[0] % m_cellCounts[1];
+				const U32 z = cell / (m_cellCounts[0] * m_cellCounts[1]);
+
+				AABB cellBox{};
+				cellBox.min = m_bounds.min + Vector3(static_cast<F32>(x), static_cast<F32>(y), static_cast<F32>(z)) * m_cellSize;
+				cellBox.max = cellBox.min + Vector3(m_cellSize);
+
+				std::mt19937 random(cell);
+				origins[0] = (cellBox.min + cellBox.max) * 0.5f;
+				for (U32 i = 1; i < originSamples; ++i)
+				{
+					origins[i] = RandomPointInBox(random, cellBox.min, cellBox.max);
+				}
+
+				U64* bits = m_bits.data() + static_cast<size_t>(cell) * m_wordsPerCell;
+
+				for (U32 objectIndex = 0; objectIndex < m_objectCount; ++objectIndex)
+				{
+					bool visible = Overlaps(cellBox, objects[objectIndex].bounds);
+
+					for (U32 target = 0; target < targetSamples && !visible; ++target)
+					{
+						for (U32 origin = 0; origin < originSamples && !visible; ++origin)
+						{
+							visible = !blockers.IsBlocked(origins[origin], targets[objectIndex * targetSamples + target], objectIndex);
+						}
+					}
+
+					if (visible)
+					{
+						bits[objectIndex / 64] |= U64(1) << (objectIndex % 64);
+					}
+				}
+			}
+		};
+
+		JobSystem::ParallelFor(GetCellCount(), bakeRange);
+
+		MP_INFO("Baked PVS: {} objects, {}x{}x{} cells of {:.2f}, {} bytes", m_objectCount, m_cellCounts[0], m_cellCounts[1], m_cellCounts[2],
+			m_cellSize, GetMemorySize());
+	}
+
+	void PotentiallyVisibleSet::Clear()
+	{
+		m_bounds = {};
+		m_cellCounts[0] = m_cellCounts[1] = m_cellCounts[2] = 0;
+		m_objectCount = 0;
+		m_wordsPerCell = 0;
+		m_bits.clear();
+	}
+
+	U32 PotentiallyVisibleSet::FindCell(const Vector3& position) const
+	{
+		if (!IsBaked())
+		{
+			return INVALID_CELL;
+		}
+
+		U32 cell[3];
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			const F32 coordinate = std::floor((position[axis] - m_bounds.min[axis]) / m_cellSize);
+
+			// Also rejects NaN.
+			if (!(coordinate >= 0.0f && coordinate < static_cast<F32>(m_cellCounts[axis])))
+			{
+				return INVALID_CELL;
+			}
+
+			cell[axis] = static_cast<U32>(coordinate);
+		}
+
+		return (cell[2] * m_cellCounts[1] + cell[1]) * m_cellCounts[0] + cell[0];
+	}
+
+} // namespace Mapo
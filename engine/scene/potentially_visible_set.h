@@ -0,0 +1,75 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <vector>
+
+namespace Mapo
+{
+	// Static object as the baker sees it: world bounds, and the triangles that block sight to other objects.
+	struct PvsObject
+	{
+		AABB		   bounds{};
+		Matrix4		   worldMatrix{ 1.0f };
+		const Vector3* positions = nullptr;
+		U32			   vertexCount = 0;
+		const U32*	   indices = nullptr;
+		U32			   indexCount = 0;
+	};
+
+	struct PvsBakeSettings
+	{
+		F32 cellSize = 1.0f;
+		F32 margin = 1.0f;			// the grid reaches this far past the objects' bounds
+		U32 maxCellCount = 1 << 16; // the cell size grows to stay below
+		U32 originSamples = 16;		// ray origins per cell
+		U32 targetSamples = 16;		// ray targets per object
+	};
+
+	// Precomputed visibility of static objects. The scene's bounds are split into a grid of cells, and every cell
+	// stores a bitset with one bit per object that can be seen from somewhere in the cell. At runtime the camera's
+	// cell is found with one division per axis and each object is a single bit test.
+	//
+	// Baking casts rays from random points in each cell to random points in each object's bounds, against the
+	// triangles of all other objects, and stops at the first ray that gets through. Cells are baked in parallel.
+	// Like any sampled PVS it can miss sight lines through gaps that no ray found, so more samples trade bake time
+	// for fewer mistakes.
+	class PotentiallyVisibleSet
+	{
+	public:
+		static constexpr U32 INVALID_CELL = ~0u;
+
+		// Replaces the baked data. Objects are referred to by their index in `objects`.
+		void Bake(const std::vector<PvsObject>& objects, const PvsBakeSettings& settings = {});
+		void Clear();
+
+		bool IsBaked() const { return !m_bits.empty(); }
+
+		// Cell containing the position, or INVALID_CELL outside of the grid.
+		U32 FindCell(const Vector3& position) const;
+
+		bool IsVisible(U32 cell, U32 object) const
+		{
+			return (m_bits[static_cast<size_t>(cell) * m_wordsPerCell + object / 64] >> (object % 64)) & 1;
+		}
+
+		const AABB& GetBounds() const { return m_bounds; }
+		F32			GetCellSize() const { return m_cellSize; }
+		U32			GetCellCount() const { return m_cellCounts[0] * m_cellCounts[1] * m_cellCounts[2]; }
+		U32			GetObjectCount() const { return m_objectCount; }
+		size_t		GetMemorySize() const { return m_bits.size() * sizeof(U64); }
+
+	private:
+		AABB			 m_bounds{};
+		F32				 m_cellSize = 1.0f;
+		U32				 m_cellCounts[3]{};
+		U32				 m_objectCount = 0;
+		U32				 m_wordsPerCell = 0;
+		std::vector<U64> m_bits{}; // m_wordsPerCell words per cell, x fastest
+	};
+
+} // namespace Mapo
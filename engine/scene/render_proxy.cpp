@@ -0,0 +1,61 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "render_proxy.h"
+
+#include "engine/model.h"
+
+namespace Mapo
+{
+	void RenderProxyBounds::Resize(U32 count)
+	{
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			center[axis].resize(count);
+			extent[axis].resize(count);
+		}
+
+		radius.resize(count);
+	}
+
+	void RenderProxyBounds::Set(U32 index, const Matrix4& worldMatrix, const Model& model)
+	{
+		const AABB&			  box = model.GetBoundingBox();
+		const BoundingSphere& sphere = model.GetBoundingSphere();
+
+		const Vector3 worldCenter = Vector3(worldMatrix * Vector4(sphere.center, 1.0f));
+		const Vector3 localExtent = (box.max - box.min) * 0.5f;
+
+		const Vector3 column0 = Vector3(worldMatrix[0]);
+		const Vector3 column1 = Vector3(worldMatrix[1]);
+		const Vector3 column2 = Vector3(worldMatrix[2]);
+
+		// Projection of the rotated and scaled box on each axis, and the sphere scaled by the largest axis.
+		const Vector3 worldExtent = MathOp::Abs(column0) * localExtent.x + MathOp::Abs(column1) * localExtent.y + MathOp::Abs(column2) * localExtent.z;
+		const F32	  maxScale = MathOp::Max(MathOp::Length(column0), MathOp::Max(MathOp::Length(column1), MathOp::Length(column2)));
+
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			center[axis][index] = worldCenter[axis];
+			extent[axis][index] = worldExtent[axis];
+		}
+
+		radius[index] = sphere.radius * maxScale;
+	}
+
+	Simd::BoundsSoA RenderProxyBounds::GetBounds() const
+	{
+		Simd::BoundsSoA bounds{};
+
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			bounds.center[axis] = center[axis].data();
+			bounds.extent[axis] = extent[axis].data();
+		}
+
+		bounds.radius = radius.data();
+		return bounds;
+	}
+
+} // namespace Mapo
@@ -0,0 +1,50 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+#include "core/simd/simd_batch.h"
+
+#include <entt/entity/registry.hpp>
+
+namespace Mapo
+{
+	class Model;
+
+	enum RenderProxyFlagBits : U32
+	{
+		RENDER_PROXY_VISIBLE = 1 << 0,	// mesh component enabled
+		RENDER_PROXY_OCCLUDER = 1 << 1, // hides other proxies in software occlusion culling
+	};
+
+	// What the renderer needs to draw one mesh, extracted from the scene once per frame. Proxies are stored
+	// packed, so render systems iterate them linearly instead of looking up components per game object.
+	struct RenderProxy
+	{
+		Matrix4		 modelMatrix{ 1.0f };
+		Matrix4		 normalMatrix{ 1.0f }; // upper 3x3 is used
+		Model*		 model = nullptr;	   // owned by the mesh component
+		entt::entity entity{ entt::null };
+		U32			 flags = 0;
+		I32			 pvsObject = -1; // object in the scene's baked PVS, -1 if it is not part of it
+	};
+
+	// World-space bounds of the render proxies in structure-of-arrays layout for SIMD culling. Entry i belongs
+	// to proxy i.
+	struct RenderProxyBounds
+	{
+		std::vector<F32> center[3];
+		std::vector<F32> extent[3];
+		std::vector<F32> radius;
+
+		void Resize(U32 count);
+
+		// Bounds of the model's box and sphere placed with `worldMatrix`.
+		void Set(U32 index, const Matrix4& worldMatrix, const Model& model);
+
+		Simd::BoundsSoA GetBounds() const;
+	};
+
+} // namespace Mapo
@@ -6,11 +6,42 @@
 
 #include "engine/scene/game_object.h"
 #include "engine/scene/component.h"
+#include "engine/scene/entity_command_buffer.h"
+#include "engine/scene/transform_batch.h"
+#include "engine/renderer/frustum_culling.h"
+#include "engine/renderer/software_occlusion.h"
+#include "engine/model.h"
+
+#include <atomic>
 
 namespace Mapo
 {
 	Scene::Scene()
 	{
+		m_registry.on_destroy<NativeScriptComponent>().connect<&Scene::OnNativeScriptDestroyed>(*this);
+
+		m_registry.on_construct<HierarchyComponent>().connect<&Scene::OnHierarchyChanged>(*this);
+		m_registry.on_destroy<HierarchyComponent>().connect<&Scene::OnHierarchyChanged>(*this);
+
+		m_registry.on_destroy<MeshComponent>().connect<&Scene::OnRenderableDestroyed>(*this);
+		m_registry.on_destroy<TransformComponent>().connect<&Scene::OnRenderableDestroyed>(*this);
+
+		// Owning group that keeps the transforms and meshes of renderable game objects packed in the same order.
+		m_registry.group<TransformComponent, MeshComponent>();
+
+		m_softwareOcclusion = MakeUnique<SoftwareOcclusion>();
+
+		for (U32 i = 0; i < JobSystem::GetThreadCount(); ++i)
+		{
+			m_commandBuffers.push_back(MakeUnique<EntityCommandBuffer>());
+			m_commandBufferPointers.push_back(m_commandBuffers.back().get());
+		}
+	}
+
+	Scene::~Scene()
+	{
+		// Destroys the script instances while their batches are still alive.
+		m_registry.clear();
 	}
 
 	void Scene::OnUpdateRuntime(Timestep dt)
@@ -20,25 +51,638 @@ namespace Mapo
 
 	void Scene::OnUpdateEditor(Timestep dt, EditorCamera& camera)
 	{
-		// Run scripts.
-		m_registry.view<NativeScriptComponent>().each([=](entt::entity entityHandle, NativeScriptComponent& scriptComponent) {
-			if (scriptComponent.enabled && scriptComponent.runInEditor)
+		MP_PROFILE_SCOPE("Scene::OnUpdateEditor");
+
+		UpdateScripts(dt);
+		PlaybackCommandBuffers();
+
+		m_systemScheduler.Run(m_registry, m_commandBufferPointers.data(), dt);
+		PlaybackCommandBuffers();
+
+		UpdateWorldTransforms();
+		ExtractRenderProxies();
+
+		// Proxies rejected here lose their visible flag, so CullRenderProxies and the GPU skip them as well.
+		m_culledRenderProxyCount = CullRenderProxiesByPotentiallyVisibleSet(camera.GetPosition());
+		m_visibleRenderProxies.clear();
+
+		CollectChangedRenderProxies();
+	}
+
+	void Scene::UpdateScripts(Timestep dt)
+	{
+		MP_PROFILE_SCOPE("Scene::UpdateScripts");
+
+		// Sync point on the main thread: create new script instances and refresh which ones run.
+		m_registry.view<NativeScriptComponent>().each([this](entt::entity entityHandle, NativeScriptComponent& scriptComponent) {
+			const bool active = scriptComponent.enabled && scriptComponent.runInEditor;
+
+			if (active && !scriptComponent.scriptable && scriptComponent.GetScriptBatch)
+			{
+				scriptComponent.scriptable = scriptComponent.GetScriptBatch(*this).Create();
+				scriptComponent.scriptable->m_gameObject = GameObject{ entityHandle, this };
+				scriptComponent.scriptable->OnCreate();
+			}
+
+			if (scriptComponent.scriptable)
 			{
-				if (!scriptComponent.scriptable)
+				scriptComponent.scriptable->m_active = active;
+			}
+		});
+
+		// Thread-safe script types update in parallel; the others run here one batch after another.
+		for (UniqueRef<ScriptBatchBase>& batch : m_scriptBatches)
+		{
+			batch->UpdateEditor(dt);
+		}
+	}
+
+	EntityCommandBuffer& Scene::GetCommandBuffer()
+	{
+		const U32 threadIndex = JobSystem::GetThreadIndex();
+		MP_ASSERT(threadIndex < m_commandBuffers.size(), "Command buffers can only be used from job system threads!");
+
+		return *m_commandBuffers[threadIndex];
+	}
+
+	void Scene::PlaybackCommandBuffers()
+	{
+		EntityCommandBuffer::Playback(*this, m_commandBufferPointers.data(), static_cast<U32>(m_commandBufferPointers.size()));
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		MP_PROFILE_SCOPE("Scene::UpdateWorldTransforms");
+
+		if (m_hierarchyDirty)
+		{
+			SortHierarchy();
+		}
+
+		auto& transforms = m_registry.storage<TransformComponent>();
+		auto& hierarchies = m_registry.storage<HierarchyComponent>();
+
+		// Local matrices, and world matrices of game objects without a hierarchy component, in packed order.
+		// Unchanged transforms cost one comparison; changed ones are gathered into blocks and computed with SIMD.
+		const entt::entity* entities = transforms.data();
+		auto				components = transforms.rbegin(); // rbegin()[i] is the component of data()[i]
+
+		auto updateRange = [entities, components, &hierarchies](U32 begin, U32 end) {
+			static constexpr U32 BLOCK_SIZE = 64;
+
+			F32				  soa[9][BLOCK_SIZE];
+			U32				  indices[BLOCK_SIZE];
+			TransformMatrices matrices[BLOCK_SIZE];
+			U32				  blockCount = 0;
+
+			TransformBatchInput input{};
+			for (U32 axis = 0; axis < 3; ++axis)
+			{
+				input.translation[axis] = soa[axis];
+				input.rotation[axis] = soa[3 + axis];
+				input.scale[axis] = soa[6 + axis];
+			}
+
+			auto flushBlock = [&]() {
+				ComputeTransformMatrices(input, blockCount, matrices);
+
+				for (U32 b = 0; b < blockCount; ++b)
+				{
+					TransformComponent& transform = components[indices[b]];
+					transform.cache.localMatrix = matrices[b].model;
+					transform.cache.localNormalMatrix = matrices[b].normal;
+
+					if (!hierarchies.contains(entities[indices[b]]))
+					{
+						transform.worldMatrix = matrices[b].model;
+						transform.worldNormalMatrix = matrices[b].normal;
+					}
+				}
+
+				blockCount = 0;
+			};
+
+			for (U32 i = begin; i < end; ++i)
+			{
+				TransformComponent&		   transform = components[i];
+				TransformComponent::Cache& cache = transform.cache;
+
+				cache.localChanged = !cache.valid || cache.translation != transform.translation || cache.rotation != transform.rotation || cache.scale != transform.scale;
+
+				// Game objects in the hierarchy get their world change flag in the pass below.
+				cache.worldChanged = cache.localChanged;
+
+				if (!cache.localChanged)
+				{
+					continue;
+				}
+
+				cache.translation = transform.translation;
+				cache.rotation = transform.rotation;
+				cache.scale = transform.scale;
+				cache.valid = true;
+
+				for (U32 axis = 0; axis < 3; ++axis)
+				{
+					soa[axis][blockCount] = transform.translation[axis];
+					soa[3 + axis][blockCount] = transform.rotation[axis];
+					soa[6 + axis][blockCount] = transform.scale[axis];
+				}
+
+				indices[blockCount++] = i;
+
+				if (blockCount == BLOCK_SIZE)
+				{
+					flushBlock();
+				}
+			}
+
+			if (blockCount > 0)
+			{
+				flushBlock();
+			}
+		};
+
+		JobSystem::ParallelFor(static_cast<U32>(transforms.size()), updateRange, 1024);
+
+		// Hierarchy components are sorted by depth, so parents are always updated before their children and only
+		// subtrees below a changed transform are recomputed.
+		for (auto [entityHandle, hierarchy] : hierarchies.each())
+		{
+			TransformComponent&		   transform = transforms.get(entityHandle);
+			TransformComponent::Cache& cache = transform.cache;
+
+			if (hierarchy.parent == entt::null)
+			{
+				cache.worldChanged = cache.localChanged;
+
+				if (cache.worldChanged)
+				{
+					transform.worldMatrix = cache.localMatrix;
+					transform.worldNormalMatrix = cache.localNormalMatrix;
+				}
+
+				continue;
+			}
+
+			const TransformComponent& parentTransform = transforms.get(hierarchy.parent);
+			cache.worldChanged = cache.localChanged || parentTransform.cache.worldChanged;
+
+			if (cache.worldChanged)
+			{
+				// The inverse transpose of a product is the product of the inverse transposes.
+				transform.worldMatrix = parentTransform.worldMatrix * cache.localMatrix;
+				transform.worldNormalMatrix = parentTransform.worldNormalMatrix * cache.localNormalMatrix;
+			}
+		}
+	}
+
+	void Scene::SortHierarchy()
+	{
+		MP_PROFILE_SCOPE("Scene::SortHierarchy");
+
+		auto& hierarchies = m_registry.storage<HierarchyComponent>();
+
+		// Parents destroyed since the last sort leave their children as roots.
+		for (auto [entityHandle, hierarchy] : hierarchies.each())
+		{
+			if (hierarchy.parent != entt::null && !m_registry.valid(hierarchy.parent))
+			{
+				hierarchy.parent = entt::null;
+				m_registry.get<TransformComponent>(entityHandle).cache.valid = false;
+			}
+		}
+
+		// SetParent prevents cycles, so every chain ends at a root.
+		for (auto [entityHandle, hierarchy] : hierarchies.each())
+		{
+			U32			 depth = 0;
+			entt::entity parent = hierarchy.parent;
+
+			while (parent != entt::null)
+			{
+				depth++;
+				parent = hierarchies.contains(parent) ? hierarchies.get(parent).parent : entt::null;
+			}
+
+			hierarchy.depth = depth;
+		}
+
+		m_registry.sort<HierarchyComponent>([](const HierarchyComponent& a, const HierarchyComponent& b) { return a.depth < b.depth; });
+
+		m_hierarchyDirty = false;
+	}
+
+	void Scene::OnHierarchyChanged(entt::registry& registry, entt::entity entityHandle)
+	{
+		m_hierarchyDirty = true;
+
+		// The world matrix has to be rebuilt against the new parent.
+		if (TransformComponent* transform = registry.try_get<TransformComponent>(entityHandle))
+		{
+			transform->cache.valid = false;
+		}
+	}
+
+	void Scene::SetParent(GameObject& child, GameObject parent)
+	{
+		MP_ASSERT(child.IsValid(), "Child game object is invalid!");
+
+		// Walk up from the new parent to make sure the child is not one of its ancestors.
+		for (entt::entity ancestor = parent; ancestor != entt::null;)
+		{
+			MP_ASSERT(ancestor != child.m_entityHandle, "Cannot parent a game object to itself or one of its descendants!");
+
+			const HierarchyComponent* ancestorHierarchy = m_registry.try_get<HierarchyComponent>(ancestor);
+			ancestor = ancestorHierarchy ? ancestorHierarchy->parent : entt::null;
+		}
+
+		if (!child.HasComponent<HierarchyComponent>())
+		{
+			child.AddComponent<HierarchyComponent>();
+		}
+
+		child.GetComponent<HierarchyComponent>().parent = parent.m_entityHandle;
+		OnHierarchyChanged(m_registry, child.m_entityHandle);
+	}
+
+	GameObject Scene::GetParent(GameObject& child)
+	{
+		const HierarchyComponent* hierarchy = m_registry.try_get<HierarchyComponent>(child.m_entityHandle);
+
+		if (!hierarchy || !m_registry.valid(hierarchy->parent))
+		{
+			return GameObject{};
+		}
+
+		return GameObject(hierarchy->parent, this);
+	}
+
+	Matrix4 Scene::GetParentWorldMatrix(GameObject& gameObject)
+	{
+		GameObject parent = GetParent(gameObject);
+		return parent ? parent.GetComponent<TransformComponent>().worldMatrix : Matrix4{ 1.0f };
+	}
+
+	void Scene::ExtractRenderProxies()
+	{
+		MP_PROFILE_SCOPE("Scene::ExtractRenderProxies");
+
+		// Adding or removing either component moves game objects in and out of the group, so the proxies are
+		// resized to match and entries whose game object changed are rebuilt.
+		auto group = m_registry.group<TransformComponent, MeshComponent>();
+
+		const U32 count = static_cast<U32>(group.size());
+		m_renderProxies.resize(count);
+		m_renderProxyEntities.resize(count, entt::null);
+		m_renderProxyBounds.Resize(count);
+		m_renderProxyBoundsChanged.resize(count);
+		m_previousRenderProxyFlags.resize(count);
+
+		std::atomic<bool> pvsChanged = false;
+
+		auto extractRange = [this, &group, &pvsChanged](U32 begin, U32 end) {
+			for (U32 i = begin; i < end; ++i)
+			{
+				const entt::entity entity = group[i];
+				auto [transform, mesh] = group.get<TransformComponent, MeshComponent>(entity);
+
+				RenderProxy& proxy = m_renderProxies[i];
+
+				Model* model = mesh.model.get();
+				const bool modelChanged = m_renderProxyEntities[i] == entity && proxy.model != model;
+				const bool moved = m_renderProxyEntities[i] != entity || transform.cache.worldChanged;
+				const bool boundsChanged = moved || proxy.model != model || (model && mesh.spatialProxy == DynamicAABBTree::NULL_NODE);
+
+				if (moved)
+				{
+					proxy.modelMatrix = transform.worldMatrix;
+					proxy.normalMatrix = transform.worldNormalMatrix;
+					m_renderProxyEntities[i] = entity;
+				}
+
+				if (model && boundsChanged)
+				{
+					m_renderProxyBounds.Set(i, transform.worldMatrix, *model);
+				}
+
+				m_renderProxyBoundsChanged[i] = boundsChanged;
+				m_previousRenderProxyFlags[i] = proxy.flags;
+
+				// The baked visibility only holds while the baked meshes stay where and what they were.
+				if (mesh.pvsObject >= 0 && (transform.cache.worldChanged || modelChanged || !mesh.enabled))
+				{
+					pvsChanged.store(true, std::memory_order_relaxed);
+				}
+
+				proxy.model = model;
+				proxy.entity = entity;
+				proxy.pvsObject = mesh.pvsObject;
+				proxy.flags = 0;
+
+				if (mesh.enabled && proxy.model)
 				{
-					scriptComponent.scriptable = scriptComponent.InstantiateScript();
-					scriptComponent.scriptable->m_gameObject = GameObject{ entityHandle, this };
-					scriptComponent.scriptable->OnCreate();
+					proxy.flags = RENDER_PROXY_VISIBLE | (mesh.occluder ? RENDER_PROXY_OCCLUDER : 0u);
 				}
+			}
+		};
 
-				scriptComponent.scriptable->OnUpdateEditor(dt);
+		JobSystem::ParallelFor(count, extractRange, 1024);
+
+		if (pvsChanged)
+		{
+			InvalidatePotentiallyVisibleSet();
+		}
+
+		// The spatial tree is not thread-safe, so it follows on the main thread.
+		for (U32 i = 0; i < count; ++i)
+		{
+			if (m_renderProxyBoundsChanged[i])
+			{
+				const entt::entity entity = group[i];
+				UpdateSpatialProxy(i, entity, group.get<MeshComponent>(entity));
+			}
+		}
+	}
+
+	void Scene::UpdateSpatialProxy(U32 renderProxyIndex, entt::entity entityHandle, MeshComponent& mesh)
+	{
+		if (!mesh.model)
+		{
+			if (mesh.spatialProxy != DynamicAABBTree::NULL_NODE)
+			{
+				m_spatialTree.DestroyProxy(mesh.spatialProxy);
+				mesh.spatialProxy = DynamicAABBTree::NULL_NODE;
 			}
+			return;
+		}
+
+		AABB box{};
+		for (U32 axis = 0; axis < 3; ++axis)
+		{
+			box.min[axis] = m_renderProxyBounds.center[axis][renderProxyIndex] - m_renderProxyBounds.extent[axis][renderProxyIndex];
+			box.max[axis] = m_renderProxyBounds.center[axis][renderProxyIndex] + m_renderProxyBounds.extent[axis][renderProxyIndex];
+		}
+
+		if (mesh.spatialProxy == DynamicAABBTree::NULL_NODE)
+		{
+			mesh.spatialProxy = m_spatialTree.CreateProxy(box, static_cast<U32>(entityHandle));
+		}
+		else
+		{
+			m_spatialTree.MoveProxy(mesh.spatialProxy, box);
+		}
+	}
+
+	void Scene::OnRenderableDestroyed(entt::registry& registry, entt::entity entityHandle)
+	{
+		MeshComponent* mesh = registry.try_get<MeshComponent>(entityHandle);
+
+		if (mesh && mesh->spatialProxy != DynamicAABBTree::NULL_NODE)
+		{
+			m_spatialTree.DestroyProxy(mesh->spatialProxy);
+			mesh->spatialProxy = DynamicAABBTree::NULL_NODE;
+		}
+
+		if (mesh && mesh->pvsObject >= 0)
+		{
+			InvalidatePotentiallyVisibleSet();
+		}
+	}
+
+	GameObject Scene::Raycast(const Ray& ray, F32 maxDistance, F32* hitDistance)
+	{
+		MP_PROFILE_SCOPE("Scene::Raycast");
+
+		entt::entity closest = entt::null;
+
+		m_spatialTree.RayCast(ray, maxDistance, [&](I32 proxy, F32 currentMaxDistance) {
+			const entt::entity entity = static_cast<entt::entity>(m_spatialTree.GetUserData(proxy));
+			const TransformComponent& transform = m_registry.get<TransformComponent>(entity);
+			const MeshComponent&	  mesh = m_registry.get<MeshComponent>(entity);
+
+			if (!mesh.enabled || !mesh.model)
+			{
+				return currentMaxDistance;
+			}
+
+			// Distances along the ray are kept by affine transforms, so the local hit distance is the world one.
+			const Matrix4 inverse = MathOp::Inverse(transform.worldMatrix);
+			const Ray	  localRay = { Vector3(inverse * Vector4(ray.origin, 1.0f)), Vector3(inverse * Vector4(ray.direction, 0.0f)) };
+
+			F32 distance = 0.0f;
+			if (!MathOp::IntersectRayAABB(localRay, mesh.model->GetBoundingBox(), currentMaxDistance, distance))
+			{
+				return currentMaxDistance;
+			}
+
+			closest = entity;
+			maxDistance = distance;
+			return distance;
 		});
 
-		// TODO
-		// Begin render.
+		if (hitDistance && closest != entt::null)
+		{
+			*hitDistance = maxDistance;
+		}
 
-		// End render.
+		return closest != entt::null ? GameObject(closest, this) : GameObject{};
+	}
+
+	void Scene::QueryAABB(const AABB& box, std::vector<GameObject>& result)
+	{
+		m_spatialTree.QueryAABB(box, [&](I32 proxy) {
+			result.push_back(GameObject(static_cast<entt::entity>(m_spatialTree.GetUserData(proxy)), this));
+			return true;
+		});
+	}
+
+	void Scene::QueryFrustum(const Vector4* planes, U32 planeCount, std::vector<GameObject>& result)
+	{
+		m_spatialTree.QueryFrustum(planes, planeCount, [&](I32 proxy) {
+			result.push_back(GameObject(static_cast<entt::entity>(m_spatialTree.GetUserData(proxy)), this));
+			return true;
+		});
+	}
+
+	void Scene::CollectChangedRenderProxies()
+	{
+		MP_PROFILE_SCOPE("Scene::CollectChangedRenderProxies");
+
+		m_changedRenderProxies.clear();
+
+		// Bounds change whenever the matrices, the model or the game object in the slot do. Flags are compared
+		// after PVS culling, so proxies it keeps hiding are not reported every update.
+		for (U32 i = 0; i < static_cast<U32>(m_renderProxies.size()); ++i)
+		{
+			if (m_renderProxyBoundsChanged[i] || m_renderProxies[i].flags != m_previousRenderProxyFlags[i])
+			{
+				m_changedRenderProxies.push_back(i);
+			}
+		}
+	}
+
+	void Scene::CullRenderProxies(const EditorCamera& camera)
+	{
+		MP_PROFILE_SCOPE("Scene::CullRenderProxies");
+
+		const Matrix4 viewProjection = camera.GetViewProjectionMatrix();
+
+		const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+		m_culledRenderProxyCount += Mapo::CullRenderProxies(frustum, m_renderProxies, m_renderProxyBounds, m_visibleRenderProxies);
+
+		if (m_softwareOcclusionCulling)
+		{
+			m_culledRenderProxyCount += CullOccludedRenderProxies(viewProjection);
+		}
+	}
+
+	U32 Scene::CullRenderProxiesByPotentiallyVisibleSet(const Vector3& cameraPosition)
+	{
+		if (!m_potentiallyVisibleSetCulling || m_potentiallyVisibleSetStale)
+		{
+			return 0;
+		}
+
+		const U32 cell = m_potentiallyVisibleSet.FindCell(cameraPosition);
+
+		if (cell == PotentiallyVisibleSet::INVALID_CELL)
+		{
+			return 0;
+		}
+
+		U32 culledCount = 0;
+
+		for (RenderProxy& proxy : m_renderProxies)
+		{
+			if ((proxy.flags & RENDER_PROXY_VISIBLE) && proxy.pvsObject >= 0
+				&& !m_potentiallyVisibleSet.IsVisible(cell, static_cast<U32>(proxy.pvsObject)))
+			{
+				proxy.flags &= ~RENDER_PROXY_VISIBLE;
+				culledCount++;
+			}
+		}
+
+		return culledCount;
+	}
+
+	void Scene::BakePotentiallyVisibleSet(const PvsBakeSettings& settings)
+	{
+		MP_PROFILE_SCOPE("Scene::BakePotentiallyVisibleSet");
+
+		std::vector<PvsObject> objects;
+
+		m_registry.view<TransformComponent, MeshComponent>().each([&](TransformComponent& transform, MeshComponent& mesh) {
+			mesh.pvsObject = -1;
+
+			// Disabled meshes are not drawn, so they do not block anything either.
+			if (!mesh.enabled || !mesh.model)
+			{
+				return;
+			}
+
+			const Model&				model = *mesh.model;
+			const std::vector<Vector3>& positions = model.GetPositions();
+			const std::vector<U32>&		indices = model.GetIndices();
+
+			PvsObject object{};
+			Simd::TransformAABBs(transform.worldMatrix, &model.GetBoundingBox(), &object.bounds, 1);
+			object.worldMatrix = transform.worldMatrix;
+			object.positions = positions.data();
+			object.vertexCount = static_cast<U32>(positions.size());
+			object.indices = indices.data();
+			object.indexCount = static_cast<U32>(indices.size());
+
+			mesh.pvsObject = static_cast<I32>(objects.size());
+			objects.push_back(object);
+		});
+
+		m_potentiallyVisibleSet.Bake(objects, settings);
+		m_potentiallyVisibleSetStale = false;
+	}
+
+	void Scene::ClearPotentiallyVisibleSet()
+	{
+		m_registry.view<MeshComponent>().each([](MeshComponent& mesh) { mesh.pvsObject = -1; });
+		m_potentiallyVisibleSet.Clear();
+		m_potentiallyVisibleSetStale = false;
+	}
+
+	void Scene::InvalidatePotentiallyVisibleSet()
+	{
+		if (m_potentiallyVisibleSet.IsBaked() && !m_potentiallyVisibleSetStale)
+		{
+			MP_WARN("Scene: A baked mesh changed, the PVS is not used until it is baked again.");
+			m_potentiallyVisibleSetStale = true;
+		}
+	}
+
+	U32 Scene::CullOccludedRenderProxies(const Matrix4& viewProjection)
+	{
+		MP_PROFILE_SCOPE("Scene::CullOccludedRenderProxies");
+
+		// Occluders outside of the frustum cannot hide anything inside it.
+		m_occluders.clear();
+
+		for (U32 index : m_visibleRenderProxies)
+		{
+			const RenderProxy& proxy = m_renderProxies[index];
+
+			if (proxy.flags & RENDER_PROXY_OCCLUDER)
+			{
+				const std::vector<Vector3>& positions = proxy.model->GetPositions();
+				const std::vector<U32>&		indices = proxy.model->GetIndices();
+
+				m_occluders.push_back({ proxy.modelMatrix, positions.data(), static_cast<U32>(positions.size()), indices.data(),
+					static_cast<U32>(indices.size()) });
+			}
+		}
+
+		if (m_occluders.empty())
+		{
+			return 0;
+		}
+
+		m_softwareOcclusion->RenderOccluders(viewProjection, m_occluders.data(), static_cast<U32>(m_occluders.size()));
+
+		const U32 visibleCount = static_cast<U32>(m_visibleRenderProxies.size());
+		m_occlusionResults.resize(visibleCount);
+
+		// Occluders are never tested: their boxes start at their own surface, so rounding could hide them.
+		auto testRange = [this](U32 begin, U32 end) {
+			for (U32 i = begin; i < end; ++i)
+			{
+				const U32 index = m_visibleRenderProxies[i];
+
+				const Vector3 center{ m_renderProxyBounds.center[0][index], m_renderProxyBounds.center[1][index], m_renderProxyBounds.center[2][index] };
+				const Vector3 extent{ m_renderProxyBounds.extent[0][index], m_renderProxyBounds.extent[1][index], m_renderProxyBounds.extent[2][index] };
+
+				m_occlusionResults[i] = (m_renderProxies[index].flags & RENDER_PROXY_OCCLUDER) || m_softwareOcclusion->IsVisible(center, extent);
+			}
+		};
+
+		JobSystem::ParallelFor(visibleCount, testRange, 256);
+
+		U32 keptCount = 0;
+		for (U32 i = 0; i < visibleCount; ++i)
+		{
+			m_visibleRenderProxies[keptCount] = m_visibleRenderProxies[i];
+			keptCount += m_occlusionResults[i];
+		}
+
+		m_visibleRenderProxies.resize(keptCount);
+		return visibleCount - keptCount;
+	}
+
+	void Scene::OnNativeScriptDestroyed(entt::registry& registry, entt::entity entityHandle)
+	{
+		NativeScriptComponent& scriptComponent = registry.get<NativeScriptComponent>(entityHandle);
+
+		if (scriptComponent.scriptable)
+		{
+			scriptComponent.GetScriptBatch(*this).Destroy(scriptComponent.scriptable);
+			scriptComponent.scriptable = nullptr;
+		}
 	}
 
 	GameObject Scene::CreateGameObject(const String& name)
@@ -54,6 +698,9 @@ namespace Mapo
 	void Scene::DestroyGameObject(GameObject& gameObject)
 	{
 		m_registry.destroy(gameObject.m_entityHandle);
+
+		// Children of the game object are detached on the next update.
+		m_hierarchyDirty = true;
 	}
 
 	std::vector<GameObject> Scene::GetGameObjects()
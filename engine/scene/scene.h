@@ -7,6 +7,12 @@
 #include "core/core.h"
 
 #include "engine/scene/editor_camera.h"
+#include "engine/scene/system_scheduler.h"
+#include "engine/scene/render_proxy.h"
+#include "engine/scene/dynamic_aabb_tree.h"
+#include "engine/scene/potentially_visible_set.h"
+
+#include "engine/renderer/software_occlusion.h"
 
 #include <entt/entity/registry.hpp>
 
@@ -15,11 +21,15 @@
 namespace Mapo
 {
 	class GameObject;
+	class ScriptBatchBase;
+	class EntityCommandBuffer;
+	class SoftwareOcclusion;
+	struct MeshComponent;
 
 	class Scene
 	{
 	public:
-		virtual ~Scene() = default;
+		virtual ~Scene();
 
 		Scene();
 
@@ -27,18 +37,135 @@ namespace Mapo
 		void OnUpdateEditor(Timestep dt, EditorCamera& camera);
 
 		GameObject CreateGameObject(const String& name = "");
-		void	   DestroyGameObject(GameObject& gameObject);
+		void	   DestroyGameObject(GameObject& gameObject); // children become roots
+
+		// Passing an invalid parent makes the child a root again. The child keeps its local transform.
+		void	   SetParent(GameObject& child, GameObject parent);
+		GameObject GetParent(GameObject& child);
+
+		// World matrix the game object's transform is relative to (identity for roots), as of the last update.
+		Matrix4 GetParentWorldMatrix(GameObject& gameObject);
 
 		// TODO: Should not do this.
 		std::vector<GameObject> GetGameObjects();
 
+		// Game objects with a transform and a mesh, extracted at the end of OnUpdateEditor after the world
+		// transforms have been updated.
+		const std::vector<RenderProxy>& GetRenderProxies() const { return m_renderProxies; }
+		const RenderProxyBounds&		GetRenderProxyBounds() const { return m_renderProxyBounds; }
+
+		// Indices of the render proxies whose matrices, model or flags changed in the last OnUpdateEditor, or
+		// whose slot now holds another game object, in proxy order. Renderers that keep their own copy of the
+		// proxies only update these.
+		const std::vector<U32>& GetChangedRenderProxies() const { return m_changedRenderProxies; }
+
+		// Frustum culls the render proxies against the camera, then tests what passed against the meshes marked
+		// as occluders if software occlusion culling is on. Call after OnUpdateEditor on frames the GPU does not
+		// cull; until then no proxy is visible.
+		void CullRenderProxies(const EditorCamera& camera);
+
+		// Indices of the render proxies that passed CullRenderProxies, in proxy order.
+		const std::vector<U32>& GetVisibleRenderProxies() const { return m_visibleRenderProxies; }
+
+		// Proxies culled by the PVS in OnUpdateEditor, plus the ones culled by CullRenderProxies.
+		U32 GetCulledRenderProxyCount() const { return m_culledRenderProxyCount; }
+
+		bool& SoftwareOcclusionCulling() { return m_softwareOcclusionCulling; }
+
+		// Bakes the visibility between the meshes as of the last update, for static scenes. While the camera is
+		// inside the grid, meshes that cannot be seen from its cell are culled before any other test. Once a baked
+		// mesh moves, changes its model, is disabled or is destroyed, what it hid may be visible, so the PVS is
+		// stale and not used until it is baked again. Meshes added afterwards are never culled by it.
+		void BakePotentiallyVisibleSet(const PvsBakeSettings& settings = {});
+		void ClearPotentiallyVisibleSet();
+
+		const PotentiallyVisibleSet& GetPotentiallyVisibleSet() const { return m_potentiallyVisibleSet; }
+		bool						 IsPotentiallyVisibleSetStale() const { return m_potentiallyVisibleSetStale; }
+		bool&						 PotentiallyVisibleSetCulling() { return m_potentiallyVisibleSetCulling; }
+
+		// Game objects with a model, by world bounds as of the last OnUpdateEditor. The user data of a proxy is
+		// its entity handle.
+		const DynamicAABBTree& GetSpatialTree() const { return m_spatialTree; }
+
+		// Closest game object with an enabled mesh whose model bounds the ray hits. The ray is tested against the
+		// model's box in its local space, so rotated objects are not picked by the corners of their world box.
+		GameObject Raycast(const Ray& ray, F32 maxDistance, F32* hitDistance = nullptr);
+
+		void QueryAABB(const AABB& box, std::vector<GameObject>& result);
+		void QueryFrustum(const Vector4* planes, U32 planeCount, std::vector<GameObject>& result);
+
+		// Systems run in OnUpdateEditor after the scripts.
+		SystemScheduler& GetSystemScheduler() { return m_systemScheduler; }
+
+		// Defined in script_batch.h.
+		template <typename T>
+		ScriptBatchBase& GetScriptBatch();
+
+		// Command buffer of the calling job system thread. Scripts and systems record structural changes here
+		// instead of changing the registry while it is being iterated; the scene plays them back on the main
+		// thread after the scripts and again after the systems.
+		EntityCommandBuffer& GetCommandBuffer();
+
 	private:
 		template <typename T>
 		void OnComponentAdded(GameObject& gameObject, T& component);
 
+		void UpdateScripts(Timestep dt);
+		void PlaybackCommandBuffers();
+		void UpdateWorldTransforms();
+		void SortHierarchy();
+		void ExtractRenderProxies();
+		void CollectChangedRenderProxies();
+		U32	 CullRenderProxiesByPotentiallyVisibleSet(const Vector3& cameraPosition);
+		void InvalidatePotentiallyVisibleSet();
+		U32	 CullOccludedRenderProxies(const Matrix4& viewProjection);
+		void UpdateSpatialProxy(U32 renderProxyIndex, entt::entity entityHandle, MeshComponent& mesh);
+
+		void OnNativeScriptDestroyed(entt::registry& registry, entt::entity entityHandle);
+		void OnHierarchyChanged(entt::registry& registry, entt::entity entityHandle);
+		void OnRenderableDestroyed(entt::registry& registry, entt::entity entityHandle);
+
 	private:
 		entt::registry m_registry;
+
+		SystemScheduler m_systemScheduler;
+
+		// Script instances by script type.
+		std::vector<UniqueRef<ScriptBatchBase>> m_scriptBatches{};
+		HashMap<entt::id_type, U32>				m_scriptBatchIndices{};
+
+		// Hierarchy components need to be sorted by depth again.
+		bool m_hierarchyDirty = false;
+
+		// Same order as the render group. A proxy's matrices are only copied when its world transform has
+		// changed or another game object has moved into its slot.
+		std::vector<RenderProxy>  m_renderProxies{};
+		std::vector<entt::entity> m_renderProxyEntities{};
+		RenderProxyBounds		  m_renderProxyBounds{};
+		std::vector<U8>			  m_renderProxyBoundsChanged{};
+		std::vector<U32>		  m_previousRenderProxyFlags{}; // as of the last update, PVS culling included
+		std::vector<U32>		  m_changedRenderProxies{};
+
+		DynamicAABBTree m_spatialTree{};
+
+		std::vector<U32> m_visibleRenderProxies{};
+		U32				 m_culledRenderProxyCount = 0;
+
+		bool						 m_softwareOcclusionCulling = true;
+		UniqueRef<SoftwareOcclusion> m_softwareOcclusion{};
+		std::vector<OccluderMesh>	 m_occluders{};
+		std::vector<U8>				 m_occlusionResults{}; // per visible proxy
+
+		PotentiallyVisibleSet m_potentiallyVisibleSet{};
+		bool				  m_potentiallyVisibleSetStale = false;
+		bool				  m_potentiallyVisibleSetCulling = true;
+
+		// One buffer per job system thread.
+		std::vector<UniqueRef<EntityCommandBuffer>> m_commandBuffers{};
+		std::vector<EntityCommandBuffer*>			m_commandBufferPointers{};
+
 		friend class GameObject;
+		friend class EntityCommandBuffer;
 	};
 
 } // namespace Mapo
@@ -0,0 +1,83 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include <entt/entity/registry.hpp>
+
+#include <vector>
+
+namespace Mapo
+{
+	class EntityCommandBuffer;
+
+	struct ComponentAccess
+	{
+		using StorageFunc = void (*)(entt::registry&);
+
+		entt::id_type componentType;
+		StorageFunc	  createStorage; // pools must exist before views are used from several threads
+		bool		  write;
+	};
+
+	// A system of the scene's update. Systems declare the component types they read and write in their
+	// constructor; SystemScheduler runs systems whose declarations do not conflict at the same time.
+	//
+	// OnUpdate may run on any thread, so it must only touch the declared components and its own members.
+	// Structural changes (create/destroy game objects, add/remove components) are recorded into the given
+	// command buffer and applied after all systems have run. Systems that need anything else declare exclusive
+	// access and run alone.
+	class SceneSystem
+	{
+	public:
+		virtual ~SceneSystem() = default;
+
+		SceneSystem(const String& name)
+			: m_name(name) { }
+
+		virtual void OnUpdate(entt::registry& registry, EntityCommandBuffer& commands, Timestep dt) = 0;
+
+		const String& GetName() const { return m_name; }
+
+		bool  IsEnabled() const { return m_enabled; }
+		void  SetEnabled(bool enabled) { m_enabled = enabled; }
+		bool& GetEnabled() { return m_enabled; }
+
+		bool IsExclusive() const { return m_exclusive; }
+
+		const std::vector<ComponentAccess>& GetComponentAccesses() const { return m_accesses; }
+
+	protected:
+		template <typename... Components>
+		void Reads()
+		{
+			(AddAccess<Components>(false), ...);
+		}
+
+		template <typename... Components>
+		void Writes()
+		{
+			(AddAccess<Components>(true), ...);
+		}
+
+		void RequireExclusiveAccess() { m_exclusive = true; }
+
+	private:
+		template <typename Component>
+		void AddAccess(bool write)
+		{
+			m_accesses.push_back({ entt::type_hash<Component>::value(), [](entt::registry& registry) { registry.storage<Component>(); }, write });
+		}
+
+	private:
+		String m_name{};
+		bool   m_enabled = true;
+		bool   m_exclusive = false;
+
+		std::vector<ComponentAccess> m_accesses{};
+	};
+
+} // namespace Mapo
@@ -0,0 +1,184 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "engine/scene/scriptable.h"
+
+#include <new>
+#include <vector>
+
+namespace Mapo
+{
+	// Storage and update loop of all script instances of one type.
+	class ScriptBatchBase
+	{
+	public:
+		virtual ~ScriptBatchBase() = default;
+
+		virtual Scriptable* Create() = 0;
+		virtual void		Destroy(Scriptable* script) = 0;
+
+		// Runs OnUpdateEditor of every active instance. Thread-safe script types are split across the job system.
+		virtual void UpdateEditor(Timestep dt) = 0;
+
+		virtual bool IsThreadSafe() const = 0;
+		virtual U32	 GetCount() const = 0;
+	};
+
+	// Instances live in fixed-size chunks, so they are contiguous in memory and never move (components keep
+	// pointers to them). The dense instance list is kept in allocation order and is what the update iterates.
+	template <typename T>
+	class ScriptBatch final : public ScriptBatchBase
+	{
+		static_assert(std::is_base_of_v<Scriptable, T>, "Scripts must derive from Scriptable!");
+
+	public:
+		static constexpr U32 SCRIPTS_PER_CHUNK = 256;
+
+		// Instances per job. Script updates are usually tiny, so batches need to be large to pay off.
+		static constexpr U32 MIN_BATCH_SIZE = 256;
+
+		virtual ~ScriptBatch()
+		{
+			for (T* script : m_instances)
+			{
+				static_cast<Scriptable*>(script)->OnDestroy();
+				script->~T();
+			}
+		}
+
+		virtual Scriptable* Create() override
+		{
+			if (m_freeSlots.empty())
+			{
+				m_chunks.push_back(MakeUnique<Chunk>());
+
+				Chunk& chunk = *m_chunks.back();
+				for (U32 i = SCRIPTS_PER_CHUNK; i > 0; --i)
+				{
+					m_freeSlots.push_back(&chunk.slots[i - 1]);
+				}
+			}
+
+			void* slot = m_freeSlots.back();
+			m_freeSlots.pop_back();
+
+			T* script = new (slot) T();
+			script->m_batchIndex = static_cast<U32>(m_instances.size());
+			m_instances.push_back(script);
+			return script;
+		}
+
+		virtual void Destroy(Scriptable* script) override
+		{
+			T* typedScript = static_cast<T*>(script);
+			script->OnDestroy();
+
+			// A script of this batch destroyed a game object while the batch is being iterated. Removing it now
+			// would move another instance into its slot, so it is only deactivated and removed after the loop.
+			if (m_updating)
+			{
+				MP_ASSERT(!T::THREAD_SAFE, "Thread-safe scripts must destroy game objects through the command buffer!");
+
+				script->m_active = false;
+				m_pendingDestroys.push_back(typedScript);
+				return;
+			}
+
+			Remove(typedScript);
+		}
+
+		virtual void UpdateEditor(Timestep dt) override
+		{
+			m_updating = true;
+
+			T* const* instances = m_instances.data();
+
+			auto updateRange = [instances, dt](U32 begin, U32 end) {
+				for (U32 i = begin; i < end; ++i)
+				{
+					Scriptable& script = *instances[i];
+					if (script.m_active)
+					{
+						script.OnUpdateEditor(dt);
+					}
+				}
+			};
+
+			const U32 count = static_cast<U32>(m_instances.size());
+
+			if constexpr (T::THREAD_SAFE)
+			{
+				JobSystem::ParallelFor(count, updateRange, MIN_BATCH_SIZE);
+			}
+			else
+			{
+				updateRange(0, count);
+			}
+
+			m_updating = false;
+
+			for (T* script : m_pendingDestroys)
+			{
+				Remove(script);
+			}
+
+			m_pendingDestroys.clear();
+		}
+
+		virtual bool IsThreadSafe() const override { return T::THREAD_SAFE; }
+		virtual U32	 GetCount() const override { return static_cast<U32>(m_instances.size()); }
+
+	private:
+		void Remove(T* script)
+		{
+			// Swap-remove from the dense list.
+			const U32 index = script->m_batchIndex;
+			m_instances[index] = m_instances.back();
+			m_instances[index]->m_batchIndex = index;
+			m_instances.pop_back();
+
+			script->~T();
+			m_freeSlots.push_back(script);
+		}
+
+	private:
+		struct Chunk
+		{
+			struct alignas(T) Slot
+			{
+				U8 bytes[sizeof(T)];
+			};
+
+			Slot slots[SCRIPTS_PER_CHUNK];
+		};
+
+		std::vector<UniqueRef<Chunk>> m_chunks{};
+		std::vector<void*>			  m_freeSlots{};
+		std::vector<T*>				  m_instances{};
+
+		// Destroyed during UpdateEditor, removed when it finishes.
+		bool			m_updating = false;
+		std::vector<T*> m_pendingDestroys{};
+	};
+
+	template <typename T>
+	ScriptBatchBase& Scene::GetScriptBatch()
+	{
+		const entt::id_type scriptType = entt::type_hash<T>::value();
+
+		auto iter = m_scriptBatchIndices.find(scriptType);
+		if (iter == m_scriptBatchIndices.end())
+		{
+			iter = m_scriptBatchIndices.emplace(scriptType, static_cast<U32>(m_scriptBatches.size())).first;
+			m_scriptBatches.push_back(MakeUnique<ScriptBatch<T>>());
+		}
+
+		return *m_scriptBatches[iter->second];
+	}
+
+} // namespace Mapo
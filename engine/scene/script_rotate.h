@@ -9,9 +9,12 @@
 
 namespace Mapo
 {
-	class RotateScript : public Scriptable
+	class RotateScript final : public Scriptable
 	{
 	public:
+		// Only touches its own transform.
+		static constexpr bool THREAD_SAFE = true;
+
 		RotateScript(F32 speed = 30.0f)
 			: Scriptable("RotateScript"), rotateSpeed(speed)
 		{
@@ -6,6 +6,9 @@
 
 namespace Mapo
 {
+	EntityCommandBuffer& Scriptable::GetCommandBuffer()
+	{
+		return m_gameObject.m_scene->GetCommandBuffer();
+	}
 
-
-}
+} // namespace Mapo
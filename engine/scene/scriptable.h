@@ -5,12 +5,20 @@
 #pragma once
 
 #include "engine/scene/game_object.h"
+#include "engine/scene/entity_command_buffer.h"
 
 namespace Mapo
 {
+	// Script instances of the same type are stored together in a ScriptBatch and updated in a batch.
+	//
+	// A script type that only reads and writes the components of its own game object may set THREAD_SAFE to
+	// true; its instances are then updated in parallel. Thread-safe scripts must not change the scene structure
+	// (create/destroy game objects, add/remove components) directly and record them into GetCommandBuffer instead.
 	class Scriptable
 	{
 	public:
+		static constexpr bool THREAD_SAFE = false;
+
 		~Scriptable() = default;
 
 		Scriptable(const String& scriptName)
@@ -30,13 +38,25 @@ namespace Mapo
 		virtual void OnUpdateEditor(Timestep dt) { }
 		virtual void OnUpdateRuntime(Timestep dt) { }
 
+		GameObject& GetGameObject() { return m_gameObject; }
+
+		// Command buffer of the current thread. Played back after all scripts have been updated.
+		EntityCommandBuffer& GetCommandBuffer();
+
 	private:
 		GameObject m_gameObject;
 
 		String m_scriptName{};
 
+		// Set by the scene before each update from the component's enabled and runInEditor flags.
+		bool m_active = false;
+		U32	 m_batchIndex = 0;
+
 		friend class Scene;
 		friend struct NativeScriptComponent;
+
+		template <typename T>
+		friend class ScriptBatch;
 	};
 
 } // namespace Mapo
@@ -0,0 +1,153 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "system_scheduler.h"
+
+namespace Mapo
+{
+	// Weight of the newest sample in the averaged system timings.
+	static constexpr F32 TIMING_SMOOTHING = 0.1f;
+
+	void SystemScheduler::AddSystem(UniqueRef<SceneSystem> system)
+	{
+		MP_ASSERT(system, "System is null!");
+
+		SystemTiming timing{};
+		timing.system = system.get();
+
+		m_systems.push_back(std::move(system));
+		m_timings.push_back(timing);
+	}
+
+	bool SystemScheduler::HasConflict(const SceneSystem& a, const SceneSystem& b)
+	{
+		if (a.IsExclusive() || b.IsExclusive())
+		{
+			return true;
+		}
+
+		for (const ComponentAccess& accessA : a.GetComponentAccesses())
+		{
+			for (const ComponentAccess& accessB : b.GetComponentAccesses())
+			{
+				if (accessA.componentType == accessB.componentType && (accessA.write || accessB.write))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		const U32 systemCount = static_cast<U32>(m_systems.size());
+
+		if (m_nodeCapacity < systemCount)
+		{
+			m_nodes = MakeUnique<SystemNode[]>(systemCount);
+			m_nodeCapacity = systemCount;
+		}
+		m_nodeCount = 0;
+
+		for (U32 i = 0; i < systemCount; ++i)
+		{
+			if (!m_systems[i]->IsEnabled())
+			{
+				continue;
+			}
+
+			SystemNode& node = m_nodes[m_nodeCount];
+			node.systemIndex = i;
+			node.dependents.clear();
+			node.dependencyCount = 0;
+
+			// Only direct conflicts become edges. Transitive ones are redundant but harmless,
+			// and there are few systems.
+			for (U32 j = 0; j < m_nodeCount; ++j)
+			{
+				if (HasConflict(*m_systems[m_nodes[j].systemIndex], *m_systems[i]))
+				{
+					m_nodes[j].dependents.push_back(m_nodeCount);
+					node.dependencyCount++;
+				}
+			}
+
+			m_nodeCount++;
+		}
+	}
+
+	void SystemScheduler::Run(entt::registry& registry, EntityCommandBuffer* const* commandBuffers, Timestep dt)
+	{
+		BuildGraph();
+
+		if (m_nodeCount == 0)
+		{
+			return;
+		}
+
+		// Views create missing pools on first use, which is not thread-safe. Create them up front.
+		for (U32 i = 0; i < m_nodeCount; ++i)
+		{
+			for (const ComponentAccess& access : m_systems[m_nodes[i].systemIndex]->GetComponentAccesses())
+			{
+				access.createStorage(registry);
+			}
+
+			m_nodes[i].remainingDependencies.store(m_nodes[i].dependencyCount, std::memory_order_relaxed);
+		}
+
+		m_registry = &registry;
+		m_commandBuffers = commandBuffers;
+		m_deltaTime = dt;
+
+		for (U32 i = 0; i < m_nodeCount; ++i)
+		{
+			if (m_nodes[i].dependencyCount == 0)
+			{
+				JobSystem::Run([this, i]() { RunSystem(i); }, &m_counter);
+			}
+		}
+
+		JobSystem::Wait(m_counter);
+
+		m_registry = nullptr;
+		m_commandBuffers = nullptr;
+	}
+
+	void SystemScheduler::RunSystem(U32 node)
+	{
+		const U32	 systemIndex = m_nodes[node].systemIndex;
+		SceneSystem& system = *m_systems[systemIndex];
+
+		// One command buffer per job system thread, like Scene::GetCommandBuffer.
+		const U32 threadIndex = JobSystem::GetThreadIndex();
+		MP_ASSERT(threadIndex < JobSystem::GetThreadCount(), "Systems can only run on job system threads!");
+
+		Timer timer;
+		timer.Start();
+
+		{
+			MP_PROFILE_SCOPE(system.GetName().c_str());
+			system.OnUpdate(*m_registry, *m_commandBuffers[threadIndex], m_deltaTime);
+		}
+
+		// Only the thread running the system writes its timing.
+		SystemTiming& timing = m_timings[systemIndex];
+		timing.lastMs = static_cast<F32>(timer.Elapsed<Timer::Milliseconds>());
+		timing.averageMs += (timing.lastMs - timing.averageMs) * TIMING_SMOOTHING;
+		timing.threadIndex = threadIndex;
+
+		// Dependents are submitted before this job counts as finished, so the counter cannot reach zero early.
+		for (U32 dependent : m_nodes[node].dependents)
+		{
+			if (m_nodes[dependent].remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				JobSystem::Run([this, dependent]() { RunSystem(dependent); }, &m_counter);
+			}
+		}
+	}
+
+} // namespace Mapo
@@ -0,0 +1,88 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "engine/scene/scene_system.h"
+
+#include <atomic>
+#include <vector>
+
+namespace Mapo
+{
+	struct SystemTiming
+	{
+		const SceneSystem* system = nullptr;
+		F32				   lastMs = 0.0f;
+		F32				   averageMs = 0.0f; // exponential moving average
+		U32				   threadIndex = 0;	 // job system thread of the last run
+	};
+
+	// Runs scene systems as jobs. Every frame the enabled systems are put into a dependency graph: a system
+	// depends on each earlier system (in registration order) that writes a component it reads or writes, or
+	// reads a component it writes. Systems start as soon as their dependencies finish, so non-conflicting
+	// systems run concurrently and conflicting ones keep their registration order.
+	class SystemScheduler
+	{
+	public:
+		~SystemScheduler() = default;
+
+		SystemScheduler() = default;
+
+		SystemScheduler(const SystemScheduler&) = delete;
+		SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+		template <typename T, typename... Args>
+		T& AddSystem(Args&&... args)
+		{
+			UniqueRef<T> system = MakeUnique<T>(std::forward<Args>(args)...);
+			T&			 systemRef = *system;
+			AddSystem(std::move(system));
+			return systemRef;
+		}
+
+		void AddSystem(UniqueRef<SceneSystem> system);
+
+		// Blocks until every system has run. The calling thread runs systems too. Systems record structural
+		// changes into the command buffer of the thread they run on (one per job system thread).
+		void Run(entt::registry& registry, EntityCommandBuffer* const* commandBuffers, Timestep dt);
+
+		const std::vector<UniqueRef<SceneSystem>>& GetSystems() const { return m_systems; }
+
+		// Same order as GetSystems. Disabled systems keep their last timing.
+		const std::vector<SystemTiming>& GetTimings() const { return m_timings; }
+
+	private:
+		void BuildGraph();
+		void RunSystem(U32 node);
+
+		static bool HasConflict(const SceneSystem& a, const SceneSystem& b);
+
+	private:
+		struct SystemNode
+		{
+			U32				 systemIndex = 0;
+			std::vector<U32> dependents{};
+			U32				 dependencyCount = 0;
+			std::atomic<U32> remainingDependencies{ 0 };
+		};
+
+		std::vector<UniqueRef<SceneSystem>> m_systems{};
+		std::vector<SystemTiming>			m_timings{};
+
+		// Rebuilt every frame from the enabled systems.
+		UniqueRef<SystemNode[]> m_nodes{};
+		U32						m_nodeCount = 0;
+		U32						m_nodeCapacity = 0;
+
+		// Valid during Run.
+		entt::registry*				m_registry = nullptr;
+		EntityCommandBuffer* const* m_commandBuffers = nullptr;
+		Timestep					m_deltaTime = 0.0f;
+		JobCounter		m_counter{};
+	};
+
+} // namespace Mapo
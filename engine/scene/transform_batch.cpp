@@ -0,0 +1,58 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "transform_batch.h"
+
+#include "engine/scene/component.h"
+
+namespace Mapo
+{
+	// Reference path. Goes through TransformComponent so it always matches the per-object functions.
+	static void ComputeTransformMatricesScalar(const TransformBatchInput& input, U32 count, TransformMatrices* output)
+	{
+		TransformComponent transform;
+
+		for (U32 i = 0; i < count; ++i)
+		{
+			transform.translation = { input.translation[0][i], input.translation[1][i], input.translation[2][i] };
+			transform.rotation = { input.rotation[0][i], input.rotation[1][i], input.rotation[2][i] };
+			transform.scale = { input.scale[0][i], input.scale[1][i], input.scale[2][i] };
+
+			output[i].model = transform.GetTransformMatrix();
+			output[i].normal = Matrix4(transform.GetNormalMatrix());
+		}
+	}
+
+	void ComputeTransformMatrices(const TransformBatchInput& input, U32 count, TransformMatrices* output)
+	{
+		ComputeTransformMatrices(input, count, output, Simd::GetSimdLevel());
+	}
+
+	void ComputeTransformMatrices(const TransformBatchInput& input, U32 count, TransformMatrices* output, Simd::SimdLevel level)
+	{
+#if MP_SIMD_X86
+		const F32* soa[9] = {
+			input.translation[0], input.translation[1], input.translation[2],
+			input.rotation[0], input.rotation[1], input.rotation[2],
+			input.scale[0], input.scale[1], input.scale[2]
+		};
+#endif
+
+		switch (level)
+		{
+#if MP_SIMD_X86
+			case Simd::SimdLevel::AVX2:
+				Detail::ComputeTransformMatricesAVX2(soa, count, reinterpret_cast<F32*>(output));
+				return;
+			case Simd::SimdLevel::SSE41:
+				Detail::ComputeTransformMatricesSSE41(soa, count, reinterpret_cast<F32*>(output));
+				return;
+#endif
+			default:
+				ComputeTransformMatricesScalar(input, count, output);
+				return;
+		}
+	}
+
+} // namespace Mapo
@@ -0,0 +1,50 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "core/core.h"
+
+#include "core/simd/cpu_features.h"
+
+namespace Mapo
+{
+	// Transforms of many objects in structure-of-arrays layout, in the units of TransformComponent (rotations
+	// are Euler angles in degrees). Each pointer addresses `count` values.
+	struct TransformBatchInput
+	{
+		const F32* translation[3]{};
+		const F32* rotation[3]{};
+		const F32* scale[3]{};
+	};
+
+	// Matrices of one object, laid out like the per-object shader data.
+	struct TransformMatrices
+	{
+		Matrix4 model{ 1.0f };
+		Matrix4 normal{ 1.0f }; // upper 3x3 is used
+	};
+
+	static_assert(sizeof(TransformMatrices) == 32 * sizeof(F32), "The SIMD paths write matrices as packed floats!");
+
+	// Computes the same matrices as TransformComponent::GetTransformMatrix and GetNormalMatrix for `count`
+	// objects, using the widest instruction set the CPU supports. The SIMD paths use polynomial sine and
+	// cosine on angles wrapped to [-180, 180] degrees; elements stay within 2e-6 of the scalar path (relative
+	// to the scale) for angles within [-720, 720] degrees. Beyond that the scalar path drifts, as it converts
+	// the unwrapped angles to radians in single precision.
+	void ComputeTransformMatrices(const TransformBatchInput& input, U32 count, TransformMatrices* output);
+
+	// Same with an explicit code path. The level must be supported by the CPU.
+	void ComputeTransformMatrices(const TransformBatchInput& input, U32 count, TransformMatrices* output, Simd::SimdLevel level);
+
+	namespace Detail
+	{
+		// Defined in the per-instruction-set source files, which only include core/typedefs.h so no shared inline
+		// code gets built with their flags. `soa` holds the nine input arrays in TransformBatchInput order and
+		// `output` receives 32 floats per object. Only present on x86.
+		void ComputeTransformMatricesSSE41(const F32* const* soa, U32 count, F32* output);
+		void ComputeTransformMatricesAVX2(const F32* const* soa, U32 count, F32* output);
+	} // namespace Detail
+
+} // namespace Mapo
@@ -0,0 +1,77 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Built with AVX2 and FMA enabled. Only called when the CPU supports both.
+
+#include "core/typedefs.h"
+#include "core/simd/cpu_features.h"
+#include "core/simd/simd_sincos.h"
+
+#if MP_SIMD_X86
+
+	#include <cstring>
+	#include <immintrin.h>
+
+namespace Mapo
+{
+	namespace
+	{
+		struct Lanes
+		{
+			using V = __m256;
+
+			static constexpr U32 WIDTH = 8;
+
+			static V Set1(F32 value) { return _mm256_set1_ps(value); }
+			static V Load(const F32* data) { return _mm256_loadu_ps(data); }
+
+			static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+			static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+			static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+			static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+			static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+
+			static V Floor(V a) { return _mm256_floor_ps(a); }
+			static V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+			static V CmpLess(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static V Select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+
+			// Transposes the two 128-bit halves separately: the low half holds lanes 0-3, the high half 4-7.
+			static void StoreColumns(V a, V b, V c, V d, F32* out, size_t stride)
+			{
+				__m128 a0 = _mm256_castps256_ps128(a), a1 = _mm256_extractf128_ps(a, 1);
+				__m128 b0 = _mm256_castps256_ps128(b), b1 = _mm256_extractf128_ps(b, 1);
+				__m128 c0 = _mm256_castps256_ps128(c), c1 = _mm256_extractf128_ps(c, 1);
+				__m128 d0 = _mm256_castps256_ps128(d), d1 = _mm256_extractf128_ps(d, 1);
+
+				_MM_TRANSPOSE4_PS(a0, b0, c0, d0);
+				_MM_TRANSPOSE4_PS(a1, b1, c1, d1);
+
+				_mm_storeu_ps(out, a0);
+				_mm_storeu_ps(out + stride, b0);
+				_mm_storeu_ps(out + stride * 2, c0);
+				_mm_storeu_ps(out + stride * 3, d0);
+				_mm_storeu_ps(out + stride * 4, a1);
+				_mm_storeu_ps(out + stride * 5, b1);
+				_mm_storeu_ps(out + stride * 6, c1);
+				_mm_storeu_ps(out + stride * 7, d1);
+			}
+		};
+
+	#include "transform_batch_kernel.inl"
+
+	} // namespace
+
+	namespace Detail
+	{
+		void ComputeTransformMatricesAVX2(const F32* const* soa, U32 count, F32* output)
+		{
+			ComputeTransformMatricesLanes(soa, count, output);
+		}
+	} // namespace Detail
+
+} // namespace Mapo
+
+#endif
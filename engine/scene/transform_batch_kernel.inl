@@ -0,0 +1,121 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Batched transform kernel shared by the per-instruction-set source files. It is included inside an
+// anonymous namespace after a `Lanes` struct that wraps one register type:
+//
+//   using V; static constexpr U32 WIDTH;
+//   Set1, Load, Add, Sub, Mul, Div, MulAdd (a * b + c), Floor, Abs, CmpLess, Select (mask ? a : b)
+//   StoreColumns(a, b, c, d, out, stride): writes (a[i], b[i], c[i], d[i]) to out + i * stride for each lane i
+//
+// Each file is built with its own instruction set flags, so nothing here may have external linkage or call
+// inline functions shared with other files (glm included): the linker could keep a copy built for a newer
+// instruction set. Matrices are therefore written as raw floats. The sine / cosine kernel is the one of
+// Simd::SinCos, see core/simd/simd_sincos.h.
+
+using V = Lanes::V;
+
+constexpr F32 DEGREES_TO_RADIANS = 0.01745329251994329577f;
+
+// Floats per TransformMatrices: model columns, then normal columns.
+constexpr size_t MATRICES_STRIDE = 32;
+
+// Sine and cosine of angles in degrees. Angles are wrapped to [-180, 180] first, so the absolute error stays
+// below 2e-7 (about 2 ULPs of 1.0) however far a rotation has accumulated.
+inline void SinCosDegrees(V degrees, V& outSin, V& outCos)
+{
+	const V turns = Lanes::Floor(Lanes::MulAdd(degrees, Lanes::Set1(1.0f / 360.0f), Lanes::Set1(0.5f)));
+	const V wrapped = Lanes::MulAdd(turns, Lanes::Set1(-360.0f), degrees);
+
+	Simd::Detail::SinCosKernel<Lanes>(Lanes::Mul(wrapped, Lanes::Set1(DEGREES_TO_RADIANS)), outSin, outCos);
+}
+
+// Computes Lanes::WIDTH objects starting at `first`. See TransformComponent::GetTransformMatrix for the math.
+inline void ComputeTransformBlock(const F32* const* soa, U32 first, F32* output)
+{
+	const V tx = Lanes::Load(soa[0] + first);
+	const V ty = Lanes::Load(soa[1] + first);
+	const V tz = Lanes::Load(soa[2] + first);
+
+	V s1, c1, s2, c2, s3, c3;
+	SinCosDegrees(Lanes::Load(soa[4] + first), s1, c1); // y
+	SinCosDegrees(Lanes::Load(soa[3] + first), s2, c2); // x
+	SinCosDegrees(Lanes::Load(soa[5] + first), s3, c3); // z
+
+	const V sx = Lanes::Load(soa[6] + first);
+	const V sy = Lanes::Load(soa[7] + first);
+	const V sz = Lanes::Load(soa[8] + first);
+
+	const V s2s3 = Lanes::Mul(s2, s3);
+	const V c3s2 = Lanes::Mul(c3, s2);
+
+	// Rotation Ry * Rx * Rz, column by column.
+	const V r00 = Lanes::MulAdd(s1, s2s3, Lanes::Mul(c1, c3));
+	const V r01 = Lanes::Mul(c2, s3);
+	const V r02 = Lanes::Sub(Lanes::Mul(c1, s2s3), Lanes::Mul(c3, s1));
+
+	const V r10 = Lanes::Sub(Lanes::Mul(s1, c3s2), Lanes::Mul(c1, s3));
+	const V r11 = Lanes::Mul(c2, c3);
+	const V r12 = Lanes::MulAdd(c1, c3s2, Lanes::Mul(s1, s3));
+
+	const V r20 = Lanes::Mul(c2, s1);
+	const V r21 = Lanes::Sub(Lanes::Set1(0.0f), s2);
+	const V r22 = Lanes::Mul(c1, c2);
+
+	const V zero = Lanes::Set1(0.0f);
+	const V one = Lanes::Set1(1.0f);
+
+	constexpr size_t STRIDE = MATRICES_STRIDE;
+	F32*			 model = output + first * STRIDE;
+	F32*			 normal = model + 16;
+
+	Lanes::StoreColumns(Lanes::Mul(sx, r00), Lanes::Mul(sx, r01), Lanes::Mul(sx, r02), zero, model, STRIDE);
+	Lanes::StoreColumns(Lanes::Mul(sy, r10), Lanes::Mul(sy, r11), Lanes::Mul(sy, r12), zero, model + 4, STRIDE);
+	Lanes::StoreColumns(Lanes::Mul(sz, r20), Lanes::Mul(sz, r21), Lanes::Mul(sz, r22), zero, model + 8, STRIDE);
+	Lanes::StoreColumns(tx, ty, tz, one, model + 12, STRIDE);
+
+	const V isx = Lanes::Div(one, sx);
+	const V isy = Lanes::Div(one, sy);
+	const V isz = Lanes::Div(one, sz);
+
+	Lanes::StoreColumns(Lanes::Mul(isx, r00), Lanes::Mul(isx, r01), Lanes::Mul(isx, r02), zero, normal, STRIDE);
+	Lanes::StoreColumns(Lanes::Mul(isy, r10), Lanes::Mul(isy, r11), Lanes::Mul(isy, r12), zero, normal + 4, STRIDE);
+	Lanes::StoreColumns(Lanes::Mul(isz, r20), Lanes::Mul(isz, r21), Lanes::Mul(isz, r22), zero, normal + 8, STRIDE);
+	Lanes::StoreColumns(zero, zero, zero, one, normal + 12, STRIDE);
+}
+
+inline void ComputeTransformMatricesLanes(const F32* const* soa, U32 count, F32* output)
+{
+	constexpr U32 WIDTH = Lanes::WIDTH;
+
+	U32 first = 0;
+	for (; first + WIDTH <= count; first += WIDTH)
+	{
+		ComputeTransformBlock(soa, first, output);
+	}
+
+	if (first == count)
+	{
+		return;
+	}
+
+	// Pad the tail with identity transforms and compute one more full block.
+	F32		   padded[9][WIDTH];
+	const F32* paddedSoa[9];
+	F32		   paddedOutput[WIDTH * MATRICES_STRIDE];
+
+	for (U32 component = 0; component < 9; ++component)
+	{
+		for (U32 lane = 0; lane < WIDTH; ++lane)
+		{
+			padded[component][lane] = first + lane < count ? soa[component][first + lane] : (component >= 6 ? 1.0f : 0.0f);
+		}
+
+		paddedSoa[component] = padded[component];
+	}
+
+	ComputeTransformBlock(paddedSoa, 0, paddedOutput);
+
+	memcpy(output + first * MATRICES_STRIDE, paddedOutput, (count - first) * MATRICES_STRIDE * sizeof(F32));
+}
@@ -0,0 +1,65 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+// Built with SSE4.1 enabled. Only called when the CPU supports it.
+
+#include "core/typedefs.h"
+#include "core/simd/cpu_features.h"
+#include "core/simd/simd_sincos.h"
+
+#if MP_SIMD_X86
+
+	#include <cstring>
+	#include <smmintrin.h>
+
+namespace Mapo
+{
+	namespace
+	{
+		struct Lanes
+		{
+			using V = __m128;
+
+			static constexpr U32 WIDTH = 4;
+
+			static V Set1(F32 value) { return _mm_set1_ps(value); }
+			static V Load(const F32* data) { return _mm_loadu_ps(data); }
+
+			static V Add(V a, V b) { return _mm_add_ps(a, b); }
+			static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+			static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+			static V Div(V a, V b) { return _mm_div_ps(a, b); }
+			static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+			static V Floor(V a) { return _mm_floor_ps(a); }
+			static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+			static V CmpLess(V a, V b) { return _mm_cmplt_ps(a, b); }
+			static V Select(V mask, V a, V b) { return _mm_blendv_ps(b, a, mask); }
+
+			static void StoreColumns(V a, V b, V c, V d, F32* out, size_t stride)
+			{
+				_MM_TRANSPOSE4_PS(a, b, c, d);
+				_mm_storeu_ps(out, a);
+				_mm_storeu_ps(out + stride, b);
+				_mm_storeu_ps(out + stride * 2, c);
+				_mm_storeu_ps(out + stride * 3, d);
+			}
+		};
+
+	#include "transform_batch_kernel.inl"
+
+	} // namespace
+
+	namespace Detail
+	{
+		void ComputeTransformMatricesSSE41(const F32* const* soa, U32 count, F32* output)
+		{
+			ComputeTransformMatricesLanes(soa, count, output);
+		}
+	} // namespace Detail
+
+} // namespace Mapo
+
+#endif
@@ -6,6 +6,7 @@
 
 #include "engine/renderer/vk_common.h"
 #include "engine/renderer/render_context.h"
+#include "engine/renderer/renderer.h"
 #include "engine/renderer/device.h"
 #include "engine/renderer/pipeline.h"
 #include "engine/renderer/frame_info.h"
@@ -66,6 +67,8 @@ namespace Mapo
 
 	void PointLightSystem::Render(FrameInfo& frameInfo)
 	{
+		MP_PROFILE_SCOPE("PointLightSystem::Render");
+
 		// Bind graphics pipeline.
 		m_pipeline->Bind(frameInfo.commandBuffer);
 
@@ -81,6 +84,11 @@ namespace Mapo
 			nullptr);
 
 		vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
+
+		RenderStats& stats = RenderContext::GetRenderer().GetStats();
+		stats.drawCalls++;
+		stats.triangleCount += 2;
+		stats.vertexCount += 6;
 	}
 
 } // namespace Mapo
@@ -6,7 +6,7 @@
 
 #include "core/core.h"
 
-#include "engine/scene/game_object.h"
+#include "engine/scene/scene_system.h"
 #include "engine/scene/component.h"
 
 #include <random>
@@ -14,14 +14,16 @@
 
 namespace Mapo
 {
-	class RainbowSystem
+	class RainbowSystem : public SceneSystem
 	{
 	public:
 		virtual ~RainbowSystem() = default;
 
 		RainbowSystem(F32 flickerRate)
-			: m_flickerRate(flickerRate)
+			: SceneSystem("RainbowSystem"), m_flickerRate(flickerRate)
 		{
+			Writes<MaterialComponent>();
+
 			// Initialize colors.
 			m_colors = { { 0.8f, 0.1f, 0.1f }, { 0.1f, 0.8f, 0.1f }, { 0.1f, 0.1f, 0.8f },
 				{ 0.8f, 0.8f, 0.1f }, { 0.8f, 0.1f, 0.8f }, { 0.1f, 0.8f, 0.8f } };
@@ -29,12 +31,10 @@ namespace Mapo
 			m_elapsedTime = m_flickerRate;
 		}
 
-		// Randomly select a color for each game object every m_flickerRate seconds.
-		void Update(std::vector<GameObject>& gameObjects)
+		// Randomly select a color for each material every m_flickerRate seconds.
+		virtual void OnUpdate(entt::registry& registry, EntityCommandBuffer& commands, Timestep dt) override
 		{
-			F32 deltaTime = 0;
-
-			m_elapsedTime -= deltaTime;
+			m_elapsedTime -= dt;
 
 			if (m_elapsedTime < 0.0f)
 			{
@@ -42,16 +42,10 @@ namespace Mapo
 
 				std::uniform_int_distribution<int> randInt{ 0, static_cast<int>(m_colors.size()) - 1 };
 
-				for (GameObject& gameObject : gameObjects)
-				{
-					if (gameObject.HasComponent<MaterialComponent>())
-					{
-						auto& material = gameObject.GetComponent<MaterialComponent>();
-
-						int randValue = randInt(m_rng);
-						material.color = m_colors[randValue];
-					}
-				}
+				registry.view<MaterialComponent>().each([&](MaterialComponent& material) {
+					int randValue = randInt(m_rng);
+					material.color = m_colors[randValue];
+				});
 			}
 		}
 
@@ -4,43 +4,63 @@
 
 #include "simple_render_system.h"
 
-#include "engine/scene/component.h"
 #include "engine/model.h"
 
 #include "engine/renderer/vk_common.h"
 #include "engine/renderer/render_context.h"
+#include "engine/renderer/renderer.h"
 #include "engine/renderer/device.h"
 #include "engine/renderer/pipeline.h"
 #include "engine/renderer/frame_info.h"
+#include "engine/renderer/object_buffer.h"
+#include "engine/renderer/geometry_pool.h"
+#include "engine/renderer/gpu_culling.h"
+#include "engine/renderer/hiz_pyramid.h"
+
+#include <filesystem>
 
 namespace Mapo
 {
+	// Matches the push constants of simple_shader.vert. Every pipeline of the system declares the same range, so
+	// the bound descriptor sets stay valid when a frame switches between them.
 	struct SimplePushConstantData
 	{
-		Matrix4 modelMatrix{ 1.0f };
-		Matrix4 normalMatrix{ 1.0f };
+		U32 objectIndex = 0; // entry in the object buffer
 	};
 
+	static constexpr const char* INSTANCED_VERTEX_SHADER = "assets/shaders/simple_shader_instanced.vert.spv";
+	static constexpr const char* INDIRECT_VERTEX_SHADER = "assets/shaders/simple_shader_indirect.vert.spv";
+	static constexpr const char* DEPTH_ONLY_FRAGMENT_SHADER = "assets/shaders/depth_only.frag.spv";
+
 	SimpleRenderSystem::SimpleRenderSystem(VkRenderPass renderPass, VkDescriptorSetLayout globalDescriptorSetLayout)
 		: m_device(RenderContext::GetDevice())
 	{
 		CreatePipelineLayout(globalDescriptorSetLayout);
 		CreatePipeline(renderPass);
+		CreateInstancedPipeline(renderPass);
+		CreateIndirectPipeline(renderPass, globalDescriptorSetLayout);
 	}
 
 	SimpleRenderSystem::~SimpleRenderSystem()
 	{
 		vkDestroyPipelineLayout(m_device.GetDevice(), m_pipelineLayout, nullptr);
+
+		if (m_indirectPipelineLayout != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineLayout(m_device.GetDevice(), m_indirectPipelineLayout, nullptr);
+		}
 	}
 
 	void SimpleRenderSystem::CreatePipelineLayout(VkDescriptorSetLayout globalDescriptorSetLayout)
 	{
 		VkPushConstantRange pushConstantRange{};
-		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 		pushConstantRange.offset = 0;
 		pushConstantRange.size = sizeof(SimplePushConstantData);
 
-		std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalDescriptorSetLayout };
+		m_objectBuffer = MakeUnique<ObjectBuffer>();
+
+		std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalDescriptorSetLayout, m_objectBuffer->GetDescriptorSetLayout() };
 
 		// This will be referenced throughout the program's lifetime.
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -71,47 +91,537 @@ namespace Mapo
 			pipelineConfig);
 	}
 
-	void SimpleRenderSystem::RenderGameObjects(FrameInfo& frameInfo)
+	void SimpleRenderSystem::CreateInstancedPipeline(VkRenderPass renderPass)
+	{
+		// Shaders are compiled offline (assets/shaders/compile.sh). Keep drawing per object until it is.
+		if (!std::filesystem::exists(INSTANCED_VERTEX_SHADER))
+		{
+			MP_WARN("{} not found, drawing without instancing. Run assets/shaders/compile.sh.", INSTANCED_VERTEX_SHADER);
+			return;
+		}
+
+		// The shader finds its object through the instance index and ignores the push constants.
+		PipelineConfigInfo pipelineConfig{};
+		Pipeline::DefaultPipelineConfigInfo(pipelineConfig);
+
+		pipelineConfig.renderPass = renderPass;
+		pipelineConfig.pipelineLayout = m_pipelineLayout;
+
+		m_instancedPipeline = MakeUnique<Pipeline>(
+			INSTANCED_VERTEX_SHADER,
+			"assets/shaders/simple_shader.frag.spv",
+			pipelineConfig);
+	}
+
+	void SimpleRenderSystem::CreateIndirectPipeline(VkRenderPass renderPass, VkDescriptorSetLayout globalDescriptorSetLayout)
+	{
+		if (!std::filesystem::exists(INDIRECT_VERTEX_SHADER) || !GpuCulling::IsSupported())
+		{
+			MP_WARN("GPU culling is not available, culling on the CPU. Check drawIndirectFirstInstance and run assets/shaders/compile.sh.");
+			return;
+		}
+
+		m_gpuCulling = MakeUnique<GpuCulling>();
+
+		m_gpuFrames.resize(RenderContext::GetMaxFramesInFlight());
+		MP_ASSERT(m_gpuFrames.size() <= 32, "Dirty proxies are tracked with one bit per frame in flight!");
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(SimplePushConstantData);
+
+		std::vector<VkDescriptorSetLayout> descriptorSetLayouts{
+			globalDescriptorSetLayout,
+			m_objectBuffer->GetDescriptorSetLayout(),
+			m_gpuCulling->GetDrawSetLayout()
+		};
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = static_cast<U32>(descriptorSetLayouts.size());
+		pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+		VK_CHECK(vkCreatePipelineLayout(m_device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_indirectPipelineLayout));
+
+		PipelineConfigInfo pipelineConfig{};
+		Pipeline::DefaultPipelineConfigInfo(pipelineConfig);
+
+		pipelineConfig.renderPass = renderPass;
+		pipelineConfig.pipelineLayout = m_indirectPipelineLayout;
+
+		m_indirectPipeline = MakeUnique<Pipeline>(
+			INDIRECT_VERTEX_SHADER,
+			"assets/shaders/simple_shader.frag.spv",
+			pipelineConfig);
+
+		if (!std::filesystem::exists(DEPTH_ONLY_FRAGMENT_SHADER))
+		{
+			MP_WARN("{} not found, drawing without occlusion culling. Run assets/shaders/compile.sh.", DEPTH_ONLY_FRAGMENT_SHADER);
+			return;
+		}
+
+		// Same shader inputs, but only depth is written.
+		PipelineConfigInfo prepassConfig{};
+		Pipeline::DefaultPipelineConfigInfo(prepassConfig);
+
+		prepassConfig.renderPass = m_gpuCulling->GetHiZPyramid().GetDepthRenderPass();
+		prepassConfig.pipelineLayout = m_indirectPipelineLayout;
+		prepassConfig.colorBlendInfo.attachmentCount = 0;
+
+		m_depthPrepassPipeline = MakeUnique<Pipeline>(
+			INDIRECT_VERTEX_SHADER,
+			DEPTH_ONLY_FRAGMENT_SHADER,
+			prepassConfig);
+	}
+
+	void SimpleRenderSystem::PrepareGameObjects(FrameInfo& frameInfo)
 	{
-		// Bind graphics pipeline.
-		m_pipeline->Bind(frameInfo.commandBuffer);
+		MP_PROFILE_SCOPE("SimpleRenderSystem::PrepareGameObjects");
 
-		// Bind descriptor set.
-		vkCmdBindDescriptorSets(
-			frameInfo.commandBuffer,
-			VK_PIPELINE_BIND_POINT_GRAPHICS,
-			m_pipelineLayout,
-			0,
-			1,
-			&frameInfo.globalDescriptorSet,
-			0,
-			nullptr);
+		m_gpuCulled = false;
 
-		// Render objects.
-		// For now the game object list has been filtered with TransformComponent, i.e., all components.
-		for (GameObject& gameObject : frameInfo.gameObjects)
+		if (!m_indirectPipeline)
 		{
-			auto& transform = gameObject.GetComponent<TransformComponent>();
+			return;
+		}
+
+		// Batches follow every scene update, also on frames culled on the CPU, so no change is missed.
+		UpdateBatches(frameInfo);
 
-			if (gameObject.HasComponent<MeshComponent>())
+		// Indirect draws are indexed. Cull this frame on the CPU instead.
+		if (m_nonIndexedBatchCount > 0)
+		{
+			return;
+		}
+
+		const U32 objectCount = static_cast<U32>(frameInfo.renderProxies.size());
+		const U32 batchCount = static_cast<U32>(m_batchSizes.size());
+		GpuFrame& frame = m_gpuFrames[frameInfo.frameIndex];
+
+		// The scene has not culled on the CPU yet, so its count only includes the PVS.
+		AddCulledStats(frameInfo.frameIndex, frameInfo.culledRenderProxyCount);
+		UploadDirtyProxies(frameInfo);
+
+		// Each batch gets a slice of the visible list as large as the batch; the shader fills in the instances.
+		VkDrawIndexedIndirectCommand* commands = m_gpuCulling->MapDrawCommands(frameInfo.frameIndex, batchCount);
+		U32							  firstInstance = 0;
+
+		frame.batchVertexCounts.resize(batchCount);
+
+		for (U32 batch = 0; batch < batchCount; ++batch)
+		{
+			const GeometryRange& geometry = m_batchGeometry[batch];
+
+			commands[batch].indexCount = geometry.indexCount;
+			commands[batch].instanceCount = 0;
+			commands[batch].firstIndex = geometry.firstIndex;
+			commands[batch].vertexOffset = static_cast<I32>(geometry.firstVertex);
+			commands[batch].firstInstance = firstInstance;
+
+			frame.batchVertexCounts[batch] = geometry.vertexCount;
+			firstInstance += m_batchSizes[batch];
+		}
+
+		frame.batchCount = batchCount;
+		frame.batchedObjectCount = firstInstance;
+
+		Renderer&	  renderer = RenderContext::GetRenderer();
+		const Matrix4 viewProjection = frameInfo.camera.GetProjectionMatrix() * frameInfo.camera.GetViewMatrix();
+		const bool	  occlusion = m_depthPrepassPipeline && renderer.OcclusionCulling();
+
+		m_gpuCulling->SetViewportSize(renderer.GetSwapchainWidth(), renderer.GetSwapchainHeight());
+
+		// Last frame's visible objects are drawn into the prepass depth that the pyramid is built from.
+		if (occlusion)
+		{
+			m_gpuCulling->DispatchOccluders(frameInfo.commandBuffer, frameInfo.frameIndex, viewProjection, objectCount, batchCount);
+
+			HiZPyramid& hiZPyramid = m_gpuCulling->GetHiZPyramid();
+			hiZPyramid.BeginDepthPass(frameInfo.commandBuffer);
+
+			BindPipeline(frameInfo, PIPELINE_DEPTH_PREPASS);
+			RenderContext::GetGeometryPool().Bind(frameInfo.commandBuffer);
+			renderer.GetStats().drawCalls += m_gpuCulling->DrawOccluders(frameInfo.commandBuffer, frameInfo.frameIndex, batchCount);
+
+			hiZPyramid.EndDepthPass(frameInfo.commandBuffer);
+		}
+
+		m_gpuCulling->Dispatch(frameInfo.commandBuffer, frameInfo.frameIndex, viewProjection, objectCount, batchCount, occlusion);
+		m_gpuCulled = true;
+	}
+
+	void SimpleRenderSystem::UpdateBatches(FrameInfo& frameInfo)
+	{
+		const std::vector<RenderProxy>& proxies = frameInfo.renderProxies;
+		const U32						objectCount = static_cast<U32>(proxies.size());
+		const U32						frameCount = static_cast<U32>(m_gpuFrames.size());
+
+		// Proxies past the end were removed from the scene.
+		for (U32 index = objectCount; index < static_cast<U32>(m_proxyBatches.size()); ++index)
+		{
+			ReleaseBatch(m_proxyBatches[index]);
+		}
+
+		m_proxyBatches.resize(objectCount, GpuCullData::INVALID_BATCH);
+
+		// Dirty lists may still hold removed proxies, so their bits are kept until the lists are uploaded.
+		if (m_proxyDirtyFrames.size() < objectCount)
+		{
+			m_proxyDirtyFrames.resize(objectCount, 0);
+		}
+
+		// Every changed proxy leaves its batch before any joins one. A model destroyed this update frees its
+		// batch first, so a new model allocated at the same address cannot inherit its geometry.
+		for (U32 index : frameInfo.changedRenderProxies)
+		{
+			ReleaseBatch(m_proxyBatches[index]);
+			m_proxyBatches[index] = GpuCullData::INVALID_BATCH;
+		}
+
+		for (U32 index : frameInfo.changedRenderProxies)
+		{
+			const RenderProxy& proxy = proxies[index];
+
+			if (proxy.flags & RENDER_PROXY_VISIBLE)
 			{
-				auto& meshComponent = gameObject.GetComponent<MeshComponent>();
+				m_proxyBatches[index] = AcquireBatch(proxy.model);
+			}
+
+			for (U32 frame = 0; frame < frameCount; ++frame)
+			{
+				const U32 frameBit = 1u << frame;
 
-				if (!meshComponent.enabled)
+				if (!(m_proxyDirtyFrames[index] & frameBit))
 				{
-					continue;
+					m_proxyDirtyFrames[index] |= frameBit;
+					m_gpuFrames[frame].dirtyProxies.push_back(index);
 				}
+			}
+		}
+	}
+
+	U32 SimpleRenderSystem::AcquireBatch(Model* model)
+	{
+		auto [it, inserted] = m_batchIds.try_emplace(model, 0);
+
+		if (inserted)
+		{
+			if (m_freeBatches.empty())
+			{
+				it->second = static_cast<U32>(m_batchModels.size());
+				m_batchModels.push_back(model);
+				m_batchGeometry.push_back(model->GetGeometryRange());
+				m_batchSizes.push_back(0);
+			}
+			else
+			{
+				it->second = m_freeBatches.back();
+				m_freeBatches.pop_back();
+				m_batchModels[it->second] = model;
+				m_batchGeometry[it->second] = model->GetGeometryRange();
+			}
+
+			if (m_batchGeometry[it->second].indexCount == 0)
+			{
+				m_nonIndexedBatchCount++;
+			}
+		}
+
+		m_batchSizes[it->second]++;
+		return it->second;
+	}
+
+	void SimpleRenderSystem::ReleaseBatch(U32 batch)
+	{
+		if (batch == GpuCullData::INVALID_BATCH || --m_batchSizes[batch] > 0)
+		{
+			return;
+		}
+
+		if (m_batchGeometry[batch].indexCount == 0)
+		{
+			m_nonIndexedBatchCount--;
+		}
 
-				SimplePushConstantData push{};
-				push.modelMatrix = transform.GetTransformMatrix();
-				push.normalMatrix = transform.GetNormalMatrix(); // glm automatically converts from mat4 to mat3
+		m_batchIds.erase(m_batchModels[batch]);
+		m_batchModels[batch] = nullptr;
+		m_freeBatches.push_back(batch);
+	}
 
-				vkCmdPushConstants(frameInfo.commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-					sizeof(SimplePushConstantData), &push);
+	void SimpleRenderSystem::UploadDirtyProxies(FrameInfo& frameInfo)
+	{
+		MP_PROFILE_SCOPE("SimpleRenderSystem::UploadDirtyProxies");
+
+		const std::vector<RenderProxy>& proxies = frameInfo.renderProxies;
+		const RenderProxyBounds&		bounds = frameInfo.renderProxyBounds;
+		const U32						objectCount = static_cast<U32>(proxies.size());
+		const U32						frameBit = 1u << frameInfo.frameIndex;
+		GpuFrame&						frame = m_gpuFrames[frameInfo.frameIndex];
+
+		// Every proxy lives at its proxy index; the GPU decides which ones are drawn.
+		ObjectData*	 objects = m_objectBuffer->Map(frameInfo.frameIndex, objectCount);
+		GpuCullData* cullData = m_gpuCulling->MapCullData(frameInfo.frameIndex, objectCount);
+
+		auto upload = [&](U32 index) {
+			const RenderProxy& proxy = proxies[index];
+			GpuCullData&	   cull = cullData[index];
+
+			objects[index].Set(proxy.modelMatrix, proxy.normalMatrix);
+
+			cull.center = { bounds.center[0][index], bounds.center[1][index], bounds.center[2][index] };
+			cull.extent = { bounds.extent[0][index], bounds.extent[1][index], bounds.extent[2][index] };
+			cull.radius = bounds.radius[index];
+			cull.batchIndex = m_proxyBatches[index];
+		};
+
+		for (U32 index : frame.dirtyProxies)
+		{
+			m_proxyDirtyFrames[index] &= ~frameBit;
 
-				meshComponent.model->Bind(frameInfo.commandBuffer);
-				meshComponent.model->Draw(frameInfo.commandBuffer);
+			// Proxies removed since they changed are not culled.
+			if (!frame.uploadAll && index < objectCount)
+			{
+				upload(index);
+			}
+		}
+
+		frame.dirtyProxies.clear();
+
+		if (frame.uploadAll)
+		{
+			for (U32 index = 0; index < objectCount; ++index)
+			{
+				upload(index);
 			}
+
+			frame.uploadAll = false;
+		}
+	}
+
+	void SimpleRenderSystem::AddCulledStats(U32 frameIndex, U32 pvsCulledCount)
+	{
+		// The instance counts of the frame's last submission. Its fence has been waited on, and the culling
+		// made them visible to the host.
+		const GpuFrame&						frame = m_gpuFrames[frameIndex];
+		const VkDrawIndexedIndirectCommand* commands = m_gpuCulling->GetCulledDrawCommands(frameIndex);
+
+		RenderStats& stats = RenderContext::GetRenderer().GetStats();
+		U32			 visibleCount = 0;
+
+		for (U32 batch = 0; batch < frame.batchCount; ++batch)
+		{
+			const U32 instanceCount = commands[batch].instanceCount;
+
+			visibleCount += instanceCount;
+			stats.vertexCount += instanceCount * frame.batchVertexCounts[batch];
+			stats.triangleCount += instanceCount * (commands[batch].indexCount / 3);
+		}
+
+		stats.visibleObjectCount += visibleCount;
+		stats.culledObjectCount += frame.batchedObjectCount - visibleCount + pvsCulledCount;
+	}
+
+	void SimpleRenderSystem::RenderGameObjects(FrameInfo& frameInfo)
+	{
+		MP_PROFILE_SCOPE("SimpleRenderSystem::RenderGameObjects");
+
+		// Object, vertex and triangle counts of GPU culled frames were read back in PrepareGameObjects.
+		if (m_gpuCulled)
+		{
+			RenderIndirect(frameInfo);
+			return;
+		}
+
+		// The CPU paths write the object buffer in queue order, and nothing was culled on the GPU.
+		if (!m_gpuFrames.empty())
+		{
+			GpuFrame& frame = m_gpuFrames[frameInfo.frameIndex];
+			frame.uploadAll = true;
+			frame.batchCount = 0;
+		}
+
+		RenderStats& stats = RenderContext::GetRenderer().GetStats();
+		stats.visibleObjectCount += static_cast<U32>(frameInfo.visibleRenderProxies.size());
+		stats.culledObjectCount += frameInfo.culledRenderProxyCount;
+
+		if (frameInfo.visibleRenderProxies.empty())
+		{
+			return;
+		}
+
+		BuildRenderQueue(frameInfo, m_instancedPipeline ? PIPELINE_INSTANCED : PIPELINE_PER_OBJECT);
+
+		if (m_instancedPipeline)
+		{
+			RenderInstanced(frameInfo);
+		}
+		else
+		{
+			RenderPerObject(frameInfo);
+		}
+	}
+
+	void SimpleRenderSystem::BuildRenderQueue(FrameInfo& frameInfo, U32 pipeline)
+	{
+		MP_PROFILE_SCOPE("SimpleRenderSystem::BuildRenderQueue");
+
+		const Matrix4& viewMatrix = frameInfo.camera.GetViewMatrix();
+		const F32	   farClip = frameInfo.camera.GetFarClip();
+
+		m_renderQueue.Clear();
+		m_renderQueue.Reserve(static_cast<U32>(frameInfo.visibleRenderProxies.size()));
+		m_meshIds.clear();
+
+		for (U32 index : frameInfo.visibleRenderProxies)
+		{
+			const RenderProxy& proxy = frameInfo.renderProxies[index];
+
+			// Mesh ids are handed out in order of first appearance; only equality matters for batching.
+			auto [it, inserted] = m_meshIds.try_emplace(proxy.model, static_cast<U32>(m_meshIds.size()));
+			MP_ASSERT(it->second < (1u << RenderQueue::MESH_BITS), "Too many meshes for the sort key!");
+
+			// The camera looks down -Z in view space.
+			const F32 viewDepth = -(viewMatrix * proxy.modelMatrix[3]).z;
+			const U32 depthBucket = RenderQueue::GetDepthBucket(DRAW_PASS_OPAQUE, viewDepth, farClip);
+
+			// No materials yet, every mesh uses material 0.
+			m_renderQueue.Push(RenderQueue::MakeSortKey(DRAW_PASS_OPAQUE, pipeline, 0, it->second, depthBucket), index);
+		}
+
+		m_renderQueue.Sort();
+	}
+
+	void SimpleRenderSystem::BindPipeline(FrameInfo& frameInfo, U32 pipeline)
+	{
+		if (pipeline == PIPELINE_INDIRECT || pipeline == PIPELINE_DEPTH_PREPASS)
+		{
+			Pipeline& boundPipeline = pipeline == PIPELINE_INDIRECT ? *m_indirectPipeline : *m_depthPrepassPipeline;
+			boundPipeline.Bind(frameInfo.commandBuffer);
+
+			VkDescriptorSet descriptorSets[] = {
+				frameInfo.globalDescriptorSet,
+				m_objectBuffer->GetDescriptorSet(frameInfo.frameIndex),
+				m_gpuCulling->GetDrawSet(frameInfo.frameIndex)
+			};
+
+			vkCmdBindDescriptorSets(
+				frameInfo.commandBuffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				m_indirectPipelineLayout,
+				0,
+				3,
+				descriptorSets,
+				0,
+				nullptr);
+		}
+		else
+		{
+			Pipeline& boundPipeline = pipeline == PIPELINE_INSTANCED ? *m_instancedPipeline : *m_pipeline;
+			boundPipeline.Bind(frameInfo.commandBuffer);
+
+			VkDescriptorSet descriptorSets[] = { frameInfo.globalDescriptorSet, m_objectBuffer->GetDescriptorSet(frameInfo.frameIndex) };
+
+			vkCmdBindDescriptorSets(
+				frameInfo.commandBuffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				m_pipelineLayout,
+				0,
+				2,
+				descriptorSets,
+				0,
+				nullptr);
+		}
+	}
+
+	void SimpleRenderSystem::RenderIndirect(FrameInfo& frameInfo)
+	{
+		BindPipeline(frameInfo, PIPELINE_INDIRECT);
+		RenderContext::GetGeometryPool().Bind(frameInfo.commandBuffer);
+
+		RenderStats& stats = RenderContext::GetRenderer().GetStats();
+		stats.drawCalls += m_gpuCulling->Draw(frameInfo.commandBuffer, frameInfo.frameIndex, static_cast<U32>(m_batchSizes.size()));
+	}
+
+	void SimpleRenderSystem::RenderInstanced(FrameInfo& frameInfo)
+	{
+		const std::vector<DrawPacket>& packets = m_renderQueue.GetPackets();
+		const U32					   packetCount = m_renderQueue.GetPacketCount();
+
+		// Objects are written in queue order, so each run of packets that differ only in depth is one draw
+		// whose instances start at the run's first packet.
+		ObjectData* objects = m_objectBuffer->Map(frameInfo.frameIndex, packetCount);
+
+		for (U32 i = 0; i < packetCount; ++i)
+		{
+			const RenderProxy& proxy = frameInfo.renderProxies[packets[i].payload];
+			objects[i].Set(proxy.modelMatrix, proxy.normalMatrix);
+		}
+
+		// Every model lives in the geometry pool, so one bind serves all draws.
+		RenderContext::GetGeometryPool().Bind(frameInfo.commandBuffer);
+
+		U32 boundPipeline = INVALID_PIPELINE;
+
+		for (U32 first = 0; first < packetCount;)
+		{
+			const U64 drawKey = packets[first].sortKey >> RenderQueue::MESH_SHIFT;
+
+			U32 last = first + 1;
+			while (last < packetCount && (packets[last].sortKey >> RenderQueue::MESH_SHIFT) == drawKey)
+			{
+				++last;
+			}
+
+			const U32 pipeline = RenderQueue::GetPipeline(packets[first].sortKey);
+			if (pipeline != boundPipeline)
+			{
+				BindPipeline(frameInfo, pipeline);
+				boundPipeline = pipeline;
+			}
+
+			Model* model = frameInfo.renderProxies[packets[first].payload].model;
+			model->Draw(frameInfo.commandBuffer, last - first, first);
+			first = last;
+		}
+	}
+
+	void SimpleRenderSystem::RenderPerObject(FrameInfo& frameInfo)
+	{
+		const std::vector<DrawPacket>& packets = m_renderQueue.GetPackets();
+		const U32					   packetCount = m_renderQueue.GetPacketCount();
+
+		// Objects are written in queue order, like the instanced path, and each draw pushes only its index.
+		ObjectData* objects = m_objectBuffer->Map(frameInfo.frameIndex, packetCount);
+
+		for (U32 i = 0; i < packetCount; ++i)
+		{
+			const RenderProxy& proxy = frameInfo.renderProxies[packets[i].payload];
+			objects[i].Set(proxy.modelMatrix, proxy.normalMatrix);
+		}
+
+		RenderContext::GetGeometryPool().Bind(frameInfo.commandBuffer);
+
+		U32 boundPipeline = INVALID_PIPELINE;
+
+		// Render objects that passed culling, in queue order.
+		for (U32 i = 0; i < packetCount; ++i)
+		{
+			const U32 pipeline = RenderQueue::GetPipeline(packets[i].sortKey);
+			if (pipeline != boundPipeline)
+			{
+				BindPipeline(frameInfo, pipeline);
+				boundPipeline = pipeline;
+			}
+
+			SimplePushConstantData push{};
+			push.objectIndex = i;
+
+			vkCmdPushConstants(frameInfo.commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(SimplePushConstantData), &push);
+
+			frameInfo.renderProxies[packets[i].payload].model->Draw(frameInfo.commandBuffer);
 		}
 	}
 
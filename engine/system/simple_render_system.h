@@ -8,6 +8,8 @@
 
 #include "engine/scene/game_object.h"
 #include "engine/renderer/camera.h"
+#include "engine/renderer/render_queue.h"
+#include "engine/renderer/geometry_pool.h"
 
 #include <vulkan/vulkan.h>
 
@@ -18,6 +20,9 @@ namespace Mapo
 {
 	class Device;
 	class Pipeline;
+	class ObjectBuffer;
+	class GpuCulling;
+	class Model;
 	class FrameInfo;
 
 	class SimpleRenderSystem
@@ -30,17 +35,86 @@ namespace Mapo
 		SimpleRenderSystem(const SimpleRenderSystem&) = delete;
 		SimpleRenderSystem& operator=(const SimpleRenderSystem&) = delete;
 
+		// Uploads the changed objects and records GPU culling when it is available. Must be called after every
+		// scene update, outside of the render pass and before RenderGameObjects in the same frame.
+		void PrepareGameObjects(FrameInfo& frameInfo);
 		void RenderGameObjects(FrameInfo& frameInfo);
 
+		// Whether PrepareGameObjects recorded GPU culling for this frame. If not, the objects need to be culled
+		// on the CPU before RenderGameObjects.
+		bool IsGpuCulled() const { return m_gpuCulled; }
+
 	private:
+		// Pipeline field of the sort keys.
+		enum PipelineId : U32
+		{
+			PIPELINE_PER_OBJECT = 0,
+			PIPELINE_INSTANCED = 1,
+			PIPELINE_INDIRECT = 2,
+			PIPELINE_DEPTH_PREPASS = 3,
+			INVALID_PIPELINE = ~0u,
+		};
+
+		struct GpuFrame
+		{
+			std::vector<U32> dirtyProxies{};		 // proxies whose copy in this frame's buffers is stale
+			bool			 uploadAll = true;		 // the object buffer holds something else, e.g. the CPU path's queue
+			U32				 batchCount = 0;		 // batches culled when the frame was last submitted
+			U32				 batchedObjectCount = 0; // proxies in those batches
+			std::vector<U32> batchVertexCounts{};	 // vertices of each of those batches' meshes
+		};
+
 		void CreatePipelineLayout(VkDescriptorSetLayout globalDescriptorSetLayout);
 		void CreatePipeline(VkRenderPass renderPass);
+		void CreateInstancedPipeline(VkRenderPass renderPass);
+		void CreateIndirectPipeline(VkRenderPass renderPass, VkDescriptorSetLayout globalDescriptorSetLayout);
+
+		// GPU culling keeps every proxy at its proxy index. Changes move proxies between batches and mark them
+		// dirty in every frame in flight; each frame uploads its dirty proxies when it is prepared.
+		void UpdateBatches(FrameInfo& frameInfo);
+		U32	 AcquireBatch(Model* model);
+		void ReleaseBatch(U32 batch);
+		void UploadDirtyProxies(FrameInfo& frameInfo);
+		void AddCulledStats(U32 frameIndex, U32 pvsCulledCount);
+
+		// Queues the visible objects with sort keys and sorts them.
+		void BuildRenderQueue(FrameInfo& frameInfo, U32 pipeline);
+		void BindPipeline(FrameInfo& frameInfo, U32 pipeline);
+
+		void RenderIndirect(FrameInfo& frameInfo);
+		void RenderInstanced(FrameInfo& frameInfo);
+		void RenderPerObject(FrameInfo& frameInfo);
 
 	private:
 		Device& m_device;
 
-		UniqueRef<Pipeline> m_pipeline;
-		VkPipelineLayout	m_pipelineLayout;
+		UniqueRef<Pipeline> m_pipeline;			 // one draw per object, object index in push constants
+		UniqueRef<Pipeline> m_instancedPipeline; // one draw per model, null if the shader is missing
+		UniqueRef<Pipeline> m_indirectPipeline;	 // culled and drawn by the GPU, null if unsupported
+		UniqueRef<Pipeline> m_depthPrepassPipeline; // occluders into the Hi-Z depth, null if unsupported
+		VkPipelineLayout	m_pipelineLayout; // global set and object buffer, for the per-object and instanced pipelines
+		VkPipelineLayout	m_indirectPipelineLayout = VK_NULL_HANDLE; // adds the visible list, also for the prepass
+
+		UniqueRef<ObjectBuffer> m_objectBuffer{}; // in queue order, or by proxy index when GPU culled
+		UniqueRef<GpuCulling>	m_gpuCulling{};
+
+		// Batches are persistent; emptied ones are drawn with no instances until a new model takes their slot.
+		// Their geometry is copied, so models can be destroyed while their batch empties.
+		std::vector<Model*>		   m_batchModels{};	  // model of every GPU batch, only used as a key
+		std::vector<GeometryRange> m_batchGeometry{}; // geometry of every GPU batch's model
+		std::vector<U32>		   m_batchSizes{};	  // proxies per GPU batch
+		std::vector<U32>		   m_freeBatches{};
+		HashMap<Model*, U32>	   m_batchIds{};
+		U32						   m_nonIndexedBatchCount = 0; // indirect draws are indexed, these force CPU culling
+
+		std::vector<U32>	  m_proxyBatches{};		// batch of every proxy, GpuCullData::INVALID_BATCH if not drawn
+		std::vector<U32>	  m_proxyDirtyFrames{}; // bit i is set while the proxy is in frame i's dirty list
+		std::vector<GpuFrame> m_gpuFrames{};
+
+		bool m_gpuCulled = false; // PrepareGameObjects recorded culling for this frame
+
+		RenderQueue			 m_renderQueue{};
+		HashMap<Model*, U32> m_meshIds{}; // mesh field of the sort keys, rebuilt every frame
 	};
 
 } // namespace Mapo
@@ -115,9 +115,12 @@ namespace Mapo
 		// 	style.Colors[ImGuiCol_WindowBg].w = 1.f;
 		// }
 
-		// Set up GLFW & Vulkan backends.
+		// Set up GLFW & Vulkan backends. Headless windows have no platform backend.
 		Window& window = Application::Get().GetWindow();
-		ImGui_ImplGlfw_InitForVulkan(static_cast<GLFWwindow*>(window.GetNativeWindow()), true);
+		if (!window.IsHeadless())
+		{
+			ImGui_ImplGlfw_InitForVulkan(static_cast<GLFWwindow*>(window.GetNativeWindow()), true);
+		}
 
 		Renderer& renderer = RenderContext::GetRenderer();
 
@@ -141,14 +144,31 @@ namespace Mapo
 
 		ImGui_ImplVulkan_Init(&initInfo);
 
-		// Upload fonts.
-		ImGui_ImplVulkan_CreateFontsTexture();
+		// Rasterizing the font atlas is the most expensive part of the ImGui setup. It only touches the atlas,
+		// so it runs on a worker thread while the other layers are attached. The texture is uploaded in the first Begin.
+		ImFontAtlas* fontAtlas = io.Fonts;
+		m_fontAtlasBuild = std::async(std::launch::async, [fontAtlas]() {
+			MP_STARTUP_PHASE("ImGui font atlas");
+
+			unsigned char* pixels = nullptr;
+			int			   width = 0;
+			int			   height = 0;
+			fontAtlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+		});
 	}
 
 	void ImGuiLayer::OnDetach()
 	{
+		if (m_fontAtlasBuild.valid())
+		{
+			m_fontAtlasBuild.wait();
+		}
+
 		ImGui_ImplVulkan_Shutdown();
-		ImGui_ImplGlfw_Shutdown();
+		if (!Application::Get().GetWindow().IsHeadless())
+		{
+			ImGui_ImplGlfw_Shutdown();
+		}
 		ImGui::DestroyContext();
 
 		vkDestroyDescriptorPool(m_device.GetDevice(), s_descriptorPool, nullptr);
@@ -157,8 +177,30 @@ namespace Mapo
 
 	void ImGuiLayer::Begin()
 	{
+		if (m_fontAtlasBuild.valid())
+		{
+			m_fontAtlasBuild.get();
+
+			// Upload fonts. The backend submits to the graphics queue itself.
+			std::unique_lock<std::mutex> queueLock = m_device.LockQueues();
+			ImGui_ImplVulkan_CreateFontsTexture();
+		}
+
 		ImGui_ImplVulkan_NewFrame();
-		ImGui_ImplGlfw_NewFrame(); // Update input for instance.
+
+		Window& window = Application::Get().GetWindow();
+		if (window.IsHeadless())
+		{
+			// No platform backend to fill in the frame data.
+			ImGuiIO& io = ImGui::GetIO();
+			io.DisplaySize = ImVec2(window.GetWidth(), window.GetHeight());
+			io.DeltaTime = 1.0f / 60.0f;
+		}
+		else
+		{
+			ImGui_ImplGlfw_NewFrame(); // Update input for instance.
+		}
+
 		ImGui::NewFrame();
 
 		ImGuizmo::BeginFrame();
@@ -179,6 +221,8 @@ namespace Mapo
 		{
 			void* backupCurrentContext = window.GetCurrentContext();
 
+			// The backend submits and presents the platform windows itself.
+			std::unique_lock<std::mutex> queueLock = m_device.LockQueues();
 			ImGui::UpdatePlatformWindows();
 			ImGui::RenderPlatformWindowsDefault();
 
@@ -6,6 +6,8 @@
 
 #include "engine/layer.h"
 
+#include <future>
+
 namespace Mapo
 {
 	class Device;
@@ -41,6 +43,9 @@ namespace Mapo
 		Device& m_device;
 
 		bool m_blockEvents = false;
+
+		// Font atlas rasterization started in OnAttach.
+		std::future<void> m_fontAtlasBuild;
 	};
 
 } // namespace Mapo
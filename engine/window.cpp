@@ -4,6 +4,10 @@
 
 #include "window.h"
 
+#include "core/uassert.h"
+
+#include "platform/headless/headless_window.h"
+
 #ifdef MP_MACOS_BUILD
 	#include "platform/macos/macos_window.h"
 #endif
@@ -12,10 +16,15 @@ namespace Mapo
 {
 	UniqueRef<Window> Window::Create(const WindowProps& props)
 	{
+		if (props.headless)
+		{
+			return MakeUnique<HeadlessWindow>(props);
+		}
+
 #ifdef MP_MACOS_BUILD
 		return MakeUnique<MacosWindow>(props);
 #else
-		ASSERT(false, "Unsupported platform!");
+		MP_ASSERT(false, "Unsupported platform! Only headless windows are available.");
 		return nullptr;
 #endif
 	}
@@ -17,9 +17,10 @@ namespace Mapo
 		String title;
 		U32	   width;
 		U32	   height;
+		bool   headless;
 
-		WindowProps(const String& title_ = "Hello Window", U32 width_ = 800, U32 height_ = 600)
-			: title(title_), width(width_), height(height_)
+		WindowProps(const String& title_ = "Hello Window", U32 width_ = 800, U32 height_ = 600, bool headless_ = false)
+			: title(title_), width(width_), height(height_), headless(headless_)
 		{
 		}
 	};
@@ -46,6 +47,9 @@ namespace Mapo
 		virtual U32 GetWidth() const = 0;
 		virtual U32 GetHeight() const = 0;
 
+		// Headless windows have no native window and receive no input.
+		virtual bool IsHeadless() const { return false; }
+
 		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 
 		// For Vulkan and GLFW.
@@ -0,0 +1,65 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "core/core.h"
+
+#include "engine/input/input.h"
+#include "engine/input/input_recorder.h"
+
+namespace Mapo
+{
+	// Platforms without a windowing backend (e.g. Linux CI boxes) only support headless windows,
+	// which only receive replayed input (see InputRecorder).
+#ifndef MP_MACOS_BUILD
+	bool Input::IsKeyPressed(KeyCode keycode)
+	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->IsKeyPressed(keycode);
+		}
+
+		return false;
+	}
+
+	bool Input::IsAnyModifierPressed()
+	{
+		bool control = Input::IsKeyPressed(Key::LeftControl) || Input::IsKeyPressed(Key::RightControl);
+		bool shift = Input::IsKeyPressed(Key::LeftShift) || Input::IsKeyPressed(Key::RightShift);
+		bool super = Input::IsKeyPressed(Key::LeftSuper) || Input::IsKeyPressed(Key::RightSuper);
+		bool alt = Input::IsKeyPressed(Key::LeftAlt) || Input::IsKeyPressed(Key::RightAlt);
+		return control || shift || super || alt;
+	}
+
+	bool Input::IsMouseButtonPressed(MouseCode button)
+	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->IsMouseButtonPressed(button);
+		}
+
+		return false;
+	}
+
+	Vector2 Input::GetMousePosition()
+	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->mousePosition;
+		}
+
+		return { 0.0f, 0.0f };
+	}
+
+	F32 Input::GetMouseX()
+	{
+		return GetMousePosition().x;
+	}
+
+	F32 Input::GetMouseY()
+	{
+		return GetMousePosition().y;
+	}
+#endif
+
+} // namespace Mapo
@@ -0,0 +1,48 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "headless_window.h"
+
+#include "core/logging.h"
+#include "core/uassert.h"
+
+#include "engine/renderer/vk_common.h"
+
+#include <vulkan/vulkan.h>
+
+namespace Mapo
+{
+	HeadlessWindow::HeadlessWindow(const WindowProps& props)
+		: Window()
+	{
+		m_data.title = props.title;
+		m_data.width = props.width;
+		m_data.height = props.height;
+
+		MP_INFO("Created headless window '{}' ({}x{})", m_data.title, m_data.width, m_data.height);
+	}
+
+	void HeadlessWindow::CreateWindowSurface(void* instance, void* surface)
+	{
+		VkInstance*	  pInstance = (VkInstance*)instance;
+		VkSurfaceKHR* pSurface = (VkSurfaceKHR*)surface;
+
+		// Extension function, so we have to look up its address ourselves.
+		auto func = (PFN_vkCreateHeadlessSurfaceEXT)vkGetInstanceProcAddr(*pInstance, "vkCreateHeadlessSurfaceEXT");
+		MP_ASSERT(func, "Failed to create headless surface. VK_EXT_headless_surface is not supported by the driver!");
+
+		VkHeadlessSurfaceCreateInfoEXT createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+		VK_CHECK(func(*pInstance, &createInfo, nullptr, pSurface));
+	}
+
+	const char** HeadlessWindow::GlfwGetRequiredExtensions(U32* count)
+	{
+		static const char* extensions[] = { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+		*count = 2;
+		return extensions;
+	}
+
+} // namespace Mapo
@@ -0,0 +1,49 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#pragma once
+
+#include "engine/window.h"
+
+namespace Mapo
+{
+	// Window without a display. The swapchain is backed by VK_EXT_headless_surface so that
+	// the renderer runs unchanged on machines without a display server (e.g. lavapipe in CI).
+	class HeadlessWindow : public Window
+	{
+	public:
+		virtual ~HeadlessWindow() = default;
+
+		HeadlessWindow(const WindowProps& props);
+
+		virtual void OnUpdate() override { }
+
+		virtual bool  WasFramebufferResized() const override { return false; }
+		virtual void  ResetFramebufferResizedFlag() override { }
+		virtual void* GetNativeWindow() const override { return nullptr; }
+		virtual U32	  GetWidth() const override { return m_data.width; }
+		virtual U32	  GetHeight() const override { return m_data.height; }
+		virtual bool  IsHeadless() const override { return true; }
+
+		virtual void SetEventCallback(const EventCallbackFn& callback) override { m_data.eventCallback = callback; }
+
+		virtual void		 CreateWindowSurface(void* instance, void* surface) override;
+		virtual void		 GlfwWaitEvents() override { }
+		virtual const char** GlfwGetRequiredExtensions(U32* count) override;
+		virtual void*		 GetCurrentContext() override { return nullptr; }
+		virtual void		 MakeCurrentContext(void* context) override { }
+
+	private:
+		struct WindowData
+		{
+			String			title{};
+			U32				width{};
+			U32				height{};
+			EventCallbackFn eventCallback;
+		};
+
+		WindowData m_data{};
+	};
+
+} // namespace Mapo
@@ -0,0 +1,362 @@
+//
+// Created by Junhao Wang (@forkercat) on 10/19/26.
+//
+
+#include "core/core.h"
+
+#include "engine/profiling/sampler_backend.h"
+
+#ifdef MP_LINUX_BUILD
+	#include <atomic>
+	#include <cerrno>
+	#include <cstring>
+	#include <mutex>
+
+	#include <pthread.h>
+	#include <signal.h>
+	#include <sys/syscall.h>
+	#include <time.h>
+	#include <ucontext.h>
+	#include <unistd.h>
+
+	// Older glibc headers do not expose the field name.
+	#ifndef sigev_notify_thread_id
+		#define sigev_notify_thread_id _sigev_un._tid
+	#endif
+#endif
+
+namespace Mapo
+{
+#ifdef MP_LINUX_BUILD
+	// Each registered thread gets a POSIX timer on its own CPU-time clock that delivers SIGPROF to exactly
+	// that thread. The handler walks the frame pointer chain (the build keeps frame pointers on Linux) and
+	// pushes the stack into a bounded lock-free ring, which SamplingProfiler drains on its own thread.
+
+	static constexpr U32 MAX_THREADS = 64;
+	static constexpr U32 RING_SIZE = 4096; // power of two
+
+	struct ThreadRecord
+	{
+		bool	  used = false;
+		pid_t	  tid = 0;
+		pthread_t handle{};
+		uintptr_t stackLow = 0;
+		uintptr_t stackHigh = 0;
+		timer_t	  timer{};
+		bool	  hasTimer = false;
+		char	  name[32]{};
+	};
+
+	struct SampleSlot
+	{
+		std::atomic<U64> sequence{ 0 };
+		RawSample		 sample;
+	};
+
+	static ThreadRecord s_threads[MAX_THREADS];
+	static std::mutex	s_threadMutex; // never taken in the signal handler
+
+	static SampleSlot		 s_ring[RING_SIZE];
+	static std::atomic<U64>	 s_writePosition{ 0 };
+	static U64				 s_readPosition = 0;
+	static std::atomic<U64>	 s_droppedSamples{ 0 };
+	static std::atomic<bool> s_running{ false };
+	static bool				 s_handlerInstalled = false;
+	static U32				 s_frequencyHz = 0;
+
+	static thread_local ThreadRecord* t_thread = nullptr;
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Signal handler
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static U32 WalkStack(const ucontext_t* context, const ThreadRecord& thread, uintptr_t* frames)
+	{
+	#if defined(__x86_64__)
+		uintptr_t pc = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]);
+		uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RBP]);
+	#elif defined(__aarch64__)
+		uintptr_t pc = static_cast<uintptr_t>(context->uc_mcontext.pc);
+		uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.regs[29]);
+	#else
+		return 0;
+	#endif
+
+		U32 depth = 0;
+		frames[depth++] = pc;
+
+		// Every frame record is [previous fp, return address]. Frames without a frame pointer (system libraries,
+		// drivers) end the walk as soon as the chain leaves the thread's stack or stops growing towards its base.
+		while (depth < RawSample::MAX_STACK_DEPTH)
+		{
+			if (fp < thread.stackLow || fp + 2 * sizeof(uintptr_t) > thread.stackHigh || (fp & (sizeof(uintptr_t) - 1)) != 0)
+			{
+				break;
+			}
+
+			const uintptr_t* record = reinterpret_cast<const uintptr_t*>(fp);
+			uintptr_t		 nextFp = record[0];
+			uintptr_t		 returnAddress = record[1];
+
+			if (returnAddress == 0)
+			{
+				break;
+			}
+
+			frames[depth++] = returnAddress;
+
+			if (nextFp <= fp)
+			{
+				break;
+			}
+
+			fp = nextFp;
+		}
+
+		return depth;
+	}
+
+	static void OnProfilingSignal(int signal, siginfo_t* info, void* context)
+	{
+		const int savedErrno = errno;
+
+		ThreadRecord* thread = t_thread;
+
+		if (thread && s_running.load(std::memory_order_relaxed))
+		{
+			// Bounded MPMC ring (sequence per slot). Drops the sample when the consumer falls behind.
+			U64 position = s_writePosition.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				SampleSlot& slot = s_ring[position & (RING_SIZE - 1)];
+				U64			sequence = slot.sequence.load(std::memory_order_acquire);
+				I64			difference = static_cast<I64>(sequence) - static_cast<I64>(position);
+
+				if (difference == 0)
+				{
+					if (s_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.sample.threadIndex = static_cast<U32>(thread - s_threads);
+						slot.sample.depth = WalkStack(static_cast<const ucontext_t*>(context), *thread, slot.sample.frames);
+						slot.sequence.store(position + 1, std::memory_order_release);
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					s_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+					break;
+				}
+				else
+				{
+					position = s_writePosition.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		errno = savedErrno;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Timers
+	/////////////////////////////////////////////////////////////////////////////////
+
+	static void CreateTimer(ThreadRecord& thread)
+	{
+		clockid_t clock{};
+		if (pthread_getcpuclockid(thread.handle, &clock) != 0)
+		{
+			MP_WARN("SamplingProfiler: Failed to get the CPU clock of thread '{}'", thread.name);
+			return;
+		}
+
+		struct sigevent event{};
+		event.sigev_notify = SIGEV_THREAD_ID;
+		event.sigev_signo = SIGPROF;
+		event.sigev_notify_thread_id = thread.tid;
+
+		if (timer_create(clock, &event, &thread.timer) != 0)
+		{
+			MP_WARN("SamplingProfiler: Failed to create the timer of thread '{}' ({})", thread.name, strerror(errno));
+			return;
+		}
+
+		const long intervalNs = 1000000000L / static_cast<long>(s_frequencyHz);
+
+		struct itimerspec spec{};
+		spec.it_interval.tv_sec = intervalNs / 1000000000L;
+		spec.it_interval.tv_nsec = intervalNs % 1000000000L;
+		spec.it_value = spec.it_interval;
+
+		timer_settime(thread.timer, 0, &spec, nullptr);
+		thread.hasTimer = true;
+	}
+
+	static void DeleteTimer(ThreadRecord& thread)
+	{
+		if (thread.hasTimer)
+		{
+			timer_delete(thread.timer);
+			thread.hasTimer = false;
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////
+	// Backend
+	/////////////////////////////////////////////////////////////////////////////////
+
+	bool SamplerBackend::IsSupported()
+	{
+		return true;
+	}
+
+	bool SamplerBackend::Start(U32 frequencyHz)
+	{
+		std::lock_guard<std::mutex> lock(s_threadMutex);
+
+		if (s_running)
+		{
+			return true;
+		}
+
+		if (!s_handlerInstalled)
+		{
+			// The handler stays installed: a SIGPROF that is still in flight after Stop would otherwise
+			// hit the default action and terminate the process.
+			struct sigaction action{};
+			action.sa_sigaction = OnProfilingSignal;
+			action.sa_flags = SA_SIGINFO | SA_RESTART;
+			sigemptyset(&action.sa_mask);
+
+			if (sigaction(SIGPROF, &action, nullptr) != 0)
+			{
+				MP_ERROR("SamplingProfiler: Failed to install the SIGPROF handler ({})", strerror(errno));
+				return false;
+			}
+
+			s_handlerInstalled = true;
+		}
+
+		for (U32 i = 0; i < RING_SIZE; ++i)
+		{
+			s_ring[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		s_writePosition.store(0, std::memory_order_relaxed);
+		s_readPosition = 0;
+		s_droppedSamples.store(0, std::memory_order_relaxed);
+
+		s_frequencyHz = frequencyHz;
+		s_running.store(true, std::memory_order_release);
+
+		for (ThreadRecord& thread : s_threads)
+		{
+			if (thread.used)
+			{
+				CreateTimer(thread);
+			}
+		}
+
+		return true;
+	}
+
+	void SamplerBackend::Stop()
+	{
+		std::lock_guard<std::mutex> lock(s_threadMutex);
+
+		for (ThreadRecord& thread : s_threads)
+		{
+			DeleteTimer(thread);
+		}
+
+		s_running.store(false, std::memory_order_release);
+	}
+
+	void SamplerBackend::RegisterCurrentThread(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(s_threadMutex);
+
+		if (t_thread)
+		{
+			return;
+		}
+
+		for (ThreadRecord& thread : s_threads)
+		{
+			if (thread.used)
+			{
+				continue;
+			}
+
+			thread = ThreadRecord{};
+			thread.used = true;
+			thread.tid = static_cast<pid_t>(syscall(SYS_gettid));
+			thread.handle = pthread_self();
+			strncpy(thread.name, name, sizeof(thread.name) - 1);
+
+			pthread_attr_t attributes;
+			if (pthread_getattr_np(thread.handle, &attributes) == 0)
+			{
+				void*  stackAddress = nullptr;
+				size_t stackSize = 0;
+				pthread_attr_getstack(&attributes, &stackAddress, &stackSize);
+				pthread_attr_destroy(&attributes);
+
+				thread.stackLow = reinterpret_cast<uintptr_t>(stackAddress);
+				thread.stackHigh = thread.stackLow + stackSize;
+			}
+
+			t_thread = &thread;
+
+			if (s_running)
+			{
+				CreateTimer(thread);
+			}
+			return;
+		}
+
+		MP_WARN("SamplingProfiler: Too many threads. '{}' is not sampled.", name);
+	}
+
+	void SamplerBackend::UnregisterCurrentThread()
+	{
+		std::lock_guard<std::mutex> lock(s_threadMutex);
+
+		if (ThreadRecord* thread = t_thread)
+		{
+			t_thread = nullptr;
+			DeleteTimer(*thread);
+			thread->used = false;
+		}
+	}
+
+	const char* SamplerBackend::GetThreadName(U32 threadIndex)
+	{
+		return threadIndex < MAX_THREADS ? s_threads[threadIndex].name : "?";
+	}
+
+	bool SamplerBackend::PopSample(RawSample& sample)
+	{
+		SampleSlot& slot = s_ring[s_readPosition & (RING_SIZE - 1)];
+
+		if (slot.sequence.load(std::memory_order_acquire) != s_readPosition + 1)
+		{
+			return false;
+		}
+
+		sample.threadIndex = slot.sample.threadIndex;
+		sample.depth = slot.sample.depth;
+		memcpy(sample.frames, slot.sample.frames, sample.depth * sizeof(uintptr_t));
+
+		slot.sequence.store(s_readPosition + RING_SIZE, std::memory_order_release);
+		s_readPosition++;
+		return true;
+	}
+
+	U64 SamplerBackend::GetDroppedSampleCount()
+	{
+		return s_droppedSamples.load(std::memory_order_relaxed);
+	}
+#endif
+
+} // namespace Mapo
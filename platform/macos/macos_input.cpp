@@ -6,6 +6,7 @@
 
 #include "engine/application.h"
 #include "engine/input/input.h"
+#include "engine/input/input_recorder.h"
 
 #ifdef MP_MACOS_BUILD
 	#include <GLFW/glfw3.h>
@@ -16,8 +17,17 @@ namespace Mapo
 #ifdef MP_MACOS_BUILD
 	bool Input::IsKeyPressed(KeyCode keycode)
 	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->IsKeyPressed(keycode);
+		}
+
 		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
+		if (!window)
+		{
+			return false; // headless
+		}
 		int state = glfwGetKey(window, static_cast<I32>(keycode));
 		return state == GLFW_PRESS || state == GLFW_REPEAT;
 	}
@@ -33,17 +43,35 @@ namespace Mapo
 
 	bool Input::IsMouseButtonPressed(MouseCode button)
 	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->IsMouseButtonPressed(button);
+		}
+
 		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
+		if (!window)
+		{
+			return false; // headless
+		}
 		int state = glfwGetMouseButton(window, static_cast<I32>(button));
 		return state == GLFW_PRESS;
 	}
 
 	Vector2 Input::GetMousePosition()
 	{
+		if (const InputState* replayState = InputRecorder::GetReplayState())
+		{
+			return replayState->mousePosition;
+		}
+
 		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 		F64 x{}, y{};
+		if (!window)
+		{
+			return { 0.0f, 0.0f }; // headless
+		}
 		glfwGetCursorPos(window, &x, &y);
 		return { (F32)x, (F32)y };
 	}